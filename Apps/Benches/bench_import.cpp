@@ -0,0 +1,102 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <cstdio>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Algo/Export/export.h"
+#include "Algo/Import/import.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+/**
+ * read the tables of an OBJ and an OFF file with 1 and with all threads
+ * and give the throughput of the text parsing
+ */
+void benchTables(const char* filename, unsigned int nbThreads)
+{
+	unsigned int save = CGoGN::Parallel::NumberOfThreads ;
+	CGoGN::Parallel::NumberOfThreads = nbThreads ;
+
+	MAP myMap ;
+	Algo::Surface::Import::MeshTablesSurface<PFP> mts(myMap) ;
+	std::vector<std::string> attrNames ;
+	if (!mts.importMesh(filename, attrNames))
+		std::cout << "failed to read " << filename << std::endl ;
+	else
+		std::cout << filename << " (" << nbThreads << " threads): " << mts.getNbVertices() << " vertices, " << mts.getNbFaces() << " faces in "
+			<< mts.getImportTime() << " ms (" << mts.getImportThroughput() << " MB/s)" << std::endl ;
+
+	CGoGN::Parallel::NumberOfThreads = save ;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int n = 1000 ;
+	if (argc > 1)
+		n = atoi(argv[1]) ;
+
+	{
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		Algo::Surface::Tilings::Square::Cylinder<PFP> c(myMap, n, n, true, true) ;
+		c.embedIntoSphere(position, 10.0f) ;
+
+		Algo::Surface::Export::exportOBJ<PFP>(myMap, position, "bench_import.obj") ;
+		Algo::Surface::Export::exportOFF<PFP>(myMap, position, "bench_import.off") ;
+	}
+
+	const char* files[2] = { "bench_import.obj", "bench_import.off" } ;
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		benchTables(files[i], 1) ;
+		if (CGoGN::Parallel::NumberOfThreads > 1)
+			benchTables(files[i], CGoGN::Parallel::NumberOfThreads) ;
+
+		// complete import (tables and sewing)
+		Utils::Chrono chrono ;
+		MAP myMap ;
+		std::vector<std::string> attrNames ;
+		chrono.start() ;
+		Algo::Surface::Import::importMesh<PFP>(myMap, files[i], attrNames) ;
+		std::cout << "importMesh " << files[i] << " in " << chrono.elapsed() << " ms" << std::endl ;
+
+		remove(files[i]) ;
+	}
+
+	return 0 ;
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Remeshing/isotropic.h"
+#include "Geometry/distances.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+typedef PFP::REAL REAL ;
+
+void bumpyTorus(MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int n)
+{
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(map, 2 * n, n) ;
+	tore.embedIntoTore(position, 2.0f, 0.7f) ;
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		VEC3& p = position[i] ;
+		p[2] *= 1.0f + 0.15f * std::sin(6.0f * std::atan2(p[1], p[0])) ;
+	}
+}
+
+// max distance from the given points to the faces of the map
+REAL maxDistance(MAP& map, const VertexAttribute<VEC3, MAP>& position, const std::vector<VEC3>& points)
+{
+	std::vector<VEC3> tris ;
+	for (Face f : allFacesOf(map))
+	{
+		tris.push_back(position[f.dart]) ;
+		tris.push_back(position[map.phi1(f.dart)]) ;
+		tris.push_back(position[map.phi_1(f.dart)]) ;
+	}
+	REAL max = 0 ;
+	for (unsigned int i = 0; i < points.size(); ++i)
+	{
+		REAL d2 = std::numeric_limits<REAL>::max() ;
+		for (unsigned int t = 0; t < tris.size(); t += 3)
+			d2 = std::min(d2, Geom::squaredDistancePoint2Triangle(points[i], tris[t], tris[t + 1], tris[t + 2])) ;
+		max = std::max(max, d2) ;
+	}
+	return std::sqrt(max) ;
+}
+
+/**
+ * isotropic remeshing of a bumpy torus with 1 thread and with all threads:
+ * time, edge length deviation, proportion of regular vertices and distance
+ * from a sample of the original vertices to the result
+ */
+int main(int argc, char **argv)
+{
+	unsigned int n = 200 ;
+	if (argc > 1)
+		n = atoi(argv[1]) ;
+	// about the length of the edges of the minor circles: the long edges are split
+	const REAL target = REAL(2.0 * M_PI * 0.7 / n) ;
+
+	Utils::Chrono chrono ;
+	std::vector<VEC3> samples ;
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		unsigned int nbth = (i == 1) ? CGoGN::Parallel::NumberOfThreads : 1 ;
+		if (i == 1 && nbth <= 1)
+			break ;
+
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		bumpyTorus(myMap, position, n) ;
+		if (samples.empty())
+		{
+			unsigned int k = 0 ;
+			for (unsigned int j = position.begin(); j != position.end(); position.next(j), ++k)
+				if (k % 997 == 0)
+					samples.push_back(position[j]) ;
+		}
+
+		chrono.start() ;
+		Algo::Surface::Remeshing::isotropicRemeshing<PFP>(myMap, position, target, 5, nbth) ;
+		std::cout << "isotropic remeshing (" << nbth << " threads) in " << chrono.elapsed() << " ms" ;
+
+		REAL sum = 0, sum2 = 0 ;
+		unsigned int nbEdges = 0 ;
+		for (Edge e : allEdgesOf(myMap))
+		{
+			REAL l = (position[myMap.phi1(e.dart)] - position[e.dart]).norm() ;
+			sum += l ;
+			sum2 += l * l ;
+			++nbEdges ;
+		}
+		REAL mean = sum / nbEdges ;
+		REAL deviation = std::sqrt(std::max(REAL(0), sum2 / nbEdges - mean * mean)) ;
+
+		unsigned int nbVertices = 0, nbRegular = 0 ;
+		for (Vertex v : allVerticesOf(myMap))
+		{
+			++nbVertices ;
+			if (myMap.vertexDegree(v.dart) == 6)
+				++nbRegular ;
+		}
+
+		std::cout << " - " << nbVertices << " vertices, edge length " << mean << " +/- " << deviation
+			<< " (target " << target << "), regular " << REAL(nbRegular) / nbVertices
+			<< ", max error " << maxDistance(myMap, position, samples) << std::endl ;
+	}
+
+	return 0 ;
+}
@@ -0,0 +1,106 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+/**
+ * compare gzip binary map files (saveMapBin) with raw mappable ones (saveMapBinRaw)
+ * and chunked ones compressed in parallel (saveMapBinChunked)
+ */
+int main(int argc, char **argv)
+{
+	unsigned int n = 1000 ;
+	if (argc > 1)
+		n = atoi(argv[1]) ;
+
+	Utils::Chrono chrono ;
+
+	{
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		Algo::Surface::Tilings::Square::Cylinder<PFP> c(myMap, n, n, true, true) ;
+		c.embedIntoSphere(position, 10.0f) ;
+
+		chrono.start() ;
+		myMap.saveMapBin("bench_mapio.map") ;
+		std::cout << "saveMapBin in " << chrono.elapsed() << " ms" << std::endl ;
+
+		chrono.start() ;
+		myMap.saveMapBinRaw("bench_mapio.rmap") ;
+		std::cout << "saveMapBinRaw in " << chrono.elapsed() << " ms" << std::endl ;
+
+		chrono.start() ;
+		myMap.saveMapBinChunked("bench_mapio.cmap") ;
+		std::cout << "saveMapBinChunked in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	{
+		MAP myMap ;
+		chrono.start() ;
+		myMap.loadMapBin("bench_mapio.map") ;
+		std::cout << "loadMapBin in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	{
+		MAP myMap ;
+		chrono.start() ;
+		myMap.loadMapBinChunked("bench_mapio.cmap") ;
+		std::cout << "loadMapBinChunked in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	{
+		MAP myMap ;
+		chrono.start() ;
+		myMap.loadMapBinRaw("bench_mapio.rmap") ;
+		std::cout << "loadMapBinRaw in " << chrono.elapsed() << " ms" << std::endl ;
+
+		// first traversal touches the mapped pages
+		VertexAttribute<VEC3, MAP> position = myMap.getAttribute<VEC3, VERTEX, MAP>("position") ;
+		VEC3 center(0) ;
+		chrono.start() ;
+		foreach_cell<VERTEX>(myMap, [&] (Vertex v)
+		{
+			center += position[v] ;
+		});
+		std::cout << "first traversal after loadMapBinRaw in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	return 0 ;
+}
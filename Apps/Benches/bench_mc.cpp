@@ -0,0 +1,111 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <cmath>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/MC/marchingcube.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+typedef Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> MC ;
+
+/**
+ * compare simpleMeshing and parallelMeshing on a n^3 image and on its bricked version
+ * (with an empty frame: simpleMeshing needs the object inside the image)
+ */
+int main(int argc, char **argv)
+{
+	int n = 256 ;
+	if (argc > 1)
+		n = atoi(argv[1]) ;
+
+	std::vector<unsigned char> data(std::size_t(n) * n * n) ;
+	for (int z = 0; z < n; ++z)
+		for (int y = 0; y < n; ++y)
+			for (int x = 0; x < n; ++x)
+			{
+				float fx = float(x) / n, fy = float(y) / n, fz = float(z) / n ;
+				float v = std::sin(3.0f * fx) * std::cos(2.0f * fy) + std::sin(3.0f * fz) ;
+				bool frame = (x == 0) || (y == 0) || (z == 0) || (x == n - 1) || (y == n - 1) || (z == n - 1) ;
+				data[x + std::size_t(n) * (y + std::size_t(n) * z)] = frame ? 0 : (unsigned char)(127.0f + 60.0f * v) ;
+			}
+	Algo::Surface::MC::Image<unsigned char> img(&data[0], n, n, n, 1.0f, 1.0f, 1.0f, false) ;
+
+	Algo::Surface::MC::WindowingGreater<unsigned char> wind ;
+	wind.setIsoValue(127) ;
+
+	Utils::Chrono chrono ;
+
+	{
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		MC mc(&img, &myMap, position, wind, false) ;
+		chrono.start() ;
+		mc.simpleMeshing() ;
+		std::cout << "simpleMeshing in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	unsigned int nbth[2] = { 1, unsigned(CGoGN::Parallel::NumberOfThreads) } ;
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		if (i == 1 && nbth[1] <= 1)
+			break ;
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		MC mc(&img, &myMap, position, wind, false) ;
+		chrono.start() ;
+		mc.parallelMeshing(nbth[i]) ;
+		std::cout << "parallelMeshing (" << nbth[i] << " threads) in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	{
+		Algo::Surface::MC::BrickedImage<unsigned char> bricked ;
+		chrono.start() ;
+		bricked.create(img) ;
+		std::cout << "bricks created in " << chrono.elapsed() << " ms (" << bricked.getNbStoredBricks() << " stored, "
+			<< bricked.getStoredSize() / 1024 << " KB)" << std::endl ;
+
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		MC mc(&bricked, &myMap, position, wind, false) ;
+		chrono.start() ;
+		mc.parallelMeshing() ;
+		std::cout << "parallelMeshing on bricks in " << chrono.elapsed() << " ms" << std::endl ;
+	}
+
+	return 0 ;
+}
@@ -0,0 +1,100 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdlib>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/BooleanOperator/mergeVertices.h"
+#include "Algo/Topo/basic.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+/**
+ * build a n x n grid of segments, each segment having its own two vertices,
+ * with a jitter smaller than the merge precision on every vertex
+ */
+void buildSegments(MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int n)
+{
+	srand(42) ;
+	for (unsigned int i = 0 ; i < n ; ++i)
+	{
+		for (unsigned int j = 0 ; j < n ; ++j)
+		{
+			for (unsigned int k = 0 ; k < 2 ; ++k)
+			{
+				if ((k == 0 && i + 1 == n) || (k == 1 && j + 1 == n))
+					continue ;
+				Dart d = map.newPolyLine(1) ;
+				VEC3 p0(10.0f * i, 10.0f * j, 0.0f) ;
+				VEC3 p1 = (k == 0) ? VEC3(10.0f * (i + 1), 10.0f * j, 0.0f) : VEC3(10.0f * i, 10.0f * (j + 1), 0.0f) ;
+				VEC3 jitter0(0.2f * rand() / RAND_MAX, 0.2f * rand() / RAND_MAX, 0.0f) ;
+				VEC3 jitter1(0.2f * rand() / RAND_MAX, 0.2f * rand() / RAND_MAX, 0.0f) ;
+				position[d] = p0 + jitter0 ;
+				position[map.phi1(d)] = p1 + jitter1 ;
+			}
+		}
+	}
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int n = 100 ;
+	if (argc > 1)
+		n = atoi(argv[1]) ;
+
+	Utils::Chrono chrono ;
+
+	{
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		buildSegments(myMap, position, n) ;
+		std::cout << "grid of " << n << "x" << n << " -> " << Algo::Topo::getNbOrbits<VERTEX>(myMap) << " vertices before merge" << std::endl ;
+
+		chrono.start() ;
+		Algo::Surface::BooleanOperator::mergeVertices<PFP>(myMap, position, 1) ;
+		std::cout << "mergeVertices (grid) in " << chrono.elapsed() << " ms -> " << Algo::Topo::getNbOrbits<VERTEX>(myMap) << " vertices" << std::endl ;
+	}
+
+	{
+		MAP myMap ;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+		buildSegments(myMap, position, n) ;
+
+		chrono.start() ;
+		Algo::Surface::BooleanOperator::mergeVerticesNaive<PFP>(myMap, position, 1) ;
+		std::cout << "mergeVerticesNaive in " << chrono.elapsed() << " ms -> " << Algo::Topo::getNbOrbits<VERTEX>(myMap) << " vertices" << std::endl ;
+	}
+
+	return 0 ;
+}
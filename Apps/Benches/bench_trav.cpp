@@ -28,8 +28,12 @@
 #include "Algo/Tiling/Volume/cubic.h"
 #include "Algo/Geometry/area.h"
 #include "Algo/Geometry/volume.h"
+#include "Algo/Topo/reorder.h"
 #include "Utils/chrono.h"
 
+#include <algorithm>
+#include <random>
+
 
 using namespace CGoGN ;
 
@@ -49,21 +53,11 @@ typedef PFP::MAP MAP;
 typedef PFP::MAP::IMPL MAP_IMPL;
 typedef PFP::VEC3 VEC3;
 
-int main()
+/**
+ * center of the mesh computed as mean of centers of volumes (from centers of faces)
+ */
+VEC3 meshCenter(MAP& myMap, const VertexAttribute<VEC3, MAP>& position)
 {
-	// declare a map to handle the mesh
-	MAP myMap;
-
-	Utils::Chrono ch;
-	ch.start();
-	// add position attribute on vertices and get handler on it
-	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
-	const int nb = 100;
-	Algo::Volume::Tilings::Cubic::Grid<PFP> cubic(myMap, nb, nb, nb);
-	cubic.embedIntoGrid(position, 10.0f, 10.0f, 10.0f);
-	std::cout<< "construct grid in " << ch.elapsed()<< " ms"<< std::endl;
-
-	ch.start();
 	VEC3 centerMesh(0,0,0);
 	int nbVols=0;
 	foreach_cell<VOLUME>(myMap, [&](Vol w) // foreach volume
@@ -88,12 +82,31 @@ int main()
 		nbVols++;
 	});
 	centerMesh /= nbVols;
+	return centerMesh;
+}
+
+int main()
+{
+	// declare a map to handle the mesh
+	MAP myMap;
+
+	Utils::Chrono ch;
+	ch.start();
+	// add position attribute on vertices and get handler on it
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	const int nb = 100;
+	Algo::Volume::Tilings::Cubic::Grid<PFP> cubic(myMap, nb, nb, nb);
+	cubic.embedIntoGrid(position, 10.0f, 10.0f, 10.0f);
+	std::cout<< "construct grid in " << ch.elapsed()<< " ms"<< std::endl;
+
+	ch.start();
+	VEC3 centerMesh = meshCenter(myMap, position);
 	CGoGNout<< "Traverse with foreach in " << ch.elapsed()<< " ms"<< CGoGNendl;
 
 
 	ch.start();
 	centerMesh=VEC3(0,0,0);
-	nbVols=0;
+	int nbVols=0;
 	TraversorW<MAP> tw(myMap);	// alias for Traversor<MAP,VERTEX>
 	for (Dart dw=tw.begin(); dw!=tw.end(); dw=tw.next())
 	{
@@ -132,6 +145,44 @@ int main()
 
 	CGoGNout<< "Linear volume:" << ch.elapsed()<< " ms  val="<<vol<< CGoGNendl;
 
+	// same traversal with darts and vertices stored contiguously (single indexed accesses)
+	ch.start();
+	myMap.getAttributeContainer<DART>().setContiguousStorage(myMap.getAttributeContainer<DART>().realEnd());
+	myMap.getAttributeContainer<VERTEX>().setContiguousStorage(myMap.getAttributeContainer<VERTEX>().realEnd());
+	CGoGNout<< "Switch to contiguous storage in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
+	ch.start();
+	centerMesh = meshCenter(myMap, position);
+	CGoGNout<< "Traverse with foreach (contiguous storage) in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
+	// locality of traversals: random renumbering (as after many modifications) then reorderings
+	std::vector<unsigned int> dartOrder;
+	for (Dart d = myMap.begin(); d != myMap.end(); myMap.next(d))
+		dartOrder.push_back(myMap.dartIndex(d));
+	std::mt19937 rng(0);
+	std::shuffle(dartOrder.begin(), dartOrder.end(), rng);
+	myMap.reorder(dartOrder);
+
+	ch.start();
+	centerMesh = meshCenter(myMap, position);
+	CGoGNout<< "Traverse with foreach (random order) in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
+	ch.start();
+	Algo::Topo::reorderBFS(myMap);
+	CGoGNout<< "BFS reordering in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
+	ch.start();
+	centerMesh = meshCenter(myMap, position);
+	CGoGNout<< "Traverse with foreach (BFS order) in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
+	ch.start();
+	Algo::Topo::reorderHilbert<PFP>(myMap, position);
+	CGoGNout<< "Hilbert reordering in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
+	ch.start();
+	centerMesh = meshCenter(myMap, position);
+	CGoGNout<< "Traverse with foreach (Hilbert order) in " << ch.elapsed()<< " ms"<< CGoGNendl;
+
 
 	return 0;
 }
@@ -0,0 +1,90 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Export/exportVTU.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP ;
+};
+
+typedef PFP::MAP MAP ;
+typedef PFP::VEC3 VEC3 ;
+
+std::size_t fileSize(const char* filename)
+{
+	std::ifstream fs(filename, std::ios::in | std::ios::binary | std::ios::ate) ;
+	return std::size_t(fs.tellg()) ;
+}
+
+/**
+ * export of a large torus: binary inline VTU, appended raw VTU and
+ * appended zlib VTU with 1 thread and with all threads (time and size)
+ */
+int main(int argc, char **argv)
+{
+	unsigned int n = 1000 ;
+	if (argc > 1)
+		n = atoi(argv[1]) ;
+
+	MAP myMap ;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position") ;
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(myMap, 2 * n, n) ;
+	tore.embedIntoTore(position, 2.0f, 0.7f) ;
+
+	const char* filename = "bench_vtuExport.vtu" ;
+	Utils::Chrono chrono ;
+
+	chrono.start() ;
+	Algo::Surface::Export::exportVTUBinary<PFP>(myMap, position, filename) ;
+	std::cout << "exportVTUBinary in " << chrono.elapsed() << " ms, " << fileSize(filename) << " bytes" << std::endl ;
+
+	chrono.start() ;
+	Algo::Surface::Export::exportVTUAppended<PFP>(myMap, position, filename, false) ;
+	std::cout << "exportVTUAppended raw in " << chrono.elapsed() << " ms, " << fileSize(filename) << " bytes" << std::endl ;
+
+	chrono.start() ;
+	Algo::Surface::Export::exportVTUAppended<PFP>(myMap, position, filename, true, 1) ;
+	std::cout << "exportVTUAppended zlib (1 thread) in " << chrono.elapsed() << " ms, " << fileSize(filename) << " bytes" << std::endl ;
+
+	if (CGoGN::Parallel::NumberOfThreads > 1)
+	{
+		chrono.start() ;
+		Algo::Surface::Export::exportVTUAppended<PFP>(myMap, position, filename, true, CGoGN::Parallel::NumberOfThreads) ;
+		std::cout << "exportVTUAppended zlib (" << CGoGN::Parallel::NumberOfThreads << " threads) in " << chrono.elapsed() << " ms, "
+			<< fileSize(filename) << " bytes" << std::endl ;
+	}
+
+	remove(filename) ;
+	return 0 ;
+}
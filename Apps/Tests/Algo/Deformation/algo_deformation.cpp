@@ -0,0 +1,11 @@
+#include <iostream>
+
+extern int test_asRigidAsPossible();
+
+
+int main()
+{
+	test_asRigidAsPossible();
+
+	return 0;
+}
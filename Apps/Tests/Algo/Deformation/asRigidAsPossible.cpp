@@ -0,0 +1,27 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Deformation/asRigidAsPossible.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+
+template class Algo::Surface::Deformation::ARAP<PFP1>;
+template class Algo::Surface::Deformation::ARAP<PFP2>;
+
+
+int test_asRigidAsPossible()
+{
+	return 0;
+}
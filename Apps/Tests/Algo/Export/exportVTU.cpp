@@ -15,6 +15,7 @@ struct PFP1 : public PFP_STANDARD
 
 template bool Algo::Surface::Export::exportVTU<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename);
 template bool Algo::Surface::Export::exportVTUBinary<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename);
+template bool Algo::Surface::Export::exportVTUAppended<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const char* filename, bool compress, unsigned int nbThreads);
 template class Algo::Surface::Export::VTUExporter<PFP1>;
 
 
@@ -23,6 +24,7 @@ struct PFP2 : public PFP_STANDARD
 	typedef EmbeddedMap3 MAP;
 };
 
+template bool Algo::Volume::Export::exportVTUAppended<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const char* filename, bool compress, unsigned int nbThreads);
 template class Algo::Volume::Export::VTUExporter<PFP2>;
 
 int test_exportVTU()
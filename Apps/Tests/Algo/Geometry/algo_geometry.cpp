@@ -3,6 +3,7 @@
 extern int test_area();
 extern int test_centroid();
 extern int test_boundingbox();
+extern int test_bvh();
 extern int test_basic();
 extern int test_convexity();
 extern int test_curvature();
@@ -14,6 +15,7 @@ int main()
 	test_area();
 	test_centroid();
 	test_boundingbox();
+	test_bvh();
 	test_basic();
 	test_convexity();
 	test_curvature();
@@ -0,0 +1,34 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+
+#include "Algo/Geometry/bvh.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_STANDARD
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+
+template class Algo::Geometry::BVH<PFP1>;
+template class Algo::Geometry::BVH<PFP2>;
+template class Algo::Geometry::BVH<PFP3>;
+
+
+int test_bvh()
+{
+	return 0;
+}
@@ -38,6 +38,24 @@ template PFP3::REAL Algo::Geometry::squaredDistancePoint2Edge<PFP3>(PFP3::MAP& m
 
 
 
+template Algo::Geometry::DistanceStats<PFP1::REAL> Algo::Geometry::computeDistance<PFP1>(PFP1::MAP& map1, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position1, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance1, const Algo::Geometry::BVH<PFP1>& bvh2);
+template Algo::Geometry::DistanceStats<PFP1::REAL> Algo::Geometry::computeDistance<PFP1>(PFP1::MAP& map1, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position1, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance1, PFP1::MAP& map2, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2);
+template Algo::Geometry::DistanceStats<PFP1::REAL> Algo::Geometry::computeSymmetricDistance<PFP1>(PFP1::MAP& map1, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position1, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance1, PFP1::MAP& map2, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance2, Algo::Geometry::DistanceStats<PFP1::REAL>& stats12, Algo::Geometry::DistanceStats<PFP1::REAL>& stats21);
+template Algo::Geometry::DistanceStats<PFP1::REAL> Algo::Geometry::Parallel::computeDistance<PFP1>(PFP1::MAP& map1, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position1, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance1, const Algo::Geometry::BVH<PFP1>& bvh2);
+template Algo::Geometry::DistanceStats<PFP1::REAL> Algo::Geometry::Parallel::computeSymmetricDistance<PFP1>(PFP1::MAP& map1, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position1, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance1, PFP1::MAP& map2, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance2, Algo::Geometry::DistanceStats<PFP1::REAL>& stats12, Algo::Geometry::DistanceStats<PFP1::REAL>& stats21);
+
+template Algo::Geometry::DistanceStats<PFP2::REAL> Algo::Geometry::computeDistance<PFP2>(PFP2::MAP& map1, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position1, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance1, const Algo::Geometry::BVH<PFP2>& bvh2);
+template Algo::Geometry::DistanceStats<PFP2::REAL> Algo::Geometry::computeDistance<PFP2>(PFP2::MAP& map1, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position1, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance1, PFP2::MAP& map2, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2);
+template Algo::Geometry::DistanceStats<PFP2::REAL> Algo::Geometry::computeSymmetricDistance<PFP2>(PFP2::MAP& map1, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position1, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance1, PFP2::MAP& map2, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance2, Algo::Geometry::DistanceStats<PFP2::REAL>& stats12, Algo::Geometry::DistanceStats<PFP2::REAL>& stats21);
+template Algo::Geometry::DistanceStats<PFP2::REAL> Algo::Geometry::Parallel::computeDistance<PFP2>(PFP2::MAP& map1, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position1, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance1, const Algo::Geometry::BVH<PFP2>& bvh2);
+template Algo::Geometry::DistanceStats<PFP2::REAL> Algo::Geometry::Parallel::computeSymmetricDistance<PFP2>(PFP2::MAP& map1, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position1, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance1, PFP2::MAP& map2, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance2, Algo::Geometry::DistanceStats<PFP2::REAL>& stats12, Algo::Geometry::DistanceStats<PFP2::REAL>& stats21);
+
+template Algo::Geometry::DistanceStats<PFP3::REAL> Algo::Geometry::computeDistance<PFP3>(PFP3::MAP& map1, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position1, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance1, const Algo::Geometry::BVH<PFP3>& bvh2);
+template Algo::Geometry::DistanceStats<PFP3::REAL> Algo::Geometry::computeDistance<PFP3>(PFP3::MAP& map1, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position1, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance1, PFP3::MAP& map2, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2);
+template Algo::Geometry::DistanceStats<PFP3::REAL> Algo::Geometry::computeSymmetricDistance<PFP3>(PFP3::MAP& map1, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position1, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance1, PFP3::MAP& map2, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance2, Algo::Geometry::DistanceStats<PFP3::REAL>& stats12, Algo::Geometry::DistanceStats<PFP3::REAL>& stats21);
+template Algo::Geometry::DistanceStats<PFP3::REAL> Algo::Geometry::Parallel::computeDistance<PFP3>(PFP3::MAP& map1, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position1, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance1, const Algo::Geometry::BVH<PFP3>& bvh2);
+template Algo::Geometry::DistanceStats<PFP3::REAL> Algo::Geometry::Parallel::computeSymmetricDistance<PFP3>(PFP3::MAP& map1, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position1, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance1, PFP3::MAP& map2, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance2, Algo::Geometry::DistanceStats<PFP3::REAL>& stats12, Algo::Geometry::DistanceStats<PFP3::REAL>& stats21);
+
 int test_distances()
 {
 	return 0;
@@ -1,10 +1,12 @@
 #include <iostream>
 
 extern int test_pliant();
+extern int test_isotropic();
 
 int main()
 {
 	test_pliant();
+	test_isotropic();
 
 	return 0;
 }
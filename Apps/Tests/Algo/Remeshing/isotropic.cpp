@@ -0,0 +1,39 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/gmap/embeddedGMap2.h"
+
+
+#include "Algo/Remeshing/isotropic.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_DOUBLE
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+
+template class Algo::Surface::Remeshing::IsotropicRemesher<PFP1>;
+template class Algo::Surface::Remeshing::IsotropicRemesher<PFP2>;
+template class Algo::Surface::Remeshing::IsotropicRemesher<PFP3>;
+
+template void Algo::Surface::Remeshing::isotropicRemeshing<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::REAL, PFP1::MAP>& targetLength, unsigned int nbIterations, unsigned int nbth);
+template void Algo::Surface::Remeshing::isotropicRemeshing<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL targetLength, unsigned int nbIterations, unsigned int nbth);
+template void Algo::Surface::Remeshing::isotropicRemeshing<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, PFP3::REAL targetLength, unsigned int nbIterations, unsigned int nbth);
+
+
+int test_isotropic()
+{
+
+	return 0;
+}
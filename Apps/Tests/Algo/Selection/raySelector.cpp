@@ -193,6 +193,63 @@ template Edge Algo::Selection::edgesBubbleSelection<PFP4>(PFP4::MAP& map, const
 	const PFP4::VEC3& cursor, PFP4::REAL radiusMax);
 
 
+// MAP2 float with BVH
+template void Algo::Selection::facesRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, std::vector<Face>& vecFaces, std::vector<PFP1::VEC3>& iPoints);
+
+template void Algo::Selection::facesRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, std::vector<Face>& vecFaces);
+
+template void Algo::Selection::faceRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, Face& face);
+
+template void Algo::Selection::edgesRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, std::vector<Edge>& vecEdges, float distMax);
+
+template void Algo::Selection::edgeRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, Edge& edge);
+
+template void Algo::Selection::verticesRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, std::vector<Vertex>& vecVertices, float dist);
+
+template void Algo::Selection::vertexRaySelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, Vertex& vertex);
+
+template void Algo::Selection::verticesConeSelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, float angle, std::vector<Vertex>& vecVertices);
+
+template void Algo::Selection::edgesConeSelection<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, const Algo::Geometry::BVH<PFP1>& bvh,
+	const PFP1::VEC3& rayA, const PFP1::VEC3& rayAB, float angle, std::vector<Edge>& vecEdges);
+
+// MAP2 double with BVH
+template void Algo::Selection::facesRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, std::vector<Face>& vecFaces, std::vector<PFP2::VEC3>& iPoints);
+
+template void Algo::Selection::facesRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, std::vector<Face>& vecFaces);
+
+template void Algo::Selection::faceRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, Face& face);
+
+template void Algo::Selection::edgesRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, std::vector<Edge>& vecEdges, float distMax);
+
+template void Algo::Selection::edgeRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, Edge& edge);
+
+template void Algo::Selection::verticesRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, std::vector<Vertex>& vecVertices, float dist);
+
+template void Algo::Selection::vertexRaySelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, Vertex& vertex);
+
+template void Algo::Selection::verticesConeSelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, float angle, std::vector<Vertex>& vecVertices);
+
+template void Algo::Selection::edgesConeSelection<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::BVH<PFP2>& bvh,
+	const PFP2::VEC3& rayA, const PFP2::VEC3& rayAB, float angle, std::vector<Edge>& vecEdges);
+
+
 
 
 
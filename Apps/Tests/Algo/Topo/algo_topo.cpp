@@ -2,16 +2,20 @@
 
 extern int test_basic();
 extern int test_embedding();
+extern int test_reorder();
 extern int test_simplex();
 extern int test_uniformOrientation();
 
 int main()
 {
+	int status = 0;
+
 	test_basic();
 	test_embedding();
+	status |= test_reorder();
 	test_simplex();
 	test_uniformOrientation();
 
 
-	return 0;
+	return status;
 }
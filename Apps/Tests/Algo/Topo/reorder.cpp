@@ -0,0 +1,216 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/gmap/embeddedGMap2.h"
+#include "Topology/map/embeddedMap3.h"
+
+#include "Algo/Topo/reorder.h"
+#include "Algo/Topo/basic.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include <array>
+#include <map>
+#include <random>
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+struct PFP3 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+template void Algo::Topo::dartOrderBFS<EmbeddedMap2>(EmbeddedMap2& map, std::vector<unsigned int>& dartOrder);
+template void Algo::Topo::dartOrderBFS<EmbeddedGMap2>(EmbeddedGMap2& map, std::vector<unsigned int>& dartOrder);
+template void Algo::Topo::dartOrderBFS<EmbeddedMap3>(EmbeddedMap3& map, std::vector<unsigned int>& dartOrder);
+
+template void Algo::Topo::dartOrderHilbert<PFP1>(EmbeddedMap2& map, const VertexAttribute<PFP1::VEC3, EmbeddedMap2>& position, std::vector<unsigned int>& dartOrder);
+template void Algo::Topo::dartOrderHilbert<PFP2>(EmbeddedGMap2& map, const VertexAttribute<PFP2::VEC3, EmbeddedGMap2>& position, std::vector<unsigned int>& dartOrder);
+template void Algo::Topo::dartOrderHilbert<PFP3>(EmbeddedMap3& map, const VertexAttribute<PFP3::VEC3, EmbeddedMap3>& position, std::vector<unsigned int>& dartOrder);
+
+template void Algo::Topo::reorderBFS<EmbeddedMap2>(EmbeddedMap2& map);
+template void Algo::Topo::reorderBFS<EmbeddedGMap2>(EmbeddedGMap2& map);
+template void Algo::Topo::reorderBFS<EmbeddedMap3>(EmbeddedMap3& map);
+
+template void Algo::Topo::reorderHilbert<PFP1>(EmbeddedMap2& map, const VertexAttribute<PFP1::VEC3, EmbeddedMap2>& position);
+template void Algo::Topo::reorderHilbert<PFP2>(EmbeddedGMap2& map, const VertexAttribute<PFP2::VEC3, EmbeddedGMap2>& position);
+template void Algo::Topo::reorderHilbert<PFP3>(EmbeddedMap3& map, const VertexAttribute<PFP3::VEC3, EmbeddedMap3>& position);
+
+
+typedef PFP1::MAP MAP;
+typedef PFP1::VEC3 VEC3;
+
+// a dart of the torus is identified by the positions of its ends
+typedef std::array<float, 6> DartKey;
+
+DartKey dartKey(MAP& map, const VertexAttribute<VEC3, MAP>& position, Dart d)
+{
+	const VEC3& P = position[d];
+	const VEC3& Q = position[map.phi1(d)];
+	DartKey k = {{ P[0], P[1], P[2], Q[0], Q[1], Q[2] }};
+	return k;
+}
+
+// values attached to a dart: its dart attribute and the attributes of its edge and face
+struct DartValues
+{
+	unsigned int dartValue;
+	float edgeValue;
+	VEC3 faceValue;
+	DartKey next;
+	DartKey opposite;
+
+	bool operator==(const DartValues& v) const
+	{
+		return dartValue == v.dartValue && edgeValue == v.edgeValue && faceValue == v.faceValue && next == v.next && opposite == v.opposite;
+	}
+};
+
+void collect(MAP& map, const VertexAttribute<VEC3, MAP>& position, const DartAttribute<unsigned int, MAP>& dartAttr,
+			 const EdgeAttribute<float, MAP>& edgeAttr, const FaceAttribute<VEC3, MAP>& faceAttr, std::map<DartKey, DartValues>& values)
+{
+	values.clear();
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		DartValues v;
+		v.dartValue = dartAttr[d];
+		v.edgeValue = edgeAttr[d];
+		v.faceValue = faceAttr[d];
+		v.next = dartKey(map, position, map.phi1(d));
+		v.opposite = dartKey(map, position, map.phi2(d));
+		values[dartKey(map, position, d)] = v;
+	}
+}
+
+// the lines of the container of an orbit are compact and numbered in the order of the first dart of the cells
+template <unsigned int ORBIT>
+bool cellsInDartOrder(MAP& map)
+{
+	const AttributeContainer& cont = map.getAttributeContainer<ORBIT>();
+	if (cont.size() != cont.realEnd())
+		return false;
+	unsigned int next = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		unsigned int emb = map.getEmbedding<ORBIT>(d);
+		if (emb > next)
+			return false;
+		if (emb == next)
+			++next;
+	}
+	return next == cont.size();
+}
+
+/**
+ * reorder a shuffled torus in BFS and Hilbert orders: attribute values and
+ * embeddings must be kept, darts must follow the computed order and the
+ * darts of each vertex and the cells must be contiguous
+ */
+bool checkReorder(bool hilbert)
+{
+	MAP map;
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Triangular::Tore<PFP1> tore(map, 40, 20);
+	tore.embedIntoTore(position, 2.0f, 0.7f);
+	Algo::Topo::initAllOrbitsEmbedding<EDGE>(map);
+	Algo::Topo::initAllOrbitsEmbedding<FACE>(map);
+
+	DartAttribute<unsigned int, MAP> dartAttr = map.addAttribute<unsigned int, DART, MAP>("dartValue");
+	EdgeAttribute<float, MAP> edgeAttr = map.addAttribute<float, EDGE, MAP>("edgeValue");
+	FaceAttribute<VEC3, MAP> faceAttr = map.addAttribute<VEC3, FACE, MAP>("faceValue");
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		dartAttr[d] = map.dartIndex(d);
+	foreach_cell<EDGE>(map, [&] (Edge e) { edgeAttr[e] = (position[map.phi1(e.dart)] - position[e.dart]).norm(); });
+	foreach_cell<FACE>(map, [&] (Face f) { faceAttr[f] = position[f.dart] + position[map.phi1(f.dart)] + position[map.phi_1(f.dart)]; });
+
+	// random order first, as after many modifications
+	std::vector<unsigned int> order;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+		order.push_back(map.dartIndex(d));
+	std::mt19937 rng(0);
+	std::shuffle(order.begin(), order.end(), rng);
+	map.reorder(order);
+
+	std::map<DartKey, DartValues> before;
+	collect(map, position, dartAttr, edgeAttr, faceAttr, before);
+
+	if (hilbert)
+		Algo::Topo::dartOrderHilbert<PFP1>(map, position, order);
+	else
+		Algo::Topo::dartOrderBFS<MAP>(map, order);
+	std::vector<DartKey> orderKeys;
+	for (unsigned int k = 0; k < order.size(); ++k)
+		orderKeys.push_back(dartKey(map, position, Dart(order[k])));
+
+	map.reorder(order);
+
+	const char* name = hilbert ? "Hilbert" : "BFS";
+	if (!map.check())
+	{
+		CGoGNout << name << " reorder FAILED: wrong topology" << CGoGNendl;
+		return false;
+	}
+
+	std::map<DartKey, DartValues> after;
+	collect(map, position, dartAttr, edgeAttr, faceAttr, after);
+	if (after.size() != before.size() || !std::equal(before.begin(), before.end(), after.begin()))
+	{
+		CGoGNout << name << " reorder FAILED: attribute values or embeddings changed" << CGoGNendl;
+		return false;
+	}
+
+	// dart k of the new numbering is the dart order[k]
+	unsigned int k = 0;
+	for (Dart d = map.begin(); d != map.end(); map.next(d), ++k)
+	{
+		if (map.dartIndex(d) != k || k >= orderKeys.size() || dartKey(map, position, d) != orderKeys[k])
+		{
+			CGoGNout << name << " reorder FAILED: darts not in the given order" << CGoGNendl;
+			return false;
+		}
+	}
+
+	// the darts of a vertex are consecutive
+	bool ok = true;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		unsigned int minIdx = map.dartIndex(v.dart), maxIdx = minIdx, nb = 0;
+		map.foreach_dart_of_orbit(v, [&] (Dart d)
+		{
+			minIdx = std::min(minIdx, map.dartIndex(d));
+			maxIdx = std::max(maxIdx, map.dartIndex(d));
+			++nb;
+		});
+		if (maxIdx - minIdx + 1 != nb)
+			ok = false;
+	});
+	if (!ok)
+	{
+		CGoGNout << name << " reorder FAILED: darts of a vertex not contiguous" << CGoGNendl;
+		return false;
+	}
+
+	if (!cellsInDartOrder<VERTEX>(map) || !cellsInDartOrder<EDGE>(map) || !cellsInDartOrder<FACE>(map))
+	{
+		CGoGNout << name << " reorder FAILED: cells not numbered along the darts" << CGoGNendl;
+		return false;
+	}
+
+	return true;
+}
+
+int test_reorder()
+{
+	if (!checkReorder(false) || !checkReorder(true))
+		return 1;
+	CGoGNout << "reorder OK" << CGoGNendl;
+	return 0;
+}
@@ -0,0 +1,48 @@
+#include "Utils/indexedHeap.h"
+#include "Topology/generic/dart.h"
+
+#include <iostream>
+#include <cstdlib>
+
+template class CGoGN::Utils::IndexedHeap<float, CGoGN::Dart>;
+template class CGoGN::Utils::IndexedHeap<double, unsigned int>;
+
+
+int test_indexedHeap()
+{
+	CGoGN::Utils::IndexedHeap<double, unsigned int> heap;
+	std::vector<CGoGN::Utils::IndexedHeap<double, unsigned int>::Handle> handles;
+
+	srand(0);
+	for (unsigned int i = 0; i < 1000; ++i)
+		handles.push_back(heap.insert(double(rand() % 100), i));
+
+	// remove and change some keys
+	for (unsigned int i = 0; i < 1000; i += 3)
+		heap.erase(handles[i]);
+	for (unsigned int i = 1; i < 1000; i += 3)
+		heap.update(handles[i], double(rand() % 100));
+
+	// elements come out sorted by key, then by insertion
+	double prevKey = -1.0;
+	unsigned int nb = 0;
+	while (!heap.empty())
+	{
+		if (heap.topKey() < prevKey)
+		{
+			std::cerr << "IndexedHeap: wrong order" << std::endl;
+			return 1;
+		}
+		prevKey = heap.topKey();
+		heap.pop();
+		++nb;
+	}
+
+	if (nb != 666)
+	{
+		std::cerr << "IndexedHeap: wrong number of elements" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,12 @@
+#include "Utils/sphericalHarmonicsBatch.h"
+
+
+template class CGoGN::Utils::SphericalHarmonicsBatch<float>;
+template class CGoGN::Utils::SphericalHarmonicsBatch<double>;
+
+
+int test_sphericalHarmonicsBatch()
+{
+
+	return 0;
+}
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Deformation/asRigidAsPossible.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+typedef Algo::Surface::Deformation::ARAP<PFP> ARAP;
+
+/**
+ * deform an open cylinder whose two end rings are fixed:
+ * - when both rings are moved by the same rigid motion, the whole cylinder must follow it,
+ * - when the top ring is twisted, the energy must decrease at each iteration,
+ * - the result must not depend on the number of threads
+ */
+const REAL height = 2.0f;
+
+void cylinder(MAP& map, VertexAttribute<VEC3, MAP>& position, CellMarker<MAP, VERTEX>& freeMarker)
+{
+	Algo::Surface::Tilings::Triangular::Cylinder<PFP> cyl(map, 64, 40);
+	cyl.embedIntoCylinder(position, 0.5f, 0.5f, height);
+	for (Vertex v : allVerticesOf(map))
+	{
+		if (std::fabs(std::fabs(position[v][2]) - height / 2) > 1e-4f)
+			freeMarker.mark(v);
+	}
+}
+
+// rotation of angle a around the x axis, then translation t
+VEC3 rigid(const VEC3& p, REAL a, const VEC3& t)
+{
+	return VEC3(p[0], std::cos(a) * p[1] - std::sin(a) * p[2], std::sin(a) * p[1] + std::cos(a) * p[2]) + t;
+}
+
+// rotation of angle a around the z axis
+VEC3 twist(const VEC3& p, REAL a)
+{
+	return VEC3(std::cos(a) * p[0] - std::sin(a) * p[1], std::sin(a) * p[0] + std::cos(a) * p[1], p[2]);
+}
+
+int main()
+{
+	bool ok = true;
+
+	// rigid motion of the fixed vertices
+	{
+		MAP myMap;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+		CellMarker<MAP, VERTEX> freeMarker(myMap);
+		cylinder(myMap, position, freeMarker);
+
+		ARAP arap(myMap, position);
+		if (!arap.setFreeVertices(freeMarker) || arap.nbFreeVertices() != 64 * 39)
+		{
+			CGoGNout << "ARAP FAILED: factorization" << CGoGNendl;
+			return 1;
+		}
+
+		const REAL angle = 0.6f;
+		const VEC3 t(0.3f, -0.2f, 1.0f);
+		VertexAttribute<VEC3, MAP> target = myMap.addAttribute<VEC3, VERTEX, MAP>("target");
+		for (Vertex v : allVerticesOf(myMap))
+		{
+			target[v] = rigid(position[v], angle, t);
+			if (!freeMarker.isMarked(v))
+				position[v] = target[v];
+		}
+
+		arap.iterate(300);
+
+		REAL maxError = 0;
+		for (Vertex v : allVerticesOf(myMap))
+			maxError = std::max(maxError, (position[v] - target[v]).norm());
+		if (maxError > 1e-3f)
+		{
+			CGoGNout << "ARAP FAILED: rigid motion not recovered, error " << maxError << CGoGNendl;
+			ok = false;
+		}
+	}
+
+	// twist of the top ring
+	std::vector<VEC3> ref;
+	for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+	{
+		MAP myMap;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+		CellMarker<MAP, VERTEX> freeMarker(myMap);
+		cylinder(myMap, position, freeMarker);
+
+		ARAP arap(myMap, position, nbth);
+		arap.setFreeVertices(freeMarker);
+
+		for (Vertex v : allVerticesOf(myMap))
+		{
+			if (position[v][2] > height / 2 - 1e-4f)
+				position[v] = twist(position[v], 1.0f);
+		}
+
+		arap.iterate();
+		double e = arap.energy();
+		for (unsigned int i = 0; i < 20; ++i)
+		{
+			arap.iterate();
+			double en = arap.energy();
+			if (en > e * (1.0 + 1e-6))
+			{
+				CGoGNout << "ARAP FAILED: energy increases (" << e << " -> " << en << ")" << CGoGNendl;
+				ok = false;
+				break;
+			}
+			e = en;
+		}
+
+		std::vector<VEC3> positions;
+		for (Vertex v : allVerticesOf(myMap))
+			positions.push_back(position[v]);
+		if (ref.empty())
+			ref.swap(positions);
+		else if (positions != ref)
+		{
+			CGoGNout << "ARAP FAILED: result depends on the number of threads" << CGoGNendl;
+			ok = false;
+		}
+	}
+
+	if (ok)
+		CGoGNout << "ARAP deformation OK" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
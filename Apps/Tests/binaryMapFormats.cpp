@@ -0,0 +1,363 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Utils/compress.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * grid with vertex, edge and face attributes, and holes in the containers
+ * of the darts, vertices, edges and faces (removed vertices)
+ */
+void buildMap(MAP& map, unsigned int n)
+{
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP> grid(map, n, n);
+	grid.embedIntoGrid(position, 1.0f, 1.0f);
+
+	unsigned int nbDeleted = 0;
+	foreach_cell<VERTEX>(map, [&](Vertex v)
+	{
+		if (nbDeleted < n && map.vertexDegree(v) == 4 && !map.isBoundaryVertex(v) && (v.dart.index % 7) == 0)
+		{
+			map.deleteVertex(v);
+			++nbDeleted;
+		}
+	});
+
+	EdgeAttribute<float, MAP> length = map.addAttribute<float, EDGE, MAP>("length");
+	foreach_cell<EDGE>(map, [&](Edge e)
+	{
+		length[e] = (position[map.phi1(e.dart)] - position[e.dart]).norm();
+	});
+	FaceAttribute<unsigned int, MAP> degree = map.addAttribute<unsigned int, FACE, MAP>("degree");
+	foreach_cell<FACE>(map, [&](Face f)
+	{
+		degree[f] = map.faceDegree(f);
+	});
+}
+
+/**
+ * same lines in the containers of an orbit
+ */
+bool sameLines(const AttributeContainer& c1, const AttributeContainer& c2, const std::string& orbit)
+{
+	bool same = c1.size() == c2.size() && c1.realEnd() == c2.realEnd();
+	for (unsigned int i = 0; same && i < c1.realEnd(); ++i)
+		same = (c1.used(i) == c2.used(i));
+	if (!same)
+		std::cerr << "different lines in the " << orbit << " containers" << std::endl;
+	return same;
+}
+
+/**
+ * same darts, involutions, embeddings and attribute values in both maps
+ * (only positions if not allAttributes)
+ */
+bool sameMaps(MAP& m1, MAP& m2, bool allAttributes = true)
+{
+	if (!sameLines(m1.getAttributeContainer<DART>(), m2.getAttributeContainer<DART>(), "dart")
+		|| !sameLines(m1.getAttributeContainer<VERTEX>(), m2.getAttributeContainer<VERTEX>(), "vertex")
+		|| !sameLines(m1.getAttributeContainer<EDGE>(), m2.getAttributeContainer<EDGE>(), "edge")
+		|| !sameLines(m1.getAttributeContainer<FACE>(), m2.getAttributeContainer<FACE>(), "face"))
+		return false;
+
+	for (Dart d = m1.begin(); d != m1.end(); m1.next(d))
+	{
+		if (m1.phi1(d) != m2.phi1(d) || m1.phi_1(d) != m2.phi_1(d) || m1.phi2(d) != m2.phi2(d))
+		{
+			std::cerr << "different involutions or permutations at dart " << d << std::endl;
+			return false;
+		}
+		if (m1.getEmbedding(Vertex(d)) != m2.getEmbedding(Vertex(d)) || m1.getEmbedding(Edge(d)) != m2.getEmbedding(Edge(d))
+			|| m1.getEmbedding(Face(d)) != m2.getEmbedding(Face(d)))
+		{
+			std::cerr << "different embeddings at dart " << d << std::endl;
+			return false;
+		}
+	}
+
+	VertexAttribute<VEC3, MAP> position1 = m1.getAttribute<VEC3, VERTEX, MAP>("position");
+	VertexAttribute<VEC3, MAP> position2 = m2.getAttribute<VEC3, VERTEX, MAP>("position");
+	if (!position2.isValid())
+	{
+		std::cerr << "position missing after load" << std::endl;
+		return false;
+	}
+	for (unsigned int i = position1.begin(); i != position1.end(); position1.next(i))
+	{
+		if (position1[i] != position2[i])
+		{
+			std::cerr << "different position at line " << i << std::endl;
+			return false;
+		}
+	}
+	if (!allAttributes)
+		return true;
+
+	EdgeAttribute<float, MAP> length1 = m1.getAttribute<float, EDGE, MAP>("length");
+	EdgeAttribute<float, MAP> length2 = m2.getAttribute<float, EDGE, MAP>("length");
+	FaceAttribute<unsigned int, MAP> degree1 = m1.getAttribute<unsigned int, FACE, MAP>("degree");
+	FaceAttribute<unsigned int, MAP> degree2 = m2.getAttribute<unsigned int, FACE, MAP>("degree");
+	if (!length2.isValid() || !degree2.isValid())
+	{
+		std::cerr << "attribute missing after load" << std::endl;
+		return false;
+	}
+	for (unsigned int i = length1.begin(); i != length1.end(); length1.next(i))
+	{
+		if (length1[i] != length2[i])
+		{
+			std::cerr << "different length at line " << i << std::endl;
+			return false;
+		}
+	}
+	for (unsigned int i = degree1.begin(); i != degree1.end(); degree1.next(i))
+	{
+		if (degree1[i] != degree2[i])
+		{
+			std::cerr << "different degree at line " << i << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+std::vector<char> readFile(const std::string& filename)
+{
+	std::ifstream fs(filename.c_str(), std::ios::in|std::ios::binary);
+	return std::vector<char>((std::istreambuf_iterator<char>(fs)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& filename, const std::vector<char>& data, std::size_t size)
+{
+	std::ofstream fs(filename.c_str(), std::ios::out|std::ios::binary);
+	fs.write(&data[0], size);
+}
+
+/**
+ * a damaged file must be rejected without leaving a partly loaded map:
+ * the map is unchanged (bad header) or empty
+ */
+bool rejected(bool loaded, MAP& map, const std::string& what, MAP& original)
+{
+	if (loaded)
+	{
+		std::cerr << what << " file loaded" << std::endl;
+		return false;
+	}
+	if (map.getAttributeContainer<DART>().size() != 0 && !sameMaps(original, map))
+	{
+		std::cerr << "map partly loaded from a " << what << " file" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * groups of blocks of various sizes (last group incomplete) compressed
+ * then uncompressed with several threads
+ */
+bool testCompressGroups()
+{
+	const unsigned int nbBlocks = 10;
+	const unsigned int groupSize = 3;
+	std::vector<std::string> data(nbBlocks);
+	std::srand(0);
+	for (unsigned int b = 0; b < nbBlocks; ++b)
+	{
+		data[b].resize(1000 + 137 * b);
+		for (unsigned int i = 0; i < data[b].size(); ++i)
+			data[b][i] = (b % 2 == 0) ? char(i % 13) : char(std::rand());
+	}
+	std::vector<std::pair<const char*, std::size_t> > blocks(nbBlocks);
+	for (unsigned int b = 0; b < nbBlocks; ++b)
+		blocks[b] = std::make_pair(data[b].data(), data[b].size());
+
+	for (unsigned int nbThreads = 1; nbThreads <= 3; nbThreads += 2)
+	{
+		std::vector<std::string> chunks;
+		Utils::zlibCompressGroups(blocks, groupSize, chunks, nbThreads);
+		if (chunks.size() != (nbBlocks + groupSize - 1) / groupSize)
+		{
+			std::cerr << chunks.size() << " compressed groups instead of " << (nbBlocks + groupSize - 1) / groupSize << std::endl;
+			return false;
+		}
+
+		std::vector<std::string> result(nbBlocks);
+		std::vector<std::pair<char*, std::size_t> > outBlocks(nbBlocks);
+		for (unsigned int b = 0; b < nbBlocks; ++b)
+		{
+			result[b].resize(data[b].size());
+			outBlocks[b] = std::make_pair(&result[b][0], result[b].size());
+		}
+		if (!Utils::zlibUncompressGroups(chunks, outBlocks, groupSize, nbThreads) || result != data)
+		{
+			std::cerr << "groups not uncompressed back with " << nbThreads << " threads" << std::endl;
+			return false;
+		}
+
+		// corrupted stream, blocks larger than the data, missing group
+		std::vector<std::string> bad(chunks);
+		bad[1][bad[1].size() / 2] ^= 0x5a;
+		bool rejected = !Utils::zlibUncompressGroups(bad, outBlocks, groupSize, nbThreads);
+		outBlocks[4].second++;
+		result[4].push_back('\0');
+		outBlocks[4].first = &result[4][0];
+		rejected &= !Utils::zlibUncompressGroups(chunks, outBlocks, groupSize, nbThreads);
+		outBlocks[4].second--;
+		bad = chunks;
+		bad.pop_back();
+		rejected &= !Utils::zlibUncompressGroups(bad, outBlocks, groupSize, nbThreads);
+		if (!rejected)
+		{
+			std::cerr << "invalid compressed groups accepted" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	MAP map;
+	buildMap(map, 130);
+	if (map.getAttributeContainer<VERTEX>().size() == map.getAttributeContainer<VERTEX>().realEnd()
+		|| map.getAttributeContainer<DART>().size() == map.getAttributeContainer<DART>().realEnd())
+	{
+		std::cerr << "no holes in the containers" << std::endl;
+		return 1;
+	}
+
+	// raw (mappable) format
+	if (!map.saveMapBinRaw("bmf_map.raw"))
+	{
+		std::cerr << "saveMapBinRaw failed" << std::endl;
+		return 1;
+	}
+	MAP map2;
+	if (!map2.loadMapBinRaw("bmf_map.raw") || !sameMaps(map, map2))
+	{
+		std::cerr << "raw map not loaded back" << std::endl;
+		return 1;
+	}
+
+	std::vector<char> raw = readFile("bmf_map.raw");
+	std::size_t cuts[3] = { 100, raw.size() / 2, raw.size() - 1 };
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		writeFile("bmf_bad.raw", raw, cuts[i]);
+		if (!rejected(map2.loadMapBinRaw("bmf_bad.raw"), map2, "truncated raw", map))
+			return 1;
+	}
+
+	// corrupted magic string, then block size, number of blocks and orbit of the first container
+	std::size_t fields[4] = { 0, 256 + sizeof(unsigned int), 256 + 2 * sizeof(unsigned int), 256 + 7 * sizeof(unsigned int) };
+	for (unsigned int i = 0; i < 4; ++i)
+	{
+		std::vector<char> bad(raw);
+		bad[fields[i]] ^= 0x5a;
+		writeFile("bmf_bad.raw", bad, bad.size());
+		if (!rejected(map2.loadMapBinRaw("bmf_bad.raw"), map2, "corrupted raw", map))
+			return 1;
+	}
+
+	// the map can still be loaded after the failures
+	if (!map2.loadMapBinRaw("bmf_map.raw") || !sameMaps(map, map2))
+	{
+		std::cerr << "raw map not loaded back after failed loads" << std::endl;
+		return 1;
+	}
+
+	// chunked (compressed) format
+	if (!testCompressGroups())
+		return 1;
+
+	if (map.getAttributeContainer<DART>().realEnd() <= 16 * _BLOCKSIZE_)
+	{
+		std::cerr << "darts fit in a single chunk" << std::endl;
+		return 1;
+	}
+	if (!map.saveMapBinChunked("bmf_map.chk", 3))
+	{
+		std::cerr << "saveMapBinChunked failed" << std::endl;
+		return 1;
+	}
+	MAP map3;
+	if (!map3.loadMapBinChunked("bmf_map.chk", std::vector<std::string>(), 3) || !sameMaps(map, map3))
+	{
+		std::cerr << "chunked map not loaded back" << std::endl;
+		return 1;
+	}
+
+	// only the wanted attributes are loaded (and the whole topology)
+	MAP map4;
+	std::vector<std::string> wanted(1, "position");
+	if (!map4.loadMapBinChunked("bmf_map.chk", wanted, 1)
+		|| map4.getAttribute<float, EDGE, MAP>("length").isValid() || map4.getAttribute<unsigned int, FACE, MAP>("degree").isValid())
+	{
+		std::cerr << "filtered chunked map not loaded" << std::endl;
+		return 1;
+	}
+	if (!sameMaps(map, map4, false))
+	{
+		std::cerr << "filtered chunked map differs" << std::endl;
+		return 1;
+	}
+
+	std::vector<char> chunked = readFile("bmf_map.chk");
+	std::size_t chunkedCuts[3] = { 100, chunked.size() / 2, chunked.size() - 1 };
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		writeFile("bmf_bad.chk", chunked, chunkedCuts[i]);
+		if (!rejected(map3.loadMapBinChunked("bmf_bad.chk"), map3, "truncated chunked", map))
+			return 1;
+	}
+
+	std::remove("bmf_map.raw");
+	std::remove("bmf_bad.raw");
+	std::remove("bmf_map.chk");
+	std::remove("bmf_bad.chk");
+
+	std::cout << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,148 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <string>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Utils/blockPool.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * maps built and destroyed in a loop with a shared block pool:
+ * after the first map, all the blocks must come from the pool
+ */
+void buildGrid(MAP& map, unsigned int n)
+{
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+	FaceAttribute<std::string, MAP> names = map.addAttribute<std::string, FACE, MAP>("names");
+	Algo::Surface::Tilings::Square::Grid<PFP> grid(map, n, n);
+	grid.embedIntoGrid(position, 1.0f, 1.0f);
+	foreach_cell<FACE>(map, [&](Face f)
+	{
+		names[f] = std::string("face of a grid built in a pool");
+	});
+}
+
+int main(int argc, char**)
+{
+	bool hugePages = (argc > 1);
+	Utils::BlockPool pool(hugePages);
+
+	Utils::BlockPool::Stats first;
+	for (unsigned int i = 0; i < 5; ++i)
+	{
+		{
+			MAP map;
+			map.setBlockPool(&pool);
+			buildGrid(map, 100);
+
+			Utils::BlockPool::Stats s = pool.getStats();
+			if (i == 0)
+				first = s;
+			else if (s.nbLiveBlocks != first.nbLiveBlocks || s.nbPooledBlocks != 0)
+			{
+				std::cerr << "blocks not recycled: " << s.nbLiveBlocks << " live / " << s.nbPooledBlocks << " pooled" << std::endl;
+				return 1;
+			}
+		}
+
+		Utils::BlockPool::Stats s = pool.getStats();
+		if (s.nbLiveBlocks != 0 || s.nbPooledBlocks != first.nbLiveBlocks)
+		{
+			std::cerr << "blocks not released in the pool: " << s.nbLiveBlocks << " live / " << s.nbPooledBlocks << " pooled" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << first.nbLiveBlocks << " blocks (" << first.liveBytes / 1024 << "KB) recycled" << std::endl;
+
+	// a map moved in the pool after its construction keeps its data
+	MAP map;
+	buildGrid(map, 50);
+	VertexAttribute<VEC3, MAP> position = map.getAttribute<VEC3, VERTEX, MAP>("position");
+	std::vector<VEC3> before(position.end());
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		before[i] = position[i];
+
+	map.setBlockPool(&pool);
+	if (pool.getStats().nbLiveBlocks == 0)
+	{
+		std::cerr << "blocks not moved in the pool" << std::endl;
+		return 1;
+	}
+	FaceAttribute<std::string, MAP> names = map.getAttribute<std::string, FACE, MAP>("names");
+	bool lost = false;
+	foreach_cell<FACE>(map, [&](Face f)
+	{
+		lost |= (names[f] != "face of a grid built in a pool");
+	});
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		if (lost || before[i] != position[i])
+		{
+			std::cerr << "data lost when moving blocks in the pool" << std::endl;
+			return 1;
+		}
+	}
+
+	// holes left by removed vertices
+	unsigned int nbDeleted = 0;
+	foreach_cell<VERTEX>(map, [&](Vertex v)
+	{
+		if (nbDeleted < 100 && map.vertexDegree(v) == 4 && !map.isBoundaryVertex(v))
+		{
+			map.deleteVertex(v);
+			++nbDeleted;
+		}
+	});
+	std::size_t wasted = map.getAttributeContainer<VERTEX>().fragmentationBytes();
+	std::cout << "fragmentation: " << map.fragmentation(VERTEX) << " (" << wasted << " bytes in vertex holes, "
+			  << map.fragmentationBytes() << " bytes in all holes)" << std::endl;
+	if (wasted == 0)
+	{
+		std::cerr << "no fragmentation after removing vertices" << std::endl;
+		return 1;
+	}
+
+	map.setBlockPool(NULL);
+	if (pool.getStats().nbLiveBlocks != 0)
+	{
+		std::cerr << "blocks not given back to the pool" << std::endl;
+		return 1;
+	}
+
+	std::cout << "OK" << std::endl;
+	return 0;
+}
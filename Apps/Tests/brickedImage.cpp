@@ -0,0 +1,193 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/MC/marchingcube.h"
+#include "Algo/Topo/basic.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * mesh a sparse image (a small ball in a large empty volume) with a dense image
+ * and with a bricked image (built in memory and mapped from a raw or inr file) and compare the results
+ */
+struct Result
+{
+	unsigned int nbVertices;
+	unsigned int nbFaces;
+	unsigned int nbFreeEdges;
+	std::vector<VEC3> positions;
+};
+
+bool lessVec(const VEC3& a, const VEC3& b)
+{
+	return std::lexicographical_compare(&a[0], &a[0] + 3, &b[0], &b[0] + 3);
+}
+
+template <typename IMG>
+Result mesh(IMG* img, int nbth, bool simple = false)
+{
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+
+	Algo::Surface::MC::WindowingLess<float> wind;
+	wind.setIsoValue(1.0f);
+	Algo::Surface::MC::MarchingCube<float, Algo::Surface::MC::WindowingLess, PFP> mc(img, &myMap, position, wind, false);
+	if (simple)
+		mc.simpleMeshing();
+	else
+		mc.parallelMeshing(nbth);
+
+	Result r;
+	r.nbVertices = Algo::Topo::getNbOrbits<VERTEX>(myMap);
+	r.nbFaces = Algo::Topo::getNbOrbits<FACE>(myMap);
+	r.nbFreeEdges = 0;
+	for (Dart d = myMap.begin(); d != myMap.end(); myMap.next(d))
+		if (myMap.phi2(d) == d)
+			++r.nbFreeEdges;
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		r.positions.push_back(position[i]);
+	std::sort(r.positions.begin(), r.positions.end(), lessVec);
+	return r;
+}
+
+bool compare(const Result& r, const Result& ref, const char* what)
+{
+	if (r.nbVertices != ref.nbVertices || r.nbFaces != ref.nbFaces || r.nbFreeEdges != ref.nbFreeEdges || r.positions != ref.positions)
+	{
+		CGoGNout << "bricked image (" << what << ") FAILED: " << r.nbVertices << "/" << ref.nbVertices << " vertices, "
+			<< r.nbFaces << "/" << ref.nbFaces << " faces, " << r.nbFreeEdges << "/" << ref.nbFreeEdges << " free edges" << CGoGNendl;
+		return false;
+	}
+	return true;
+}
+
+int main()
+{
+	// sizes not multiple of the brick size, ball crossing brick boundaries and touching the border
+	const int wx = 75, wy = 60, wz = 53;
+	std::vector<float> data(wx * wy * wz);
+	for (int z = 0; z < wz; ++z)
+		for (int y = 0; y < wy; ++y)
+			for (int x = 0; x < wx; ++x)
+			{
+				float d = std::sqrt(float((x - 31) * (x - 31) + (y - 33) * (y - 33) + (z - 45) * (z - 45))) / 9.5f;
+				data[x + wx * (y + wy * z)] = std::min(d, 2.0f);
+			}
+	Algo::Surface::MC::Image<float> img(&data[0], wx, wy, wz, 1.0f, 1.0f, 1.0f, false);
+
+	Result ref = mesh(&img, 1);
+	bool ok = ref.nbFaces > 0 && ref.nbFreeEdges > 0;
+
+	Algo::Surface::MC::BrickedImage<float> bricked;
+	bricked.create(img);
+	const unsigned int nbBricks = bricked.getNbBricksX() * bricked.getNbBricksY() * bricked.getNbBricksZ();
+	if (bricked.getNbStoredBricks() >= nbBricks)
+	{
+		CGoGNout << "bricked image FAILED: " << bricked.getNbStoredBricks() << " bricks stored on " << nbBricks << CGoGNendl;
+		ok = false;
+	}
+	for (int nbth = 1; nbth <= 4; nbth += 3)
+		ok &= compare(mesh(&bricked, nbth), ref, "in memory");
+	ok &= compare(mesh(&bricked, 1, true), ref, "simpleMeshing");
+
+	// same voxels read from a mapped raw file
+	const char* filename = "brickedImage_test.raw";
+	{
+		std::ofstream fs(filename, std::ios::out | std::ios::binary);
+		int sizes[3] = { wx, wy, wz };
+		fs.write(reinterpret_cast<const char*>(sizes), 3 * sizeof(int));
+		fs.write(reinterpret_cast<const char*>(&data[0]), data.size() * sizeof(float));
+	}
+	Algo::Surface::MC::BrickedImage<float> mapped;
+	if (!mapped.openRaw(filename))
+		ok = false;
+	else
+	{
+		if (mapped.getNbStoredBricks() != 0)
+		{
+			CGoGNout << "bricked image FAILED: bricks read before use" << CGoGNendl;
+			ok = false;
+		}
+		ok &= compare(mesh(&mapped, 4), ref, "mapped file");
+		if (mapped.getNbStoredBricks() != bricked.getNbStoredBricks())
+		{
+			CGoGNout << "bricked image FAILED: " << mapped.getNbStoredBricks() << "/" << bricked.getNbStoredBricks() << " stored bricks" << CGoGNendl;
+			ok = false;
+		}
+		mapped.clear();
+	}
+	std::remove(filename);
+
+	// same voxels read from a mapped inr file, which is rejected if its TYPE does not match float
+	const char* inrname = "brickedImage_test.inr";
+	const char* types[2] = { "float", "unsigned fixed" };
+	for (int t = 0; t < 2; ++t)
+	{
+		{
+			std::ostringstream oss;
+			oss << "#INRIMAGE-4#{\nXDIM=" << wx << "\nYDIM=" << wy << "\nZDIM=" << wz
+				<< "\nVDIM=1\nTYPE=" << types[t] << "\nPIXSIZE=32 bits\nCPU=decm\n";
+			std::string header = oss.str();
+			header.resize(252, '\n');
+			header += "##}\n";
+			std::ofstream fs(inrname, std::ios::out | std::ios::binary);
+			fs.write(header.c_str(), header.size());
+			fs.write(reinterpret_cast<const char*>(&data[0]), data.size() * sizeof(float));
+		}
+		Algo::Surface::MC::BrickedImage<float> inr;
+		bool opened = inr.openInr(inrname);
+		if (opened != (t == 0))
+		{
+			CGoGNout << "bricked image FAILED: inr file of type " << types[t] << (opened ? " opened" : " not opened") << CGoGNendl;
+			ok = false;
+		}
+		else if (opened)
+			ok &= compare(mesh(&inr, 4), ref, "inr file");
+		inr.clear();
+	}
+	std::remove(inrname);
+
+	if (ok)
+		CGoGNout << "bricked image OK (" << ref.nbVertices << " vertices, " << bricked.getNbStoredBricks() << "/" << nbBricks << " bricks stored)" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Tiling/Volume/cubic.h"
+#include "Algo/Topo/connectivitySnapshot.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Geometry/laplacian.h"
+#include "Algo/Filtering/taubin.h"
+#include "Algo/Filtering/bilateral.h"
+
+#include <cstdlib>
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap3 MAP;
+};
+
+typedef PFP2::MAP MAP;
+typedef PFP2::VEC3 VEC3;
+typedef PFP2::REAL REAL;
+
+template <typename M>
+bool sameValues(M& map, const VertexAttribute<VEC3, M>& a, const VertexAttribute<VEC3, M>& b, REAL eps)
+{
+	bool ok = true;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		if ((a[v] - b[v]).norm() > eps)
+			ok = false;
+	});
+	return ok;
+}
+
+/**
+ * compare the functions working on a snapshot with the functions following the topology
+ */
+bool check(MAP& myMap, VertexAttribute<VEC3, MAP>& position)
+{
+	bool ok = true;
+
+	EdgeAttribute<REAL, MAP> edgeWeight = myMap.addAttribute<REAL, EDGE, MAP>("edgeWeight");
+	VertexAttribute<REAL, MAP> vertexArea = myMap.addAttribute<REAL, VERTEX, MAP>("vertexArea");
+	VertexAttribute<VEC3, MAP> normal = myMap.addAttribute<VEC3, VERTEX, MAP>("normal");
+	VertexAttribute<VEC3, MAP> tmp = myMap.addAttribute<VEC3, VERTEX, MAP>("tmp");
+	VertexAttribute<VEC3, MAP> result = myMap.addAttribute<VEC3, VERTEX, MAP>("result");
+	VertexAttribute<VEC3, MAP> resultCS = myMap.addAttribute<VEC3, VERTEX, MAP>("resultCS");
+
+	Algo::Topo::ConnectivitySnapshot cs(myMap);
+
+	// smoothing iterations
+	VertexAttribute<VEC3, MAP> pos = myMap.addAttribute<VEC3, VERTEX, MAP>("pos");
+	myMap.copyAttribute(pos, position);
+	myMap.copyAttribute(resultCS, position);
+	for (unsigned int i = 0; i < 10; ++i)
+	{
+		Algo::Surface::Filtering::filterTaubin<PFP2>(myMap, pos, tmp);
+		Algo::Surface::Filtering::filterTaubin<PFP2>(myMap, cs, resultCS, tmp);
+	}
+	if (!sameValues(myMap, pos, resultCS, 1e-5f))
+	{
+		CGoGNout << "filterTaubin: FAILED" << CGoGNendl;
+		ok = false;
+	}
+
+	Algo::Surface::Geometry::computeNormalVertices<PFP2>(myMap, position, normal);
+	Algo::Surface::Filtering::filterBilateral<PFP2>(myMap, position, result, normal);
+	Algo::Surface::Filtering::filterBilateral<PFP2>(myMap, cs, position, resultCS, normal);
+	if (!sameValues(myMap, result, resultCS, 1e-5f))
+	{
+		CGoGNout << "filterBilateral: FAILED" << CGoGNendl;
+		ok = false;
+	}
+
+	Algo::Surface::Geometry::computeLaplacianTopoVertices<PFP2, VEC3>(myMap, position, result);
+	Algo::Surface::Geometry::computeLaplacianTopoVertices<PFP2, VEC3>(myMap, cs, position, resultCS);
+	if (!sameValues(myMap, result, resultCS, 1e-5f))
+	{
+		CGoGNout << "computeLaplacianTopoVertices: FAILED" << CGoGNendl;
+		ok = false;
+	}
+
+	Algo::Surface::Geometry::computeCotanWeightEdges<PFP2>(myMap, position, edgeWeight);
+	Algo::Surface::Geometry::computeVoronoiAreaVertices<PFP2>(myMap, position, vertexArea);
+	Algo::Surface::Geometry::computeLaplacianCotanVertices<PFP2, VEC3>(myMap, edgeWeight, vertexArea, position, result);
+	Algo::Surface::Geometry::computeLaplacianCotanVertices<PFP2, VEC3>(myMap, cs, edgeWeight, vertexArea, position, resultCS);
+	if (!sameValues(myMap, result, resultCS, 1e-4f))
+	{
+		CGoGNout << "computeLaplacianCotanVertices: FAILED" << CGoGNendl;
+		ok = false;
+	}
+
+	// the snapshot is outdated by a topological modification
+	if (!cs.isUpToDate(myMap))
+		ok = false;
+	Dart d = myMap.begin();
+	while (myMap.isBoundaryEdge(d))
+		myMap.next(d);
+	myMap.flipEdge(d);
+	myMap.flipBackEdge(d);
+	if (cs.isUpToDate(myMap))
+	{
+		CGoGNout << "isUpToDate: FAILED" << CGoGNendl;
+		ok = false;
+	}
+
+	myMap.removeAttribute(edgeWeight);
+	myMap.removeAttribute(vertexArea);
+	myMap.removeAttribute(normal);
+	myMap.removeAttribute(tmp);
+	myMap.removeAttribute(result);
+	myMap.removeAttribute(resultCS);
+	myMap.removeAttribute(pos);
+
+	return ok;
+}
+
+int main()
+{
+	srand(11);
+	bool ok = true;
+
+	for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+	{
+		CGoGN::Parallel::NumberOfThreads = nbth;
+
+		// closed surface
+		{
+			MAP myMap;
+			VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+			Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(myMap, 40, 40);
+			tore.embedIntoTore(position, 1.0f, 0.4f);
+			ok &= check(myMap, position);
+		}
+
+		// open surface
+		{
+			MAP myMap;
+			VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+			Algo::Surface::Tilings::Triangular::Grid<PFP2> grid(myMap, 40, 40);
+			grid.embedIntoGrid(position, 1.0f, 1.0f);
+			foreach_cell<VERTEX>(myMap, [&] (Vertex v)
+			{
+				position[v][2] = REAL(rand()) / REAL(RAND_MAX) * 0.05f;
+			});
+			ok &= check(myMap, position);
+		}
+
+		// volume
+		{
+			PFP3::MAP myMap;
+			VertexAttribute<VEC3, PFP3::MAP> position = myMap.addAttribute<VEC3, VERTEX, PFP3::MAP>("position");
+			Algo::Volume::Tilings::Cubic::Grid<PFP3> cubic(myMap, 6, 6, 6);
+			cubic.embedIntoGrid(position, 1.0f, 1.0f, 1.0f);
+			VertexAttribute<VEC3, PFP3::MAP> result = myMap.addAttribute<VEC3, VERTEX, PFP3::MAP>("result");
+			VertexAttribute<VEC3, PFP3::MAP> resultCS = myMap.addAttribute<VEC3, VERTEX, PFP3::MAP>("resultCS");
+			Algo::Topo::ConnectivitySnapshot cs(myMap);
+			Algo::Volume::Geometry::computeLaplacianTopoVertices<PFP3, VEC3>(myMap, position, result);
+			Algo::Volume::Geometry::computeLaplacianTopoVertices<PFP3, VEC3>(myMap, cs, position, resultCS);
+			if (!sameValues(myMap, result, resultCS, 1e-5f))
+			{
+				CGoGNout << "Volume::computeLaplacianTopoVertices: FAILED" << CGoGNendl;
+				ok = false;
+			}
+		}
+	}
+
+	if (ok)
+		CGoGNout << "connectivity snapshot OK" << CGoGNendl;
+	else
+		CGoGNout << "connectivity snapshot FAILED" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
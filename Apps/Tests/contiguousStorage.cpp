@@ -0,0 +1,184 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <new>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * every line of the attribute is at its index in the contiguous range
+ */
+bool checkContiguous(const AttributeContainer& cont, const AttributeMultiVector<VEC3>* amv)
+{
+	const VEC3* base = amv->getContiguousData();
+	if (base == NULL)
+	{
+		std::cerr << "storage of " << amv->getName() << " is not contiguous" << std::endl;
+		return false;
+	}
+	for (unsigned int i = cont.begin(); i != cont.end(); cont.next(i))
+	{
+		if (&(*amv)[i] != base + i)
+		{
+			std::cerr << "line " << i << " of " << amv->getName() << " is not in the contiguous range" << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	// contiguous storage enabled on a populated map
+	MAP map;
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP> grid(map, 20, 20);
+	grid.embedIntoGrid(position, 1.0f, 1.0f);
+
+	AttributeContainer& cont = map.getAttributeContainer<VERTEX>();
+	std::vector<VEC3> before(cont.realEnd());
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		before[i] = position[i];
+
+	if (!cont.setContiguousStorage(4 * _BLOCKSIZE_))
+	{
+		std::cerr << "contiguous storage not set" << std::endl;
+		return 1;
+	}
+	AttributeMultiVector<VEC3>* amv = position.getDataVector();
+	if (!checkContiguous(cont, amv))
+		return 1;
+
+	std::vector<const VEC3*> addresses(cont.realEnd());
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		if (before[i] != position[i])
+		{
+			std::cerr << "data lost when switching to contiguous storage" << std::endl;
+			return 1;
+		}
+		addresses[i] = &position[i];
+	}
+
+	// growth past the first block: the new vertices go in the same range, old ones do not move
+	unsigned int nbBlocks = amv->getNbBlocks();
+	Algo::Surface::Tilings::Square::Grid<PFP> grid2(map, 80, 80);
+	grid2.embedIntoGrid(position, 2.0f, 2.0f);
+	if (amv->getNbBlocks() <= nbBlocks || cont.size() <= _BLOCKSIZE_)
+	{
+		std::cerr << "the attribute did not grow past its first block" << std::endl;
+		return 1;
+	}
+	if (!checkContiguous(cont, amv))
+		return 1;
+	for (unsigned int i = 0; i < addresses.size(); ++i)
+	{
+		if (addresses[i] != NULL && (addresses[i] != &position[i] || before[i] != position[i]))
+		{
+			std::cerr << "line " << i << " moved or changed when the storage grew" << std::endl;
+			return 1;
+		}
+	}
+	std::cout << cont.size() << " vertices in " << amv->getNbBlocks() << " contiguous blocks" << std::endl;
+
+	// capacity smaller than the current size is refused, the storage does not change
+	if (cont.setContiguousStorage(_BLOCKSIZE_) || cont.getContiguousStorage() != 4 * _BLOCKSIZE_ || !checkContiguous(cont, amv))
+	{
+		std::cerr << "too small contiguous storage accepted" << std::endl;
+		return 1;
+	}
+
+	// overflow: the lines of all the reserved blocks can be used, then insertion fails
+	// without changing the container
+	AttributeContainer small;
+	AttributeMultiVector<VEC3>* values = small.addAttribute<VEC3>("values");
+	small.setContiguousStorage(2 * _BLOCKSIZE_);
+	for (unsigned int i = 0; i < 2 * _BLOCKSIZE_; ++i)
+	{
+		unsigned int l = small.insertLine();
+		(*values)[l] = VEC3(float(l), 0.0f, 0.0f);
+	}
+	bool thrown = false;
+	try
+	{
+		small.insertLine();
+	}
+	catch (std::bad_alloc&)
+	{
+		thrown = true;
+	}
+	if (!thrown || small.size() != 2 * _BLOCKSIZE_ || values->getNbBlocks() != 2 || !checkContiguous(small, values))
+	{
+		std::cerr << "insertion in a full contiguous storage not refused" << std::endl;
+		return 1;
+	}
+	for (unsigned int i = small.begin(); i != small.end(); small.next(i))
+	{
+		if ((*values)[i] != VEC3(float(i), 0.0f, 0.0f))
+		{
+			std::cerr << "data changed by the refused insertion" << std::endl;
+			return 1;
+		}
+	}
+
+	// a hole left by a removed line is used again
+	small.removeLine(100);
+	if (small.insertLine() != 100)
+	{
+		std::cerr << "hole not reused in a full contiguous storage" << std::endl;
+		return 1;
+	}
+	thrown = false;
+	try
+	{
+		small.insertLine();
+	}
+	catch (std::bad_alloc&)
+	{
+		thrown = true;
+	}
+	if (!thrown || small.size() != 2 * _BLOCKSIZE_)
+	{
+		std::cerr << "insertion in a full contiguous storage not refused after reusing a hole" << std::endl;
+		return 1;
+	}
+
+	std::cout << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,221 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <atomic>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/generic/cellmarker.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Selection/collector.h"
+#include "Algo/Topo/basic.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+/**
+ * check the epoch cell markers (unmarking by change of epoch, reuse of the stamps
+ * of the pool, growth of the map) and the Collector_WithinSphere that uses them
+ * against a breadth first search, sequentially and in parallel
+ */
+bool testMarker(MAP& map)
+{
+	std::vector<Vertex> vertices;
+	for (Vertex v : allVerticesOf(map))
+		vertices.push_back(v);
+
+	{
+		CellMarkerEpoch<MAP, VERTEX> cm(map);
+		for (unsigned int i = 0; i < vertices.size(); i += 3)
+			cm.mark(vertices[i]);
+		cm.unmark(vertices[3]);
+		for (unsigned int i = 0; i < vertices.size(); ++i)
+		{
+			if (cm.isMarked(vertices[i]) != (i % 3 == 0 && i != 3))
+			{
+				CGoGNout << "epoch marker FAILED: wrong mark" << CGoGNendl;
+				return false;
+			}
+		}
+		cm.unmarkAll();
+		for (unsigned int i = 0; i < vertices.size(); ++i)
+		{
+			if (cm.isMarked(vertices[i]))
+			{
+				CGoGNout << "epoch marker FAILED: unmarkAll" << CGoGNendl;
+				return false;
+			}
+		}
+		cm.mark(vertices[1]);
+	}
+
+	// the stamps of the previous marker are reused: nothing must be marked
+	CellMarkerEpoch<MAP, VERTEX> cm(map);
+	for (unsigned int i = 0; i < vertices.size(); ++i)
+	{
+		if (cm.isMarked(vertices[i]))
+		{
+			CGoGNout << "epoch marker FAILED: marks kept by the pool" << CGoGNendl;
+			return false;
+		}
+	}
+
+	// cells created after the marker
+	Dart d = vertices[0].dart;
+	map.cutEdge(d);
+	Vertex nv(map.phi1(d));
+	if (cm.isMarked(nv))
+	{
+		CGoGNout << "epoch marker FAILED: new cell marked" << CGoGNendl;
+		return false;
+	}
+	cm.mark(nv);
+	if (!cm.isMarked(nv) || cm.isMarked(vertices[0]))
+	{
+		CGoGNout << "epoch marker FAILED: marking a new cell" << CGoGNendl;
+		return false;
+	}
+	map.collapseEdge(map.phi1(d));
+	return true;
+}
+
+// inside vertices, edges and faces of the sphere by a breadth first search
+void reference(MAP& map, const VertexAttribute<VEC3, MAP>& position, Vertex v, REAL radius, unsigned int& nbV, unsigned int& nbE, unsigned int& nbF)
+{
+	const VEC3& center = position[v];
+	CellMarkerStore<MAP, VERTEX> vm(map);
+	std::vector<Vertex> inside;
+	inside.push_back(v);
+	vm.mark(v);
+	for (unsigned int i = 0; i < inside.size(); ++i)
+	{
+		foreach_adjacent2<EDGE>(map, inside[i], [&] (Vertex w)
+		{
+			if (!vm.isMarked(w) && (position[w] - center).norm2() <= radius * radius)
+			{
+				vm.mark(w);
+				inside.push_back(w);
+			}
+		});
+	}
+
+	nbV = uint32(inside.size());
+	nbE = 0;
+	nbF = 0;
+	for (unsigned int i = 0; i < inside.size(); ++i)
+	{
+		foreach_incident2<EDGE>(map, inside[i], [&] (Edge e)
+		{
+			if (vm.isMarked(Vertex(map.phi1(e.dart))))
+				++nbE;
+		});
+		foreach_incident2<FACE>(map, inside[i], [&] (Face f)
+		{
+			if (vm.isMarked(Vertex(map.phi1(f.dart))) && vm.isMarked(Vertex(map.phi_1(f.dart))))
+				++nbF;
+		});
+	}
+	// each edge counted by its 2 ends, each face by its 3 vertices
+	nbE /= 2;
+	nbF /= 3;
+}
+
+int main()
+{
+	bool ok = true;
+
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(myMap, 200, 80);
+	tore.embedIntoTore(position, 2.0f, 0.7f);
+	Algo::Topo::initAllOrbitsEmbedding<EDGE>(myMap);
+	Algo::Topo::initAllOrbitsEmbedding<FACE>(myMap);
+
+	ok = testMarker(myMap);
+
+	const REAL radius = 0.15f;
+	VertexAttribute<unsigned int, MAP> counts = myMap.addAttribute<unsigned int, VERTEX, MAP>("counts");
+
+	unsigned int nbChecked = 0;
+	for (Vertex v : allVerticesOf(myMap))
+	{
+		if (nbChecked++ % 50 != 0)
+			continue;
+		Algo::Surface::Selection::Collector_WithinSphere<PFP> neigh(myMap, position, radius);
+		neigh.collectAll(v);
+		unsigned int nbV, nbE, nbF;
+		reference(myMap, position, v, radius, nbV, nbE, nbF);
+		if (neigh.getNbInsideVertices() != nbV || neigh.getNbInsideEdges() != nbE || neigh.getNbInsideFaces() != nbF)
+		{
+			CGoGNout << "Collector_WithinSphere FAILED: " << neigh.getNbInsideVertices() << "/" << neigh.getNbInsideEdges() << "/" << neigh.getNbInsideFaces()
+				<< " instead of " << nbV << "/" << nbE << "/" << nbF << CGoGNendl;
+			ok = false;
+			break;
+		}
+	}
+
+	// one local query per vertex
+	Utils::Chrono chrono;
+	chrono.start();
+	Algo::Surface::Selection::Collector_WithinSphere<PFP> neigh(myMap, position, radius);
+	foreach_cell<VERTEX>(myMap, [&] (Vertex v)
+	{
+		neigh.collectAll(v);
+		counts[v] = neigh.getNbInsideVertices() + neigh.getNbInsideEdges() + neigh.getNbInsideFaces();
+	});
+	CGoGNout << "sequential queries in " << chrono.elapsed() << " ms" << CGoGNendl;
+
+	// the pools of markers are per thread
+	std::atomic<unsigned int> nbErrors(0);
+	chrono.start();
+	Parallel::foreach_cell<VERTEX>(myMap, [&] (Vertex v, unsigned int /*thr*/)
+	{
+		Algo::Surface::Selection::Collector_WithinSphere<PFP> tneigh(myMap, position, radius);
+		tneigh.collectAll(v);
+		if (counts[v] != tneigh.getNbInsideVertices() + tneigh.getNbInsideEdges() + tneigh.getNbInsideFaces())
+			++nbErrors;
+	}, FORCE_CELL_MARKING, 4);
+	CGoGNout << "parallel queries (4 threads) in " << chrono.elapsed() << " ms" << CGoGNendl;
+	if (nbErrors > 0)
+		ok = false;
+
+	if (ok)
+		CGoGNout << "epoch markers OK" << CGoGNendl;
+	else
+		CGoGNout << "epoch markers FAILED" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
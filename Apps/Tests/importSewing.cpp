@@ -0,0 +1,145 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <fstream>
+#include <cstdio>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Algo/Import/import.h"
+#include "Algo/Topo/basic.h"
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3: public PFP_STANDARD
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+/**
+ * surface: grid of n x n quads with a non manifold fan of 3 triangles on one of its corners
+ */
+bool testSurface(unsigned int n, unsigned int nbThreads)
+{
+	{
+		std::ofstream off("importSewing.off");
+		unsigned int nv = (n + 1) * (n + 1);
+		off << "OFF\n" << nv + 4 << " " << n * n + 3 << " 0\n";
+		for (unsigned int j = 0; j <= n; ++j)
+			for (unsigned int i = 0; i <= n; ++i)
+				off << i << " " << j << " 0\n";
+		off << "-1 -1 0\n-1 0 1\n-1 0 -1\n0 -1 1\n";
+		for (unsigned int j = 0; j < n; ++j)
+			for (unsigned int i = 0; i < n; ++i)
+			{
+				unsigned int a = j * (n + 1) + i;
+				off << "4 " << a << " " << a + 1 << " " << a + n + 2 << " " << a + n + 1 << "\n";
+			}
+		// 3 triangles sharing the edge (0, nv)
+		off << "3 0 " << nv << " " << nv + 1 << "\n";
+		off << "3 " << nv << " 0 " << nv + 2 << "\n";
+		off << "3 0 " << nv << " " << nv + 3 << "\n";
+	}
+
+	CGoGN::Parallel::NumberOfThreads = nbThreads;
+	PFP2::MAP myMap;
+	std::vector<std::string> attrNames;
+	bool ok = Algo::Surface::Import::importMesh<PFP2>(myMap, "importSewing.off", attrNames);
+	remove("importSewing.off");
+
+	ok &= myMap.check();
+	// the first two triangles of the fan are sewn, the edge of the third one stays on the boundary
+	if (Algo::Topo::getNbOrbits<EDGE>(myMap) != 2 * n * (n + 1) + 8)
+		ok = false;
+	if (!ok)
+		CGoGNout << "surface sewing FAILED (" << nbThreads << " threads)" << CGoGNendl;
+	return ok;
+}
+
+/**
+ * volume: k x k x k cubes, each cut in 6 tetrahedra around its diagonal
+ */
+bool testVolume(unsigned int k, unsigned int nbThreads)
+{
+	{
+		std::ofstream tet("importSewing.tet");
+		tet << (k + 1) * (k + 1) * (k + 1) << " vertices\n" << 6 * k * k * k << " tetras\n";
+		for (unsigned int z = 0; z <= k; ++z)
+			for (unsigned int y = 0; y <= k; ++y)
+				for (unsigned int x = 0; x <= k; ++x)
+					tet << x << " " << y << " " << z << "\n";
+		const unsigned int perm[6][3] = { {0,1,2}, {0,2,1}, {1,0,2}, {1,2,0}, {2,0,1}, {2,1,0} };
+		const unsigned int step[3] = { 1, k + 1, (k + 1) * (k + 1) };
+		for (unsigned int z = 0; z < k; ++z)
+			for (unsigned int y = 0; y < k; ++y)
+				for (unsigned int x = 0; x < k; ++x)
+					for (unsigned int p = 0; p < 6; ++p)
+					{
+						unsigned int v = x * step[0] + y * step[1] + z * step[2];
+						tet << "4 " << v;
+						for (unsigned int a = 0; a < 3; ++a)
+						{
+							v += step[perm[p][a]];
+							tet << " " << v;
+						}
+						tet << "\n";
+					}
+	}
+
+	CGoGN::Parallel::NumberOfThreads = nbThreads;
+	PFP3::MAP myMap;
+	std::vector<std::string> attrNames;
+	bool ok = Algo::Volume::Import::importMesh<PFP3>(myMap, "importSewing.tet", attrNames);
+	remove("importSewing.tet");
+
+	ok &= myMap.check();
+	unsigned int nbFaces = 12 * k * k * k + 6 * k * k;
+	if (Algo::Topo::getNbOrbits<VERTEX>(myMap) != (k + 1) * (k + 1) * (k + 1) || Algo::Topo::getNbOrbits<FACE>(myMap) != nbFaces)
+		ok = false;
+	if (!ok)
+		CGoGNout << "volume sewing FAILED (" << nbThreads << " threads)" << CGoGNendl;
+	return ok;
+}
+
+int main()
+{
+	bool ok = true;
+	for (unsigned int nbThreads = 1; nbThreads <= 4; nbThreads += 3)
+	{
+		ok &= testSurface(100, nbThreads);
+		ok &= testVolume(10, nbThreads);
+	}
+
+	if (ok)
+		CGoGNout << "import sewing OK" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Import/import.h"
+
+#include <fstream>
+#include <cstdio>
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP2::MAP MAP;
+typedef PFP2::VEC3 VEC3;
+
+/**
+ * write a grid of n x n quads (split in 2 triangles every other quad)
+ * in OBJ (with texture coordinates, normals, comments, CRLF ends of line and negative indices)
+ * and in OFF
+ */
+void writeFiles(unsigned int n)
+{
+	std::ofstream obj("importText.obj", std::ios::binary);
+	std::ofstream off("importText.off", std::ios::binary);
+
+	unsigned int nbFaces = 0;
+	for (unsigned int j = 0; j < n; ++j)
+		for (unsigned int i = 0; i < n; ++i)
+			nbFaces += ((i + j) % 2) ? 1 : 2;
+
+	obj << "# grid\r\nmtllib none.mtl\r\no grid\r\n";
+	off << "OFF\n# grid\n" << (n + 1) * (n + 1) << " " << nbFaces << " 0\n";
+	for (unsigned int j = 0; j <= n; ++j)
+	{
+		for (unsigned int i = 0; i <= n; ++i)
+		{
+			float z = 1e-3f * float(i * j);
+			obj << "v " << i << ".5 " << -float(j) << " " << z << "e+2\r\n";
+			obj << "vt 0.5 0.5\r\nvn 0 0 1\r\n";
+			off << i << ".5 " << -float(j) << " " << z << "e+2 255 0 0\n";
+		}
+	}
+	obj << "\r\n";
+	for (unsigned int j = 0; j < n; ++j)
+	{
+		for (unsigned int i = 0; i < n; ++i)
+		{
+			unsigned int a = j * (n + 1) + i, b = a + 1, c = a + n + 2, d = a + n + 1;
+			if ((i + j) % 2)
+			{
+				obj << "f " << a + 1 << "/1/1 " << b + 1 << "/1/1 " << c + 1 << "/1/1 " << d + 1 << "/1/1\r\n";
+				off << "4 " << a << " " << b << " " << c << " " << d << "\n";
+			}
+			else
+			{
+				obj << "f " << a + 1 << "//1 " << b + 1 << "//1 " << c + 1 << "//1\r\n";
+				obj << "f " << int(a) - int((n + 1) * (n + 1)) << " " << c + 1 << " " << d + 1 << "\r\n";
+				off << "3 " << a << " " << b << " " << c << "\n3 " << a << " " << c << " " << d << "\n";
+			}
+		}
+	}
+}
+
+bool check(const char* filename, unsigned int n)
+{
+	bool ok = true;
+
+	// tables read with 1 and 4 threads
+	std::vector<std::vector<unsigned int> > faces(2);
+	std::vector<std::vector<VEC3> > positions(2);
+	for (unsigned int k = 0; k < 2; ++k)
+	{
+		CGoGN::Parallel::NumberOfThreads = 1 + 3 * k;
+
+		MAP myMap;
+		Algo::Surface::Import::MeshTablesSurface<PFP2> mts(myMap);
+		std::vector<std::string> attrNames;
+		if (!mts.importMesh(filename, attrNames))
+			return false;
+
+		VertexAttribute<VEC3, MAP> position = myMap.getAttribute<VEC3, VERTEX, MAP>(attrNames[0]);
+		unsigned int e = 0;
+		for (unsigned int f = 0; f < mts.getNbFaces(); ++f)
+		{
+			faces[k].push_back(mts.getNbEdgesFace(f));
+			for (int i = 0; i < mts.getNbEdgesFace(f); ++i)
+			{
+				positions[k].push_back(position[mts.getEmbIdx(e++)]);
+				faces[k].push_back(mts.getEmbIdx(e - 1));
+			}
+		}
+
+		if (mts.getNbVertices() != (n + 1) * (n + 1) || positions[k].size() != 5 * n * n)
+			ok = false;
+	}
+
+	if (faces[0] != faces[1] || positions[0] != positions[1])
+		ok = false;
+
+	// value of the last vertex
+	VEC3 last(float(n) + 0.5f, -float(n), 1e-1f * float(n * n));
+	if ((positions[0][positions[0].size() - 2] - last).norm2() > 1e-4f)
+		ok = false;
+
+	if (!ok)
+		CGoGNout << filename << ": FAILED" << CGoGNendl;
+	return ok;
+}
+
+int main()
+{
+	unsigned int n = 200;
+	writeFiles(n);
+
+	bool ok = check("importText.obj", n);
+	ok &= check("importText.off", n);
+
+	remove("importText.obj");
+	remove("importText.off");
+
+	if (ok)
+		CGoGNout << "text import OK" << CGoGNendl;
+	else
+		CGoGNout << "text import FAILED" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
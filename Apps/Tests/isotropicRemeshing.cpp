@@ -0,0 +1,250 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Remeshing/isotropic.h"
+#include "Geometry/distances.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+/**
+ * remesh a bumpy torus with a uniform and a varying target edge length and a bumpy grid:
+ * the result must not depend on the number of threads, the edge lengths must be close
+ * to their targets, the surface close to the input one and the boundary kept
+ */
+void bumpyTorus(MAP& map, VertexAttribute<VEC3, MAP>& position)
+{
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(map, 60, 30);
+	tore.embedIntoTore(position, 2.0f, 0.7f);
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		VEC3& p = position[i];
+		p[2] *= 1.0f + 0.15f * std::sin(6.0f * std::atan2(p[1], p[0]));
+	}
+}
+
+// mean edge length on each side of the plane x = 0
+void meanEdgeLengths(MAP& map, const VertexAttribute<VEC3, MAP>& position, REAL& negative, REAL& positive)
+{
+	REAL sum[2] = { 0, 0 };
+	unsigned int nb[2] = { 0, 0 };
+	for (Edge e : allEdgesOf(map))
+	{
+		const VEC3& a = position[e.dart];
+		const VEC3& b = position[map.phi1(e.dart)];
+		unsigned int side = (a[0] + b[0] > 0) ? 1 : 0;
+		sum[side] += (b - a).norm();
+		++nb[side];
+	}
+	negative = nb[0] > 0 ? sum[0] / nb[0] : 0;
+	positive = nb[1] > 0 ? sum[1] / nb[1] : 0;
+}
+
+// max distance from the given points to the faces of the map
+REAL maxDistance(MAP& map, const VertexAttribute<VEC3, MAP>& position, const std::vector<VEC3>& points)
+{
+	std::vector<VEC3> tris;
+	for (Face f : allFacesOf(map))
+	{
+		tris.push_back(position[f.dart]);
+		tris.push_back(position[map.phi1(f.dart)]);
+		tris.push_back(position[map.phi_1(f.dart)]);
+	}
+	REAL maxDist = 0;
+	for (unsigned int i = 0; i < points.size(); ++i)
+	{
+		REAL d2 = std::numeric_limits<REAL>::max();
+		for (unsigned int t = 0; t < tris.size(); t += 3)
+			d2 = std::min(d2, Geom::squaredDistancePoint2Triangle(points[i], tris[t], tris[t + 1], tris[t + 2]));
+		maxDist = std::max(maxDist, d2);
+	}
+	return std::sqrt(maxDist);
+}
+
+bool isTriangular(MAP& map)
+{
+	for (Face f : allFacesOf(map))
+	{
+		if (map.faceDegree(f.dart) != 3)
+			return false;
+	}
+	return true;
+}
+
+bool lessVec(const VEC3& a, const VEC3& b)
+{
+	return std::lexicographical_compare(&a[0], &a[0] + 3, &b[0], &b[0] + 3);
+}
+
+bool testTorus()
+{
+	const REAL target = 0.15f;
+	bool ok = true;
+
+	std::vector<VEC3> ref;
+	for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+	{
+		MAP myMap;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+		bumpyTorus(myMap, position);
+		std::vector<VEC3> points;
+		for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+			points.push_back(position[i]);
+
+		Algo::Surface::Remeshing::isotropicRemeshing<PFP>(myMap, position, target, 5, nbth);
+
+		if (myMap.check() == false || !isTriangular(myMap))
+		{
+			CGoGNout << "isotropic remeshing (" << nbth << " threads) FAILED: invalid map" << CGoGNendl;
+			ok = false;
+			continue;
+		}
+
+		std::vector<VEC3> positions;
+		unsigned int nbRegular = 0;
+		for (Vertex v : allVerticesOf(myMap))
+		{
+			positions.push_back(position[v]);
+			if (myMap.vertexDegree(v.dart) == 6)
+				++nbRegular;
+		}
+		std::sort(positions.begin(), positions.end(), lessVec);
+		if (ref.empty())
+			ref.swap(positions);
+		else if (positions != ref)
+		{
+			CGoGNout << "isotropic remeshing FAILED: result depends on the number of threads" << CGoGNendl;
+			ok = false;
+		}
+
+		REAL negative, positive;
+		meanEdgeLengths(myMap, position, negative, positive);
+		REAL error = maxDistance(myMap, position, points);
+		REAL regular = REAL(nbRegular) / REAL(ref.size());
+		if (nbth == 1)
+			CGoGNout << "uniform: mean edge lengths " << negative << " / " << positive << ", regular vertices " << regular << ", max error " << error << CGoGNendl;
+		if (std::abs(negative - target) > 0.15f * target || std::abs(positive - target) > 0.15f * target || regular < 0.6f || error > 0.25f * target)
+		{
+			CGoGNout << "isotropic remeshing FAILED: bad uniform remeshing" << CGoGNendl;
+			ok = false;
+		}
+	}
+
+	// finer on the positive side
+	{
+		MAP myMap;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+		VertexAttribute<REAL, MAP> sizing = myMap.addAttribute<REAL, VERTEX, MAP>("sizing");
+		bumpyTorus(myMap, position);
+		for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+			sizing[i] = position[i][0] > 0 ? 0.5f * target : target;
+
+		Algo::Surface::Remeshing::isotropicRemeshing<PFP>(myMap, position, sizing, 5, 4);
+
+		REAL negative, positive;
+		meanEdgeLengths(myMap, position, negative, positive);
+		CGoGNout << "sizing field: mean edge lengths " << negative << " / " << positive << CGoGNendl;
+		if (myMap.check() == false || !isTriangular(myMap) || positive > 0.7f * negative)
+		{
+			CGoGNout << "isotropic remeshing FAILED: sizing field not followed" << CGoGNendl;
+			ok = false;
+		}
+	}
+
+	return ok;
+}
+
+bool testGrid()
+{
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Triangular::Grid<PFP> grid(myMap, 12, 12, true);
+	grid.embedIntoGrid(position, 2.0f, 2.0f);
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+	{
+		VEC3& p = position[i];
+		p[2] = 0.2f * std::sin(3.0f * p[0]) * std::cos(3.0f * p[1]);
+	}
+
+	std::vector<std::pair<VEC3, VEC3> > border;
+	for (Edge e : allEdgesOf(myMap))
+	{
+		if (myMap.isBoundaryEdge(e.dart))
+			border.push_back(std::make_pair(position[e.dart], position[myMap.phi1(e.dart)]));
+	}
+
+	Algo::Surface::Remeshing::isotropicRemeshing<PFP>(myMap, position, 0.08f, 5, 4);
+
+	if (myMap.check() == false || !isTriangular(myMap))
+	{
+		CGoGNout << "isotropic remeshing FAILED: invalid map (grid)" << CGoGNendl;
+		return false;
+	}
+
+	// the boundary vertices stay on the input boundary
+	for (Vertex v : allVerticesOf(myMap))
+	{
+		if (!myMap.isBoundaryVertex(v.dart))
+			continue;
+		REAL d2 = std::numeric_limits<REAL>::max();
+		for (unsigned int i = 0; i < border.size(); ++i)
+		{
+			VEC3 ab = border[i].second - border[i].first;
+			d2 = std::min(d2, Geom::squaredDistanceSeg2Point(border[i].first, ab, ab * ab, position[v]));
+		}
+		if (d2 > 1e-10f)
+		{
+			CGoGNout << "isotropic remeshing FAILED: boundary moved" << CGoGNendl;
+			return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	bool ok = testTorus();
+	ok = testGrid() && ok;
+
+	if (ok)
+		CGoGNout << "isotropic remeshing OK" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/MC/marchingcube.h"
+#include "Algo/Topo/basic.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * mesh an image (two intersecting balls) with simpleMeshing and parallelMeshing
+ * and compare the results
+ */
+struct Result
+{
+	unsigned int nbVertices;
+	unsigned int nbFaces;
+	unsigned int nbFreeEdges;
+	std::vector<VEC3> positions;
+};
+
+bool lessVec(const VEC3& a, const VEC3& b)
+{
+	return std::lexicographical_compare(&a[0], &a[0] + 3, &b[0], &b[0] + 3);
+}
+
+Result mesh(Algo::Surface::MC::Image<float>& img, int nbth)
+{
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+
+	Algo::Surface::MC::WindowingLess<float> wind;
+	wind.setIsoValue(1.0f);
+	Algo::Surface::MC::MarchingCube<float, Algo::Surface::MC::WindowingLess, PFP> mc(&img, &myMap, position, wind, false);
+	if (nbth == 0)
+		mc.simpleMeshing();
+	else
+		mc.parallelMeshing(nbth);
+
+	Result r;
+	r.nbVertices = Algo::Topo::getNbOrbits<VERTEX>(myMap);
+	r.nbFaces = Algo::Topo::getNbOrbits<FACE>(myMap);
+	r.nbFreeEdges = 0;
+	for (Dart d = myMap.begin(); d != myMap.end(); myMap.next(d))
+		if (myMap.phi2(d) == d)
+			++r.nbFreeEdges;
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		r.positions.push_back(position[i]);
+	std::sort(r.positions.begin(), r.positions.end(), lessVec);
+	return r;
+}
+
+int main()
+{
+	const int w = 48;
+	std::vector<float> data(w * w * w);
+	for (int z = 0; z < w; ++z)
+		for (int y = 0; y < w; ++y)
+			for (int x = 0; x < w; ++x)
+			{
+				float d1 = std::sqrt(float((x - 18) * (x - 18) + (y - 20) * (y - 20) + (z - 20) * (z - 20))) / 14.0f;
+				float d2 = std::sqrt(float((x - 32) * (x - 32) + (y - 26) * (y - 26) + (z - 30) * (z - 30))) / 12.5f;
+				// the second ball touches the border of the image: open surface
+				data[x + w * (y + w * z)] = std::min(d1, d2 * ((z == w - 1) ? 0.5f : 1.0f));
+			}
+	Algo::Surface::MC::Image<float> img(&data[0], w, w, w, 1.0f, 1.0f, 1.0f, false);
+
+	Result ref = mesh(img, 0);
+	bool ok = ref.nbFaces > 0;
+	for (int nbth = 1; nbth <= 4; nbth += 3)
+	{
+		Result r = mesh(img, nbth);
+		if (r.nbVertices != ref.nbVertices || r.nbFaces != ref.nbFaces || r.nbFreeEdges != ref.nbFreeEdges || r.positions != ref.positions)
+		{
+			CGoGNout << "parallel marching cubes (" << nbth << " threads) FAILED: " << r.nbVertices << "/" << ref.nbVertices << " vertices, "
+				<< r.nbFaces << "/" << ref.nbFaces << " faces, " << r.nbFreeEdges << "/" << ref.nbFreeEdges << " free edges" << CGoGNendl;
+			ok = false;
+		}
+	}
+
+	if (ok)
+		CGoGNout << "parallel marching cubes OK (" << ref.nbVertices << " vertices, " << ref.nbFaces << " faces)" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
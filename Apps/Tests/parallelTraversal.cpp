@@ -0,0 +1,114 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+
+#include <set>
+#include <mutex>
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP2::MAP MAP;
+typedef PFP2::VEC3 VEC3;
+
+/**
+ * compare the cells given to the threads by Parallel::foreach_cell
+ * with the cells of the sequential traversal (each one exactly once)
+ */
+template <unsigned int ORBIT>
+bool checkTraversal(MAP& map, TraversalOptim opt, unsigned int nbth)
+{
+	std::vector< std::multiset<unsigned int> > cells(nbth);
+	bool threadOk = true;
+	Parallel::foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c, unsigned int thr)
+	{
+		if (thr == 0 || thr >= nbth || map.getCurrentThreadIndex() != thr)
+			threadOk = false;
+		else
+			cells[thr].insert(map.isOrbitEmbedded<ORBIT>() ? map.getEmbedding(c) : c.dart.index);
+	}, opt, nbth);
+
+	std::multiset<unsigned int> all;
+	for (unsigned int i = 0; i < nbth; ++i)
+		all.insert(cells[i].begin(), cells[i].end());
+
+	std::multiset<unsigned int> ref;
+	foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
+	{
+		ref.insert(map.isOrbitEmbedded<ORBIT>() ? map.getEmbedding(c) : c.dart.index);
+	}, opt);
+
+	bool ok = threadOk && (all == ref);
+	std::cout << "orbit " << ORBIT << " opt " << opt << " threads " << nbth << (ok ? " OK" : " FAILED") << std::endl;
+	return ok;
+}
+
+int main()
+{
+	MAP myMap;
+
+	// open cylinder: boundary darts must be skipped
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Square::Cylinder<PFP2> cyl(myMap, 100, 50, false, false);
+	cyl.embedIntoCylinder(position, 1.0f, 1.0f, 1.0f);
+
+	bool ok = true;
+	for (unsigned int nbth = 2; nbth < 10; nbth += 3)
+	{
+		ok &= checkTraversal<DART>(myMap, AUTO, nbth);
+		ok &= checkTraversal<VERTEX>(myMap, AUTO, nbth);
+		ok &= checkTraversal<VERTEX>(myMap, FORCE_DART_MARKING, nbth);
+		ok &= checkTraversal<EDGE>(myMap, AUTO, nbth);
+	}
+
+	// more threads than cores (and than the former limit of 16 threads)
+	ok &= checkTraversal<VERTEX>(myMap, AUTO, 24);
+	ok &= checkTraversal<EDGE>(myMap, AUTO, 24);
+
+	myMap.enableQuickTraversal<MAP, FACE>();
+	ok &= checkTraversal<FACE>(myMap, FORCE_QUICK_TRAVERSAL, 4);
+
+	// each line of the attribute exactly once
+	std::vector<unsigned int> nb(position.end(), 0);
+	std::mutex mutex;
+	Parallel::foreach_attribute(position, [&] (unsigned int i, unsigned int)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		nb[i]++;
+	}, 4);
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		ok &= (nb[i] == 1);
+
+	std::cout << (ok ? "parallel traversals OK" : "parallel traversals FAILED") << std::endl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include <map>
+#include <algorithm>
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP2::MAP MAP;
+typedef PFP2::VEC3 VEC3;
+
+template <unsigned int ORBIT>
+std::vector<unsigned int> listCells(MAP& map, const Dart* list)
+{
+	std::vector<unsigned int> cells;
+	for (; *list != NIL; ++list)
+		cells.push_back(map.getEmbedding<ORBIT>(*list));
+	std::sort(cells.begin(), cells.end());
+	return cells;
+}
+
+/**
+ * compare the incrementally updated lists of a table with the lists
+ * given by a complete update of the table
+ */
+template <unsigned int ORBIT, unsigned int INCI>
+bool checkIncident(MAP& map)
+{
+	std::map<unsigned int, std::vector<unsigned int> > lists;
+	foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
+	{
+		lists[map.getEmbedding(c)] = listCells<INCI>(map, (*map.getQuickIncidentTraversal<ORBIT, INCI>())[map.getEmbedding(c)]);
+	});
+
+	map.updateQuickIncidentTraversal<MAP, ORBIT, INCI>();
+
+	bool ok = true;
+	foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
+	{
+		ok &= (lists[map.getEmbedding(c)] == listCells<INCI>(map, (*map.getQuickIncidentTraversal<ORBIT, INCI>())[map.getEmbedding(c)]));
+	});
+	return ok;
+}
+
+template <unsigned int ORBIT, unsigned int ADJ>
+bool checkAdjacent(MAP& map)
+{
+	std::map<unsigned int, std::vector<unsigned int> > lists;
+	foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
+	{
+		lists[map.getEmbedding(c)] = listCells<ORBIT>(map, (*map.getQuickAdjacentTraversal<ORBIT, ADJ>())[map.getEmbedding(c)]);
+	});
+
+	map.updateQuickAdjacentTraversal<MAP, ORBIT, ADJ>();
+
+	bool ok = true;
+	foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
+	{
+		ok &= (lists[map.getEmbedding(c)] == listCells<ORBIT>(map, (*map.getQuickAdjacentTraversal<ORBIT, ADJ>())[map.getEmbedding(c)]));
+	});
+	return ok;
+}
+
+bool checkTables(MAP& map)
+{
+	bool ok = true;
+	ok &= checkIncident<VERTEX, EDGE>(map);
+	ok &= checkIncident<VERTEX, FACE>(map);
+	ok &= checkIncident<FACE, VERTEX>(map);
+	ok &= checkIncident<EDGE, VERTEX>(map);
+	ok &= checkAdjacent<VERTEX, EDGE>(map);
+	ok &= checkAdjacent<FACE, EDGE>(map);
+	ok &= checkAdjacent<FACE, VERTEX>(map);
+	return ok;
+}
+
+int main()
+{
+	MAP myMap;
+
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(myMap, 20, 20);
+	tore.embedIntoTore(position, 1.0f, 0.4f);
+
+	myMap.enableQuickIncidentTraversal<MAP, VERTEX, EDGE>();
+	myMap.enableQuickIncidentTraversal<MAP, VERTEX, FACE>();
+	myMap.enableQuickIncidentTraversal<MAP, FACE, VERTEX>();
+	myMap.enableQuickIncidentTraversal<MAP, EDGE, VERTEX>();
+	myMap.enableQuickAdjacentTraversal<MAP, VERTEX, EDGE>();
+	myMap.enableQuickAdjacentTraversal<MAP, FACE, EDGE>();
+	myMap.enableQuickAdjacentTraversal<MAP, FACE, VERTEX>();
+
+	bool ok = true;
+	unsigned int seed = 1;
+	for (unsigned int i = 0; i < 200 && ok; ++i)
+	{
+		// pick a dart at random among the darts of the map
+		seed = seed * 1103515245 + 12345;
+		unsigned int nb = (seed >> 8) % myMap.getNbDarts();
+		Dart d = myMap.begin();
+		for (unsigned int j = 0; j < nb; ++j)
+			myMap.next(d);
+
+		switch (i % 4)
+		{
+			case 0 :
+			{
+				// split the edge and the two triangles
+				Dart dd = myMap.phi2(d);
+				myMap.cutEdge(d);
+				myMap.splitFace(myMap.phi1(d), myMap.phi_1(d));
+				myMap.splitFace(myMap.phi1(dd), myMap.phi_1(dd));
+				break;
+			}
+			case 1 :
+				if (myMap.edgeCanCollapse(d))
+					myMap.collapseEdge(d);
+				break;
+			case 2 :
+				// do not create an edge that already exists
+				if (myMap.vertexDegree(d) > 3 && myMap.vertexDegree(myMap.phi2(d)) > 3
+					&& !myMap.sameVertex(myMap.phi_1(d), myMap.phi_1(myMap.phi2(d))))
+					myMap.flipEdge(d);
+				break;
+			case 3 :
+			{
+				// merge two triangles and split the quad again
+				Dart e = myMap.phi_1(d);
+				if (myMap.mergeFaces(d))
+					myMap.splitFace(e, myMap.phi1(myMap.phi1(e)));
+				break;
+			}
+		}
+
+		ok &= checkTables(myMap);
+	}
+
+	std::cout << (ok ? "quick traversal tables OK" : "quick traversal tables FAILED") << std::endl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Filtering/average.h"
+
+#include <cstdlib>
+#include <cmath>
+
+using namespace CGoGN ;
+
+struct PFP2: public PFP_STANDARD
+{
+	// definition of the type of the map
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP2::MAP MAP;
+typedef PFP2::VEC3 VEC3;
+typedef PFP2::REAL REAL;
+
+/**
+ * compare the SIMD kernels with the scalar functions on a map
+ */
+bool check(MAP& myMap, const VertexAttribute<VEC3, MAP>& position)
+{
+	bool ok = true;
+
+	FaceAttribute<REAL, MAP> area = myMap.addAttribute<REAL, FACE, MAP>("area");
+	FaceAttribute<REAL, MAP> areaSIMD = myMap.addAttribute<REAL, FACE, MAP>("areaSIMD");
+	Algo::Surface::Geometry::computeAreaFaces<PFP2>(myMap, position, area);
+	Algo::Surface::Geometry::SIMD::computeAreaFaces<PFP2>(myMap, position, areaSIMD);
+	foreach_cell<FACE>(myMap, [&] (Face f)
+	{
+		if (std::fabs(area[f] - areaSIMD[f]) > 1e-5f * std::max(REAL(1), area[f]))
+			ok = false;
+	});
+	if (!ok)
+		CGoGNout << "computeAreaFaces: FAILED" << CGoGNendl;
+
+	VertexAttribute<VEC3, MAP> normal = myMap.addAttribute<VEC3, VERTEX, MAP>("normal");
+	VertexAttribute<VEC3, MAP> normalSIMD = myMap.addAttribute<VEC3, VERTEX, MAP>("normalSIMD");
+	Algo::Surface::Geometry::computeNormalVertices<PFP2>(myMap, position, normal);
+	Algo::Surface::Geometry::SIMD::computeNormalVertices<PFP2>(myMap, position, normalSIMD);
+	bool okNormal = true;
+	foreach_cell<VERTEX>(myMap, [&] (Vertex v)
+	{
+		if ((normal[v] - normalSIMD[v]).norm() > 1e-4f)
+			okNormal = false;
+	});
+	if (!okNormal)
+		CGoGNout << "computeNormalVertices: FAILED" << CGoGNendl;
+
+	VertexAttribute<VEC3, MAP> smooth = myMap.addAttribute<VEC3, VERTEX, MAP>("smooth");
+	VertexAttribute<VEC3, MAP> smoothSIMD = myMap.addAttribute<VEC3, VERTEX, MAP>("smoothSIMD");
+	bool okAverage = true;
+	for (int neigh = 1; neigh <= 3; ++neigh)
+	{
+		Algo::Surface::Filtering::filterAverageAttribute_OneRing<PFP2, VEC3>(myMap, position, smooth, neigh);
+		Algo::Surface::Filtering::SIMD::filterAverageAttribute_OneRing<PFP2>(myMap, position, smoothSIMD, neigh);
+		foreach_cell<VERTEX>(myMap, [&] (Vertex v)
+		{
+			if ((smooth[v] - smoothSIMD[v]).norm() > 1e-5f)
+				okAverage = false;
+		});
+	}
+	if (!okAverage)
+		CGoGNout << "filterAverageAttribute_OneRing: FAILED" << CGoGNendl;
+
+	myMap.removeAttribute(area);
+	myMap.removeAttribute(areaSIMD);
+	myMap.removeAttribute(normal);
+	myMap.removeAttribute(normalSIMD);
+	myMap.removeAttribute(smooth);
+	myMap.removeAttribute(smoothSIMD);
+
+	return ok && okNormal && okAverage;
+}
+
+int main()
+{
+	srand(7);
+	bool ok = true;
+
+	// closed surface with triangles and quads
+	{
+		MAP myMap;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+		Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(myMap, 20, 20);
+		tore.embedIntoTore(position, 1.0f, 0.4f);
+
+		std::vector<Dart> edges;
+		foreach_cell<EDGE>(myMap, [&] (Edge e) { edges.push_back(e.dart); });
+		DartMarker<MAP> dm(myMap);
+		for (unsigned int i = 0; i < edges.size(); i += 7)
+		{
+			Dart d = edges[i];
+			if (!dm.isMarked(d) && !dm.isMarked(myMap.phi2(d)))
+			{
+				dm.markOrbit<FACE>(d);
+				dm.markOrbit<FACE>(myMap.phi2(d));
+				myMap.mergeFaces(d);
+			}
+		}
+
+		ok &= check(myMap, position);
+	}
+
+	// open surface with a boundary
+	{
+		MAP myMap;
+		VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+		Algo::Surface::Tilings::Triangular::Grid<PFP2> grid(myMap, 30, 30);
+		grid.embedIntoGrid(position, 1.0f, 1.0f);
+		foreach_cell<VERTEX>(myMap, [&] (Vertex v)
+		{
+			position[v][2] = REAL(rand()) / REAL(RAND_MAX) * 0.05f;
+		});
+
+		ok &= check(myMap, position);
+	}
+
+	if (ok)
+		CGoGNout << "SIMD kernels OK" << CGoGNendl;
+	else
+		CGoGNout << "SIMD kernels FAILED" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
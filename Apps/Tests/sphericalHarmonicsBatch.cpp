@@ -0,0 +1,185 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Geometry/vector_gen.h"
+#include "Utils/sphericalHarmonics.h"
+#include "Utils/sphericalHarmonicsBatch.h"
+#include "Utils/threadPool.h"
+#include "Utils/cgognStream.h"
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+using namespace CGoGN ;
+
+typedef Geom::Vec3d VEC3;
+typedef Utils::SphericalHarmonics<double, VEC3> SH;
+
+const int resolution = 5;
+
+VEC3 randomDirection()
+{
+	VEC3 d;
+	do
+	{
+		for (unsigned int c = 0; c < 3; ++c)
+			d[c] = 2.0 * double(rand()) / RAND_MAX - 1.0;
+	} while (d.norm2() > 1.0 || d.norm2() < 1e-4);
+	d.normalize();
+	return d;
+}
+
+void randomSH(SH& sh)
+{
+	for (int l = 0; l <= resolution; ++l)
+		for (int m = -l; m <= l; ++m)
+			for (unsigned int c = 0; c < 3; ++c)
+				sh.get_coef(l, m)[c] = 2.0 * double(rand()) / RAND_MAX - 1.0;
+}
+
+/**
+ * compare the batch evaluation and fitting of spherical harmonics with SphericalHarmonics
+ */
+int main()
+{
+	bool ok = true;
+	srand(7);
+
+	SH::set_level(resolution);
+
+	// directions with poles and equator
+	std::vector<VEC3> directions;
+	directions.push_back(VEC3(0, 0, 1));
+	directions.push_back(VEC3(0, 0, -1));
+	directions.push_back(VEC3(1, 0, 0));
+	directions.push_back(VEC3(0, -1, 0));
+	for (unsigned int i = 0; i < 997; ++i)
+		directions.push_back(randomDirection());
+	const unsigned int n = (unsigned int)(directions.size());
+
+	Utils::SphericalHarmonicsBatch<double> batch(resolution);
+	Utils::SphericalHarmonicsBatch<float> batchf(resolution);
+	batch.setDirections(directions);
+	batchf.setDirections(directions);
+
+	// evaluation
+	SH sh;
+	randomSH(sh);
+	std::vector<VEC3> values(n);
+	std::vector<Geom::Vec3f> valuesf(n);
+	std::vector<double> norms(n);
+	batch.evaluate(sh.get_coef_tab(), &values[0]);
+	std::vector<Geom::Vec3f> coefsf(batch.getNbCoefs());
+	for (int i = 0; i < batch.getNbCoefs(); ++i)
+		coefsf[i] = Geom::Vec3f(sh.get_coef_tab()[i][0], sh.get_coef_tab()[i][1], sh.get_coef_tab()[i][2]);
+	batchf.evaluate(&coefsf[0], &valuesf[0]);
+	batch.evaluateSquaredNorm(sh.get_coef_tab(), &norms[0]);
+
+	double maxError = 0;
+	double maxErrorf = 0;
+	double maxNormError = 0;
+	for (unsigned int p = 0; p < n; ++p)
+	{
+		VEC3 ref = sh.evaluate_at(directions[p][0], directions[p][1], directions[p][2]);
+		maxError = std::max(maxError, (values[p] - ref).norm());
+		maxErrorf = std::max(maxErrorf, (VEC3(valuesf[p][0], valuesf[p][1], valuesf[p][2]) - ref).norm() / std::max(1.0, ref.norm()));
+		maxNormError = std::max(maxNormError, std::fabs(norms[p] - ref.norm2()) / std::max(1.0, ref.norm2()));
+	}
+	// SphericalHarmonics computes the Legendre recurrence coefficients in float
+	if (maxError > 1e-6 || maxErrorf > 1e-4 || maxNormError > 1e-6)
+	{
+		CGoGNout << "SH batch evaluation FAILED: errors " << maxError << " / " << maxErrorf << " / " << maxNormError << CGoGNendl;
+		ok = false;
+	}
+
+	// fitting: same result as fit_to_data, several functions at once
+	const unsigned int nbFunctions = 3;
+	const double lambda = 0.01;
+	std::vector<VEC3> samples(nbFunctions * n);
+	for (unsigned int f = 0; f < nbFunctions; ++f)
+	{
+		randomSH(sh);
+		batch.evaluate(sh.get_coef_tab(), &samples[f * n]);
+	}
+	std::vector<VEC3> coefs(nbFunctions * batch.getNbCoefs());
+	batch.prepareFit(lambda);
+	batch.fit(nbFunctions, &samples[0], &coefs[0]);
+
+	std::vector<double> x(n), y(n), z(n), r(n), g(n), b(n);
+	for (unsigned int p = 0; p < n; ++p)
+	{
+		x[p] = directions[p][0];
+		y[p] = directions[p][1];
+		z[p] = directions[p][2];
+	}
+	double maxFitError = 0;
+	for (unsigned int f = 0; f < nbFunctions; ++f)
+	{
+		for (unsigned int p = 0; p < n; ++p)
+		{
+			r[p] = samples[f * n + p][0];
+			g[p] = samples[f * n + p][1];
+			b[p] = samples[f * n + p][2];
+		}
+		SH fitted;
+		fitted.fit_to_data(int(n), &x[0], &y[0], &z[0], &r[0], &g[0], &b[0], lambda);
+		for (int i = 0; i < batch.getNbCoefs(); ++i)
+			maxFitError = std::max(maxFitError, (fitted.get_coef_tab()[i] - coefs[f * batch.getNbCoefs() + i]).norm());
+	}
+	if (maxFitError > 1e-6)
+	{
+		CGoGNout << "SH batch fitting FAILED: error " << maxFitError << CGoGNendl;
+		ok = false;
+	}
+
+	// one batch per thread: same values as the sequential evaluation
+	const unsigned int nbThreads = 4;
+	std::vector<SH> functions(64);
+	for (unsigned int f = 0; f < functions.size(); ++f)
+		randomSH(functions[f]);
+	std::vector<double> seq(functions.size() * n);
+	for (unsigned int f = 0; f < functions.size(); ++f)
+		batch.evaluateSquaredNorm(functions[f].get_coef_tab(), &seq[f * n]);
+
+	std::vector<double> par(functions.size() * n);
+	std::function<void(unsigned int)> job = [&] (unsigned int th)
+	{
+		Utils::SphericalHarmonicsBatch<double> local(resolution);
+		local.setDirections(directions);
+		for (unsigned int f = th; f < functions.size(); f += nbThreads)
+			local.evaluateSquaredNorm(functions[f].get_coef_tab(), &par[f * n]);
+	};
+	Utils::ThreadPool::getInstance().run(nbThreads, job);
+	if (par != seq)
+	{
+		CGoGNout << "SH batch evaluation FAILED: parallel result differs" << CGoGNendl;
+		ok = false;
+	}
+
+	if (ok)
+		CGoGNout << "SH batch OK" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Decimation/streamingSimplification.h"
+#include "Algo/Import/import.h"
+#include "Algo/Topo/basic.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+/**
+ * write a torus (quads) as OBJ, OFF (triangles) and binary STL, simplify the three files
+ * and check that the results are the same and close to the torus
+ */
+const float R = 2.0f;
+const float r = 0.7f;
+
+VEC3 torusPoint(int i, int j, int n, int m)
+{
+	float a = float(2.0 * M_PI * i / n);
+	float b = float(2.0 * M_PI * j / m);
+	return VEC3((R + r * std::cos(b)) * std::cos(a), (R + r * std::cos(b)) * std::sin(a), r * std::sin(b));
+}
+
+std::string readFile(const std::string& filename)
+{
+	std::ifstream fs(filename.c_str());
+	std::stringstream ss;
+	ss << fs.rdbuf();
+	return ss.str();
+}
+
+int main()
+{
+	const int n = 300, m = 120;
+	std::vector<VEC3> vertices;
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < m; ++j)
+			vertices.push_back(torusPoint(i, j, n, m));
+	std::vector<unsigned int> quads;
+	for (int i = 0; i < n; ++i)
+		for (int j = 0; j < m; ++j)
+		{
+			quads.push_back(i * m + j);
+			quads.push_back(((i + 1) % n) * m + j);
+			quads.push_back(((i + 1) % n) * m + (j + 1) % m);
+			quads.push_back(i * m + (j + 1) % m);
+		}
+	const unsigned int nbQuads = uint32(quads.size() / 4);
+
+	{
+		std::ofstream obj("streamingSimplification_in.obj");
+		obj << "# torus\n";
+		for (unsigned int i = 0; i < vertices.size(); ++i)
+			obj << "v " << vertices[i][0] << " " << vertices[i][1] << " " << vertices[i][2] << "\n";
+		for (unsigned int q = 0; q < nbQuads; ++q)
+			obj << "f " << quads[4*q] + 1 << "//1 " << quads[4*q+1] + 1 << "//1 " << quads[4*q+2] + 1 << "//1 " << quads[4*q+3] + 1 << "//1\n";
+	}
+	// same vertices as the OBJ file (read back with the same precision)
+	{
+		std::vector<std::string> names;
+		MAP tmp;
+		Algo::Surface::Import::importMesh<PFP>(tmp, "streamingSimplification_in.obj", names);
+		VertexAttribute<VEC3, MAP> pos = tmp.getAttribute<VEC3, VERTEX, MAP>(names[0]);
+		unsigned int k = 0;
+		for (unsigned int i = pos.begin(); i != pos.end(); pos.next(i), ++k)
+			vertices[k] = pos[i];
+	}
+	{
+		std::ofstream off("streamingSimplification_in.off");
+		off << "OFF\n" << vertices.size() << " " << 2 * nbQuads << " 0\n";
+		off.precision(9);
+		for (unsigned int i = 0; i < vertices.size(); ++i)
+			off << vertices[i][0] << " " << vertices[i][1] << " " << vertices[i][2] << "\n";
+		for (unsigned int q = 0; q < nbQuads; ++q)
+		{
+			off << "3 " << quads[4*q] << " " << quads[4*q+1] << " " << quads[4*q+2] << "\n";
+			off << "3 " << quads[4*q] << " " << quads[4*q+2] << " " << quads[4*q+3] << "\n";
+		}
+	}
+	{
+		std::ofstream stl("streamingSimplification_in.stlb", std::ios::out | std::ios::binary);
+		char header[80] = { 0 };
+		stl.write(header, 80);
+		unsigned int nbTriangles = 2 * nbQuads;
+		stl.write(reinterpret_cast<const char*>(&nbTriangles), 4);
+		for (unsigned int q = 0; q < nbQuads; ++q)
+		{
+			for (unsigned int t = 0; t < 2; ++t)
+			{
+				unsigned int tri[3] = { quads[4*q], quads[4*q + 1 + t], quads[4*q + 2 + t] };
+				float data[12] = { 0, 0, 0 };
+				for (unsigned int i = 0; i < 3; ++i)
+					for (unsigned int c = 0; c < 3; ++c)
+						data[3 + 3*i + c] = vertices[tri[i]][c];
+				stl.write(reinterpret_cast<const char*>(data), 48);
+				stl.write(header, 2);
+			}
+		}
+	}
+
+	bool ok = true;
+	const char* inputs[3] = { "streamingSimplification_in.obj", "streamingSimplification_in.off", "streamingSimplification_in.stlb" };
+	const char* outputs[3] = { "streamingSimplification_out0.off", "streamingSimplification_out1.off", "streamingSimplification_out2.off" };
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		if (!Algo::Surface::Decimation::simplifyFile<PFP>(inputs[i], outputs[i], 30))
+		{
+			CGoGNout << "streaming simplification FAILED: " << inputs[i] << " not simplified" << CGoGNendl;
+			ok = false;
+		}
+	}
+	if (ok && (readFile(outputs[0]) != readFile(outputs[1]) || readFile(outputs[0]) != readFile(outputs[2])))
+	{
+		CGoGNout << "streaming simplification FAILED: results depend on the input format" << CGoGNendl;
+		ok = false;
+	}
+
+	if (ok)
+	{
+		MAP myMap;
+		std::vector<std::string> names;
+		Algo::Surface::Import::importMesh<PFP>(myMap, outputs[0], names);
+		VertexAttribute<VEC3, MAP> position = myMap.getAttribute<VEC3, VERTEX, MAP>(names[0]);
+		unsigned int nbVertices = Algo::Topo::getNbOrbits<VERTEX>(myMap);
+
+		// vertices close to the torus (cells are 2 * (R + r) / 30 wide)
+		float maxDist = 0.0f;
+		for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		{
+			const VEC3& p = position[i];
+			float d = std::sqrt(p[0] * p[0] + p[1] * p[1]) - R;
+			maxDist = std::max(maxDist, std::abs(std::sqrt(d * d + p[2] * p[2]) - r));
+		}
+		if (nbVertices == 0 || nbVertices * 10 > vertices.size() || maxDist > 0.05f)
+		{
+			CGoGNout << "streaming simplification FAILED: " << nbVertices << " vertices, distance " << maxDist << CGoGNendl;
+			ok = false;
+		}
+		else
+			CGoGNout << "streaming simplification OK (" << vertices.size() << " -> " << nbVertices << " vertices, distance " << maxDist << ")" << CGoGNendl;
+	}
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		std::remove(inputs[i]);
+		std::remove(outputs[i]);
+	}
+
+	return ok ? 0 : 1;
+}
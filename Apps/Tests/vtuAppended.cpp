@@ -0,0 +1,314 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <zlib.h>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Topology/generic/traversor/traversor3.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Tiling/Volume/cubic.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Algo/Export/exportVTU.h"
+#include "Algo/Export/exportVol.h"
+#include "Utils/chrono.h"
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3: public PFP_STANDARD
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+typedef PFP3::MAP MAP3;
+
+bool lessVec(const VEC3& a, const VEC3& b)
+{
+	return std::lexicographical_compare(&a[0], &a[0] + 3, &b[0], &b[0] + 3);
+}
+
+/**
+ * read an appended array of a VTU file written by exportVTUAppended
+ * (raw encoding, UInt64 headers, optional zlib compression)
+ */
+bool readArray(const std::string& file, const std::string& name, bool compressed, std::string& data)
+{
+	std::size_t pos = file.find("Name=\"" + name + "\"");
+	if (pos == std::string::npos)
+		return false;
+	pos = file.find("offset=\"", pos);
+	std::size_t offset = std::size_t(atol(file.c_str() + pos + 8));
+	std::size_t start = file.find("<AppendedData encoding=\"raw\">\n_");
+	if (start == std::string::npos)
+		return false;
+	const char* ptr = file.data() + start + strlen("<AppendedData encoding=\"raw\">\n_") + offset;
+
+	unsigned long long h[3];
+	memcpy(h, ptr, sizeof(h));
+	if (!compressed)
+	{
+		data.assign(ptr + sizeof(unsigned long long), std::size_t(h[0]));
+		return true;
+	}
+
+	const unsigned long long nbBlocks = h[0];
+	std::vector<unsigned long long> sizes(static_cast<std::size_t>(nbBlocks));
+	memcpy(&sizes[0], ptr + 3 * sizeof(unsigned long long), sizes.size() * sizeof(unsigned long long));
+	const char* src = ptr + (3 + nbBlocks) * sizeof(unsigned long long);
+	data.clear();
+	for (unsigned long long b = 0; b < nbBlocks; ++b)
+	{
+		uLongf size = uLongf((b == nbBlocks - 1 && h[2] != 0) ? h[2] : h[1]);
+		std::string block(size, '\0');
+		if (uncompress(reinterpret_cast<Bytef*>(&block[0]), &size, reinterpret_cast<const Bytef*>(src), uLong(sizes[b])) != Z_OK)
+			return false;
+		data.append(block.data(), size);
+		src += sizes[b];
+	}
+	return true;
+}
+
+/**
+ * export the map and compare the points and cells read back with the map
+ */
+bool check(MAP& map, const VertexAttribute<VEC3, MAP>& position, bool compress)
+{
+	const char* filename = "vtuAppended.vtu";
+	Utils::Chrono chrono;
+	chrono.start();
+	if (!Algo::Surface::Export::exportVTUAppended<PFP>(map, position, filename, compress))
+		return false;
+	CGoGNout << (compress ? "zlib" : "raw") << " export in " << chrono.elapsed() << " ms" << CGoGNendl;
+
+	std::ifstream fs(filename, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << fs.rdbuf();
+	const std::string file = ss.str();
+
+	std::string points, connectivity, offsets, types;
+	if (!readArray(file, "position", compress, points) || !readArray(file, "connectivity", compress, connectivity)
+		|| !readArray(file, "offsets", compress, offsets) || !readArray(file, "types", compress, types))
+	{
+		CGoGNout << "unable to read the arrays" << CGoGNendl;
+		return false;
+	}
+
+	const unsigned int nbVertices = map.getAttributeContainer<VERTEX>().size();
+	if (points.size() != nbVertices * sizeof(VEC3) || file.find("NumberOfPoints=\"" + std::to_string(nbVertices) + "\"") == std::string::npos)
+	{
+		CGoGNout << "wrong number of points" << CGoGNendl;
+		return false;
+	}
+
+	const VEC3* P = reinterpret_cast<const VEC3*>(points.data());
+	const unsigned int* C = reinterpret_cast<const unsigned int*>(connectivity.data());
+	const unsigned long long* O = reinterpret_cast<const unsigned long long*>(offsets.data());
+	unsigned int nbFaces = 0;
+	bool ok = true;
+	foreach_cell<FACE>(map, [&] (Face f)
+	{
+		if (!ok || nbFaces >= types.size() || types[nbFaces] != 5 || O[nbFaces] != 3 * (nbFaces + 1))
+		{
+			ok = false;
+			return;
+		}
+		Dart d = f.dart;
+		for (unsigned int i = 0; i < 3; ++i, d = map.phi1(d))
+		{
+			if (!(P[C[3 * nbFaces + i]] == position[d]))
+				ok = false;
+		}
+		++nbFaces;
+	});
+	if (!ok || nbFaces != types.size() || connectivity.size() != 3 * nbFaces * sizeof(unsigned int))
+	{
+		CGoGNout << "wrong cells" << CGoGNendl;
+		return false;
+	}
+
+	remove(filename);
+	return true;
+}
+
+/**
+ * export the volumes of map (with exportVTUAppended, or with exportMesh which compresses)
+ * and check that the points of each cell read back are the vertices of its volume,
+ * in the order of VTK (positive volume of the first corner)
+ */
+bool checkVolume(MAP3& map, const VertexAttribute<VEC3, MAP3>& position, bool compress)
+{
+	const char* filename = "vtuAppendedVolume.vtu";
+	bool written = compress ? Algo::Volume::Export::exportMesh<PFP3>(map, position, filename)
+		: Algo::Volume::Export::exportVTUAppended<PFP3>(map, position, filename, false);
+	if (!written)
+		return false;
+
+	std::ifstream fs(filename, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << fs.rdbuf();
+	const std::string file = ss.str();
+
+	std::string points, connectivity, offsets, types;
+	if (!readArray(file, "position", compress, points) || !readArray(file, "connectivity", compress, connectivity)
+		|| !readArray(file, "offsets", compress, offsets) || !readArray(file, "types", compress, types))
+	{
+		CGoGNout << "unable to read the arrays of the volume mesh" << CGoGNendl;
+		return false;
+	}
+
+	const VEC3* P = reinterpret_cast<const VEC3*>(points.data());
+	const unsigned int* C = reinterpret_cast<const unsigned int*>(connectivity.data());
+	const unsigned long long* O = reinterpret_cast<const unsigned long long*>(offsets.data());
+	const unsigned int nbPoints = (unsigned int)(points.size() / sizeof(VEC3));
+	unsigned int nbCells = 0;
+	unsigned long long first = 0;
+	bool ok = points.size() == map.getAttributeContainer<VERTEX>().size() * sizeof(VEC3);
+
+	TraversorW<MAP3> trav(map);
+	for (Dart d = trav.begin(); ok && d != trav.end(); d = trav.next(), ++nbCells)
+	{
+		std::vector<VEC3> vertices;
+		Traversor3WV<MAP3> twv(map, d);
+		for (Dart v = twv.begin(); v != twv.end(); v = twv.next())
+			vertices.push_back(position[v]);
+		const unsigned int nb = (unsigned int)(vertices.size());
+
+		if (nbCells >= types.size() || types[nbCells] != ((nb == 8) ? 12 : 10) || O[nbCells] != first + nb
+			|| O[nbCells] * sizeof(unsigned int) > connectivity.size())
+		{
+			ok = false;
+			break;
+		}
+
+		std::vector<VEC3> cell;
+		for (unsigned long long i = first; i < O[nbCells]; ++i)
+		{
+			if (C[i] >= nbPoints)
+				ok = false;
+			else
+				cell.push_back(P[C[i]]);
+		}
+		first = O[nbCells];
+		if (!ok)
+			break;
+
+		// a tetra (0,1,2,3) and a hexa (0,1,3,4) have a positive volume in VTK
+		const VEC3& a = cell[0];
+		const VEC3& b = cell[1];
+		const VEC3& c = (nb == 8) ? cell[3] : cell[2];
+		const VEC3& e = (nb == 8) ? cell[4] : cell[3];
+		if (((b - a) ^ (c - a)) * (e - a) <= 0)
+			ok = false;
+
+		std::sort(vertices.begin(), vertices.end(), lessVec);
+		std::sort(cell.begin(), cell.end(), lessVec);
+		if (cell != vertices)
+			ok = false;
+	}
+	if (!ok || nbCells == 0 || nbCells != types.size() || first * sizeof(unsigned int) != connectivity.size())
+	{
+		CGoGNout << "wrong volume cells" << CGoGNendl;
+		return false;
+	}
+
+	remove(filename);
+	return true;
+}
+
+int main()
+{
+	bool ok = true;
+
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(myMap, 400, 200);
+	tore.embedIntoTore(position, 2.0f, 0.7f);
+
+	// compact vertex container: the blocks of the attribute are written directly
+	ok = check(myMap, position, false) && check(myMap, position, true);
+
+	// holes in the vertex container
+	unsigned int n = 0;
+	std::vector<Dart> toCollapse;
+	foreach_cell<EDGE>(myMap, [&] (Edge e)
+	{
+		if (n++ % 97 == 0)
+			toCollapse.push_back(e.dart);
+	});
+	DartMarker<MAP> dm(myMap);
+	for (Dart d : toCollapse)
+	{
+		if (dm.isMarked(d) || dm.isMarked(myMap.phi2(d)))
+			continue;
+		foreach_incident2<VERTEX>(myMap, Edge(d), [&] (Vertex v) { dm.markOrbit(v); });
+		foreach_incident2<FACE>(myMap, Edge(d), [&] (Face f) { dm.markOrbit(f); });
+		myMap.collapseEdge(d);
+	}
+	if (myMap.getAttributeContainer<VERTEX>().size() == myMap.getAttributeContainer<VERTEX>().realEnd())
+	{
+		CGoGNout << "no hole in the vertex container" << CGoGNendl;
+		ok = false;
+	}
+	ok = ok && check(myMap, position, false) && check(myMap, position, true);
+
+	// hexahedra
+	{
+		MAP3 map3;
+		VertexAttribute<VEC3, MAP3> position3 = map3.addAttribute<VEC3, VERTEX, MAP3>("position");
+		Algo::Volume::Tilings::Cubic::Grid<PFP3> grid(map3, 4, 3, 2);
+		grid.embedIntoGrid(position3, 4.0f, 3.0f, 2.0f);
+		ok = ok && checkVolume(map3, position3, false) && checkVolume(map3, position3, true);
+	}
+
+	// tetrahedra
+	{
+		MAP3 map3;
+		VertexAttribute<VEC3, MAP3> position3 = map3.addAttribute<VEC3, VERTEX, MAP3>("position");
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			Dart d = Algo::Surface::Modelisation::embedPyramid<PFP3>(map3, position3, 3, true, 1.0f, 1.0f + i);
+			foreach_incident3<VERTEX>(map3, Vol(d), [&] (Vertex v) { position3[v] += VEC3(3.0f * i, 0.0f, 0.0f); });
+		}
+		ok = ok && checkVolume(map3, position3, false) && checkVolume(map3, position3, true);
+	}
+
+	if (ok)
+		CGoGNout << "VTU appended export OK" << CGoGNendl;
+	else
+		CGoGNout << "VTU appended export FAILED" << CGoGNendl;
+
+	return ok ? 0 : 1;
+}
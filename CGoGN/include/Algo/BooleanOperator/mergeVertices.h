@@ -29,6 +29,8 @@
 #include "Geometry/inclusion.h"
 #include "Geometry/orientation.h"
 
+#include <vector>
+
 namespace CGoGN
 {
 
@@ -47,9 +49,31 @@ bool isBetween(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 template <typename PFP>
 void mergeVertex(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, Dart d, Dart e, int precision);
 
+/**
+ * Find the pairs of vertices that mergeVertices would merge.
+ * Vertices are bucketed into a uniform grid whose cell size is the isNear tolerance,
+ * sorted by cell, and only the 27 neighbouring cells of each vertex are tested.
+ * The clustering is greedy in traversal order: a vertex absorbs all the not yet absorbed
+ * vertices that are near to it.
+ * @param pairs output (absorbing vertex, absorbed vertex) pairs
+ */
+template <typename PFP>
+void findVerticesToMerge(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision, std::vector<std::pair<Dart, Dart> >& pairs);
+
+/**
+ * Merge all the vertices that are near within precision (see Vector::isNear)
+ * Candidates are found in O(n log n) by findVerticesToMerge, then merged in one batch
+ */
 template <typename PFP>
 void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision);
 
+/**
+ * Former O(n^2) version of mergeVertices (all pairs of vertices are tested)
+ * Kept for comparison purpose
+ */
+template <typename PFP>
+void mergeVerticesNaive(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision);
+
 }
 
 }
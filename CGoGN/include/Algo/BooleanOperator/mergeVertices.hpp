@@ -22,6 +22,9 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+
 namespace CGoGN
 {
 
@@ -75,11 +78,139 @@ void mergeVertex(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typ
 	} while (notempty) ;
 }
 
+/**
+ * entry of the grid used to find the vertices to merge:
+ * integer coordinates of the cell and index of the vertex
+ */
+struct MergeGridEntry
+{
+	long long x, y, z ;
+	unsigned int index ;
+
+	inline bool sameCell(const MergeGridEntry& e) const
+	{
+		return x == e.x && y == e.y && z == e.z ;
+	}
+
+	inline bool operator<(const MergeGridEntry& e) const
+	{
+		if (x != e.x) return x < e.x ;
+		if (y != e.y) return y < e.y ;
+		if (z != e.z) return z < e.z ;
+		return index < e.index ;
+	}
+} ;
+
+template <typename PFP>
+void findVerticesToMerge(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision, std::vector<std::pair<Dart, Dart> >& pairs)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+
+	std::vector<Dart> vertices ;
+	TraversorV<typename PFP::MAP> travV(map) ;
+	for(Dart d = travV.begin() ; d != travV.end() ; d = travV.next())
+		vertices.push_back(d) ;
+
+	const unsigned int nb = vertices.size() ;
+	if (nb < 2)
+		return ;
+
+	VEC3 bbMin = positions[vertices[0]] ;
+	VEC3 bbMax = bbMin ;
+	for (unsigned int i = 1 ; i < nb ; ++i)
+	{
+		const VEC3& p = positions[vertices[i]] ;
+		for (unsigned int k = 0 ; k < 3 ; ++k)
+		{
+			if (p[k] < bbMin[k]) bbMin[k] = p[k] ;
+			if (p[k] > bbMax[k]) bbMax[k] = p[k] ;
+		}
+	}
+
+	// cell size must not be smaller than the isNear tolerance,
+	// so that near vertices always lie in neighbouring cells
+	double cellSize ;
+	if (precision > 0)
+		cellSize = double(precision) ;
+	else if (precision < 0)
+		cellSize = 1.0 / double(-precision) ;
+	else
+	{
+		// exact comparison: any size is valid, choose one that gives about one vertex per cell
+		double extent = 0.0 ;
+		for (unsigned int k = 0 ; k < 3 ; ++k)
+			extent = std::max(extent, double(bbMax[k] - bbMin[k])) ;
+		cellSize = extent / std::cbrt(double(nb)) ;
+		if (!(cellSize > 0.0))
+			cellSize = 1.0 ;
+	}
+
+	std::vector<MergeGridEntry> grid(nb) ;
+	for (unsigned int i = 0 ; i < nb ; ++i)
+	{
+		const VEC3& p = positions[vertices[i]] ;
+		grid[i].x = (long long)(std::floor(double(p[0] - bbMin[0]) / cellSize)) ;
+		grid[i].y = (long long)(std::floor(double(p[1] - bbMin[1]) / cellSize)) ;
+		grid[i].z = (long long)(std::floor(double(p[2] - bbMin[2]) / cellSize)) ;
+		grid[i].index = i ;
+	}
+	std::vector<MergeGridEntry> sorted(grid) ;
+	std::sort(sorted.begin(), sorted.end()) ;
+
+	std::vector<bool> absorbed(nb, false) ;
+	for (unsigned int i = 0 ; i < nb ; ++i)
+	{
+		if (absorbed[i])
+			continue ;
+		absorbed[i] = true ;
+
+		const VEC3& p = positions[vertices[i]] ;
+		for (int dx = -1 ; dx <= 1 ; ++dx)
+		{
+			for (int dy = -1 ; dy <= 1 ; ++dy)
+			{
+				for (int dz = -1 ; dz <= 1 ; ++dz)
+				{
+					MergeGridEntry cell ;
+					cell.x = grid[i].x + dx ;
+					cell.y = grid[i].y + dy ;
+					cell.z = grid[i].z + dz ;
+					cell.index = 0 ;
+
+					std::vector<MergeGridEntry>::const_iterator it = std::lower_bound(sorted.begin(), sorted.end(), cell) ;
+					for ( ; it != sorted.end() && it->sameCell(cell) ; ++it)
+					{
+						unsigned int j = it->index ;
+						if (!absorbed[j] && p.isNear(positions[vertices[j]], precision))
+						{
+							absorbed[j] = true ;
+							pairs.push_back(std::make_pair(vertices[i], vertices[j])) ;
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
 template <typename PFP>
 void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision)
 {
-	// TODO optimiser en triant les sommets
-	// map.template enableQuickTraversal<VERTEX>();
+	std::vector<std::pair<Dart, Dart> > pairs ;
+	findVerticesToMerge<PFP>(map, positions, precision, pairs) ;
+
+	for (std::vector<std::pair<Dart, Dart> >::iterator it = pairs.begin() ; it != pairs.end() ; ++it)
+	{
+		if (map.sameVertex(it->first, it->second))
+			std::cout << "fusion: sameVertex" << std::endl ;
+		else
+			mergeVertex<PFP>(map, positions, it->first, it->second, precision) ;
+	}
+}
+
+template <typename PFP>
+void mergeVerticesNaive(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision)
+{
 	TraversorV<typename PFP::MAP> travV1(map) ;
 	CellMarker<typename PFP::MAP, VERTEX> vM(map);
 	for(Dart d1 = travV1.begin() ; d1 != travV1.end() ; d1 = travV1.next())
@@ -100,7 +231,6 @@ void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, t
 			}
 		}
 	}
-	//	map.template disableQuickTraversal<VERTEX>();
 }
 
 }
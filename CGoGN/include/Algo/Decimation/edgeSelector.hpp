@@ -158,17 +158,15 @@ bool EdgeSelector_Length<PFP>::init()
 		initEdgeInfo(e.dart) ;
 	}
 
-	cur = edges.begin() ; // init the current edge to the first one
-
 	return true ;
 }
 
 template <typename PFP>
 bool EdgeSelector_Length<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -179,26 +177,26 @@ void EdgeSelector_Length<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo* edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-									// from the multimap
+		edges.erase(edgeE->handle) ;
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -229,18 +227,14 @@ void EdgeSelector_Length<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
 void EdgeSelector_Length<PFP>::updateWithoutCollapse()
 {
-	EdgeInfo& einfo = edgeInfo[(*cur).second] ;
+	EdgeInfo& einfo = edgeInfo[edges.top()] ;
 	einfo.valid = false ;
-	edges.erase(einfo.it) ;
-
-	cur = edges.begin();
+	edges.erase(einfo.handle) ;
 }
 
 template <typename PFP>
@@ -263,7 +257,7 @@ void EdgeSelector_Length<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;			// remove the edge from the multimap
+			edges.erase(einfo.handle) ;			// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -280,7 +274,7 @@ void EdgeSelector_Length<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{									// if the edge cannot be collapsed now
 			if(einfo.valid)					// and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -291,7 +285,7 @@ template <typename PFP>
 void EdgeSelector_Length<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 {
 	VEC3 vec = Algo::Geometry::vectorOutOfDart<PFP>(this->m_map, d, position) ;
-	einfo.it = edges.insert(std::make_pair(vec.norm2(), d)) ;
+	einfo.handle = edges.insert(vec.norm2(), d) ;
 	einfo.valid = true ;
 }
 
@@ -334,9 +328,7 @@ bool EdgeSelector_QEM<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -344,9 +336,9 @@ bool EdgeSelector_QEM<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_QEM<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -357,26 +349,26 @@ void EdgeSelector_QEM<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo *edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-									// from the multimap
+		edges.erase(edgeE->handle) ;
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 
 	tmpQ.zero() ;			// compute quadric for the new
@@ -413,19 +405,15 @@ void EdgeSelector_QEM<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
 void EdgeSelector_QEM<PFP>::updateWithoutCollapse()
 {
-	EdgeInfo& einfo = edgeInfo[(*cur).second] ;
+	EdgeInfo& einfo = edgeInfo[edges.top()] ;
 	einfo.valid = false ;
-	edges.erase(einfo.it) ;
+	edges.erase(einfo.handle) ;
 
-	//edges.erase(cur) ;
-	cur = edges.begin();
 }
 
 template <typename PFP>
@@ -450,7 +438,7 @@ void EdgeSelector_QEM<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.handle) ;		// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -467,7 +455,7 @@ void EdgeSelector_QEM<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{								 // if the edge cannot be collapsed now
 			if(einfo.valid)				 // and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -489,7 +477,7 @@ void EdgeSelector_QEM<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 
 	REAL err = quad(m_positionApproximator.getApprox(d)) ;
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -532,9 +520,7 @@ bool EdgeSelector_QEMml<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -542,9 +528,9 @@ bool EdgeSelector_QEMml<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_QEMml<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -555,26 +541,26 @@ void EdgeSelector_QEMml<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo *edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-									// from the multimap
+		edges.erase(edgeE->handle) ;
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -655,18 +641,14 @@ void EdgeSelector_QEMml<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
 void EdgeSelector_QEMml<PFP>::updateWithoutCollapse()
 {
-	EdgeInfo& einfo = edgeInfo[(*cur).second] ;
+	EdgeInfo& einfo = edgeInfo[edges.top()] ;
 	einfo.valid = false ;
-	edges.erase(einfo.it) ;
-
-	cur = edges.begin();
+	edges.erase(einfo.handle) ;
 }
 
 template <typename PFP>
@@ -691,7 +673,7 @@ void EdgeSelector_QEMml<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.handle) ;		// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -708,7 +690,7 @@ void EdgeSelector_QEMml<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{								 // if the edge cannot be collapsed now
 			if(einfo.valid)				 // and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -729,7 +711,7 @@ void EdgeSelector_QEMml<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 	m_positionApproximator.approximate(d) ;
 
 	REAL err = quad(m_positionApproximator.getApprox(d)) ;
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -759,17 +741,15 @@ bool EdgeSelector_NormalArea<PFP>::init()
 		initEdgeInfo(e.dart) ;	// init "edgeInfo" and "edges"
 	}
 
-	cur = edges.begin() ; // init the current edge to the first one
-
 	return true ;
 }
 
 template <typename PFP>
 bool EdgeSelector_NormalArea<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -783,36 +763,36 @@ void EdgeSelector_NormalArea<PFP>::updateBeforeCollapse(Dart d)
 	EdgeInfo* edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
-									// from the multimap
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	edgeE = &(edgeInfo[m.phi1(dd)]) ;
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 
 	edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 }
@@ -829,7 +809,7 @@ void EdgeSelector_NormalArea<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*/)
 		computeEdgeMatrix(dit);
 	}
 
-	// update the multimap
+	// update the queue
 
 	Traversor2VVaE<MAP> tv (m,d2);
 	CellMarkerStore<MAP, EDGE> eMark (m);
@@ -845,8 +825,6 @@ void EdgeSelector_NormalArea<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*/)
 			}
 		}
 	}
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -870,7 +848,7 @@ void EdgeSelector_NormalArea<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if(einfo.valid)
-		edges.erase(einfo.it) ;		// remove the edge from the multimap
+		edges.erase(einfo.handle) ;		// remove the edge from the queue
 
 	if(m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo) ;
@@ -932,7 +910,7 @@ void EdgeSelector_NormalArea<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 //	err /= area*area ; // ca favorise la contraction des gros triangles : maillages très in-homogènes et qualité géométrique mauvaise
 */
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -970,9 +948,7 @@ bool EdgeSelector_Curvature<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -980,9 +956,9 @@ bool EdgeSelector_Curvature<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_Curvature<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -993,26 +969,26 @@ void EdgeSelector_Curvature<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo *edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-									// from the multimap
+		edges.erase(edgeE->handle) ;
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -1050,18 +1026,14 @@ void EdgeSelector_Curvature<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
 void EdgeSelector_Curvature<PFP>::updateWithoutCollapse()
 {
-	EdgeInfo& einfo = edgeInfo[(*cur).second] ;
+	EdgeInfo& einfo = edgeInfo[edges.top()] ;
 	einfo.valid = false ;
-	edges.erase(einfo.it) ;
-
-	cur = edges.begin();
+	edges.erase(einfo.handle) ;
 }
 
 template <typename PFP>
@@ -1086,7 +1058,7 @@ void EdgeSelector_Curvature<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;			// remove the edge from the multimap
+			edges.erase(einfo.handle) ;			// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -1103,7 +1075,7 @@ void EdgeSelector_Curvature<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{									// if the edge cannot be collapsed now
 			if(einfo.valid)					// and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -1156,7 +1128,7 @@ void EdgeSelector_Curvature<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 //	REAL cDir1_deviation_2 = REAL(1) / fabs(cDir1 * Kmax[v2]) ;
 //	err += cDir1_deviation_1 + cDir1_deviation_2 ;
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -1181,9 +1153,7 @@ bool EdgeSelector_CurvatureTensor<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -1191,9 +1161,9 @@ bool EdgeSelector_CurvatureTensor<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_CurvatureTensor<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -1207,36 +1177,36 @@ void EdgeSelector_CurvatureTensor<PFP>::updateBeforeCollapse(Dart d)
 	EdgeInfo* edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
-									// from the multimap
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	edgeE = &(edgeInfo[m.phi1(dd)]) ;
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 
 	edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 	if(edgeE->valid)
 	{
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 		edgeE->valid = false;
 	}
 }
@@ -1262,7 +1232,7 @@ void EdgeSelector_CurvatureTensor<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*
 		}
 	}
 
-	// update the multimap
+	// update the queue
 	Traversor2VVaE<MAP> tv (m,d2);
 	eMark.unmarkAll();
 	for(Dart dit = tv.begin() ; dit != tv.end() ; dit = tv.next())
@@ -1277,8 +1247,6 @@ void EdgeSelector_CurvatureTensor<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*
 			}
 		}
 	}
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -1302,7 +1270,7 @@ void EdgeSelector_CurvatureTensor<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if(einfo.valid)
-		edges.erase(einfo.it) ;		// remove the edge from the multimap
+		edges.erase(einfo.handle) ;		// remove the edge from the queue
 
 	if(m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo) ;
@@ -1365,7 +1333,7 @@ void EdgeSelector_CurvatureTensor<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 //	if (v1 % 5000 == 0) CGoGNout << e_val << CGoGNendl << err << CGoGNendl ;
 
 	// update the priority queue and edgeinfo
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -1393,9 +1361,7 @@ bool EdgeSelector_MinDetail<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -1403,9 +1369,9 @@ bool EdgeSelector_MinDetail<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_MinDetail<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -1416,26 +1382,26 @@ void EdgeSelector_MinDetail<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo *edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-									// from the multimap
+		edges.erase(edgeE->handle) ;
+									// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -1466,18 +1432,14 @@ void EdgeSelector_MinDetail<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
 void EdgeSelector_MinDetail<PFP>::updateWithoutCollapse()
 {
-	EdgeInfo& einfo = edgeInfo[(*cur).second] ;
+	EdgeInfo& einfo = edgeInfo[edges.top()] ;
 	einfo.valid = false ;
-	edges.erase(einfo.it) ;
-
-	cur = edges.begin();
+	edges.erase(einfo.handle) ;
 }
 
 template <typename PFP>
@@ -1500,7 +1462,7 @@ void EdgeSelector_MinDetail<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;			// remove the edge from the multimap
+			edges.erase(einfo.handle) ;			// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -1517,7 +1479,7 @@ void EdgeSelector_MinDetail<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{									// if the edge cannot be collapsed now
 			if(einfo.valid)					// and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -1532,7 +1494,7 @@ void EdgeSelector_MinDetail<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 	m_positionApproximator.approximate(d) ;
 	err = m_positionApproximator.getDetail(d).norm2() ;
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -1581,9 +1543,7 @@ bool EdgeSelector_ColorNaive<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -1591,9 +1551,9 @@ bool EdgeSelector_ColorNaive<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_ColorNaive<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -1604,26 +1564,26 @@ void EdgeSelector_ColorNaive<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo *edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)						// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the edges that will disappear
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-										// from the multimap
+		edges.erase(edgeE->handle) ;
+										// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -1676,8 +1636,6 @@ void EdgeSelector_ColorNaive<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -1702,7 +1660,7 @@ void EdgeSelector_ColorNaive<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.handle) ;		// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -1719,7 +1677,7 @@ void EdgeSelector_ColorNaive<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{								 // if the edge cannot be collapsed now
 			if(einfo.valid)				 // and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -1757,7 +1715,7 @@ void EdgeSelector_ColorNaive<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 	// sum of QEM metric and squared difference between new color and old colors
 	REAL err = quad(newPos) + colDiff.norm() ;
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -1806,9 +1764,7 @@ bool EdgeSelector_GeomColOptGradient<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -1816,9 +1772,9 @@ bool EdgeSelector_GeomColOptGradient<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_GeomColOptGradient<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -1830,7 +1786,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateBeforeCollapse(Dart d)
 	const Dart& v0 = d ;
 	const Dart& v1 = m.phi2(d) ;
 
-	// remove all the edges that will disappear from the multimap
+	// remove all the edges that will disappear from the queue
 	// namely : all edges adjacent to a vertex which is adjacent
 	// to either v0 or v1
 
@@ -1869,7 +1825,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateBeforeCollapse(Dart d)
 			{
 				if(edgeInfo[e].valid)
 				{
-					edges.erase(edgeInfo[e].it) ;
+					edges.erase(edgeInfo[e].handle) ;
 					edgeInfo[e].valid = false ;
 				}
 
@@ -1909,7 +1865,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateAfterCollapse(Dart d2, Dart /*d
 	// update quadrics
 	recomputeQuadric(d2, true) ;
 
-	// update the multimap
+	// update the queue
 	Traversor2VVaE<MAP> tv(m, d2);
 	CellMarkerStore<MAP, EDGE> eMark(m);
 	for(Dart dit = tv.begin() ; dit != tv.end() ; dit = tv.next())
@@ -1924,8 +1880,6 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateAfterCollapse(Dart d2, Dart /*d
 			}
 		}
 	}
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -1949,7 +1903,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if(einfo.valid)
-		edges.erase(einfo.it) ;		// remove the edge from the multimap
+		edges.erase(einfo.handle) ;		// remove the edge from the queue
 
 	if(m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo) ;
@@ -1984,7 +1938,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::computeEdgeInfo(Dart d, EdgeInfo& ein
 		t * quad(newPos) +
 		(1-t) * (computeEdgeGradientColorError(d, newPos, newCol) + computeEdgeGradientColorError(m.phi2(d), newPos, newCol)).norm() / REAL(sqrt(3.0)) ;
 
-	einfo.it = edges.insert(std::make_pair(err, d)) ;
+	einfo.handle = edges.insert(err, d) ;
 	einfo.valid = true ;
 }
 
@@ -2100,9 +2054,7 @@ bool EdgeSelector_QEMextColor<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; // init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -2110,9 +2062,9 @@ bool EdgeSelector_QEMextColor<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_QEMextColor<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -2123,26 +2075,26 @@ void EdgeSelector_QEMextColor<PFP>::updateBeforeCollapse(Dart d)
 
 	EdgeInfo *edgeE = &(edgeInfo[d]) ;
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)					// remove all
-		edges.erase(edgeE->it) ;
+		edges.erase(edgeE->handle) ;
 
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the edges that will disappear
 	if(edgeE->valid)
-		edges.erase(edgeE->it) ;
-										// from the multimap
+		edges.erase(edgeE->handle) ;
+										// from the queue
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
 		edgeE = &(edgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 
 		edgeE = &(edgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			edges.erase(edgeE->it) ;
+			edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -2207,8 +2159,6 @@ void EdgeSelector_QEMextColor<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -2233,7 +2183,7 @@ void EdgeSelector_QEMextColor<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.handle) ;		// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -2250,7 +2200,7 @@ void EdgeSelector_QEMextColor<PFP>::updateEdgeInfo(Dart d, bool recompute)
 		{								 // if the edge cannot be collapsed now
 			if(einfo.valid)				 // and it was before
 			{
-				edges.erase(einfo.it) ;
+				edges.erase(einfo.handle) ;
 				einfo.valid = false ;
 			}
 		}
@@ -2293,7 +2243,7 @@ void EdgeSelector_QEMextColor<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 		einfo.valid = false ;
 	else
 	{
-		einfo.it = edges.insert(std::make_pair(std::max(err,REAL(0)), d)) ;
+		einfo.handle = edges.insert(std::max(err,REAL(0)), d) ;
 		einfo.valid = true ;
 	}
 }
@@ -67,15 +67,13 @@ bool HalfEdgeSelector_QEMml<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init queue for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
-
-	cur = halfEdges.begin() ; 	// init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -83,9 +81,9 @@ bool HalfEdgeSelector_QEMml<PFP>::init()
 template <typename PFP>
 bool HalfEdgeSelector_QEMml<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == halfEdges.end() || halfEdges.empty())
+	if(halfEdges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = halfEdges.top() ;
 	return true ;
 }
 
@@ -96,31 +94,31 @@ void HalfEdgeSelector_QEMml<PFP>::updateBeforeCollapse(Dart d)
 
 	HalfEdgeInfo* edgeE = &(halfEdgeInfo[d]) ;
 	if(edgeE->valid)
-		halfEdges.erase(edgeE->it) ;
+		halfEdges.erase(edgeE->handle) ;
 
 	edgeE = &(halfEdgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)						// remove all
-		halfEdges.erase(edgeE->it) ;
+		halfEdges.erase(edgeE->handle) ;
 
 	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 	if(edgeE->valid)
-		halfEdges.erase(edgeE->it) ;
-										// from the multimap
+		halfEdges.erase(edgeE->handle) ;
+										// from the queue
 	Dart dd = m.phi2(d) ;
 	assert(dd != d) ;
 	if(dd != d)
 	{
 		edgeE = &(halfEdgeInfo[dd]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 
 		edgeE = &(halfEdgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 
 		edgeE = &(halfEdgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 	}
 }
 
@@ -184,8 +182,6 @@ void HalfEdgeSelector_QEMml<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*/)
 		} while (stop != vit2) ;
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = halfEdges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -209,7 +205,7 @@ void HalfEdgeSelector_QEMml<PFP>::updateHalfEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(heinfo.valid)
-			halfEdges.erase(heinfo.it) ;			// remove the edge from the multimap
+			halfEdges.erase(heinfo.handle) ;			// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo) ;
 		else
@@ -226,7 +222,7 @@ void HalfEdgeSelector_QEMml<PFP>::updateHalfEdgeInfo(Dart d, bool recompute)
 		{								 // if the edge cannot be collapsed now
 			if(heinfo.valid)				 // and it was before
 			{
-				halfEdges.erase(heinfo.it) ;
+				halfEdges.erase(heinfo.handle) ;
 				heinfo.valid = false ;
 			}
 		}
@@ -246,7 +242,7 @@ void HalfEdgeSelector_QEMml<PFP>::computeHalfEdgeInfo(Dart d, HalfEdgeInfo& hein
 	m_positionApproximator.approximate(d) ;
 
 	REAL err = quad(m_positionApproximator.getApprox(d)) ;
-	heinfo.it = halfEdges.insert(std::make_pair(err, d)) ;
+	heinfo.handle = halfEdges.insert(err, d) ;
 	heinfo.valid = true ;
 }
 
@@ -303,15 +299,13 @@ bool HalfEdgeSelector_QEMextColor<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init queue for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
-
-	cur = halfEdges.begin() ; 	// init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -319,9 +313,9 @@ bool HalfEdgeSelector_QEMextColor<PFP>::init()
 template <typename PFP>
 bool HalfEdgeSelector_QEMextColor<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == halfEdges.end() || halfEdges.empty())
+	if(halfEdges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = halfEdges.top() ;
 	return true ;
 }
 
@@ -332,31 +326,31 @@ void HalfEdgeSelector_QEMextColor<PFP>::updateBeforeCollapse(Dart d)
 
 	HalfEdgeInfo* edgeE = &(halfEdgeInfo[d]) ;
 	if(edgeE->valid)
-		halfEdges.erase(edgeE->it) ;
+		halfEdges.erase(edgeE->handle) ;
 
 	edgeE = &(halfEdgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)						// remove all
-		halfEdges.erase(edgeE->it) ;
+		halfEdges.erase(edgeE->handle) ;
 
 	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 	if(edgeE->valid)
-		halfEdges.erase(edgeE->it) ;
-										// from the multimap
+		halfEdges.erase(edgeE->handle) ;
+										// from the queue
 	Dart dd = m.phi2(d) ;
 	assert(dd != d) ;
 	if(dd != d)
 	{
 		edgeE = &(halfEdgeInfo[dd]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 
 		edgeE = &(halfEdgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 
 		edgeE = &(halfEdgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 	}
 }
 
@@ -432,8 +426,6 @@ void HalfEdgeSelector_QEMextColor<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*
 		} while (stop != vit2) ;
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = halfEdges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -457,7 +449,7 @@ void HalfEdgeSelector_QEMextColor<PFP>::updateHalfEdgeInfo(Dart d, bool recomput
 	if(recompute)
 	{
 		if(heinfo.valid)
-			halfEdges.erase(heinfo.it) ;			// remove the edge from the multimap
+			halfEdges.erase(heinfo.handle) ;			// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo) ;
 		else
@@ -474,7 +466,7 @@ void HalfEdgeSelector_QEMextColor<PFP>::updateHalfEdgeInfo(Dart d, bool recomput
 		{								 // if the edge cannot be collapsed now
 			if(heinfo.valid)				 // and it was before
 			{
-				halfEdges.erase(heinfo.it) ;
+				halfEdges.erase(heinfo.handle) ;
 				heinfo.valid = false ;
 			}
 		}
@@ -517,7 +509,7 @@ void HalfEdgeSelector_QEMextColor<PFP>::computeHalfEdgeInfo(Dart d, HalfEdgeInfo
 		heinfo.valid = false ;
 	else
 	{
-		heinfo.it = this->halfEdges.insert(std::make_pair(std::max(err,REAL(0)), d)) ;
+		heinfo.handle = this->halfEdges.insert(std::max(err,REAL(0)), d) ;
 		heinfo.valid = true ;
 	}
 }
@@ -586,15 +578,13 @@ bool HalfEdgeSelector_QEMextColorNormal<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init queue for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
-
-	cur = halfEdges.begin() ; 	// init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -602,9 +592,9 @@ bool HalfEdgeSelector_QEMextColorNormal<PFP>::init()
 template <typename PFP>
 bool HalfEdgeSelector_QEMextColorNormal<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == halfEdges.end() || halfEdges.empty())
+	if(halfEdges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = halfEdges.top() ;
 	return true ;
 }
 
@@ -615,31 +605,31 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::updateBeforeCollapse(Dart d)
 
 	HalfEdgeInfo* edgeE = &(halfEdgeInfo[d]) ;
 	if(edgeE->valid)
-		halfEdges.erase(edgeE->it) ;
+		halfEdges.erase(edgeE->handle) ;
 
 	edgeE = &(halfEdgeInfo[m.phi1(d)]) ;
 	if(edgeE->valid)						// remove all
-		halfEdges.erase(edgeE->it) ;
+		halfEdges.erase(edgeE->handle) ;
 
 	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 	if(edgeE->valid)
-		halfEdges.erase(edgeE->it) ;
-										// from the multimap
+		halfEdges.erase(edgeE->handle) ;
+										// from the queue
 	Dart dd = m.phi2(d) ;
 	assert(dd != d) ;
 	if(dd != d)
 	{
 		edgeE = &(halfEdgeInfo[dd]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 
 		edgeE = &(halfEdgeInfo[m.phi1(dd)]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 
 		edgeE = &(halfEdgeInfo[m.phi_1(dd)]) ;
 		if(edgeE->valid)
-			halfEdges.erase(edgeE->it) ;
+			halfEdges.erase(edgeE->handle) ;
 	}
 }
 
@@ -718,8 +708,6 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::updateAfterCollapse(Dart d2, Dart
 		} while (stop != vit2) ;
 		vit = m.phi2_1(vit) ;
 	} while(vit != d2) ;
-
-	cur = halfEdges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -743,7 +731,7 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::updateHalfEdgeInfo(Dart d, bool re
 	if(recompute)
 	{
 		if(heinfo.valid)
-			halfEdges.erase(heinfo.it) ;			// remove the edge from the multimap
+			halfEdges.erase(heinfo.handle) ;			// remove the edge from the queue
 		if(m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo) ;
 		else
@@ -760,7 +748,7 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::updateHalfEdgeInfo(Dart d, bool re
 		{								 // if the edge cannot be collapsed now
 			if(heinfo.valid)				 // and it was before
 			{
-				halfEdges.erase(heinfo.it) ;
+				halfEdges.erase(heinfo.handle) ;
 				heinfo.valid = false ;
 			}
 		}
@@ -806,7 +794,7 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::computeHalfEdgeInfo(Dart d, HalfEd
 		heinfo.valid = false ;
 	else
 	{
-		heinfo.it = this->halfEdges.insert(std::make_pair(std::max(err,REAL(0)), d)) ;
+		heinfo.handle = this->halfEdges.insert(std::max(err,REAL(0)), d) ;
 		heinfo.valid = true ;
 	}
 }
@@ -855,15 +843,13 @@ bool HalfEdgeSelector_ColorGradient<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init queue for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
-
-	cur = halfEdges.begin() ; 	// init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -871,9 +857,9 @@ bool HalfEdgeSelector_ColorGradient<PFP>::init()
 template <typename PFP>
 bool HalfEdgeSelector_ColorGradient<PFP>::nextEdge(Dart& d) const
 {
-	if(cur == halfEdges.end() || halfEdges.empty())
+	if(halfEdges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = halfEdges.top() ;
 	return true ;
 }
 
@@ -894,45 +880,45 @@ void HalfEdgeSelector_ColorGradient<PFP>::updateBeforeCollapse(Dart d)
 			if(edgeE->valid)
 			{
 				edgeE->valid = false ;
-				halfEdges.erase(edgeE->it) ;
+				halfEdges.erase(edgeE->handle) ;
 			}
 			Dart de = m.phi2(he) ;
 			edgeE = &(halfEdgeInfo[de]) ;
 			if(edgeE->valid)
 			{
 				edgeE->valid = false ;
-				halfEdges.erase(edgeE->it) ;
+				halfEdges.erase(edgeE->handle) ;
 			}
 		}
 	}
 
 //	HalfEdgeInfo* edgeE = &(halfEdgeInfo[d]) ;
 //	if(edgeE->valid)
-//		halfEdges.erase(edgeE->it) ;
+//		halfEdges.erase(edgeE->handle) ;
 //
 //	edgeE = &(halfEdgeInfo[m.phi1(d)]) ;
 //	if(edgeE->valid)						// remove all
-//		halfEdges.erase(edgeE->it) ;
+//		halfEdges.erase(edgeE->handle) ;
 //
 //	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 //	if(edgeE->valid)
-//		halfEdges.erase(edgeE->it) ;
-//										// from the multimap
+//		halfEdges.erase(edgeE->handle) ;
+//										// from the queue
 //	Dart dd = m.phi2(d) ;
 //	assert(dd != d) ;
 //	if(dd != d)
 //	{
 //		edgeE = &(halfEdgeInfo[dd]) ;
 //		if(edgeE->valid)
-//			halfEdges.erase(edgeE->it) ;
+//			halfEdges.erase(edgeE->handle) ;
 //
 //		edgeE = &(halfEdgeInfo[m.phi1(dd)]) ;
 //		if(edgeE->valid)
-//			halfEdges.erase(edgeE->it) ;
+//			halfEdges.erase(edgeE->handle) ;
 //
 //		edgeE = &(halfEdgeInfo[m.phi_1(dd)]) ;
 //		if(edgeE->valid)
-//			halfEdges.erase(edgeE->it) ;
+//			halfEdges.erase(edgeE->handle) ;
 //	}
 }
 
@@ -972,8 +958,6 @@ void HalfEdgeSelector_ColorGradient<PFP>::updateAfterCollapse(Dart d2, Dart /*dd
 			updateHalfEdgeInfo(m.phi2(e)) ;
 		}
 	}
-
-	cur = halfEdges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -1047,7 +1031,7 @@ void HalfEdgeSelector_ColorGradient<PFP>::computeHalfEdgeInfo(Dart d, HalfEdgeIn
 		heinfo.valid = false ;
 	else
 	{
-		heinfo.it = this->halfEdges.insert(std::make_pair(std::max(err,REAL(0)), d)) ;
+		heinfo.handle = this->halfEdges.insert(std::max(err,REAL(0)), d) ;
 		heinfo.valid = true ;
 	}
 }
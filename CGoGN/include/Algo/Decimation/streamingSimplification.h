@@ -0,0 +1,166 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __STREAMING_SIMPLIFICATION_H__
+#define __STREAMING_SIMPLIFICATION_H__
+
+#include "Geometry/bounding_box.h"
+#include "Utils/qem.h"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Decimation
+{
+
+/*!
+ * \class VertexClustering
+ * \brief Simplification of a stream of triangles by clustering of the vertices
+ * in a regular grid (out-of-core simplification of [Lindstrom 2000]):
+ * each triangle adds its (area weighted) plane quadric to the cells of its vertices
+ * and is kept if its vertices lie in three different cells. Each occupied cell gives
+ * one vertex placed at the minimum of its quadric.
+ * The memory used depends on the size of the result, not on the number of triangles,
+ * and the triangles can be given in any order.
+ */
+template <typename PFP>
+class VertexClustering
+{
+public:
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	struct Cell
+	{
+		Utils::Quadric<REAL> quadric ;
+		VEC3 sum ;
+		unsigned int nb ;
+		Cell() : sum(0, 0, 0), nb(0) {}
+	} ;
+
+	struct Triangle
+	{
+		unsigned int v[3] ;
+	} ;
+
+	// triangles are equal if they have the same vertices (the orientation of the first one is kept)
+	struct TriangleHash
+	{
+		std::size_t operator()(const Triangle& t) const
+		{
+			unsigned long long a = std::min(std::min(t.v[0], t.v[1]), t.v[2]) ;
+			unsigned long long b = std::max(std::max(t.v[0], t.v[1]), t.v[2]) ;
+			unsigned long long c = (unsigned long long)(t.v[0]) + t.v[1] + t.v[2] - a - b ;
+			return std::size_t((a * 0x9E3779B97F4A7C15ULL) ^ (b * 0xC2B2AE3D27D4EB4FULL) ^ (c * 0x165667B19E3779F9ULL)) ;
+		}
+	} ;
+
+	struct TriangleEqual
+	{
+		bool operator()(const Triangle& t, const Triangle& u) const
+		{
+			unsigned int s[3] = { t.v[0], t.v[1], t.v[2] } ;
+			unsigned int r[3] = { u.v[0], u.v[1], u.v[2] } ;
+			std::sort(s, s + 3) ;
+			std::sort(r, r + 3) ;
+			return s[0] == r[0] && s[1] == r[1] && s[2] == r[2] ;
+		}
+	} ;
+
+	VEC3 m_origin ;
+	REAL m_cellSize ;
+	unsigned int m_res[3] ;
+
+	std::unordered_map<unsigned long long, unsigned int> m_cellIndex ;
+	std::vector<Cell> m_cells ;
+	std::unordered_set<Triangle, TriangleHash, TriangleEqual> m_triangles ;
+
+	unsigned long long m_nbInputTriangles ;
+
+	unsigned int cellOf(const VEC3& p) ;
+
+public:
+	/**
+	 * @param bb bounding box of the vertices of the mesh
+	 * @param resolution number of cells along the largest side of the box
+	 */
+	VertexClustering(const Geom::BoundingBox<VEC3>& bb, unsigned int resolution) ;
+
+	void addTriangle(const VEC3& a, const VEC3& b, const VEC3& c) ;
+
+	unsigned long long getNbInputTriangles() const { return m_nbInputTriangles ; }
+
+	unsigned int getNbCells() const { return (unsigned int)(m_cells.size()) ; }
+
+	unsigned int getNbTriangles() const { return (unsigned int)(m_triangles.size()) ; }
+
+	/**
+	 * compute the simplified mesh
+	 * @param positions (out) one vertex per occupied cell
+	 * @param triangles (out) indices in positions of the vertices of the triangles (3 per triangle)
+	 */
+	void getMesh(std::vector<VEC3>& positions, std::vector<unsigned int>& triangles) const ;
+} ;
+
+/**
+ * \fn simplifyFile
+ * Simplifies a mesh file (OFF or OBJ) by vertex clustering without loading it in a map:
+ * the file is mapped in memory and read twice (the positions are stored in a temporary
+ * file next to the output one), only the simplified mesh is built in a map and exported
+ * (OFF, OBJ or PLY, according to the extension of outputFile).
+ * Polygons are split in triangle fans.
+ *
+ * \param inputFile the mesh to simplify
+ * \param outputFile the simplified mesh
+ * \param resolution number of cells of the clustering grid along the largest side of the bounding box
+ *
+ * \return true if the input could be read and the output written
+ */
+template <typename PFP>
+bool simplifyFile(const std::string& inputFile, const std::string& outputFile, unsigned int resolution) ;
+
+} // namespace Decimation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Decimation/streamingSimplification.hpp"
+
+#endif
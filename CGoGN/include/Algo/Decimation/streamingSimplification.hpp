@@ -0,0 +1,387 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Utils/mappedFile.h"
+#include "Utils/textParser.h"
+#include "Algo/Import/import.h"
+#include "Algo/Import/importFileTypes.h"
+#include "Algo/Export/export.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Decimation
+{
+
+template <typename PFP>
+VertexClustering<PFP>::VertexClustering(const Geom::BoundingBox<VEC3>& bb, unsigned int resolution) :
+	m_nbInputTriangles(0)
+{
+	if (resolution == 0)
+		resolution = 1 ;
+	// cells slightly larger than needed: the max of the box is inside the grid
+	m_cellSize = bb.maxSize() * REAL(1.0001) / REAL(resolution) ;
+	if (!(m_cellSize > REAL(0)))
+		m_cellSize = REAL(1) ;
+	m_origin = bb.min() ;
+	for (unsigned int i = 0; i < 3; ++i)
+		m_res[i] = std::max(1u, std::min(resolution, (unsigned int)(std::ceil(bb.size(i) / m_cellSize)))) ;
+}
+
+template <typename PFP>
+unsigned int VertexClustering<PFP>::cellOf(const VEC3& p)
+{
+	unsigned long long key = 0 ;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		REAL x = std::floor((p[i] - m_origin[i]) / m_cellSize) ;
+		unsigned int c = (x < REAL(0)) ? 0 : std::min((unsigned int)(x), m_res[i] - 1) ;
+		key = key * m_res[i] + c ;
+	}
+
+	std::pair<std::unordered_map<unsigned long long, unsigned int>::iterator, bool> ins = m_cellIndex.insert(std::make_pair(key, (unsigned int)(m_cells.size()))) ;
+	if (ins.second)
+		m_cells.push_back(Cell()) ;
+	return ins.first->second ;
+}
+
+template <typename PFP>
+void VertexClustering<PFP>::addTriangle(const VEC3& a, const VEC3& b, const VEC3& c)
+{
+	++m_nbInputTriangles ;
+
+	Triangle t ;
+	t.v[0] = cellOf(a) ;
+	t.v[1] = cellOf(b) ;
+	t.v[2] = cellOf(c) ;
+
+	const VEC3* p[3] = { &a, &b, &c } ;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		m_cells[t.v[i]].sum += *(p[i]) ;
+		++m_cells[t.v[i]].nb ;
+	}
+
+	REAL area = ((b - a) ^ (c - a)).norm() / REAL(2) ;
+	if (area > REAL(0))
+	{
+		Utils::Quadric<REAL> q(a, b, c) ;
+		q *= area ;
+		for (unsigned int i = 0; i < 3; ++i)
+			m_cells[t.v[i]].quadric += q ;
+	}
+
+	if (t.v[0] != t.v[1] && t.v[1] != t.v[2] && t.v[2] != t.v[0])
+		m_triangles.insert(t) ;
+}
+
+template <typename PFP>
+void VertexClustering<PFP>::getMesh(std::vector<VEC3>& positions, std::vector<unsigned int>& triangles) const
+{
+	// only the cells used by the kept triangles give a vertex
+	std::vector<unsigned int> newIndex(m_cells.size(), 0xffffffff) ;
+	positions.clear() ;
+	triangles.clear() ;
+	triangles.reserve(3 * m_triangles.size()) ;
+
+	for (typename std::unordered_set<Triangle, TriangleHash, TriangleEqual>::const_iterator it = m_triangles.begin(); it != m_triangles.end(); ++it)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			unsigned int c = it->v[i] ;
+			if (newIndex[c] == 0xffffffff)
+			{
+				newIndex[c] = (unsigned int)(positions.size()) ;
+
+				// minimum of the quadric if it is close to the cell, mean of the vertices otherwise
+				const Cell& cell = m_cells[c] ;
+				VEC3 mean = cell.sum / REAL(cell.nb) ;
+				VEC3 p ;
+				Utils::Quadric<REAL> q ;
+				q += cell.quadric ;
+				if (!q.findOptimizedPos(p) || (p - mean).norm() > m_cellSize)
+					p = mean ;
+				positions.push_back(p) ;
+			}
+			triangles.push_back(newIndex[c]) ;
+		}
+	}
+}
+
+namespace StreamingSimplification
+{
+
+/**
+ * read the vertices and faces of an OFF or OBJ text
+ * vertexFunc(VEC3) is called for each vertex, faceFunc(indices) for each face
+ * (with indices from 0, faces are not read if readFaces is false)
+ */
+template <typename VEC3, typename VFUNC, typename FFUNC>
+bool readText(const char* p, const char* end, bool obj, bool readFaces, VFUNC vertexFunc, FFUNC faceFunc)
+{
+	using namespace Utils::TextParser ;
+
+	std::vector<unsigned int> indices ;
+	double x[3] ;
+	long long idx ;
+
+	if (obj)
+	{
+		unsigned int nbVertices = 0 ;
+		while (p < end)
+		{
+			skipSpaces(p, end) ;
+			if (p + 1 < end && p[0] == 'v' && isSpace(p[1]))
+			{
+				++p ;
+				for (unsigned int i = 0; i < 3; ++i)
+				{
+					if (!parseFloat(p, end, x[i]))
+						return false ;
+				}
+				vertexFunc(VEC3(x[0], x[1], x[2])) ;
+				++nbVertices ;
+			}
+			else if (readFaces && p + 1 < end && p[0] == 'f' && isSpace(p[1]))
+			{
+				++p ;
+				indices.clear() ;
+				while (parseInt(p, end, idx))
+				{
+					if (idx < 0)
+						idx += nbVertices ;
+					else
+						--idx ;
+					if (idx < 0)
+						return false ;
+					indices.push_back((unsigned int)(idx)) ;
+					skipToken(p, end) ; // texture and normal indices
+				}
+				if (indices.size() >= 3)
+					faceFunc(indices) ;
+			}
+			nextLine(p, end) ;
+		}
+		return true ;
+	}
+
+	// OFF: header, sizes (comment lines may appear before the sizes)
+	skipSpaces(p, end) ;
+	if (end - p < 3 || std::strncmp(p, "OFF", 3) != 0)
+		return false ;
+	nextLine(p, end) ;
+	long long nb[3] ;
+	while (p < end)
+	{
+		skipSpaces(p, end) ;
+		if (*p != '#' && *p != '\n')
+			break ;
+		nextLine(p, end) ;
+	}
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		if (!parseInt(p, end, nb[i]))
+			return false ;
+	}
+	nextLine(p, end) ;
+
+	for (long long v = 0; v < nb[0]; ++v)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			if (!parseFloat(p, end, x[i]))
+				return false ;
+		}
+		vertexFunc(VEC3(x[0], x[1], x[2])) ;
+		nextLine(p, end) ;
+	}
+
+	if (!readFaces)
+		return true ;
+
+	for (long long f = 0; f < nb[1]; ++f)
+	{
+		long long n ;
+		if (!parseInt(p, end, n))
+			return false ;
+		indices.clear() ;
+		for (long long i = 0; i < n; ++i)
+		{
+			if (!parseInt(p, end, idx) || idx < 0)
+				return false ;
+			indices.push_back((unsigned int)(idx)) ;
+		}
+		if (indices.size() >= 3)
+			faceFunc(indices) ;
+		nextLine(p, end) ;
+	}
+	return true ;
+}
+
+} // namespace StreamingSimplification
+
+template <typename PFP>
+bool simplifyFile(const std::string& inputFile, const std::string& outputFile, unsigned int resolution)
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+
+	const Import::ImportType type = Import::getFileType(inputFile) ;
+	if (type != Import::OFF && type != Import::OBJ && type != Import::STLB)
+	{
+		CGoGNerr << "simplifyFile: " << inputFile << " is not an OFF, OBJ or binary STL file" << CGoGNendl ;
+		return false ;
+	}
+
+	Utils::MappedFile input ;
+	if (!input.open(inputFile))
+	{
+		CGoGNerr << "simplifyFile: unable to open " << inputFile << CGoGNendl ;
+		return false ;
+	}
+	const char* begin = input.data() ;
+	const char* end = begin + input.size() ;
+
+	Geom::BoundingBox<VEC3> bb ;
+	std::vector<VEC3> result ;
+	std::vector<unsigned int> triangles ;
+
+	if (type == Import::STLB)
+	{
+		// triangle soup: 80 bytes header, number of triangles, then 50 bytes per triangle
+		unsigned int nbTriangles = 0 ;
+		if (input.size() >= 84)
+			memcpy(&nbTriangles, begin + 80, sizeof(unsigned int)) ;
+		if (input.size() < 84 + std::size_t(nbTriangles) * 50)
+		{
+			CGoGNerr << "simplifyFile: " << inputFile << " is too short" << CGoGNendl ;
+			return false ;
+		}
+		auto vertexOf = [&] (unsigned int t, unsigned int i)
+		{
+			float c[3] ;
+			memcpy(c, begin + 84 + std::size_t(t) * 50 + 12 * (i + 1), 3 * sizeof(float)) ;
+			return VEC3(c[0], c[1], c[2]) ;
+		} ;
+		for (unsigned int t = 0; t < nbTriangles; ++t)
+			for (unsigned int i = 0; i < 3; ++i)
+				bb.addPoint(vertexOf(t, i)) ;
+		if (!bb.isInitialized())
+			return false ;
+
+		VertexClustering<PFP> clustering(bb, resolution) ;
+		for (unsigned int t = 0; t < nbTriangles; ++t)
+			clustering.addTriangle(vertexOf(t, 0), vertexOf(t, 1), vertexOf(t, 2)) ;
+		clustering.getMesh(result, triangles) ;
+	}
+	else
+	{
+		// first pass: positions written in a temporary file (mapped for the second pass)
+		const std::string tmpFile = outputFile + ".positions.tmp" ;
+		std::ofstream tmp(tmpFile.c_str(), std::ios::out | std::ios::binary) ;
+		unsigned int nbVertices = 0 ;
+		bool ok = StreamingSimplification::readText<VEC3>(begin, end, type == Import::OBJ, false,
+			[&] (const VEC3& p) { bb.addPoint(p) ; tmp.write(reinterpret_cast<const char*>(&p), sizeof(VEC3)) ; ++nbVertices ; },
+			[] (const std::vector<unsigned int>&) {}) ;
+		tmp.close() ;
+
+		Utils::MappedFile positionFile ;
+		if (!ok || !tmp || nbVertices == 0 || !positionFile.open(tmpFile))
+		{
+			CGoGNerr << "simplifyFile: unable to read the vertices of " << inputFile << CGoGNendl ;
+			std::remove(tmpFile.c_str()) ;
+			return false ;
+		}
+		const VEC3* positions = reinterpret_cast<const VEC3*>(positionFile.data()) ;
+
+		// second pass: faces split in triangle fans
+		VertexClustering<PFP> clustering(bb, resolution) ;
+		bool badIndex = false ;
+		ok = StreamingSimplification::readText<VEC3>(begin, end, type == Import::OBJ, true,
+			[] (const VEC3&) {},
+			[&] (const std::vector<unsigned int>& indices)
+			{
+				for (unsigned int i = 0; i < indices.size(); ++i)
+				{
+					if (indices[i] >= nbVertices)
+					{
+						badIndex = true ;
+						return ;
+					}
+				}
+				for (unsigned int i = 1; i + 1 < indices.size(); ++i)
+					clustering.addTriangle(positions[indices[0]], positions[indices[i]], positions[indices[i + 1]]) ;
+			}) ;
+
+		positionFile.close() ;
+		std::remove(tmpFile.c_str()) ;
+		if (!ok || badIndex)
+		{
+			CGoGNerr << "simplifyFile: unable to read the faces of " << inputFile << CGoGNendl ;
+			return false ;
+		}
+		clustering.getMesh(result, triangles) ;
+	}
+	input.close() ;
+
+	// the simplified mesh is small enough to be built in a map and exported
+	MAP map ;
+	std::vector<std::string> attrNames ;
+	if (!Import::importTriangles<PFP>(map, result, triangles, attrNames))
+		return false ;
+	VertexAttribute<VEC3, MAP> position = map.template getAttribute<VEC3, VERTEX, MAP>(attrNames[0]) ;
+
+	switch (Import::getFileType(outputFile))
+	{
+		case Import::OFF :
+			return Export::exportOFF<PFP>(map, position, outputFile.c_str()) ;
+		case Import::OBJ :
+			return Export::exportOBJ<PFP>(map, position, outputFile.c_str()) ;
+		case Import::PLY :
+			return Export::exportPLY<PFP>(map, position, outputFile.c_str(), true) ;
+		default :
+			CGoGNerr << "simplifyFile: unknown output format " << outputFile << CGoGNendl ;
+			return false ;
+	}
+}
+
+} // namespace Decimation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
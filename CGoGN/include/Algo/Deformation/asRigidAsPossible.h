@@ -0,0 +1,147 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_DEFORMATION_AS_RIGID_AS_POSSIBLE__
+#define __ALGO_DEFORMATION_AS_RIGID_AS_POSSIBLE__
+
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
+
+#include "Topology/generic/cellmarker.h"
+#include "Algo/Topo/connectivitySnapshot.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Deformation
+{
+
+/**
+ * As-rigid-as-possible surface deformation (Sorkine & Alexa 2007) with uniform weights
+ * (the topological laplacian used by the surface deformation plugin).
+ * Each iteration alternates:
+ * - the local step: best rotation of each vertex neighbourhood, computed in parallel
+ *   on a flat copy of the connectivity,
+ * - the global step: the laplacian system of the free vertices is factorized once by
+ *   setFreeVertices, the 3 coordinates are then solved together at each iteration.
+ * Vertices that are not free keep their current position (handles are moved by the caller).
+ */
+template <typename PFP>
+class ARAP
+{
+public:
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+	typedef Eigen::SparseMatrix<double> SparseMatrix;
+	typedef Eigen::Matrix<double, Eigen::Dynamic, 3> Coordinates;
+
+protected:
+	MAP& m_map;
+	VertexAttribute<VEC3, MAP>& m_position;
+	unsigned int m_nbThreads;
+
+	Algo::Topo::ConnectivitySnapshot m_connectivity;
+
+	// index (in the snapshot) of the vertex of each line
+	std::vector<unsigned int> m_lineIndex;
+
+	// per vertex index: rest position, rotation, row in the system (-1 if not free)
+	std::vector<Eigen::Vector3d> m_rest;
+	std::vector<Eigen::Matrix3d> m_rotations;
+	std::vector<int> m_unknown;
+
+	// free vertices (vertex indices) in the order of the rows
+	std::vector<unsigned int> m_free;
+
+	Eigen::SimplicialLDLT<SparseMatrix> m_solver;
+	bool m_factorized;
+
+	Coordinates m_rhs;
+	Coordinates m_solution;
+
+	Eigen::Vector3d position(unsigned int line) const;
+
+	void computeRotations();
+
+	void computeRHS();
+
+public:
+	ARAP(MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * take the current positions as rest pose and copy the connectivity,
+	 * must be called again when the topology changes (free vertices must then be set again)
+	 */
+	void setRestPose();
+
+	/**
+	 * set the free vertices and factorize the laplacian system,
+	 * to call when the handle / free selections change
+	 * @return false if the factorization failed (a connected component without fixed vertex)
+	 */
+	bool setFreeVertices(const CellMarker<MAP, VERTEX>& freeMarker);
+
+	bool isReady() const { return m_factorized && m_connectivity.isUpToDate(m_map); }
+
+	unsigned int nbFreeVertices() const { return (unsigned int)(m_free.size()); }
+
+	/**
+	 * move the free vertices with nbIterations local / global steps
+	 * @return false if the system is not ready (see setRestPose, setFreeVertices)
+	 */
+	bool iterate(unsigned int nbIterations = 1);
+
+	/**
+	 * ARAP energy of the current positions
+	 */
+	double energy() const;
+
+	/**
+	 * rotation of the neighbourhood of a vertex computed by the last local step
+	 */
+	const Eigen::Matrix3d& getRotation(Vertex v) const { return m_rotations[m_lineIndex[m_map.template getEmbedding<VERTEX>(v)]]; }
+};
+
+} // namespace Deformation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Deformation/asRigidAsPossible.hpp"
+
+#endif
@@ -0,0 +1,249 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Deformation
+{
+
+template <typename PFP>
+ARAP<PFP>::ARAP(MAP& map, VertexAttribute<VEC3, MAP>& position, unsigned int nbth) :
+	m_map(map),
+	m_position(position),
+	m_nbThreads(nbth),
+	m_factorized(false)
+{
+	setRestPose();
+}
+
+template <typename PFP>
+inline Eigen::Vector3d ARAP<PFP>::position(unsigned int line) const
+{
+	const VEC3& p = m_position[line];
+	return Eigen::Vector3d(p[0], p[1], p[2]);
+}
+
+template <typename PFP>
+void ARAP<PFP>::setRestPose()
+{
+	m_connectivity.build(m_map);
+	const unsigned int nbv = m_connectivity.nbVertices();
+
+	unsigned int maxLine = 0;
+	for (unsigned int i = 0; i < nbv; ++i)
+		maxLine = std::max(maxLine, m_connectivity.vertices[i] + 1);
+	m_lineIndex.assign(maxLine, 0xffffffff);
+	for (unsigned int i = 0; i < nbv; ++i)
+		m_lineIndex[m_connectivity.vertices[i]] = i;
+
+	m_rest.resize(nbv);
+	for (unsigned int i = 0; i < nbv; ++i)
+		m_rest[i] = position(m_connectivity.vertices[i]);
+	m_rotations.assign(nbv, Eigen::Matrix3d::Identity());
+
+	m_unknown.assign(nbv, -1);
+	m_free.clear();
+	m_factorized = false;
+}
+
+template <typename PFP>
+bool ARAP<PFP>::setFreeVertices(const CellMarker<MAP, VERTEX>& freeMarker)
+{
+	const unsigned int nbv = m_connectivity.nbVertices();
+	const std::vector<unsigned int>& vertices = m_connectivity.vertices;
+
+	m_free.clear();
+	for (unsigned int i = 0; i < nbv; ++i)
+	{
+		if (freeMarker.isMarked(vertices[i]))
+		{
+			m_unknown[i] = int(m_free.size());
+			m_free.push_back(i);
+		}
+		else
+			m_unknown[i] = -1;
+	}
+
+	m_factorized = false;
+	if (m_free.empty())
+		return false;
+
+	// laplacian of the free vertices (fixed neighbours go to the right hand side)
+	std::vector<Eigen::Triplet<double> > coeffs;
+	coeffs.reserve(m_free.size() * 7);
+	for (unsigned int r = 0; r < m_free.size(); ++r)
+	{
+		unsigned int i = m_free[r];
+		coeffs.push_back(Eigen::Triplet<double>(r, r, double(m_connectivity.degree(i))));
+		for (unsigned int k = m_connectivity.neighbourBegin[i]; k < m_connectivity.neighbourBegin[i + 1]; ++k)
+		{
+			int c = m_unknown[m_lineIndex[m_connectivity.neighbours[k]]];
+			if (c >= 0)
+				coeffs.push_back(Eigen::Triplet<double>(r, c, -1.0));
+		}
+	}
+	SparseMatrix L(int(m_free.size()), int(m_free.size()));
+	L.setFromTriplets(coeffs.begin(), coeffs.end());
+
+	m_solver.compute(L);
+	if (m_solver.info() != Eigen::Success)
+		return false;
+
+	m_rhs.resize(m_free.size(), 3);
+	m_factorized = true;
+	return true;
+}
+
+template <typename PFP>
+void ARAP<PFP>::computeRotations()
+{
+	const std::vector<unsigned int>& vertices = m_connectivity.vertices;
+	const std::vector<unsigned int>& neighbours = m_connectivity.neighbours;
+
+	m_connectivity.foreach_vertex([&] (unsigned int i)
+	{
+		Eigen::Vector3d p = position(vertices[i]);
+		Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+		for (unsigned int k = m_connectivity.neighbourBegin[i]; k < m_connectivity.neighbourBegin[i + 1]; ++k)
+		{
+			unsigned int j = m_lineIndex[neighbours[k]];
+			cov += (position(neighbours[k]) - p) * (m_rest[j] - m_rest[i]).transpose();
+		}
+
+		Eigen::JacobiSVD<Eigen::Matrix3d> svd(cov, Eigen::ComputeFullU | Eigen::ComputeFullV);
+		Eigen::Matrix3d R = svd.matrixU() * svd.matrixV().transpose();
+		if (R.determinant() < 0)
+		{
+			Eigen::Matrix3d U = svd.matrixU();
+			U.col(2) *= -1;
+			R = U * svd.matrixV().transpose();
+		}
+		m_rotations[i] = R;
+	}, m_nbThreads);
+}
+
+template <typename PFP>
+void ARAP<PFP>::computeRHS()
+{
+	const std::vector<unsigned int>& neighbours = m_connectivity.neighbours;
+	const unsigned int nbFree = nbFreeVertices();
+
+	// rows of the free vertices: chunks of the free list, as in ConnectivitySnapshot::foreach_vertex
+	auto row = [&] (unsigned int r)
+	{
+		unsigned int i = m_free[r];
+		Eigen::Vector3d b = Eigen::Vector3d::Zero();
+		for (unsigned int k = m_connectivity.neighbourBegin[i]; k < m_connectivity.neighbourBegin[i + 1]; ++k)
+		{
+			unsigned int j = m_lineIndex[neighbours[k]];
+			b += 0.5 * (m_rotations[i] + m_rotations[j]) * (m_rest[i] - m_rest[j]);
+			if (m_unknown[j] < 0)
+				b += position(neighbours[k]);
+		}
+		m_rhs.row(r) = b.transpose();
+	};
+
+	if (m_nbThreads <= 1 || nbFree < 1024)
+	{
+		for (unsigned int r = 0; r < nbFree; ++r)
+			row(r);
+		return;
+	}
+
+	const unsigned int cs = 512;
+	Utils::WorkStealingRange range((nbFree + cs - 1) / cs, m_nbThreads);
+	std::function<void(unsigned int)> job = [&] (unsigned int th)
+	{
+		unsigned int chunk;
+		while (range.next(th, chunk))
+		{
+			unsigned int e = std::min(chunk * cs + cs, nbFree);
+			for (unsigned int r = chunk * cs; r < e; ++r)
+				row(r);
+		}
+	};
+	Utils::ThreadPool::getInstance().run(m_nbThreads, job);
+}
+
+template <typename PFP>
+bool ARAP<PFP>::iterate(unsigned int nbIterations)
+{
+	if (!isReady())
+		return false;
+
+	const std::vector<unsigned int>& vertices = m_connectivity.vertices;
+
+	for (unsigned int it = 0; it < nbIterations; ++it)
+	{
+		computeRotations();
+		computeRHS();
+
+		// the 3 coordinates share the factorization
+		m_solution = m_solver.solve(m_rhs);
+
+		for (unsigned int r = 0; r < m_free.size(); ++r)
+		{
+			VEC3& p = m_position[vertices[m_free[r]]];
+			p[0] = REAL(m_solution(r, 0));
+			p[1] = REAL(m_solution(r, 1));
+			p[2] = REAL(m_solution(r, 2));
+		}
+	}
+
+	return true;
+}
+
+template <typename PFP>
+double ARAP<PFP>::energy() const
+{
+	const std::vector<unsigned int>& vertices = m_connectivity.vertices;
+	const std::vector<unsigned int>& neighbours = m_connectivity.neighbours;
+
+	double e = 0;
+	for (unsigned int i = 0; i < m_connectivity.nbVertices(); ++i)
+	{
+		Eigen::Vector3d p = position(vertices[i]);
+		for (unsigned int k = m_connectivity.neighbourBegin[i]; k < m_connectivity.neighbourBegin[i + 1]; ++k)
+		{
+			unsigned int j = m_lineIndex[neighbours[k]];
+			e += ((position(neighbours[k]) - p) - m_rotations[i] * (m_rest[j] - m_rest[i])).squaredNorm();
+		}
+	}
+	return e;
+}
+
+} // namespace Deformation
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
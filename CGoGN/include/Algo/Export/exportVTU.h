@@ -27,6 +27,7 @@
 
 #include "Topology/generic/attributeHandler.h"
 #include "Algo/Import/importFileTypes.h"
+#include "Utils/vtkAppendedWriter.h"
 
 
 #include <stdint.h>
@@ -64,6 +65,30 @@ bool exportVTU(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 template <typename PFP>
 bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename);
 
+/**
+* export of the geometry of map into a VTU file with the data appended in binary after the xml,
+* raw or cut in blocks compressed in parallel (zlib, as vtkZLibDataCompressor)
+* the positions are written directly from the blocks of the attribute when the vertex
+* container has no hole (see compact)
+* @param map map to be exported
+* @param position the position container
+* @param filename filename of vtu file
+* @param compress true for zlib compression
+* @param nbThreads number of threads used for compression (0 for hardware concurrency)
+* @return true if ok
+*/
+template <typename PFP>
+bool exportVTUAppended(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename,
+					   bool compress = true, unsigned int nbThreads = 0);
+
+/**
+* add the points of a VTU file to an appended writer (without copy if the vertex container has no hole)
+* @param indices (out) index of the vertices in the file (empty if equal to their embedding)
+*/
+template <typename PFP>
+void vtuAppendedPoints(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+					   Utils::VTKAppendedWriter& writer, std::vector<unsigned int>& indices);
+
 //template <typename PFP>
 //bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3>& position, const char* filename);
 
@@ -178,6 +203,22 @@ namespace Volume
 namespace Export
 {
 
+/**
+* export of the tetrahedra and hexahedra of map into a VTU file with the data appended in binary after the xml,
+* raw or cut in blocks compressed in parallel (zlib, as vtkZLibDataCompressor)
+* the positions are written directly from the blocks of the attribute when the vertex
+* container has no hole (see compact)
+* @param map map to be exported
+* @param position the position container
+* @param filename filename of vtu file
+* @param compress true for zlib compression
+* @param nbThreads number of threads used for compression (0 for hardware concurrency)
+* @return true if ok
+*/
+template <typename PFP>
+bool exportVTUAppended(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename,
+					   bool compress = true, unsigned int nbThreads = 0);
+
 /**
  * class that allow the export of VTU file (ascii or binary)
  * with vertex and volume attributes
@@ -424,6 +424,93 @@ bool exportVTUBinary(typename PFP::MAP& map, const VertexAttribute<typename PFP:
 
 
 
+template <typename PFP>
+void vtuAppendedPoints(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+					   Utils::VTKAppendedWriter& writer, std::vector<unsigned int>& indices)
+{
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+	const AttributeContainer& cont = map.template getAttributeContainer<VERTEX>();
+	const unsigned int nbVertices = cont.size();
+	const std::string vtkType = (sizeof(REAL) == 4) ? "Float32" : "Float64";
+
+	indices.clear();
+	if (cont.realEnd() == nbVertices)
+	{
+		// no hole: the blocks of the attribute are the array and the embeddings are the indices
+		std::vector<void*> addr;
+		unsigned int byteBlockSize;
+		position.getDataVector()->getBlocksPointers(addr, byteBlockSize);
+		writer.dataArray(vtkType, "position", 3, addr, byteBlockSize, std::size_t(nbVertices) * sizeof(VEC3));
+		return;
+	}
+
+	indices.resize(cont.realEnd());
+	std::vector<VEC3> points;
+	points.reserve(nbVertices);
+	for (unsigned int i = cont.realBegin(); i != cont.realEnd(); cont.realNext(i))
+	{
+		indices[i] = uint32(points.size());
+		points.push_back(position[i]);
+	}
+	writer.dataArray(vtkType, "position", 3, points);
+}
+
+template <typename PFP>
+bool exportVTUAppended(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename,
+					   bool compress, unsigned int nbThreads)
+{
+	if (map.dimension() != 2)
+	{
+		CGoGNerr << "Surface::Export::exportVTUAppended works only with map of dimension 2"<< CGoGNendl;
+		return false;
+	}
+
+	std::vector<unsigned int> connectivity;
+	std::vector<unsigned long long> offsets;
+	std::vector<unsigned char> types;
+	connectivity.reserve(map.template getAttributeContainer<DART>().size());
+
+	foreach_cell<FACE>(map, [&] (Face f)
+	{
+		unsigned int degree = 0;
+		Dart it = f.dart;
+		do
+		{
+			connectivity.push_back(map.template getEmbedding<VERTEX>(it));
+			++degree;
+			it = map.phi1(it);
+		} while (it != f.dart);
+		offsets.push_back(connectivity.size());
+		types.push_back(degree == 3 ? 5 : (degree == 4 ? 9 : 7));
+	});
+
+	Utils::VTKAppendedWriter writer(compress ? Utils::VTKAppendedWriter::ZLIB : Utils::VTKAppendedWriter::RAW, nbThreads);
+	writer.begin("UnstructuredGrid");
+
+	std::ostringstream oss;
+	oss << "<UnstructuredGrid>\n<Piece NumberOfPoints=\"" << map.template getAttributeContainer<VERTEX>().size()
+		<< "\" NumberOfCells=\"" << types.size() << "\">\n<Points>\n";
+	writer.xml(oss.str());
+
+	std::vector<unsigned int> indices;
+	vtuAppendedPoints<PFP>(map, position, writer, indices);
+	if (!indices.empty())
+	{
+		for (std::size_t i = 0; i < connectivity.size(); ++i)
+			connectivity[i] = indices[connectivity[i]];
+	}
+
+	writer.xml("</Points>\n<Cells>\n");
+	writer.dataArray("Int32", "connectivity", 1, connectivity);
+	writer.dataArray("Int64", "offsets", 1, offsets);
+	writer.dataArray("UInt8", "types", 1, types);
+	writer.xml("</Cells>\n</Piece>\n</UnstructuredGrid>\n");
+
+	return writer.write(filename);
+}
+
 /*
 template <typename PFP>
 bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>& position, const char* filename)
@@ -1271,6 +1358,86 @@ namespace Volume
 namespace Export
 {
 
+template <typename PFP>
+bool exportVTUAppended(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const char* filename,
+					   bool compress, unsigned int nbThreads)
+{
+	if (map.dimension() != 3)
+	{
+		CGoGNerr << "Volume::Export::exportVTUAppended works only with map of dimension 3"<< CGoGNendl;
+		return false;
+	}
+
+	typedef typename PFP::MAP MAP;
+
+	std::vector<unsigned int> connectivity;
+	std::vector<unsigned long long> offsets;
+	std::vector<unsigned char> types;
+
+	TraversorW<MAP> trav(map) ;
+	for(Dart d = trav.begin(); d != trav.end(); d = trav.next())
+	{
+		unsigned int degree = 0 ;
+
+		Traversor3WV<MAP> twv(map, d) ;
+		for(Dart it = twv.begin(); it != twv.end(); it = twv.next())
+		{
+			degree++;
+		}
+
+		if (degree == 8)
+		{
+			// 2 quads, the first one CW
+			Dart f = map.template phi<21121>(d);
+			for (unsigned int i = 0; i < 4; ++i, f = map.phi_1(f))
+				connectivity.push_back(map.template getEmbedding<VERTEX>(f));
+			Dart e = d;
+			for (unsigned int i = 0; i < 4; ++i, e = map.phi1(e))
+				connectivity.push_back(map.template getEmbedding<VERTEX>(e));
+			types.push_back(12);
+		}
+		else if (degree == 4)
+		{
+			Dart e = d;
+			connectivity.push_back(map.template getEmbedding<VERTEX>(e));
+			e = map.phi1(e);
+			connectivity.push_back(map.template getEmbedding<VERTEX>(e));
+			e = map.phi1(e);
+			connectivity.push_back(map.template getEmbedding<VERTEX>(e));
+			e = map.template phi<211>(e);
+			connectivity.push_back(map.template getEmbedding<VERTEX>(e));
+			types.push_back(10);
+		}
+		else
+			continue;
+		offsets.push_back(connectivity.size());
+	}
+
+	Utils::VTKAppendedWriter writer(compress ? Utils::VTKAppendedWriter::ZLIB : Utils::VTKAppendedWriter::RAW, nbThreads);
+	writer.begin("UnstructuredGrid");
+
+	std::ostringstream oss;
+	oss << "<UnstructuredGrid>\n<Piece NumberOfPoints=\"" << map.template getAttributeContainer<VERTEX>().size()
+		<< "\" NumberOfCells=\"" << types.size() << "\">\n<Points>\n";
+	writer.xml(oss.str());
+
+	std::vector<unsigned int> indices;
+	Surface::Export::vtuAppendedPoints<PFP>(map, position, writer, indices);
+	if (!indices.empty())
+	{
+		for (std::size_t i = 0; i < connectivity.size(); ++i)
+			connectivity[i] = indices[connectivity[i]];
+	}
+
+	writer.xml("</Points>\n<Cells>\n");
+	writer.dataArray("Int32", "connectivity", 1, connectivity);
+	writer.dataArray("Int64", "offsets", 1, offsets);
+	writer.dataArray("UInt8", "types", 1, types);
+	writer.xml("</Cells>\n</Piece>\n</UnstructuredGrid>\n");
+
+	return writer.write(filename);
+}
+
 template <typename PFP>
 VTUExporter<PFP>::VTUExporter(MAP& map, const VertexAttribute<VEC3,MAP>& position):
 	m_map(map),m_position(position),
@@ -28,6 +28,7 @@
 #include "Topology/generic/traversor/traversor2.h"
 #include "Topology/generic/cellmarker.h"
 #include "Algo/Import/importFileTypes.h"
+#include "Algo/Export/exportVTU.h"
 
 namespace CGoGN
 {
@@ -835,7 +836,7 @@ bool exportMesh(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3
 		return exportMSH<PFP>(map, position, filename.c_str());
 		break;
 	case Import::VTU:
-		return exportVTU<PFP>(map, position, filename.c_str());
+		return exportVTUAppended<PFP>(map, position, filename.c_str());
 		break;
 	case Import::NAS:
 		return exportNAS<PFP>(map, position, filename.c_str());
@@ -25,6 +25,10 @@
 #include "Topology/generic/traversor/traversorCell.h"
 #include "Algo/Filtering/functors.h"
 #include "Algo/Selection/collector.h"
+#include "Algo/Geometry/gatheredIndices.h"
+#include "Topology/generic/attributeSoA.h"
+
+#include <algorithm>
 
 namespace CGoGN
 {
@@ -180,6 +184,101 @@ void filterAverageFaceAttribute_WithinSphere(
 	}
 }
 
+namespace SIMD
+{
+
+/**
+ * average of the vertex (INSIDE) and/or of its one ring (BORDER) computed on SoA views,
+ * the vertices gathered in g being processed by packs of Utils::SimdPack<T>::SIZE
+ * (boundary vertices are copied)
+ */
+template <typename T>
+void filterAverageAttribute_OneRing(
+	const Algo::Surface::Geometry::GatheredIndices& g,
+	const AttributeSoA<T, 3>& attIn,
+	AttributeSoA<T, 3>& attOut,
+	int neigh)
+{
+	typedef Utils::SimdPack<T> PACK;
+	const unsigned int W = PACK::SIZE;
+
+	attOut.resize(attIn.getNbBlocks() * _BLOCKSIZE_);
+
+	// sums of the 3 components then values of the current neighbours then counts
+	T* buf = static_cast<T*>(Utils::alignedMalloc(7 * W * sizeof(T)));
+	T* val = buf + 3 * W;
+	T* count = buf + 6 * W;
+
+	unsigned int nbv = g.nbVertices();
+	for (unsigned int i = 0; i < nbv; i += W)
+	{
+		unsigned int nb = std::min(W, nbv - i);
+		unsigned int maxDegree = 0;
+		for (unsigned int k = 0; k < W; ++k)
+		{
+			unsigned int v = i + std::min(k, nb - 1);
+			unsigned int degree = g.cornerBegin[v + 1] - g.cornerBegin[v];
+			maxDegree = std::max(maxDegree, degree);
+			count[k] = T(((neigh & INSIDE) ? 1 : 0) + ((neigh & BORDER) ? degree : 0));
+			for (unsigned int c = 0; c < 3; ++c)
+				buf[c * W + k] = (neigh & INSIDE) ? attIn(g.vertices[v], c) : T(0);
+		}
+
+		PACK sx = PACK::load(buf);
+		PACK sy = PACK::load(buf + W);
+		PACK sz = PACK::load(buf + 2 * W);
+		if (neigh & BORDER)
+		{
+			for (unsigned int j = 0; j < maxDegree; ++j)
+			{
+				for (unsigned int k = 0; k < W; ++k)
+				{
+					unsigned int v = i + std::min(k, nb - 1);
+					unsigned int cr = g.cornerBegin[v] + j;
+					bool active = cr < g.cornerBegin[v + 1];
+					for (unsigned int c = 0; c < 3; ++c)
+						val[c * W + k] = active ? attIn(g.cornerNext[cr], c) : T(0);
+				}
+				sx = sx + PACK::load(val);
+				sy = sy + PACK::load(val + W);
+				sz = sz + PACK::load(val + 2 * W);
+			}
+		}
+
+		PACK n = PACK::load(count);
+		(sx / n).store(buf);
+		(sy / n).store(buf + W);
+		(sz / n).store(buf + 2 * W);
+
+		for (unsigned int k = 0; k < nb; ++k)
+		{
+			unsigned int line = g.vertices[i + k];
+			for (unsigned int c = 0; c < 3; ++c)
+				attOut(line, c) = g.boundary[i + k] ? attIn(line, c) : buf[c * W + k];
+		}
+	}
+
+	Utils::alignedFree(buf);
+}
+
+template <typename PFP>
+void filterAverageAttribute_OneRing(
+	typename PFP::MAP& map,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& attIn,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& attOut,
+	int neigh)
+{
+	Algo::Surface::Geometry::GatheredIndices g;
+	g.build(map);
+	AttributeSoA<typename PFP::REAL, 3> in;
+	in.load(attIn);
+	AttributeSoA<typename PFP::REAL, 3> out;
+	filterAverageAttribute_OneRing(g, in, out, neigh);
+	out.store(attOut);
+}
+
+} // namespace SIMD
+
 } // namespace Filtering
 
 } // namespace Surface
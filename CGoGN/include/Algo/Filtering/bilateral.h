@@ -26,6 +26,7 @@
 #include "Topology/generic/traversor/traversorCell.h"
 #include "Topology/generic/traversor/traversor2.h"
 #include "Algo/Geometry/basic.h"
+#include "Algo/Topo/connectivitySnapshot.h"
 
 namespace CGoGN
 {
@@ -110,6 +111,84 @@ void filterBilateral(
 	}
 }
 
+/**
+ * sigmaBilateral computed on a connectivity snapshot of the map
+ */
+template <typename PFP>
+void sigmaBilateral(const Algo::Topo::ConnectivitySnapshot& cs, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal, typename PFP::REAL& sigmaC, typename PFP::REAL& sigmaS)
+{
+	typedef typename PFP::REAL REAL ;
+
+	REAL sumLengths = 0.0f;
+	REAL sumAngles = 0.0f;
+	long nbEdges = 0 ;
+
+	// each edge once, from its vertex of smallest line
+	for (unsigned int i = 0; i < cs.nbVertices(); ++i)
+	{
+		unsigned int v = cs.vertices[i] ;
+		for (unsigned int k = cs.neighbourBegin[i]; k < cs.neighbourBegin[i + 1]; ++k)
+		{
+			unsigned int n = cs.neighbours[k] ;
+			if (v < n)
+			{
+				sumLengths += (position[n] - position[v]).norm() ;
+				sumAngles += Geom::angle(normal[v], normal[n]) ;
+				++nbEdges ;
+			}
+		}
+	}
+
+	sigmaC = 1.0f * (sumLengths / REAL(nbEdges));
+	sigmaS = 2.5f * (sumAngles / REAL(nbEdges));
+}
+
+/**
+ * \brief bilateral filter computed on a connectivity snapshot of the map
+ * (for repeated iterations on a fixed topology)
+ */
+template <typename PFP>
+void filterBilateral(
+        typename PFP::MAP& map,
+        const Algo::Topo::ConnectivitySnapshot& cs,
+        const VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& positionIn,
+        VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& positionOut,
+        const VertexAttribute<typename PFP::VEC3,typename PFP::MAP>& normal)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	assert(cs.isUpToDate(map) || !"filterBilateral: connectivity snapshot is out of date") ;
+
+	REAL sigmaC, sigmaS;
+	sigmaBilateral<PFP>(cs, positionIn, normal, sigmaC, sigmaS) ;
+
+	cs.foreach_vertex([&] (unsigned int i)
+	{
+		unsigned int v = cs.vertices[i] ;
+		if (!cs.boundary[i])
+		{
+			const VEC3& normal_v = normal[v] ;
+			const VEC3& pos_v = positionIn[v] ;
+
+			REAL sum = 0.0f, normalizer = 0.0f;
+			for (unsigned int k = cs.neighbourBegin[i]; k < cs.neighbourBegin[i + 1]; ++k)
+			{
+				VEC3 vec = positionIn[cs.neighbours[k]] - pos_v ;
+				REAL h = normal_v * vec;
+				REAL t = vec.norm();
+				REAL wcs = std::exp((-1.0f * (t * t) / (2.0f * sigmaC * sigmaC)) + (-1.0f * (h * h) / (2.0f * sigmaS * sigmaS)));
+				sum += wcs * h ;
+				normalizer += wcs ;
+			}
+
+			positionOut[v] = pos_v + ((sum / normalizer) * normal_v) ;
+		}
+		else
+			positionOut[v] = positionIn[v] ;
+	});
+}
+
 template <typename PFP>
 void filterSUSAN(typename PFP::MAP& map, float SUSANthreshold, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
 {
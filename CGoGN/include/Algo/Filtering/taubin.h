@@ -24,6 +24,7 @@
 
 #include "Algo/Filtering/functors.h"
 #include "Algo/Selection/collector.h"
+#include "Algo/Topo/connectivitySnapshot.h"
 
 namespace CGoGN
 {
@@ -97,6 +98,47 @@ void filterTaubin(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, ty
 	}
 }
 
+/**
+ * Taubin filter computed on a connectivity snapshot of the map
+ * (for repeated iterations on a fixed topology).
+ * Triangle meshes only: the vertices are averaged with their neighbours by an edge,
+ * that are the border of their one-ring only if all faces are triangles
+ */
+template <typename PFP>
+void filterTaubin(typename PFP::MAP& map, const Algo::Topo::ConnectivitySnapshot& cs, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	assert(cs.isUpToDate(map) || !"filterTaubin: connectivity snapshot is out of date") ;
+	assert(map.isTriangular() || !"filterTaubin: connectivity snapshot version needs a triangle mesh") ;
+
+	const REAL lambda = 0.6307f;
+	const REAL mu = -0.6732f;
+
+	auto step = [&] (const VertexAttribute<VEC3, typename PFP::MAP>& in, VertexAttribute<VEC3, typename PFP::MAP>& out, REAL factor)
+	{
+		cs.foreach_vertex([&] (unsigned int i)
+		{
+			unsigned int v = cs.vertices[i] ;
+			if (!cs.boundary[i])
+			{
+				VEC3 sum(0) ;
+				for (unsigned int k = cs.neighbourBegin[i]; k < cs.neighbourBegin[i + 1]; ++k)
+					sum += in[cs.neighbours[k]] ;
+				const VEC3& p = in[v] ;
+				out[v] = p + (sum / REAL(cs.degree(i)) - p) * factor ;
+			}
+			else
+				out[v] = in[v] ;
+		});
+	};
+
+	step(position, position2, lambda) ;
+	// unshrinking step
+	step(position2, position, mu) ;
+}
+
 /**
  * Taubin filter modified as proposed by [Lav09]
  */
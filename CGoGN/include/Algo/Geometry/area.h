@@ -26,6 +26,8 @@
 #define __ALGO_GEOMETRY_AREA_H__
 
 #include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/attributeSoA.h"
+#include "Algo/Geometry/gatheredIndices.h"
 
 namespace CGoGN
 {
@@ -117,6 +119,22 @@ void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<ty
 
 } // namespace Parallel
 
+namespace SIMD
+{
+
+/**
+ * compute the area of the faces gathered in g from a SoA view of the positions
+ * (triangles are processed by packs of Utils::SimdPack<T>::SIZE)
+ * @param area (out) area of the face g.faces[i] at index i
+ */
+template <typename T>
+void computeAreaFaces(const GatheredIndices& g, const AttributeSoA<T, 3>& position, std::vector<T>& area);
+
+template <typename PFP>
+void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& area);
+
+} // namespace SIMD
+
 
 } // namespace Geometry
 
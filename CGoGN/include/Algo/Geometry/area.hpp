@@ -27,6 +27,8 @@
 
 #include "Topology/generic/autoAttributeHandler.h"
 
+#include <algorithm>
+
 namespace CGoGN
 {
 
@@ -325,6 +327,113 @@ void computeVoronoiAreaVertices(typename PFP::MAP& map, const VertexAttribute<ty
 
 } // namespace Parallel
 
+namespace SIMD
+{
+
+/**
+ * cross product (p1 - p0) ^ (p2 - p0) of the triangles [t, t + SIZE[ of g
+ * (lanes after the last triangle repeat it)
+ * @param buf (out) aligned array of 3 * SIZE values: x of the SIZE triangles, then y, then z
+ */
+template <typename T>
+void triangleCross(const GatheredIndices& g, const AttributeSoA<T, 3>& position, unsigned int t, T* buf)
+{
+	typedef Utils::SimdPack<T> PACK;
+	const unsigned int W = PACK::SIZE;
+
+	// 3 corners x 3 components, after the output
+	T* p = buf + 3 * W;
+	for (unsigned int k = 0; k < W; ++k)
+	{
+		unsigned int f = std::min(t + k, g.nbTriangles - 1);
+		const unsigned int* fv = &g.faceVertices[g.faceBegin[f]];
+		for (unsigned int j = 0; j < 3; ++j)
+			for (unsigned int c = 0; c < 3; ++c)
+				p[(3 * j + c) * W + k] = position(fv[j], c);
+	}
+
+	PACK ux = PACK::load(p + 3 * W) - PACK::load(p);
+	PACK uy = PACK::load(p + 4 * W) - PACK::load(p + W);
+	PACK uz = PACK::load(p + 5 * W) - PACK::load(p + 2 * W);
+	PACK vx = PACK::load(p + 6 * W) - PACK::load(p);
+	PACK vy = PACK::load(p + 7 * W) - PACK::load(p + W);
+	PACK vz = PACK::load(p + 8 * W) - PACK::load(p + 2 * W);
+
+	(uy * vz - uz * vy).store(buf);
+	(uz * vx - ux * vz).store(buf + W);
+	(ux * vy - uy * vx).store(buf + 2 * W);
+}
+
+/**
+ * area of a polygonal face of g (fan of triangles around the centroid, as convexFaceArea)
+ */
+template <typename T>
+T polygonArea(const GatheredIndices& g, const AttributeSoA<T, 3>& position, unsigned int f)
+{
+	typedef Geom::Vector<3, T> VEC3;
+
+	unsigned int b = g.faceBegin[f];
+	unsigned int n = g.faceBegin[f + 1] - b;
+
+	VEC3 centroid(0);
+	for (unsigned int j = 0; j < n; ++j)
+		centroid += VEC3(position(g.faceVertices[b + j], 0), position(g.faceVertices[b + j], 1), position(g.faceVertices[b + j], 2));
+	centroid /= T(n);
+
+	T area(0);
+	for (unsigned int j = 0; j < n; ++j)
+	{
+		unsigned int l1 = g.faceVertices[b + j];
+		unsigned int l2 = g.faceVertices[b + (j + 1) % n];
+		VEC3 p1(position(l1, 0), position(l1, 1), position(l1, 2));
+		VEC3 p2(position(l2, 0), position(l2, 1), position(l2, 2));
+		area += Geom::triangleArea(p1, p2, centroid);
+	}
+	return area;
+}
+
+template <typename T>
+void computeAreaFaces(const GatheredIndices& g, const AttributeSoA<T, 3>& position, std::vector<T>& area)
+{
+	typedef Utils::SimdPack<T> PACK;
+	const unsigned int W = PACK::SIZE;
+
+	area.resize(g.nbFaces());
+
+	T* buf = static_cast<T*>(Utils::alignedMalloc(12 * W * sizeof(T)));
+	for (unsigned int t = 0; t < g.nbTriangles; t += W)
+	{
+		triangleCross(g, position, t, buf);
+		PACK cx = PACK::load(buf);
+		PACK cy = PACK::load(buf + W);
+		PACK cz = PACK::load(buf + 2 * W);
+		((cx * cx + cy * cy + cz * cz).sqrt() * PACK(T(0.5))).store(buf);
+		unsigned int nb = std::min(W, g.nbTriangles - t);
+		for (unsigned int k = 0; k < nb; ++k)
+			area[t + k] = buf[k];
+	}
+	Utils::alignedFree(buf);
+
+	for (unsigned int f = g.nbTriangles; f < g.nbFaces(); ++f)
+		area[f] = polygonArea(g, position, f);
+}
+
+template <typename PFP>
+void computeAreaFaces(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, FaceAttribute<typename PFP::REAL, typename PFP::MAP>& face_area)
+{
+	GatheredIndices g;
+	g.build(map);
+	AttributeSoA<typename PFP::REAL, 3> view;
+	view.load(position);
+
+	std::vector<typename PFP::REAL> area;
+	computeAreaFaces(g, view, area);
+	for (unsigned int f = 0; f < g.nbFaces(); ++f)
+		face_area[g.faces[f]] = area[f];
+}
+
+} // namespace SIMD
+
 
 
 } // namespace Geometry
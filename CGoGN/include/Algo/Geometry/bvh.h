@@ -0,0 +1,194 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_GEOMETRY_BVH_H__
+#define __ALGO_GEOMETRY_BVH_H__
+
+#include <limits>
+#include <vector>
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+ * Bounding volume hierarchy over a set of faces of a map.
+ * Faces are considered as triangle fans (as in Algo::Selection).
+ * The tree is built once with a binned SAH and can be refitted
+ * when the positions are modified (the tree structure is kept).
+ * The BVH must be rebuilt if the topology of the faces changes.
+ */
+template <typename PFP>
+class BVH
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	/**
+	 * node of the tree:
+	 * - internal node : count == 0, children are first and first+1
+	 * - leaf : faces [first, first+count[ of m_faces
+	 */
+	struct Node
+	{
+		VEC3 bbMin ;
+		VEC3 bbMax ;
+		unsigned int first ;
+		unsigned int count ;
+	} ;
+
+	MAP& m_map ;
+	VertexAttribute<VEC3, MAP> m_position ;
+
+	unsigned int m_maxLeafSize ;
+
+	std::vector<Face> m_faces ;
+	std::vector<VEC3> m_faceMin ;
+	std::vector<VEC3> m_faceMax ;
+	std::vector<Node> m_nodes ;
+
+	static void mergeBox(VEC3& bbMin, VEC3& bbMax, const VEC3& m, const VEC3& M) ;
+
+	void computeFaceBox(unsigned int i) ;
+
+	void computeNodeBox(Node& n) ;
+
+	void buildTree() ;
+
+	bool rayBoxIntersection(const VEC3& bbMin, const VEC3& bbMax, const VEC3& rayA, const VEC3& rayAB, REAL dilation, bool line, REAL& tNear) const ;
+
+	static REAL squaredDistanceBox2Point(const VEC3& bbMin, const VEC3& bbMax, const VEC3& P) ;
+
+	REAL closestPointInFace(Face f, const VEC3& P, VEC3& closest) const ;
+
+	bool coneBoxIntersection(const VEC3& bbMin, const VEC3& bbMax, const VEC3& rayA, const VEC3& rayAB, REAL AB2, REAL sin2) const ;
+
+	bool rayFaceIntersection(Face f, const VEC3& rayA, const VEC3& rayAB, VEC3& I) const ;
+
+public:
+	/**
+	 * build the BVH over all the faces of the map
+	 * @param map the map
+	 * @param position the vertex attribute storing positions
+	 * @param maxLeafSize max number of faces stored in a leaf
+	 */
+	BVH(MAP& map, const VertexAttribute<VEC3, MAP>& position, unsigned int maxLeafSize = 4) ;
+
+	/**
+	 * build the BVH over the given set of faces
+	 * @param map the map
+	 * @param position the vertex attribute storing positions
+	 * @param faces the faces to store in the tree
+	 * @param maxLeafSize max number of faces stored in a leaf
+	 */
+	BVH(MAP& map, const VertexAttribute<VEC3, MAP>& position, const std::vector<Face>& faces, unsigned int maxLeafSize = 4) ;
+
+	/// rebuild the tree over all the faces of the map
+	void build() ;
+
+	/// rebuild the tree over the given set of faces
+	void build(const std::vector<Face>& faces) ;
+
+	/// update the bounding boxes after a modification of the positions
+	void refit() ;
+
+	inline MAP& getMap() const { return m_map ; }
+
+	inline const VertexAttribute<VEC3, MAP>& getPosition() const { return m_position ; }
+
+	inline unsigned int getNbFaces() const { return (unsigned int)(m_faces.size()) ; }
+
+	inline unsigned int getNbNodes() const { return (unsigned int)(m_nodes.size()) ; }
+
+	/**
+	 * get all the faces intersected by a ray (unsorted)
+	 * @param rayA first point of ray (user side)
+	 * @param rayAB direction of ray (directed to the scene)
+	 * @param faces (out) intersected faces
+	 * @param iPoints (out) intersection points
+	 */
+	void rayIntersection(const VEC3& rayA, const VEC3& rayAB, std::vector<Face>& faces, std::vector<VEC3>& iPoints) const ;
+
+	/**
+	 * get the first face intersected by a ray
+	 * @param rayA first point of ray (user side)
+	 * @param rayAB direction of ray (directed to the scene)
+	 * @param face (out) closest intersected face
+	 * @param iPoint (out) intersection point
+	 * @return false if no face is intersected
+	 */
+	bool closestRayIntersection(const VEC3& rayA, const VEC3& rayAB, Face& face, VEC3& iPoint) const ;
+
+	/**
+	 * get the faces whose bounding box is at distance less than dist of a line
+	 * (conservative: faces may be farther than dist)
+	 * @param rayA a point of the line
+	 * @param rayAB direction of the line
+	 * @param dist radius of the cylinder around the line
+	 * @param faces (out) candidate faces
+	 */
+	void facesNearLine(const VEC3& rayA, const VEC3& rayAB, REAL dist, std::vector<Face>& faces) const ;
+
+	/**
+	 * get the faces whose bounding box may intersect a (double) cone
+	 * (conservative: faces may be outside of the cone)
+	 * @param rayA apex of the cone
+	 * @param rayAB axis of the cone
+	 * @param angle half angle of the cone in degree
+	 * @param faces (out) candidate faces
+	 */
+	void facesInCone(const VEC3& rayA, const VEC3& rayAB, float angle, std::vector<Face>& faces) const ;
+
+	/**
+	 * get the point of the faces that is closest to a given point
+	 * @param P the point
+	 * @param face (out) face containing the closest point
+	 * @param closest (out) closest point
+	 * @param maxDist2 only points at squared distance less than maxDist2 are searched
+	 * @return squared distance from P to closest (maxDist2 if no point found)
+	 */
+	REAL closestPoint(const VEC3& P, Face& face, VEC3& closest, REAL maxDist2 = std::numeric_limits<REAL>::max()) const ;
+} ;
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/bvh.hpp"
+
+#endif
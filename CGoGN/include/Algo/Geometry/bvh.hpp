@@ -0,0 +1,663 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Geometry/distances.h"
+#include "Geometry/intersection.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+BVH<PFP>::BVH(MAP& map, const VertexAttribute<VEC3, MAP>& position, unsigned int maxLeafSize) :
+	m_map(map),
+	m_position(position),
+	m_maxLeafSize(maxLeafSize > 0 ? maxLeafSize : 1)
+{
+	build() ;
+}
+
+template <typename PFP>
+BVH<PFP>::BVH(MAP& map, const VertexAttribute<VEC3, MAP>& position, const std::vector<Face>& faces, unsigned int maxLeafSize) :
+	m_map(map),
+	m_position(position),
+	m_maxLeafSize(maxLeafSize > 0 ? maxLeafSize : 1)
+{
+	build(faces) ;
+}
+
+template <typename PFP>
+void BVH<PFP>::build()
+{
+	m_faces.clear() ;
+	foreach_cell<FACE>(m_map, [&] (Face f)
+	{
+		m_faces.push_back(f) ;
+	});
+	buildTree() ;
+}
+
+template <typename PFP>
+void BVH<PFP>::build(const std::vector<Face>& faces)
+{
+	m_faces = faces ;
+	buildTree() ;
+}
+
+template <typename PFP>
+void BVH<PFP>::computeFaceBox(unsigned int i)
+{
+	Dart d = m_faces[i].dart ;
+	VEC3 bbMin = m_position[d] ;
+	VEC3 bbMax = bbMin ;
+	for (Dart it = m_map.phi1(d) ; it != d ; it = m_map.phi1(it))
+		mergeBox(bbMin, bbMax, m_position[it], m_position[it]) ;
+	m_faceMin[i] = bbMin ;
+	m_faceMax[i] = bbMax ;
+}
+
+template <typename PFP>
+void BVH<PFP>::mergeBox(VEC3& bbMin, VEC3& bbMax, const VEC3& m, const VEC3& M)
+{
+	for (unsigned int k = 0 ; k < 3 ; ++k)
+	{
+		if (m[k] < bbMin[k]) bbMin[k] = m[k] ;
+		if (M[k] > bbMax[k]) bbMax[k] = M[k] ;
+	}
+}
+
+template <typename PFP>
+void BVH<PFP>::computeNodeBox(Node& n)
+{
+	if (n.count > 0)
+	{
+		n.bbMin = m_faceMin[n.first] ;
+		n.bbMax = m_faceMax[n.first] ;
+		for (unsigned int i = n.first + 1 ; i < n.first + n.count ; ++i)
+			mergeBox(n.bbMin, n.bbMax, m_faceMin[i], m_faceMax[i]) ;
+	}
+	else
+	{
+		n.bbMin = m_nodes[n.first].bbMin ;
+		n.bbMax = m_nodes[n.first].bbMax ;
+		mergeBox(n.bbMin, n.bbMax, m_nodes[n.first + 1].bbMin, m_nodes[n.first + 1].bbMax) ;
+	}
+}
+
+template <typename PFP>
+void BVH<PFP>::buildTree()
+{
+	const unsigned int NB_BINS = 16 ;
+
+	m_nodes.clear() ;
+
+	const unsigned int nb = (unsigned int)(m_faces.size()) ;
+	m_faceMin.resize(nb) ;
+	m_faceMax.resize(nb) ;
+	if (nb == 0)
+		return ;
+
+	std::vector<VEC3> centroids(nb) ;
+	std::vector<unsigned int> index(nb) ;
+	for (unsigned int i = 0 ; i < nb ; ++i)
+	{
+		computeFaceBox(i) ;
+		centroids[i] = (m_faceMin[i] + m_faceMax[i]) / REAL(2) ;
+		index[i] = i ;
+	}
+
+	Node root ;
+	root.first = 0 ;
+	root.count = nb ;
+	m_nodes.reserve(2 * nb / m_maxLeafSize + 1) ;
+	m_nodes.push_back(root) ;
+
+	std::vector<unsigned int> stack ;
+	stack.push_back(0) ;
+
+	while (!stack.empty())
+	{
+		unsigned int ni = stack.back() ;
+		stack.pop_back() ;
+
+		const unsigned int begin = m_nodes[ni].first ;
+		const unsigned int count = m_nodes[ni].count ;
+		const unsigned int end = begin + count ;
+
+		VEC3 bbMin = m_faceMin[index[begin]] ;
+		VEC3 bbMax = m_faceMax[index[begin]] ;
+		VEC3 cMin = centroids[index[begin]] ;
+		VEC3 cMax = cMin ;
+		for (unsigned int i = begin + 1 ; i < end ; ++i)
+		{
+			unsigned int f = index[i] ;
+			mergeBox(bbMin, bbMax, m_faceMin[f], m_faceMax[f]) ;
+			mergeBox(cMin, cMax, centroids[f], centroids[f]) ;
+		}
+		m_nodes[ni].bbMin = bbMin ;
+		m_nodes[ni].bbMax = bbMax ;
+
+		if (count <= m_maxLeafSize)
+			continue ;
+
+		unsigned int axis = 0 ;
+		VEC3 ext = cMax - cMin ;
+		if (ext[1] > ext[axis]) axis = 1 ;
+		if (ext[2] > ext[axis]) axis = 2 ;
+
+		unsigned int mid = begin + count / 2 ;
+
+		if (ext[axis] > REAL(0))
+		{
+			// binned SAH along the axis of largest centroid extent
+			unsigned int binCount[NB_BINS] ;
+			VEC3 binMin[NB_BINS] ;
+			VEC3 binMax[NB_BINS] ;
+			for (unsigned int b = 0 ; b < NB_BINS ; ++b)
+				binCount[b] = 0 ;
+
+			const REAL scale = REAL(NB_BINS) / ext[axis] ;
+			auto binOf = [&] (unsigned int f) -> unsigned int
+			{
+				unsigned int b = (unsigned int)((centroids[f][axis] - cMin[axis]) * scale) ;
+				return b < NB_BINS ? b : NB_BINS - 1 ;
+			};
+
+			for (unsigned int i = begin ; i < end ; ++i)
+			{
+				unsigned int f = index[i] ;
+				unsigned int b = binOf(f) ;
+				if (binCount[b] == 0)
+				{
+					binMin[b] = m_faceMin[f] ;
+					binMax[b] = m_faceMax[f] ;
+				}
+				else
+					mergeBox(binMin[b], binMax[b], m_faceMin[f], m_faceMax[f]) ;
+				++binCount[b] ;
+			}
+
+			auto halfArea = [] (const VEC3& m, const VEC3& M) -> REAL
+			{
+				VEC3 e = M - m ;
+				return e[0] * e[1] + e[1] * e[2] + e[2] * e[0] ;
+			};
+
+			// sweep from the right to get the cost of the right parts
+			REAL rightCost[NB_BINS] ;
+			unsigned int nbRight = 0 ;
+			VEC3 rMin, rMax ;
+			for (unsigned int b = NB_BINS - 1 ; b > 0 ; --b)
+			{
+				if (binCount[b] > 0)
+				{
+					if (nbRight == 0)
+					{
+						rMin = binMin[b] ;
+						rMax = binMax[b] ;
+					}
+					else
+						mergeBox(rMin, rMax, binMin[b], binMax[b]) ;
+					nbRight += binCount[b] ;
+				}
+				rightCost[b] = nbRight > 0 ? halfArea(rMin, rMax) * REAL(nbRight) : REAL(0) ;
+			}
+
+			unsigned int bestSplit = 0 ;
+			REAL bestCost = std::numeric_limits<REAL>::max() ;
+			unsigned int nbLeft = 0 ;
+			VEC3 lMin, lMax ;
+			for (unsigned int b = 1 ; b < NB_BINS ; ++b)
+			{
+				unsigned int p = b - 1 ;
+				if (binCount[p] > 0)
+				{
+					if (nbLeft == 0)
+					{
+						lMin = binMin[p] ;
+						lMax = binMax[p] ;
+					}
+					else
+						mergeBox(lMin, lMax, binMin[p], binMax[p]) ;
+					nbLeft += binCount[p] ;
+				}
+				if (nbLeft == 0 || nbLeft == count)
+					continue ;
+				REAL cost = halfArea(lMin, lMax) * REAL(nbLeft) + rightCost[b] ;
+				if (cost < bestCost)
+				{
+					bestCost = cost ;
+					bestSplit = b ;
+				}
+			}
+
+			// keep small nodes as leaves when splitting does not pay
+			if (bestCost >= halfArea(bbMin, bbMax) * REAL(count) && count <= 4 * m_maxLeafSize)
+				continue ;
+
+			if (bestSplit > 0)
+				mid = (unsigned int)(std::partition(index.begin() + begin, index.begin() + end,
+					[&] (unsigned int f) { return binOf(f) < bestSplit ; }) - index.begin()) ;
+		}
+
+		Node left ;
+		left.first = begin ;
+		left.count = mid - begin ;
+		Node right ;
+		right.first = mid ;
+		right.count = end - mid ;
+
+		unsigned int li = (unsigned int)(m_nodes.size()) ;
+		m_nodes.push_back(left) ;
+		m_nodes.push_back(right) ;
+		m_nodes[ni].first = li ;
+		m_nodes[ni].count = 0 ;
+
+		stack.push_back(li) ;
+		stack.push_back(li + 1) ;
+	}
+
+	// store faces in leaf order
+	std::vector<Face> faces(nb) ;
+	std::vector<VEC3> faceMin(nb) ;
+	std::vector<VEC3> faceMax(nb) ;
+	for (unsigned int i = 0 ; i < nb ; ++i)
+	{
+		faces[i] = m_faces[index[i]] ;
+		faceMin[i] = m_faceMin[index[i]] ;
+		faceMax[i] = m_faceMax[index[i]] ;
+	}
+	m_faces.swap(faces) ;
+	m_faceMin.swap(faceMin) ;
+	m_faceMax.swap(faceMax) ;
+}
+
+template <typename PFP>
+void BVH<PFP>::refit()
+{
+	const unsigned int nb = (unsigned int)(m_faces.size()) ;
+	for (unsigned int i = 0 ; i < nb ; ++i)
+		computeFaceBox(i) ;
+
+	// children are always stored after their parent
+	for (unsigned int ni = (unsigned int)(m_nodes.size()) ; ni-- > 0 ; )
+		computeNodeBox(m_nodes[ni]) ;
+}
+
+template <typename PFP>
+bool BVH<PFP>::rayBoxIntersection(const VEC3& bbMin, const VEC3& bbMax, const VEC3& rayA, const VEC3& rayAB, REAL dilation, bool line, REAL& tNear) const
+{
+	REAL tMin = line ? -std::numeric_limits<REAL>::max() : REAL(0) ;
+	REAL tMax = std::numeric_limits<REAL>::max() ;
+
+	for (unsigned int k = 0 ; k < 3 ; ++k)
+	{
+		REAL lo = bbMin[k] - dilation ;
+		REAL hi = bbMax[k] + dilation ;
+		if (rayAB[k] == REAL(0))
+		{
+			if (rayA[k] < lo || rayA[k] > hi)
+				return false ;
+		}
+		else
+		{
+			REAL t1 = (lo - rayA[k]) / rayAB[k] ;
+			REAL t2 = (hi - rayA[k]) / rayAB[k] ;
+			if (t1 > t2)
+				std::swap(t1, t2) ;
+			if (t1 > tMin) tMin = t1 ;
+			if (t2 < tMax) tMax = t2 ;
+			if (tMin > tMax)
+				return false ;
+		}
+	}
+
+	tNear = tMin ;
+	return true ;
+}
+
+template <typename PFP>
+bool BVH<PFP>::rayFaceIntersection(Face f, const VEC3& rayA, const VEC3& rayAB, VEC3& I) const
+{
+	const VEC3& Ta = m_position[f.dart] ;
+	Dart dd = m_map.phi1(f.dart) ;
+	Dart ddd = m_map.phi1(dd) ;
+	do
+	{
+		if (Geom::intersectionRayTriangleOpt<VEC3>(rayA, rayAB, Ta, m_position[dd], m_position[ddd], I))
+			return true ;
+		dd = ddd ;
+		ddd = m_map.phi1(dd) ;
+	} while (ddd != f.dart) ;
+	return false ;
+}
+
+template <typename PFP>
+typename PFP::REAL BVH<PFP>::squaredDistanceBox2Point(const VEC3& bbMin, const VEC3& bbMax, const VEC3& P)
+{
+	REAL d2(0) ;
+	for (unsigned int k = 0 ; k < 3 ; ++k)
+	{
+		if (P[k] < bbMin[k])
+			d2 += (bbMin[k] - P[k]) * (bbMin[k] - P[k]) ;
+		else if (P[k] > bbMax[k])
+			d2 += (P[k] - bbMax[k]) * (P[k] - bbMax[k]) ;
+	}
+	return d2 ;
+}
+
+template <typename PFP>
+typename PFP::REAL BVH<PFP>::closestPointInFace(Face f, const VEC3& P, VEC3& closest) const
+{
+	REAL best = std::numeric_limits<REAL>::max() ;
+	const VEC3& Ta = m_position[f.dart] ;
+	Dart dd = m_map.phi1(f.dart) ;
+	Dart ddd = m_map.phi1(dd) ;
+	do
+	{
+		const VEC3& Tb = m_position[dd] ;
+		const VEC3& Tc = m_position[ddd] ;
+		double u, v, w ;
+		Geom::closestPointInTriangle(P, Ta, Tb, Tc, u, v, w) ;
+		VEC3 Q = Ta * REAL(u) + Tb * REAL(v) + Tc * REAL(w) ;
+		REAL d2 = (Q - P).norm2() ;
+		if (d2 < best)
+		{
+			best = d2 ;
+			closest = Q ;
+		}
+		dd = ddd ;
+		ddd = m_map.phi1(dd) ;
+	} while (ddd != f.dart) ;
+	return best ;
+}
+
+template <typename PFP>
+bool BVH<PFP>::coneBoxIntersection(const VEC3& bbMin, const VEC3& bbMax, const VEC3& rayA, const VEC3& rayAB, REAL AB2, REAL sin2) const
+{
+	// bounding sphere of the box
+	VEC3 c = (bbMin + bbMax) / REAL(2) ;
+	REAL r = (bbMax - bbMin).norm() / REAL(2) ;
+
+	// lower bound of the distance to the line and upper bound of the distance to the apex
+	REAL d = std::sqrt(Geom::squaredDistanceLine2Point(rayA, rayAB, AB2, c)) - r ;
+	if (d <= REAL(0))
+		return true ;
+	REAL a = (c - rayA).norm() + r ;
+	return d * d < sin2 * a * a ;
+}
+
+template <typename PFP>
+void BVH<PFP>::rayIntersection(const VEC3& rayA, const VEC3& rayAB, std::vector<Face>& faces, std::vector<VEC3>& iPoints) const
+{
+	if (m_nodes.empty())
+		return ;
+
+	std::vector<unsigned int> stack ;
+	stack.reserve(64) ;
+	stack.push_back(0) ;
+
+	REAL tNear ;
+	while (!stack.empty())
+	{
+		const Node& n = m_nodes[stack.back()] ;
+		stack.pop_back() ;
+
+		if (!rayBoxIntersection(n.bbMin, n.bbMax, rayA, rayAB, REAL(0), false, tNear))
+			continue ;
+
+		if (n.count > 0)
+		{
+			for (unsigned int i = n.first ; i < n.first + n.count ; ++i)
+			{
+				VEC3 I ;
+				if (rayFaceIntersection(m_faces[i], rayA, rayAB, I))
+				{
+					faces.push_back(m_faces[i]) ;
+					iPoints.push_back(I) ;
+				}
+			}
+		}
+		else
+		{
+			stack.push_back(n.first) ;
+			stack.push_back(n.first + 1) ;
+		}
+	}
+}
+
+template <typename PFP>
+bool BVH<PFP>::closestRayIntersection(const VEC3& rayA, const VEC3& rayAB, Face& face, VEC3& iPoint) const
+{
+	if (m_nodes.empty())
+		return false ;
+
+	const REAL AB2 = rayAB * rayAB ;
+	REAL best = std::numeric_limits<REAL>::max() ;
+	bool found = false ;
+
+	std::vector<std::pair<unsigned int, REAL> > stack ;
+	stack.reserve(64) ;
+
+	REAL tNear ;
+	if (rayBoxIntersection(m_nodes[0].bbMin, m_nodes[0].bbMax, rayA, rayAB, REAL(0), false, tNear))
+		stack.push_back(std::make_pair(0u, tNear)) ;
+
+	while (!stack.empty())
+	{
+		const Node& n = m_nodes[stack.back().first] ;
+		tNear = stack.back().second ;
+		stack.pop_back() ;
+
+		if (tNear * tNear * AB2 > best)
+			continue ;
+
+		if (n.count > 0)
+		{
+			for (unsigned int i = n.first ; i < n.first + n.count ; ++i)
+			{
+				VEC3 I ;
+				if (rayFaceIntersection(m_faces[i], rayA, rayAB, I))
+				{
+					REAL d2 = (I - rayA).norm2() ;
+					if (d2 < best)
+					{
+						best = d2 ;
+						face = m_faces[i] ;
+						iPoint = I ;
+						found = true ;
+					}
+				}
+			}
+		}
+		else
+		{
+			// push the farthest child first so that the nearest one is visited first
+			REAL t1, t2 ;
+			bool hit1 = rayBoxIntersection(m_nodes[n.first].bbMin, m_nodes[n.first].bbMax, rayA, rayAB, REAL(0), false, t1) ;
+			bool hit2 = rayBoxIntersection(m_nodes[n.first + 1].bbMin, m_nodes[n.first + 1].bbMax, rayA, rayAB, REAL(0), false, t2) ;
+			unsigned int c1 = n.first ;
+			if (hit1 && hit2 && t2 > t1)
+			{
+				std::swap(t1, t2) ;
+				++c1 ;
+				stack.push_back(std::make_pair(c1, t1)) ;
+				stack.push_back(std::make_pair(c1 - 1, t2)) ;
+			}
+			else
+			{
+				if (hit1) stack.push_back(std::make_pair(c1, t1)) ;
+				if (hit2) stack.push_back(std::make_pair(c1 + 1, t2)) ;
+			}
+		}
+	}
+
+	return found ;
+}
+
+template <typename PFP>
+void BVH<PFP>::facesNearLine(const VEC3& rayA, const VEC3& rayAB, REAL dist, std::vector<Face>& faces) const
+{
+	if (m_nodes.empty())
+		return ;
+
+	std::vector<unsigned int> stack ;
+	stack.reserve(64) ;
+	stack.push_back(0) ;
+
+	REAL tNear ;
+	while (!stack.empty())
+	{
+		const Node& n = m_nodes[stack.back()] ;
+		stack.pop_back() ;
+
+		if (!rayBoxIntersection(n.bbMin, n.bbMax, rayA, rayAB, dist, true, tNear))
+			continue ;
+
+		if (n.count > 0)
+		{
+			for (unsigned int i = n.first ; i < n.first + n.count ; ++i)
+			{
+				if (rayBoxIntersection(m_faceMin[i], m_faceMax[i], rayA, rayAB, dist, true, tNear))
+					faces.push_back(m_faces[i]) ;
+			}
+		}
+		else
+		{
+			stack.push_back(n.first) ;
+			stack.push_back(n.first + 1) ;
+		}
+	}
+}
+
+template <typename PFP>
+void BVH<PFP>::facesInCone(const VEC3& rayA, const VEC3& rayAB, float angle, std::vector<Face>& faces) const
+{
+	if (m_nodes.empty())
+		return ;
+
+	const REAL AB2 = rayAB * rayAB ;
+	REAL sin2 = REAL(sin(M_PI / 180.0 * angle)) ;
+	sin2 = sin2 * sin2 ;
+
+	std::vector<unsigned int> stack ;
+	stack.reserve(64) ;
+	stack.push_back(0) ;
+
+	while (!stack.empty())
+	{
+		const Node& n = m_nodes[stack.back()] ;
+		stack.pop_back() ;
+
+		if (!coneBoxIntersection(n.bbMin, n.bbMax, rayA, rayAB, AB2, sin2))
+			continue ;
+
+		if (n.count > 0)
+		{
+			for (unsigned int i = n.first ; i < n.first + n.count ; ++i)
+			{
+				if (coneBoxIntersection(m_faceMin[i], m_faceMax[i], rayA, rayAB, AB2, sin2))
+					faces.push_back(m_faces[i]) ;
+			}
+		}
+		else
+		{
+			stack.push_back(n.first) ;
+			stack.push_back(n.first + 1) ;
+		}
+	}
+}
+
+template <typename PFP>
+typename PFP::REAL BVH<PFP>::closestPoint(const VEC3& P, Face& face, VEC3& closest, REAL maxDist2) const
+{
+	REAL best = maxDist2 ;
+	if (m_nodes.empty())
+		return best ;
+
+	std::vector<std::pair<unsigned int, REAL> > stack ;
+	stack.reserve(64) ;
+	stack.push_back(std::make_pair(0u, squaredDistanceBox2Point(m_nodes[0].bbMin, m_nodes[0].bbMax, P))) ;
+
+	while (!stack.empty())
+	{
+		const Node& n = m_nodes[stack.back().first] ;
+		REAL d2 = stack.back().second ;
+		stack.pop_back() ;
+
+		if (d2 >= best)
+			continue ;
+
+		if (n.count > 0)
+		{
+			for (unsigned int i = n.first ; i < n.first + n.count ; ++i)
+			{
+				if (squaredDistanceBox2Point(m_faceMin[i], m_faceMax[i], P) >= best)
+					continue ;
+				VEC3 Q ;
+				REAL fd2 = closestPointInFace(m_faces[i], P, Q) ;
+				if (fd2 < best)
+				{
+					best = fd2 ;
+					face = m_faces[i] ;
+					closest = Q ;
+				}
+			}
+		}
+		else
+		{
+			// push the farthest child first so that the nearest one is visited first
+			REAL dLeft = squaredDistanceBox2Point(m_nodes[n.first].bbMin, m_nodes[n.first].bbMax, P) ;
+			REAL dRight = squaredDistanceBox2Point(m_nodes[n.first + 1].bbMin, m_nodes[n.first + 1].bbMax, P) ;
+			if (dLeft < dRight)
+			{
+				stack.push_back(std::make_pair(n.first + 1, dRight)) ;
+				stack.push_back(std::make_pair(n.first, dLeft)) ;
+			}
+			else
+			{
+				stack.push_back(std::make_pair(n.first, dLeft)) ;
+				stack.push_back(std::make_pair(n.first + 1, dRight)) ;
+			}
+		}
+	}
+
+	return best ;
+}
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
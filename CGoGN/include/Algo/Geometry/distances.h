@@ -25,6 +25,8 @@
 #ifndef __ALGO_GEOMETRY_DISTANCE_H__
 #define __ALGO_GEOMETRY_DISTANCE_H__
 
+#include "Algo/Geometry/bvh.h"
+
 namespace CGoGN
 {
 
@@ -81,9 +83,77 @@ void closestPointInTriangle(typename PFP::MAP& map, Face f, const VertexAttribut
 template <typename PFP>
 typename PFP::REAL squaredDistancePoint2Edge(typename PFP::MAP& map, Edge e, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const typename PFP::VEC3& P) ;
 
-//template <typename PFP>
-//void computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
-//					 typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2) ;
+/**
+* statistics of the distances from the vertices of a mesh to another mesh
+* (max is the one-sided Hausdorff distance)
+*/
+template <typename REAL>
+struct DistanceStats
+{
+	REAL min ;
+	REAL max ;
+	REAL mean ;
+	REAL rms ;
+	unsigned int nbVertices ;
+
+	DistanceStats() : min(0), max(0), mean(0), rms(0), nbVertices(0) {}
+} ;
+
+/**
+* compute for each vertex of map1 its distance to the faces stored in a BVH
+* @param map1 the map whose vertices are measured
+* @param position1 the vertex attribute storing positions of map1
+* @param distance1 (out) the distance of each vertex of map1
+* @param bvh2 the BVH built on the faces of the second mesh
+* @return the statistics of the distances
+*/
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  const BVH<PFP>& bvh2) ;
+
+/**
+* compute for each vertex of map1 its distance to the surface of map2
+* (a BVH is built on the faces of map2)
+* @return the statistics of the distances
+*/
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2) ;
+
+/**
+* compute the distances from map1 to map2 and from map2 to map1
+* @param stats12 (out) statistics of the distances from map1 to map2
+* @param stats21 (out) statistics of the distances from map2 to map1
+* @return the statistics over the vertices of both maps (max is the symmetric Hausdorff distance)
+*/
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeSymmetricDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+														   typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance2,
+														   DistanceStats<typename PFP::REAL>& stats12, DistanceStats<typename PFP::REAL>& stats21) ;
+
+/**
+* merge the statistics of two sets of distances
+*/
+template <typename REAL>
+DistanceStats<REAL> mergeDistanceStats(const DistanceStats<REAL>& s1, const DistanceStats<REAL>& s2) ;
+
+namespace Parallel
+{
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  const BVH<PFP>& bvh2) ;
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2) ;
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeSymmetricDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+														   typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance2,
+														   DistanceStats<typename PFP::REAL>& stats12, DistanceStats<typename PFP::REAL>& stats21) ;
+
+} // namespace Parallel
 
 } // namespace Geometry
 
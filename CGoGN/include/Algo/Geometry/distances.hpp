@@ -23,6 +23,11 @@
 *******************************************************************************/
 
 #include "Geometry/distances.h"
+#include "Topology/generic/traversor/traversorCell.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace CGoGN
 {
@@ -89,6 +94,143 @@ typename PFP::REAL squaredDistancePoint2Edge(typename PFP::MAP& map, Edge e, con
 	return Geom::squaredDistanceSeg2Point(A, AB, AB2, P) ;
 }
 
+template <typename REAL>
+DistanceStats<REAL> mergeDistanceStats(const DistanceStats<REAL>& s1, const DistanceStats<REAL>& s2)
+{
+	if (s1.nbVertices == 0)
+		return s2 ;
+	if (s2.nbVertices == 0)
+		return s1 ;
+
+	DistanceStats<REAL> s ;
+	s.nbVertices = s1.nbVertices + s2.nbVertices ;
+	s.min = std::min(s1.min, s2.min) ;
+	s.max = std::max(s1.max, s2.max) ;
+	s.mean = (s1.mean * s1.nbVertices + s2.mean * s2.nbVertices) / s.nbVertices ;
+	s.rms = std::sqrt((s1.rms * s1.rms * s1.nbVertices + s2.rms * s2.rms * s2.nbVertices) / s.nbVertices) ;
+	return s ;
+}
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  const BVH<PFP>& bvh2)
+{
+	typedef typename PFP::REAL REAL ;
+
+	DistanceStats<REAL> stats ;
+	stats.min = std::numeric_limits<REAL>::max() ;
+	double sum = 0.0 ;
+	double sum2 = 0.0 ;
+
+	foreach_cell<VERTEX>(map1, [&] (Vertex v)
+	{
+		Face f ;
+		typename PFP::VEC3 Q ;
+		REAL d = std::sqrt(bvh2.closestPoint(position1[v], f, Q)) ;
+		distance1[v] = d ;
+		if (d < stats.min) stats.min = d ;
+		if (d > stats.max) stats.max = d ;
+		sum += d ;
+		sum2 += double(d) * double(d) ;
+		++stats.nbVertices ;
+	});
+
+	if (stats.nbVertices > 0)
+	{
+		stats.mean = REAL(sum / stats.nbVertices) ;
+		stats.rms = REAL(std::sqrt(sum2 / stats.nbVertices)) ;
+	}
+	else
+		stats.min = REAL(0) ;
+
+	return stats ;
+}
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	BVH<PFP> bvh2(map2, position2) ;
+	return computeDistance<PFP>(map1, position1, distance1, bvh2) ;
+}
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeSymmetricDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+														   typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance2,
+														   DistanceStats<typename PFP::REAL>& stats12, DistanceStats<typename PFP::REAL>& stats21)
+{
+	stats12 = computeDistance<PFP>(map1, position1, distance1, map2, position2) ;
+	stats21 = computeDistance<PFP>(map2, position2, distance2, map1, position1) ;
+	return mergeDistanceStats(stats12, stats21) ;
+}
+
+namespace Parallel
+{
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  const BVH<PFP>& bvh2)
+{
+	typedef typename PFP::REAL REAL ;
+
+	if (CGoGN::Parallel::NumberOfThreads <= 1)
+		return Geometry::computeDistance<PFP>(map1, position1, distance1, bvh2) ;
+
+	// one accumulator per worker thread: foreach_cell runs nbth-1 workers numbered from 1
+	const unsigned int nbth = CGoGN::Parallel::NumberOfThreads ;
+	std::vector<DistanceStats<REAL> > stats(nbth - 1) ;
+	std::vector<double> sums(nbth - 1, 0.0) ;
+	std::vector<double> sums2(nbth - 1, 0.0) ;
+	for (unsigned int i = 0 ; i < nbth - 1 ; ++i)
+		stats[i].min = std::numeric_limits<REAL>::max() ;
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map1, [&] (Vertex v, unsigned int thr)
+	{
+		Face f ;
+		typename PFP::VEC3 Q ;
+		REAL d = std::sqrt(bvh2.closestPoint(position1[v], f, Q)) ;
+		distance1[v] = d ;
+		DistanceStats<REAL>& s = stats[thr - 1] ;
+		if (d < s.min) s.min = d ;
+		if (d > s.max) s.max = d ;
+		sums[thr - 1] += d ;
+		sums2[thr - 1] += double(d) * double(d) ;
+		++s.nbVertices ;
+	}, AUTO, nbth) ;
+
+	DistanceStats<REAL> result ;
+	for (unsigned int i = 0 ; i < nbth - 1 ; ++i)
+	{
+		if (stats[i].nbVertices > 0)
+		{
+			stats[i].mean = REAL(sums[i] / stats[i].nbVertices) ;
+			stats[i].rms = REAL(std::sqrt(sums2[i] / stats[i].nbVertices)) ;
+			result = mergeDistanceStats(result, stats[i]) ;
+		}
+	}
+	return result ;
+}
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+												  typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2)
+{
+	BVH<PFP> bvh2(map2, position2) ;
+	return Parallel::computeDistance<PFP>(map1, position1, distance1, bvh2) ;
+}
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeSymmetricDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+														   typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance2,
+														   DistanceStats<typename PFP::REAL>& stats12, DistanceStats<typename PFP::REAL>& stats21)
+{
+	stats12 = Parallel::computeDistance<PFP>(map1, position1, distance1, map2, position2) ;
+	stats21 = Parallel::computeDistance<PFP>(map2, position2, distance2, map1, position1) ;
+	return mergeDistanceStats(stats12, stats21) ;
+}
+
+} // namespace Parallel
+
 } // namespace Geometry
 
 } // namespace Algo
@@ -0,0 +1,161 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_GEOMETRY_GATHERED_INDICES_H__
+#define __ALGO_GEOMETRY_GATHERED_INDICES_H__
+
+#include <vector>
+
+#include "Topology/generic/traversor/traversorCell.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Indices of the vertex lines gathered from the topology of a surface,
+ * read by the SIMD kernels (with an AttributeSoA) instead of phi1/phi2 chains.
+ * - faces: triangles first then other faces, vertex lines of face i in
+ *   faceVertices[faceBegin[i], faceBegin[i+1][
+ * - corners: one per dart of a face, sorted by vertex: the corners of vertex i
+ *   are [cornerBegin[i], cornerBegin[i+1][, each one gives the face and the
+ *   lines of its vertex, of the next and of the previous vertex in the face
+ *   (the next vertices of an inner vertex are its one ring)
+ * The indices must be gathered again when the topology of the map changes.
+ */
+class GatheredIndices
+{
+public:
+	std::vector<Dart> faces;
+	unsigned int nbTriangles;
+	std::vector<unsigned int> faceBegin;
+	std::vector<unsigned int> faceVertices;
+
+	std::vector<unsigned int> vertices;
+	std::vector<unsigned char> boundary;
+	std::vector<unsigned int> cornerBegin;
+	std::vector<unsigned int> cornerFace;
+	std::vector<unsigned int> cornerVertex;
+	std::vector<unsigned int> cornerNext;
+	std::vector<unsigned int> cornerPrev;
+
+	GatheredIndices() : nbTriangles(0) {}
+
+	unsigned int nbFaces() const { return (unsigned int)(faces.size()); }
+
+	unsigned int nbVertices() const { return (unsigned int)(vertices.size()); }
+
+	unsigned int nbCorners() const { return (unsigned int)(cornerFace.size()); }
+
+	template <typename MAP>
+	void build(MAP& map)
+	{
+		// faces: triangles first
+		faces.clear();
+		std::vector<Dart> polygons;
+		foreach_cell<FACE>(map, [&] (Face f)
+		{
+			if (map.faceDegree(f) == 3)
+				faces.push_back(f.dart);
+			else
+				polygons.push_back(f.dart);
+		});
+		nbTriangles = (unsigned int)(faces.size());
+		faces.insert(faces.end(), polygons.begin(), polygons.end());
+
+		faceBegin.clear();
+		faceVertices.clear();
+		faceBegin.reserve(faces.size() + 1);
+		faceVertices.reserve(3 * faces.size());
+		for (unsigned int i = 0; i < faces.size(); ++i)
+		{
+			faceBegin.push_back((unsigned int)(faceVertices.size()));
+			Dart d = faces[i];
+			do
+			{
+				faceVertices.push_back(map.template getEmbedding<VERTEX>(d));
+				d = map.phi1(d);
+			} while (d != faces[i]);
+		}
+		faceBegin.push_back((unsigned int)(faceVertices.size()));
+
+		// vertices and index of the vertex of each line
+		vertices.clear();
+		boundary.clear();
+		std::vector<unsigned int> vertexOfLine(map.template getAttributeContainer<VERTEX>().end(), 0xffffffff);
+		foreach_cell<VERTEX>(map, [&] (Vertex v)
+		{
+			vertexOfLine[map.getEmbedding(v)] = (unsigned int)(vertices.size());
+			vertices.push_back(map.getEmbedding(v));
+			boundary.push_back(map.isBoundaryVertex(v) ? 1 : 0);
+		});
+
+		// corners sorted by vertex (counting sort)
+		cornerBegin.assign(vertices.size() + 1, 0);
+		for (unsigned int i = 0; i < faceVertices.size(); ++i)
+			++cornerBegin[vertexOfLine[faceVertices[i]] + 1];
+		for (unsigned int i = 0; i < vertices.size(); ++i)
+			cornerBegin[i + 1] += cornerBegin[i];
+
+		unsigned int nbc = (unsigned int)(faceVertices.size());
+		cornerFace.resize(nbc);
+		cornerVertex.resize(nbc);
+		cornerNext.resize(nbc);
+		cornerPrev.resize(nbc);
+		std::vector<unsigned int> pos(cornerBegin.begin(), cornerBegin.end() - 1);
+		for (unsigned int f = 0; f < faces.size(); ++f)
+		{
+			unsigned int b = faceBegin[f];
+			unsigned int n = faceBegin[f + 1] - b;
+			for (unsigned int j = 0; j < n; ++j)
+			{
+				unsigned int line = faceVertices[b + j];
+				unsigned int c = pos[vertexOfLine[line]]++;
+				cornerFace[c] = f;
+				cornerVertex[c] = line;
+				cornerNext[c] = faceVertices[b + (j + 1) % n];
+				cornerPrev[c] = faceVertices[b + (j + n - 1) % n];
+			}
+		}
+	}
+};
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
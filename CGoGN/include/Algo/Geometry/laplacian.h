@@ -26,6 +26,7 @@
 #define __ALGO_GEOMETRY_LAPLACIAN_H__
 
 #include "Geometry/basic.h"
+#include "Algo/Topo/connectivitySnapshot.h"
 
 namespace CGoGN
 {
@@ -67,6 +68,28 @@ void computeLaplacianCotanVertices(
 	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
 	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian) ;
 
+/**
+ * computeLaplacianTopoVertices on a connectivity snapshot of the map
+ */
+template <typename PFP, typename ATTR_TYPE>
+void computeLaplacianTopoVertices(
+	typename PFP::MAP& map,
+	const Algo::Topo::ConnectivitySnapshot& cs,
+	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
+	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian) ;
+
+/**
+ * computeLaplacianCotanVertices on a connectivity snapshot of the map (edges must be embedded)
+ */
+template <typename PFP, typename ATTR_TYPE>
+void computeLaplacianCotanVertices(
+	typename PFP::MAP& map,
+	const Algo::Topo::ConnectivitySnapshot& cs,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeWeight,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertexArea,
+	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
+	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian) ;
+
 template <typename PFP>
 typename PFP::REAL computeCotanWeightEdge(
 	typename PFP::MAP& map,
@@ -101,6 +124,13 @@ void computeLaplacianTopoVertices(
 	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
 	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian) ;
 
+template <typename PFP, typename ATTR_TYPE>
+void computeLaplacianTopoVertices(
+	typename PFP::MAP& map,
+	const Algo::Topo::ConnectivitySnapshot& cs,
+	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
+	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian) ;
+
 } // namespace Geometry
 
 } // namespace Volume
@@ -110,6 +110,57 @@ void computeLaplacianCotanVertices(
 		laplacian[d] = computeLaplacianCotanVertex<PFP, ATTR_TYPE>(map, d, edgeWeight, vertexArea, attr) ;
 }
 
+template <typename PFP, typename ATTR_TYPE>
+void computeLaplacianTopoVertices(
+	typename PFP::MAP& map,
+	const Algo::Topo::ConnectivitySnapshot& cs,
+	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
+	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian)
+{
+	assert(cs.isUpToDate(map) || !"computeLaplacianTopoVertices: connectivity snapshot is out of date") ;
+
+	cs.foreach_vertex([&] (unsigned int i)
+	{
+		ATTR_TYPE l(0) ;
+		ATTR_TYPE value = attr[cs.vertices[i]] ;
+		for (unsigned int k = cs.neighbourBegin[i]; k < cs.neighbourBegin[i + 1]; ++k)
+			l += attr[cs.neighbours[k]] - value ;
+		l /= cs.degree(i) ;
+		laplacian[cs.vertices[i]] = l ;
+	});
+}
+
+template <typename PFP, typename ATTR_TYPE>
+void computeLaplacianCotanVertices(
+	typename PFP::MAP& map,
+	const Algo::Topo::ConnectivitySnapshot& cs,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeWeight,
+	const VertexAttribute<typename PFP::REAL, typename PFP::MAP>& vertexArea,
+	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
+	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian)
+{
+	typedef typename PFP::REAL REAL;
+
+	assert(cs.isUpToDate(map) || !"computeLaplacianCotanVertices: connectivity snapshot is out of date") ;
+	assert((cs.neighbourEdges.empty() || cs.neighbourEdges[0] != EMBNULL) || !"computeLaplacianCotanVertices: edges must be embedded") ;
+
+	cs.foreach_vertex([&] (unsigned int i)
+	{
+		ATTR_TYPE l(0) ;
+		REAL vArea = vertexArea[cs.vertices[i]] ;
+		ATTR_TYPE value = attr[cs.vertices[i]] ;
+		REAL wSum = 0 ;
+		for (unsigned int k = cs.neighbourBegin[i]; k < cs.neighbourBegin[i + 1]; ++k)
+		{
+			REAL w = edgeWeight[cs.neighbourEdges[k]] / vArea ;
+			l += (attr[cs.neighbours[k]] - value) * w ;
+			wSum += w ;
+		}
+		l /= wSum ;
+		laplacian[cs.vertices[i]] = l ;
+	});
+}
+
 template <typename PFP>
 typename PFP::REAL computeCotanWeightEdge(
 	typename PFP::MAP& map,
@@ -195,6 +246,17 @@ void computeLaplacianTopoVertices(
 		laplacian[d] = computeLaplacianTopoVertex<PFP, ATTR_TYPE>(map, d, attr) ;
 }
 
+template <typename PFP, typename ATTR_TYPE>
+void computeLaplacianTopoVertices(
+	typename PFP::MAP& map,
+	const Algo::Topo::ConnectivitySnapshot& cs,
+	const VertexAttribute<ATTR_TYPE, typename PFP::MAP>& attr,
+	VertexAttribute<ATTR_TYPE, typename PFP::MAP>& laplacian)
+{
+	// the snapshot gives the same neighbourhood in any dimension
+	Algo::Surface::Geometry::computeLaplacianTopoVertices<PFP, ATTR_TYPE>(map, cs, attr, laplacian) ;
+}
+
 } // namespace Geometry
 
 } // namespace Volume
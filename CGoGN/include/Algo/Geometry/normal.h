@@ -26,6 +26,8 @@
 #define __ALGO_GEOMETRY_NORMAL_H__
 
 #include "Geometry/basic.h"
+#include "Topology/generic/attributeSoA.h"
+#include "Algo/Geometry/gatheredIndices.h"
 
 
 namespace CGoGN
@@ -91,6 +93,21 @@ void computeAnglesBetweenNormalsOnEdges(typename PFP::MAP& map, const V_ATT& pos
 
 }
 
+namespace SIMD
+{
+
+/**
+ * compute the normals of the vertices gathered in g from a SoA view of the positions
+ * (same weighting as vertexNormal, corners are processed by packs of Utils::SimdPack<T>::SIZE)
+ */
+template <typename T>
+void computeNormalVertices(const GatheredIndices& g, const AttributeSoA<T, 3>& position, AttributeSoA<T, 3>& normal) ;
+
+template <typename PFP>
+void computeNormalVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal) ;
+
+}
+
 
 } // namespace Geometry
 
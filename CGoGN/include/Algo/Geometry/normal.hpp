@@ -29,6 +29,7 @@
 #include "Topology/generic/traversor/traversor2.h"
 
 #include <cmath>
+#include <algorithm>
 
 namespace CGoGN
 {
@@ -283,6 +284,118 @@ void computeAnglesBetweenNormalsOnEdges(typename PFP::MAP& map, const V_ATT& pos
 
 } // namespace Parallel
 
+namespace SIMD
+{
+
+template <typename T>
+void computeNormalVertices(const GatheredIndices& g, const AttributeSoA<T, 3>& position, AttributeSoA<T, 3>& normal)
+{
+	typedef Utils::SimdPack<T> PACK;
+	typedef Geom::Vector<3, T> VEC3;
+	const unsigned int W = PACK::SIZE;
+
+	normal.resize(position.getNbBlocks() * _BLOCKSIZE_);
+
+	T* buf = static_cast<T*>(Utils::alignedMalloc(12 * W * sizeof(T)));
+
+	// weighted normal of each face: unit normal * area
+	std::vector<T> fn(3 * g.nbFaces());
+	for (unsigned int t = 0; t < g.nbTriangles; t += W)
+	{
+		triangleCross(g, position, t, buf);
+		unsigned int nb = std::min(W, g.nbTriangles - t);
+		for (unsigned int k = 0; k < nb; ++k)
+			for (unsigned int c = 0; c < 3; ++c)
+				fn[3 * (t + k) + c] = T(0.5) * buf[c * W + k];
+	}
+	for (unsigned int f = g.nbTriangles; f < g.nbFaces(); ++f)
+	{
+		unsigned int b = g.faceBegin[f];
+		unsigned int n = g.faceBegin[f + 1] - b;
+		VEC3 N(0);
+		for (unsigned int j = 0; j < n; ++j)
+		{
+			unsigned int lp = g.faceVertices[b + j];
+			unsigned int lq = g.faceVertices[b + (j + 1) % n];
+			N[0] += (position(lp, 1) - position(lq, 1)) * (position(lp, 2) + position(lq, 2));
+			N[1] += (position(lp, 2) - position(lq, 2)) * (position(lp, 0) + position(lq, 0));
+			N[2] += (position(lp, 0) - position(lq, 0)) * (position(lp, 1) + position(lq, 1));
+		}
+		N.normalize();
+		if (N.hasNan())
+			N = VEC3(0);
+		else
+			N *= polygonArea(g, position, f);
+		for (unsigned int c = 0; c < 3; ++c)
+			fn[3 * f + c] = N[c];
+	}
+
+	// contribution of each corner: face normal / (|v1|^2 * |v2|^2)
+	unsigned int nbc = g.nbCorners();
+	std::vector<T> contrib(3 * nbc);
+	T* p = buf + 3 * W;
+	for (unsigned int i = 0; i < nbc; i += W)
+	{
+		for (unsigned int k = 0; k < W; ++k)
+		{
+			unsigned int cr = std::min(i + k, nbc - 1);
+			for (unsigned int c = 0; c < 3; ++c)
+			{
+				buf[c * W + k] = fn[3 * g.cornerFace[cr] + c];
+				p[c * W + k] = position(g.cornerVertex[cr], c);
+				p[(3 + c) * W + k] = position(g.cornerNext[cr], c);
+				p[(6 + c) * W + k] = position(g.cornerPrev[cr], c);
+			}
+		}
+
+		PACK vx = PACK::load(p);
+		PACK vy = PACK::load(p + W);
+		PACK vz = PACK::load(p + 2 * W);
+		PACK ax = PACK::load(p + 3 * W) - vx;
+		PACK ay = PACK::load(p + 4 * W) - vy;
+		PACK az = PACK::load(p + 5 * W) - vz;
+		PACK bx = vx - PACK::load(p + 6 * W);
+		PACK by = vy - PACK::load(p + 7 * W);
+		PACK bz = vz - PACK::load(p + 8 * W);
+		PACK w = PACK::divPositive(PACK(T(1)), (ax * ax + ay * ay + az * az) * (bx * bx + by * by + bz * bz));
+
+		(PACK::load(buf) * w).store(buf);
+		(PACK::load(buf + W) * w).store(buf + W);
+		(PACK::load(buf + 2 * W) * w).store(buf + 2 * W);
+
+		unsigned int nb = std::min(W, nbc - i);
+		for (unsigned int k = 0; k < nb; ++k)
+			for (unsigned int c = 0; c < 3; ++c)
+				contrib[3 * (i + k) + c] = buf[c * W + k];
+	}
+	Utils::alignedFree(buf);
+
+	// sum of the contributions of the corners of each vertex
+	for (unsigned int v = 0; v < g.nbVertices(); ++v)
+	{
+		VEC3 N(0);
+		for (unsigned int cr = g.cornerBegin[v]; cr < g.cornerBegin[v + 1]; ++cr)
+			N += VEC3(contrib[3 * cr], contrib[3 * cr + 1], contrib[3 * cr + 2]);
+		N.normalize();
+		for (unsigned int c = 0; c < 3; ++c)
+			normal(g.vertices[v], c) = N[c];
+	}
+}
+
+template <typename PFP>
+void computeNormalVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal)
+{
+	GatheredIndices g;
+	g.build(map);
+	AttributeSoA<typename PFP::REAL, 3> positionView;
+	positionView.load(position);
+	AttributeSoA<typename PFP::REAL, 3> normalView;
+	computeNormalVertices(g, positionView, normalView);
+	normalView.store(normal);
+}
+
+} // namespace SIMD
+
 
 } // namespace Geometry
 
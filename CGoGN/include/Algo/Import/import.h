@@ -65,6 +65,17 @@ bool importMesh(typename PFP::MAP& map, const std::string& filename, std::vector
 template <typename PFP>
 bool importVoxellisation(typename PFP::MAP& map, Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames, bool mergeCloseVertices=false);
 
+/**
+* import a triangle mesh given by arrays
+* @param map the map in which the function imports the mesh
+* @param positions the positions of the vertices
+* @param triangles the indices in positions of the vertices of the triangles (3 per triangle)
+* @param attrNames attribute names
+* @return a boolean indicating if import was successful
+*/
+template <typename PFP>
+bool importTriangles(typename PFP::MAP& map, const std::vector<typename PFP::VEC3>& positions, const std::vector<unsigned int>& triangles, std::vector<std::string>& attrNames);
+
 /**
  * import a Choupi file
  * @param map
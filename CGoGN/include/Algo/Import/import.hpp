@@ -27,6 +27,7 @@
 #include "Container/fakeAttribute.h"
 #include "Algo/Modelisation/polyhedron.h"
 #include "Algo/Topo/basic.h"
+#include "Algo/Import/orientedPairing.h"
 
 namespace CGoGN
 {
@@ -45,18 +46,17 @@ bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts)
 {
 	typedef typename PFP::MAP MAP;
 
-	VertexAutoAttribute< NoTypeNameAttribute< std::vector<Dart> >, MAP> vecDartsPerVertex(map, "incidents");
-
 	unsigned nbf = mts.getNbFaces();
 	int index = 0;
 	// buffer for tempo faces (used to remove degenerated edges)
 	std::vector<unsigned int> edgesBuffer;
 	edgesBuffer.reserve(16);
 
-	DartMarkerNoUnmark<MAP> m(map) ;
-
-//	unsigned int vemb = EMBNULL;
-//	auto fsetemb = [&] (Dart d) { map.template initDartEmbedding<VERTEX>(d, vemb); };
+	// created darts and their oriented edges for the reconstruction of phi2
+	std::vector<Dart> darts;
+	std::vector<Algo::Import::OrientedKey> keys;
+	darts.reserve(mts.getNbFaces() * 4);
+	keys.reserve(mts.getNbFaces() * 4);
 
 	// for each face of table
 	for(unsigned int i = 0; i < nbf; ++i)
@@ -88,54 +88,24 @@ bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts)
 				unsigned int vemb = edgesBuffer[j];	// get embedding
 				map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
 
-				m.mark(d) ;								// mark on the fly to unmark on second loop
-				vecDartsPerVertex[vemb].push_back(d);	// store incident darts for fast adjacency reconstruction
+				darts.push_back(d);
+				keys.push_back(Algo::Import::OrientedKey(vemb, edgesBuffer[(j + 1) % nbe]));
 				d = map.phi1(d);
 			}
 		}
 	}
 
-	bool needBijectiveCheck = false;
+	// reconstruct neighbourhood: pair opposite half-edges
+	std::vector<unsigned int> partner;
+	bool needBijectiveCheck = Algo::Import::pairOpposite(keys, map.template getAttributeContainer<VERTEX>().end(), partner);
 
-	// reconstruct neighbourhood
 	unsigned int nbBoundaryEdges = 0;
-	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	for (unsigned int i = 0; i < darts.size(); ++i)
 	{
-		if (m.isMarked(d))
-		{
-			// darts incident to end vertex of edge
-			std::vector<Dart>& vec = vecDartsPerVertex[map.phi1(d)];
-
-			unsigned int embd = map.template getEmbedding<VERTEX>(d);
-			Dart good_dart = NIL;
-			bool firstOK = true;
-			for (typename std::vector<Dart>::iterator it = vec.begin(); it != vec.end() && good_dart == NIL; ++it)
-			{
-				if (map.template getEmbedding<VERTEX>(map.phi1(*it)) == embd)
-				{
-					good_dart = *it;
-					if (good_dart == map.phi2(good_dart))
-					{
-						map.sewFaces(d, good_dart, false);
-						m.template unmarkOrbit<EDGE>(d);
-					}
-					else
-					{
-						good_dart = NIL;
-						firstOK = false;
-					}
-				}
-			}
-
-			if (!firstOK)
-				needBijectiveCheck = true;
-
-			if (good_dart == NIL)
-			{
-				m.template unmarkOrbit<EDGE>(d);
-				++nbBoundaryEdges;
-			}
-		}
+		if (partner[i] == EMBNULL)
+			++nbBoundaryEdges;
+		else if (i < partner[i])
+			map.sewFaces(darts[i], darts[partner[i]], false);
 	}
 
 	if (nbBoundaryEdges > 0)
@@ -182,6 +152,17 @@ bool importVoxellisation(typename PFP::MAP& map, Algo::Surface::Modelisation::Vo
     return importMesh<PFP>(map, mts);
 }
 
+template <typename PFP>
+bool importTriangles(typename PFP::MAP& map, const std::vector<typename PFP::VEC3>& positions, const std::vector<unsigned int>& triangles, std::vector<std::string>& attrNames)
+{
+	MeshTablesSurface<PFP> mts(map);
+
+	if(!mts.importTriangles(positions, triangles, attrNames))
+		return false;
+
+	return importMesh<PFP>(map, mts);
+}
+
 template <typename PFP2, typename PFP3>
 bool import3DMap(typename PFP2::MAP& map2, typename PFP3::MAP& map3, std::vector<std::string>& attrNames, bool mergeCloseVertices)
 {
@@ -582,15 +563,15 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
     typedef typename PFP::MAP MAP;
     typedef typename PFP::VEC3 VEC3;
 
-    VertexAutoAttribute< NoTypeNameAttribute< std::vector<Dart> >, MAP> vecDartsPerVertex(map, "incidents");
-
     unsigned int nbv = mtv.getNbVolumes();
     unsigned int index = 0;
     // buffer for tempo faces (used to remove degenerated edges)
     std::vector<unsigned int> edgesBuffer;
     edgesBuffer.reserve(16);
 
-    DartMarkerNoUnmark<MAP> m(map) ;
+    // created darts for the reconstruction of phi3
+    std::vector<Dart> darts;
+    darts.reserve(mtv.getNbVolumes() * 12);
 
     unsigned int vemb = EMBNULL;
     //auto fsetemb = [&] (Dart d) { map.template initDartEmbedding<VERTEX>(d, vemb); };
@@ -640,34 +621,34 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 4.
             d = map.phi1(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
         }
         else if(nbf == 4) //tetrahedral case
         {
@@ -683,8 +664,7 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
                 Dart dd = d;
                 do
                 {
-                    m.mark(dd) ;
-                    vecDartsPerVertex[vemb].push_back(dd);
+                    darts.push_back(dd);
                     dd = map.phi1(map.phi2(dd));
                 } while(dd != d);
 
@@ -701,8 +681,7 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             Dart dd = d;
             do
             {
-                m.mark(dd) ;
-                vecDartsPerVertex[vemb].push_back(dd);
+                darts.push_back(dd);
                 dd = map.phi1(map.phi2(dd));
             } while(dd != d);
 
@@ -715,46 +694,46 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 4.
             d = map.phi1(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 5.
             d = map.phi_1(map.phi2(d));
             vemb = edgesBuffer[4];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
         }
         else if(nbf == 6) //prism case
         {
@@ -764,54 +743,54 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 5.
             d = map.template phi<2112>(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 6.
             d = map.phi_1(d);
             vemb = edgesBuffer[4];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 7.
             d = map.phi_1(d);
             vemb = edgesBuffer[5];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
         }
         else if(nbf == 8) //hexahedral case
@@ -822,72 +801,72 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
             vemb = edgesBuffer[0];		// get embedding
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             Dart dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 2.
             d = map.phi1(d);
             vemb = edgesBuffer[1];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 3.
             d = map.phi1(d);
             vemb = edgesBuffer[2];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 4.
             d = map.phi1(d);
             vemb = edgesBuffer[3];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 5.
             d = map.template phi<2112>(d);
             vemb = edgesBuffer[4];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 6.
             d = map.phi_1(d);
             vemb = edgesBuffer[5];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 7.
             d = map.phi_1(d);
             vemb = edgesBuffer[6];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
             // 8.
             d = map.phi_1(d);
             vemb = edgesBuffer[7];
             map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
             dd = d;
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd); dd = map.phi1(map.phi2(dd));
-            vecDartsPerVertex[vemb].push_back(dd); m.mark(dd);
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd); dd = map.phi1(map.phi2(dd));
+            darts.push_back(dd);
 
         }  //end of hexa
 
@@ -895,43 +874,44 @@ bool importMesh(typename PFP::MAP& map, MeshTablesVolume<PFP>& mtv)
 
     std::cout << " elements created " << std::endl;
 
-    //reconstruct neighbourhood
-    unsigned int nbBoundaryFaces = 0 ;
-    for (Dart d = map.begin(); d != map.end(); map.next(d))
+    //reconstruct neighbourhood: pair opposite faces
+    std::vector<Algo::Import::OrientedKey> keys(darts.size());
+    for (unsigned int i = 0; i < darts.size(); ++i)
     {
-        if (m.isMarked(d))
-        {
-            std::vector<Dart>& vec = vecDartsPerVertex[map.phi1(d)];
+        Dart d = darts[i];
+        unsigned int e0 = map.template getEmbedding<VERTEX>(d);
+        unsigned int e1 = map.template getEmbedding<VERTEX>(map.phi1(d));
+        // the opposite of d goes from e1 to e0 and its previous vertex is the next of e1 in the face of d
+        unsigned int third = (e0 < e1) ? map.template getEmbedding<VERTEX>(map.phi1(map.phi1(d))) : map.template getEmbedding<VERTEX>(map.phi_1(d));
+        keys[i] = Algo::Import::OrientedKey(e0, e1, third);
+    }
 
-            Dart good_dart = NIL;
-            for(typename std::vector<Dart>::iterator it = vec.begin(); it != vec.end() && good_dart == NIL; ++it)
-            {
-                if(map.template getEmbedding<VERTEX>(map.phi1(*it)) == map.template getEmbedding<VERTEX>(d) &&
-                        map.template getEmbedding<VERTEX>(map.phi_1(*it)) == map.template getEmbedding<VERTEX>(map.phi1(map.phi1(d))))
-                {
-                    good_dart = *it ;
-                }
-            }
+    std::vector<unsigned int> partner;
+    Algo::Import::pairOpposite(keys, map.template getAttributeContainer<VERTEX>().end(), partner);
 
-            if (good_dart != NIL)
-            {
-                unsigned int degD = map.faceDegree(d);
-                unsigned int degGD = map.faceDegree(good_dart);
+    for (unsigned int i = 0; i < darts.size(); ++i)
+    {
+        Dart d = darts[i];
+        if (partner[i] != EMBNULL && i < partner[i])
+        {
+            Dart good_dart = darts[partner[i]];
+            if (map.phi3(d) == d && map.phi3(good_dart) == good_dart && map.faceDegree(d) == map.faceDegree(good_dart))
+                map.sewVolumes(d, good_dart, false);
+        }
+    }
 
-                //std::cout << "degD = " << degD << " et degGD = " << degGD << std::endl;
-                if(degD == degGD)
-                {
-                    map.sewVolumes(d, good_dart, false);
-                    m.template unmarkOrbit<FACE>(d);
-                }
-//                else
-//                    std::cout << "erreur : degD != degGD" << std::endl;
-            }
-            else
-            {
-                m.template unmarkOrbit<PFP::MAP::FACE_OF_PARENT>(d);
+    // count each boundary face once (from its dart of lowest index)
+    unsigned int nbBoundaryFaces = 0 ;
+    for (unsigned int i = 0; i < darts.size(); ++i)
+    {
+        Dart d = darts[i];
+        if (map.phi3(d) == d)
+        {
+            bool lowest = true;
+            for (Dart dd = map.phi1(d); dd != d && lowest; dd = map.phi1(dd))
+                lowest = map.dartIndex(dd) > map.dartIndex(d);
+            if (lowest)
                 ++nbBoundaryFaces;
-            }
         }
     }
 
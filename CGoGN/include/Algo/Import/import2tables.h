@@ -34,6 +34,8 @@
 #include "Geometry/matrix.h"
 
 #include "Utils/gzstream.h"
+#include "Utils/mappedFile.h"
+#include "Utils/textParser.h"
 
 #include "Algo/Import/importFileTypes.h"
 #include "Algo/Modelisation/voxellisation.h"
@@ -84,6 +86,42 @@ protected:
 	*/
 	std::vector<unsigned int> m_emb;
 
+	/**
+	* size (bytes) and read time (ms) of the last file imported by a parallel importer
+	*/
+	std::size_t m_importSize;
+	unsigned int m_importTime;
+
+	/**
+	* vertices and faces read in a chunk of a text file by the parallel importers
+	*/
+	struct TextChunk
+	{
+		std::vector<DATA_TYPE> coords;
+		std::vector<short> nbEdges;
+		std::vector<int> indices;
+		// positions in indices of the (OBJ negative) indices relative to the first vertex of the chunk
+		std::vector<unsigned int> relatives;
+		unsigned int nbLines;
+		bool ok;
+
+		TextChunk() : nbLines(0), ok(true) {}
+	};
+
+	/**
+	* call func(i) for the chunks i in [0,nbChunks) on the threads of the pool
+	*/
+	template <typename FUNC>
+	static void foreachChunk(unsigned int nbChunks, FUNC func);
+
+	static void parseObjChunk(const char* begin, const char* end, TextChunk& chunk);
+
+	/**
+	* insert the vertices of coords in the container and fill m_emb and m_nbEdges with the faces of the chunks
+	* (indices of the chunks are given in [0,nbVertices) and checked)
+	*/
+	bool fillTables(const std::vector<DATA_TYPE>& coords, std::vector<TextChunk>& chunks, const std::vector<unsigned int>& vertexOffsets);
+
 #ifdef CGOGN_WITH_ASSIMP
 	void extractMeshRec(AttributeContainer& container, VertexAttribute<VEC3, MAP>& positions, const struct aiScene* scene, const struct aiNode* nd, struct aiMatrix4x4* trafo);
 #endif
@@ -127,10 +165,32 @@ public:
 
     inline unsigned int getEmbIdx(int i) { return  m_emb[i]; }
 
+	/**
+	* size (bytes) of the last file read by a parallel importer (OBJ, OFF)
+	*/
+	inline std::size_t getImportSize() const { return m_importSize; }
+
+	/**
+	* time (ms) spent in the last parallel import (OBJ, OFF)
+	*/
+	inline unsigned int getImportTime() const { return m_importTime; }
+
+	/**
+	* throughput (MB/s) of the last parallel import (OBJ, OFF)
+	*/
+	inline double getImportThroughput() const { return double(m_importSize) / (1048.576 * double(m_importTime > 0 ? m_importTime : 1)); }
+
     bool importMesh(const std::string& filename, std::vector<std::string>& attrNames);
 
     bool importVoxellisation(Algo::Surface::Modelisation::Voxellisation& voxellisation, std::vector<std::string>& attrNames);
 
+	/**
+	* fill the tables with a triangle mesh given by arrays
+	* @param positions the positions of the vertices
+	* @param triangles the indices in positions of the vertices of the triangles (3 per triangle)
+	*/
+	bool importTriangles(const std::vector<VEC3>& positions, const std::vector<unsigned int>& triangles, std::vector<std::string>& attrNames);
+
 	bool importPlySLFgenericBin(const std::string& filename, std::vector<std::string>& attrNames);
 
 	template <typename PFP3>
@@ -138,7 +198,9 @@ public:
 
 
 	MeshTablesSurface(MAP& map):
-		m_map(map)
+		m_map(map),
+		m_importSize(0),
+		m_importTime(0)
     { }
 };
 
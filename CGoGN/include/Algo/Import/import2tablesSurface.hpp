@@ -29,6 +29,8 @@
 #include "Algo/Modelisation/voxellisation.h"
 
 #include "Algo/Import/AHEM.h"
+#include "Utils/threadPool.h"
+#include "Utils/chrono.h"
 
 #include <algorithm>
 
@@ -101,6 +103,42 @@ bool MeshTablesSurface<PFP>::importMesh(const std::string& filename, std::vector
     return false;
 }
 
+template <typename PFP>
+bool MeshTablesSurface<PFP>::importTriangles(const std::vector<VEC3>& positions, const std::vector<unsigned int>& triangles, std::vector<std::string>& attrNames)
+{
+	VertexAttribute<VEC3, MAP> position = m_map.template getAttribute<VEC3, VERTEX, MAP>("position") ;
+
+	if (!position.isValid())
+		position = m_map.template addAttribute<VEC3, VERTEX, MAP>("position") ;
+
+	attrNames.push_back(position.name()) ;
+
+	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
+
+	m_nbVertices = uint32(positions.size()) ;
+	std::vector<unsigned int> verticesID(m_nbVertices) ;
+	for (unsigned int i = 0; i < m_nbVertices; ++i)
+	{
+		verticesID[i] = container.insertLine() ;
+		position[verticesID[i]] = positions[i] ;
+	}
+
+	m_nbFaces = uint32(triangles.size() / 3) ;
+	m_nbEdges.assign(m_nbFaces, 3) ;
+	m_emb.resize(3 * m_nbFaces) ;
+	for (unsigned int i = 0; i < 3 * m_nbFaces; ++i)
+	{
+		if (triangles[i] >= m_nbVertices)
+		{
+			CGoGNerr << "importTriangles: bad vertex index " << triangles[i] << CGoGNendl ;
+			return false ;
+		}
+		m_emb[i] = verticesID[triangles[i]] ;
+	}
+
+	return true ;
+}
+
 template<typename PFP>
 bool MeshTablesSurface<PFP>::importTrian(const std::string& filename, std::vector<std::string>& attrNames)
 {
@@ -238,6 +276,81 @@ bool MeshTablesSurface<PFP>::importTrianBinGz(const std::string& filename, std::
     return true;
 }
 
+template<typename PFP>
+template <typename FUNC>
+void MeshTablesSurface<PFP>::foreachChunk(unsigned int nbChunks, FUNC func)
+{
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads > 1 ? (unsigned int)(CGoGN::Parallel::NumberOfThreads) : 1;
+	if (nbth == 1 || nbChunks == 1)
+	{
+		for (unsigned int i = 0; i < nbChunks; ++i)
+			func(i);
+		return;
+	}
+
+	Utils::WorkStealingRange range(nbChunks, nbth);
+	std::function<void(unsigned int)> job = [&] (unsigned int th)
+	{
+		unsigned int i;
+		while (range.next(th, i))
+			func(i);
+	};
+	Utils::ThreadPool::getInstance().run(nbth, job);
+}
+
+template<typename PFP>
+bool MeshTablesSurface<PFP>::fillTables(const std::vector<DATA_TYPE>& coords, std::vector<TextChunk>& chunks, const std::vector<unsigned int>& vertexOffsets)
+{
+	VertexAttribute<VEC3, MAP> positions = m_map.template getAttribute<VEC3, VERTEX, MAP>("position") ;
+	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
+
+	std::vector<unsigned int> verticesID(m_nbVertices);
+	for (unsigned int i = 0; i < m_nbVertices; ++i)
+	{
+		unsigned int id = container.insertLine();
+		positions[id] = VEC3(coords[3*i], coords[3*i+1], coords[3*i+2]);
+		verticesID[i] = id;
+	}
+
+	// place of the faces of each chunk in the tables
+	unsigned int nbChunks = uint32(chunks.size());
+	std::vector<unsigned int> faceOffsets(nbChunks + 1, 0);
+	std::vector<std::size_t> embOffsets(nbChunks + 1, 0);
+	for (unsigned int i = 0; i < nbChunks; ++i)
+	{
+		faceOffsets[i+1] = faceOffsets[i] + uint32(chunks[i].nbEdges.size());
+		embOffsets[i+1] = embOffsets[i] + chunks[i].indices.size();
+	}
+	m_nbFaces = faceOffsets[nbChunks];
+	m_nbEdges.resize(m_nbFaces);
+	m_emb.resize(embOffsets[nbChunks]);
+
+	foreachChunk(nbChunks, [&] (unsigned int i)
+	{
+		TextChunk& c = chunks[i];
+		for (std::vector<unsigned int>::const_iterator it = c.relatives.begin(); it != c.relatives.end(); ++it)
+			c.indices[*it] += int(vertexOffsets[i]);
+		std::copy(c.nbEdges.begin(), c.nbEdges.end(), m_nbEdges.begin() + faceOffsets[i]);
+		std::vector<unsigned int>::iterator out = m_emb.begin() + embOffsets[i];
+		for (std::vector<int>::const_iterator it = c.indices.begin(); it != c.indices.end(); ++it, ++out)
+		{
+			if (*it < 0 || (unsigned int)(*it) >= m_nbVertices)
+			{
+				c.ok = false;
+				return;
+			}
+			*out = verticesID[*it];
+		}
+	});
+
+	for (unsigned int i = 0; i < nbChunks; ++i)
+	{
+		if (!chunks[i].ok)
+			return false;
+	}
+	return true;
+}
+
 template<typename PFP>
 bool MeshTablesSurface<PFP>::importOff(const std::string& filename, std::vector<std::string>& attrNames)
 {
@@ -248,93 +361,126 @@ bool MeshTablesSurface<PFP>::importOff(const std::string& filename, std::vector<
 
     attrNames.push_back(positions.name()) ;
 
-    AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
-
-    // open file
-    std::ifstream fp(filename.c_str(), std::ios::in);
-    if (!fp.good())
-    {
-        CGoGNerr << "Unable to open file " << filename << CGoGNendl;
-        return false;
-    }
-
-    std::string ligne;
-
-    // lecture de OFF
-    std::getline (fp, ligne);
-    if (ligne.rfind("OFF") == std::string::npos)
-    {
-        CGoGNerr << "Problem reading off file: not an off file" << CGoGNendl;
-        CGoGNerr << ligne << CGoGNendl;
-        return false;
-    }
-
-    // lecture des nombres de sommets/faces/aretes
-    int nbe;
-    {
-        do
-        {
-            std::getline (fp, ligne);
-        } while (ligne.size() == 0);
-
-        std::stringstream oss(ligne);
-        oss >> m_nbVertices;
-        oss >> m_nbFaces;
-        oss >> nbe;
-    }
-
-    //lecture sommets
-    std::vector<unsigned int> verticesID;
-    verticesID.reserve(m_nbVertices);
-    for (unsigned int i = 0; i < m_nbVertices;++i)
-    {
-        do
-        {
-            std::getline (fp, ligne);
-        } while (ligne.size() == 0);
-
-        std::stringstream oss(ligne);
-
-        float x,y,z;
-        oss >> x;
-        oss >> y;
-        oss >> z;
-        // on peut ajouter ici la lecture de couleur si elle existe
-        VEC3 pos(x,y,z);
-
-        unsigned int id = container.insertLine();
-        positions[id] = pos;
-
-        verticesID.push_back(id);
-    }
+	Utils::Chrono chrono;
+	chrono.start();
 
-    // lecture faces
-    // normalement nbVertices*8 devrait suffire largement
-    m_nbEdges.reserve(m_nbFaces);
-    m_emb.reserve(m_nbVertices*8);
-
-    for (unsigned int i = 0; i < m_nbFaces; ++i)
-    {
-        do
-        {
-            std::getline (fp, ligne);
-        } while (ligne.size() == 0);
+	Utils::MappedFile file;
+	if (!file.open(filename))
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+	const char* p = file.data();
+	const char* end = p + file.size();
+
+	// OFF header
+	const char* q = p;
+	Utils::TextParser::nextLine(q, end);
+	if (std::string(p, q).find("OFF") == std::string::npos)
+	{
+		CGoGNerr << "Problem reading off file: not an off file" << CGoGNendl;
+		CGoGNerr << std::string(p, q) << CGoGNendl;
+		return false;
+	}
+	p = std::search(p, q, "OFF", "OFF" + 3) + 3;
+
+	// numbers of vertices/faces/edges (possibly on the OFF line)
+	while (p < end && (Utils::TextParser::endOfLine(p, end) || *p == '#'))
+		Utils::TextParser::nextLine(p, end);
+	long long nbv, nbf, nbe;
+	if (!Utils::TextParser::parseInt(p, end, nbv) || !Utils::TextParser::parseInt(p, end, nbf) || nbv < 0 || nbf < 0)
+	{
+		CGoGNerr << "Problem reading off file: wrong header" << CGoGNendl;
+		return false;
+	}
+	Utils::TextParser::parseInt(p, end, nbe);
+	Utils::TextParser::nextLine(p, end);
+	m_nbVertices = uint32(nbv);
+	m_nbFaces = uint32(nbf);
+
+	// data lines are counted in each chunk, then parsed knowing their global number
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads > 1 ? (unsigned int)(CGoGN::Parallel::NumberOfThreads) : 1;
+	std::size_t bodySize = std::size_t(end - p);
+	unsigned int nbChunks = uint32(std::min<std::size_t>(8 * nbth, bodySize / 65536 + 1));
+	std::vector<std::size_t> bounds;
+	Utils::TextParser::splitInChunks(p, bodySize, nbChunks, bounds);
+
+	std::vector<TextChunk> chunks(nbChunks);
+	foreachChunk(nbChunks, [&] (unsigned int i)
+	{
+		const char* b = p + bounds[i];
+		const char* e = p + bounds[i+1];
+		while (b < e)
+		{
+			if (!Utils::TextParser::endOfLine(b, e) && *b != '#')
+				++chunks[i].nbLines;
+			Utils::TextParser::nextLine(b, e);
+		}
+	});
+
+	std::vector<unsigned int> firstLines(nbChunks + 1, 0);
+	for (unsigned int i = 0; i < nbChunks; ++i)
+		firstLines[i+1] = firstLines[i] + chunks[i].nbLines;
+	if (firstLines[nbChunks] < m_nbVertices + m_nbFaces)
+	{
+		CGoGNerr << "Problem reading off file: not enough lines" << CGoGNendl;
+		return false;
+	}
 
-        std::stringstream oss(ligne);
-        unsigned int n;
-        oss >> n;
-        m_nbEdges.push_back(n);
-        for (unsigned int j = 0; j < n; ++j)
-        {
-            int index; // index du plongement
-            oss >> index;
-            m_emb.push_back(verticesID[index]);
-        }
-        // on peut ajouter ici la lecture de couleur si elle existe
-    }
+	std::vector<DATA_TYPE> coords(3 * std::size_t(m_nbVertices));
+	foreachChunk(nbChunks, [&] (unsigned int i)
+	{
+		TextChunk& c = chunks[i];
+		unsigned int line = firstLines[i];
+		const char* b = p + bounds[i];
+		const char* e = p + bounds[i+1];
+		for (; b < e && line < m_nbVertices + m_nbFaces; Utils::TextParser::nextLine(b, e))
+		{
+			if (Utils::TextParser::endOfLine(b, e) || *b == '#')
+				continue;
+
+			if (line < m_nbVertices)
+			{
+				// colors may follow the position
+				double x, y, z;
+				c.ok &= Utils::TextParser::parseFloat(b, e, x) && Utils::TextParser::parseFloat(b, e, y) && Utils::TextParser::parseFloat(b, e, z);
+				coords[3*std::size_t(line)] = DATA_TYPE(x);
+				coords[3*std::size_t(line)+1] = DATA_TYPE(y);
+				coords[3*std::size_t(line)+2] = DATA_TYPE(z);
+			}
+			else
+			{
+				long long n, index;
+				c.ok &= Utils::TextParser::parseInt(b, e, n);
+				for (long long j = 0; c.ok && j < n; ++j)
+				{
+					c.ok &= Utils::TextParser::parseInt(b, e, index);
+					c.indices.push_back(int(index));
+				}
+				c.nbEdges.push_back(short(n));
+			}
+			++line;
+		}
+	});
+
+	for (unsigned int i = 0; i < nbChunks; ++i)
+	{
+		if (!chunks[i].ok)
+		{
+			CGoGNerr << "Problem reading off file: wrong data" << CGoGNendl;
+			return false;
+		}
+	}
+
+	if (!fillTables(coords, chunks, std::vector<unsigned int>(nbChunks, 0)))
+	{
+		CGoGNerr << "Problem reading off file: wrong vertex index" << CGoGNendl;
+		return false;
+	}
 
-    fp.close();
-    return true;
+	m_importSize = file.size();
+	m_importTime = chrono.elapsed();
+	return true;
 }
 
 template<typename PFP>
@@ -538,7 +684,59 @@ bool MeshTablesSurface<PFP>::importMeshBin(const std::string& filename, std::vec
 }
 
 
-template <typename PFP>
+template<typename PFP>
+void MeshTablesSurface<PFP>::parseObjChunk(const char* b, const char* e, TextChunk& c)
+{
+	unsigned int nbv = 0;
+	for (; b < e; Utils::TextParser::nextLine(b, e))
+	{
+		Utils::TextParser::skipSpaces(b, e);
+		if (b + 1 >= e || !Utils::TextParser::isSpace(b[1]))
+			continue;
+
+		if (b[0] == 'v')
+		{
+			++b;
+			double x, y, z;
+			if (!Utils::TextParser::parseFloat(b, e, x) || !Utils::TextParser::parseFloat(b, e, y) || !Utils::TextParser::parseFloat(b, e, z))
+			{
+				c.ok = false;
+				return;
+			}
+			c.coords.push_back(DATA_TYPE(x));
+			c.coords.push_back(DATA_TYPE(y));
+			c.coords.push_back(DATA_TYPE(z));
+			++nbv;
+		}
+		else if (b[0] == 'f')
+		{
+			++b;
+			short n = 0;
+			while (!Utils::TextParser::endOfLine(b, e))
+			{
+				// only the vertex index of v/vt/vn is kept
+				long long index;
+				if (!Utils::TextParser::parseInt(b, e, index) || index == 0)
+				{
+					c.ok = false;
+					return;
+				}
+				if (index > 0)
+					c.indices.push_back(int(index - 1)); // obj indices begin at 1
+				else
+				{
+					c.relatives.push_back(uint32(c.indices.size()));
+					c.indices.push_back(int(nbv + index));
+				}
+				Utils::TextParser::skipToken(b, e);
+				++n;
+			}
+			c.nbEdges.push_back(n);
+		}
+	}
+}
+
+template<typename PFP>
 bool MeshTablesSurface<PFP>::importObj(const std::string& filename, std::vector<std::string>& attrNames)
 {
 	VertexAttribute<VEC3, MAP> positions =  m_map.template getAttribute<VEC3, VERTEX, MAP>("position") ;
@@ -548,118 +746,58 @@ bool MeshTablesSurface<PFP>::importObj(const std::string& filename, std::vector<
 
     attrNames.push_back(positions.name()) ;
 
-    AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
-
-    // open file
-    std::ifstream fp(filename.c_str(), std::ios::binary);
-    if (!fp.good())
-    {
-        CGoGNerr << "Unable to open file " << filename << CGoGNendl;
-        return false;
-    }
-
-//	fp.seekg(0, std::ios::end);
-//	int ab = fp.tellg();
-//	fp.seekg(0, std::ios::beg);
-//	int ac = fp.tellg();
-
-    std::string ligne;
-    std::string tag;
-
-    do
-    {
-        fp >> tag;
-        std::getline (fp, ligne);
-    }while (tag != std::string("v"));
-
-    // lecture des sommets
-    std::vector<unsigned int> verticesID;
-    verticesID.reserve(102400); // on tape large (400Ko wahouuuuu !!)
+	Utils::Chrono chrono;
+	chrono.start();
 
-    unsigned int i = 0;
-    do
-    {
-        if (tag == std::string("v"))
-        {
-            std::stringstream oss(ligne);
-
-            float x,y,z;
-            oss >> x;
-            oss >> y;
-            oss >> z;
-
-            VEC3 pos(x,y,z);
-
-            unsigned int id = container.insertLine();
-            positions[id] = pos;
-
-            verticesID.push_back(id);
-            i++;
-        }
-
-        fp >> tag;
-        std::getline(fp, ligne);
-    } while (!fp.eof());
-
-    m_nbVertices = uint32(verticesID.size());
-
-    // close/clear/open only way to go back to beginning of file
-    fp.close();
-    fp.clear();
-    fp.open(filename.c_str());
-
-    do
-    {
-        fp >> tag;
-        std::getline (fp, ligne);
-    } while (tag != std::string("f"));
-
-    m_nbEdges.reserve(verticesID.size()*2);
-    m_emb.reserve(verticesID.size()*8);
-
-    std::vector<int> table;
-    table.reserve(64); // NBV cotes pour une face devrait suffire
-    m_nbFaces = 0;
-    do
-    {
-        if (tag == std::string("f")) // lecture d'une face
-        {
-            std::stringstream oss(ligne);
-            table.clear();
-            while (!oss.eof())  // lecture de tous les indices
-            {
-                std::string str;
-                oss >> str;
-
-                unsigned int ind = 0;
-
-                while ((ind<str.length()) && (str[ind]!='/'))
-                    ind++;
+	Utils::MappedFile file;
+	if (!file.open(filename))
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	// chunks are parsed in parallel, vertices are numbered afterwards
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads > 1 ? (unsigned int)(CGoGN::Parallel::NumberOfThreads) : 1;
+	unsigned int nbChunks = uint32(std::min<std::size_t>(8 * nbth, file.size() / 65536 + 1));
+	std::vector<std::size_t> bounds;
+	Utils::TextParser::splitInChunks(file.data(), file.size(), nbChunks, bounds);
+
+	std::vector<TextChunk> chunks(nbChunks);
+	foreachChunk(nbChunks, [&] (unsigned int i)
+	{
+		parseObjChunk(file.data() + bounds[i], file.data() + bounds[i+1], chunks[i]);
+	});
 
-                if (ind > 0)
-                {
-                    long index;
-                    std::stringstream iss(str.substr(0, ind));
-                    iss >> index;
-                    table.push_back(index);
-                }
-            }
+	std::vector<unsigned int> vertexOffsets(nbChunks, 0);
+	m_nbVertices = 0;
+	for (unsigned int i = 0; i < nbChunks; ++i)
+	{
+		if (!chunks[i].ok)
+		{
+			CGoGNerr << "Problem reading obj file: wrong data" << CGoGNendl;
+			return false;
+		}
+		vertexOffsets[i] = m_nbVertices;
+		m_nbVertices += uint32(chunks[i].coords.size() / 3);
+	}
+
+	std::vector<DATA_TYPE> coords;
+	coords.reserve(3 * std::size_t(m_nbVertices));
+	for (unsigned int i = 0; i < nbChunks; ++i)
+	{
+		coords.insert(coords.end(), chunks[i].coords.begin(), chunks[i].coords.end());
+		std::vector<DATA_TYPE>().swap(chunks[i].coords);
+	}
 
-            unsigned int n = uint32(table.size());
-            m_nbEdges.push_back(short(n));
-            for (unsigned int j = 0; j < n; ++j)
-            {
-                int index = table[j] - 1; // les index commencent a 1 (boufonnerie d'obj ;)
-                m_emb.push_back(verticesID[index]);
-            }
-            m_nbFaces++;
-        }
-        fp >> tag;
-        std::getline(fp, ligne);
-     } while (!fp.eof());
+	if (!fillTables(coords, chunks, vertexOffsets))
+	{
+		CGoGNerr << "Problem reading obj file: wrong vertex index" << CGoGNendl;
+		return false;
+	}
 
-    fp.close ();
-    return true;
+	m_importSize = file.size();
+	m_importTime = chrono.elapsed();
+	return true;
 }
 
 template<typename PFP>
@@ -0,0 +1,188 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_IMPORT_ORIENTED_PAIRING__
+#define __ALGO_IMPORT_ORIENTED_PAIRING__
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+
+#include "Topology/generic/genericmap.h"
+#include "Utils/threadPool.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Import
+{
+
+/**
+ * Oriented element (edge of a face, face of a volume) seen through
+ * the embeddings of its vertices: it goes from origin to end and
+ * third disambiguates elements sharing the same edge (EMBNULL for edges).
+ * Two elements are opposite when they have the same extremities,
+ * the same third vertex and reversed orientations.
+ */
+struct OrientedKey
+{
+	unsigned int origin;
+	unsigned int end;
+	unsigned int third;
+
+	OrientedKey() : origin(EMBNULL), end(EMBNULL), third(EMBNULL) {}
+	OrientedKey(unsigned int o, unsigned int e, unsigned int t = EMBNULL) : origin(o), end(e), third(t) {}
+
+	unsigned int low() const { return std::min(origin, end); }
+	unsigned int high() const { return std::max(origin, end); }
+	bool reversed() const { return origin > end; }
+};
+
+/**
+ * Pair each element with an opposite one, in linear time:
+ * elements are bucketed by their lowest vertex (counting sort), then each
+ * (small) bucket is sorted and scanned, buckets being processed in parallel.
+ * When more than two elements share the same key, each element is paired with
+ * the first free opposite one in the order of the table (as the former per vertex search).
+ * @param keys the elements
+ * @param nbVertices upper bound of the vertex embeddings used in keys
+ * @param partner (out) index of the element paired with each element, or EMBNULL if none
+ * @param nbth number of threads
+ * @return true if some keys are shared by more than two elements (non manifold input)
+ */
+inline bool pairOpposite(const std::vector<OrientedKey>& keys, unsigned int nbVertices, std::vector<unsigned int>& partner, unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	const unsigned int nbk = uint32(keys.size());
+	partner.assign(nbk, EMBNULL);
+
+	// counting sort of the elements by lowest vertex (stable)
+	std::vector<unsigned int> bucketBegin(nbVertices + 1, 0);
+	for (unsigned int i = 0; i < nbk; ++i)
+		++bucketBegin[keys[i].low() + 1];
+	for (unsigned int v = 0; v < nbVertices; ++v)
+		bucketBegin[v + 1] += bucketBegin[v];
+
+	std::vector<unsigned int> sorted(nbk);
+	{
+		std::vector<unsigned int> pos(bucketBegin.begin(), bucketBegin.end() - 1);
+		for (unsigned int i = 0; i < nbk; ++i)
+			sorted[pos[keys[i].low()]++] = i;
+	}
+
+	std::atomic<bool> nonManifold(false);
+
+	auto pairBucket = [&] (unsigned int v)
+	{
+		unsigned int b = bucketBegin[v];
+		unsigned int e = bucketBegin[v + 1];
+		if (e - b < 2)
+			return;
+
+		std::sort(sorted.begin() + b, sorted.begin() + e, [&] (unsigned int i, unsigned int j)
+		{
+			const OrientedKey& ki = keys[i];
+			const OrientedKey& kj = keys[j];
+			if (ki.high() != kj.high())
+				return ki.high() < kj.high();
+			if (ki.third != kj.third)
+				return ki.third < kj.third;
+			return i < j;
+		});
+
+		// runs of elements with the same key
+		while (b < e)
+		{
+			const OrientedKey& kb = keys[sorted[b]];
+			unsigned int r = b + 1;
+			while (r < e && keys[sorted[r]].high() == kb.high() && keys[sorted[r]].third == kb.third)
+				++r;
+
+			if (r - b == 2)
+			{
+				unsigned int i = sorted[b];
+				unsigned int j = sorted[b + 1];
+				if (keys[i].reversed() != keys[j].reversed())
+				{
+					partner[i] = j;
+					partner[j] = i;
+				}
+			}
+			else if (r - b > 2)
+			{
+				nonManifold = true;
+				for (unsigned int k = b; k < r; ++k)
+				{
+					unsigned int i = sorted[k];
+					for (unsigned int l = k + 1; l < r && partner[i] == EMBNULL; ++l)
+					{
+						unsigned int j = sorted[l];
+						if (partner[j] == EMBNULL && keys[i].reversed() != keys[j].reversed())
+						{
+							partner[i] = j;
+							partner[j] = i;
+						}
+					}
+				}
+			}
+			b = r;
+		}
+	};
+
+	if (nbth <= 1 || nbVertices < 4096)
+	{
+		for (unsigned int v = 0; v < nbVertices; ++v)
+			pairBucket(v);
+	}
+	else
+	{
+		const unsigned int cs = 1024;
+		Utils::WorkStealingRange range((nbVertices + cs - 1) / cs, nbth);
+		std::function<void(unsigned int)> job = [&] (unsigned int th)
+		{
+			unsigned int chunk;
+			while (range.next(th, chunk))
+			{
+				unsigned int e = std::min(chunk * cs + cs, nbVertices);
+				for (unsigned int v = chunk * cs; v < e; ++v)
+					pairBucket(v);
+			}
+		};
+		Utils::ThreadPool::getInstance().run(nbth, job);
+	}
+
+	return nonManifold;
+}
+
+} // namespace Import
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
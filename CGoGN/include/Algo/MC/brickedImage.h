@@ -0,0 +1,228 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef BRICKED_IMAGE_H
+#define BRICKED_IMAGE_H
+
+#include "Algo/MC/image.h"
+#include "Utils/mappedFile.h"
+
+#include <vector>
+#include <string>
+#include <atomic>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace MC
+{
+
+/**
+ * voxel image stored by bricks
+ *
+ * The image is cut in bricks of BRICK_SIZE^3 voxels. Uniform bricks
+ * (all voxels with the same value) only store their value.
+ * The image can be built from a dense image or read lazily from a
+ * memory mapped raw or inr file: a brick is read (and tested for
+ * uniformity) the first time it is accessed, which can be done
+ * concurrently by several threads.
+ * @param DataType the type of voxel
+ */
+template< typename  DataType >
+class BrickedImage
+{
+public:
+	/**
+	 * number of voxels of the side of a brick
+	 */
+	static const int BRICK_SIZE = 16;
+
+protected:
+	enum { BRICK_UNLOADED = 0, BRICK_LOADING = 1, BRICK_LOADED = 2 };
+
+	/**
+	 * sizes of the image
+	 */
+	int m_WX;
+	int m_WY;
+	int m_WZ;
+
+	/**
+	 * number of bricks in X, Y, Z
+	 */
+	int m_NBX;
+	int m_NBY;
+	int m_NBZ;
+
+	/**
+	 * voxel sizes
+	 */
+	float m_SX;
+	float m_SY;
+	float m_SZ;
+
+	/**
+	 * voxels of the bricks (NULL for uniform bricks)
+	 */
+	mutable std::vector<DataType*> m_bricks;
+
+	/**
+	 * value of the uniform bricks
+	 */
+	mutable std::vector<DataType> m_uniform;
+
+	/**
+	 * loading state of the bricks (for lazy reading)
+	 */
+	mutable std::vector< std::atomic<unsigned char> > m_state;
+
+	/**
+	 * mapped file and address of the first voxel in it
+	 */
+	Utils::MappedFile m_file;
+	const DataType* m_fileData;
+
+	/**
+	 * number of bricks whose voxels are stored
+	 */
+	mutable std::atomic<unsigned int> m_nbStoredBricks;
+
+	/**
+	 * allocate the table of bricks for the current sizes
+	 */
+	void initBricks();
+
+	/**
+	 * read a brick from the mapped file
+	 */
+	void loadBrick(unsigned int b) const;
+
+	/**
+	 * store the voxels of a brick (taken from a dense array of widths wx,wy)
+	 * or only its value if it is uniform
+	 */
+	void storeBrick(unsigned int b, const DataType* data, int wx, int wxy) const;
+
+	/**
+	 * make sure the brick is loaded
+	 */
+	void ensureLoaded(unsigned int b) const;
+
+	unsigned int brickIndex(int bx, int by, int bz) const { return (unsigned int)(bx + m_NBX * (by + m_NBY * bz)); }
+
+	BrickedImage(const BrickedImage&);
+	BrickedImage& operator=(const BrickedImage&);
+
+public:
+	BrickedImage();
+
+	~BrickedImage();
+
+	/**
+	 * remove all bricks and close the file
+	 */
+	void clear();
+
+	/**
+	 * build the bricks from a dense image
+	 */
+	void create(const Image<DataType>& img);
+
+	/**
+	 * map a raw file (three int sizes then the voxels, as Image::loadRaw)
+	 * @return true if OK
+	 */
+	bool openRaw(const std::string& filename);
+
+	/**
+	 * map a raw file without header
+	 * @param offset size in bytes of the header to skip
+	 */
+	bool openRaw(const std::string& filename, int wx, int wy, int wz, std::size_t offset = 0);
+
+	/**
+	 * map a non compressed inr file
+	 * (with scalar voxels whose TYPE and PIXSIZE match DataType, in the byte order of the machine)
+	 * @return false if the voxels of the file are not of type DataType
+	 */
+	bool openInr(const std::string& filename);
+
+	int getWidthX() const { return m_WX; }
+	int getWidthY() const { return m_WY; }
+	int getWidthZ() const { return m_WZ; }
+
+	int getNbBricksX() const { return m_NBX; }
+	int getNbBricksY() const { return m_NBY; }
+	int getNbBricksZ() const { return m_NBZ; }
+
+	void setVoxelSize(float vx, float vy, float vz) { m_SX = vx; m_SY = vy; m_SZ = vz; }
+	float getVoxSizeX() const { return m_SX; }
+	float getVoxSizeY() const { return m_SY; }
+	float getVoxSizeZ() const { return m_SZ; }
+
+	/**
+	 * get the voxel value
+	 */
+	DataType getVoxel(int x, int y, int z) const;
+
+	/**
+	 * test if a brick is uniform (the brick is loaded if needed)
+	 * @param val (out) value of the voxels of a uniform brick
+	 */
+	bool isUniform(int bx, int by, int bz, DataType& val) const;
+
+	/**
+	 * copy the voxels of the box [x0,x0+sx)x[y0,y0+sy)x[z0,z0+sz) in dst (x first)
+	 */
+	void copyBox(int x0, int y0, int z0, int sx, int sy, int sz, DataType* dst) const;
+
+	/**
+	 * number of bricks whose voxels are stored (the others are uniform or not read)
+	 */
+	unsigned int getNbStoredBricks() const { return m_nbStoredBricks; }
+
+	/**
+	 * memory used by the voxels of the stored bricks (in bytes)
+	 */
+	std::size_t getStoredSize() const { return std::size_t(m_nbStoredBricks) * BRICK_SIZE * BRICK_SIZE * BRICK_SIZE * sizeof(DataType); }
+};
+
+} // namespace MC
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/MC/brickedImage.hpp"
+
+#endif
@@ -0,0 +1,350 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace MC
+{
+
+template< typename  DataType >
+BrickedImage<DataType>::BrickedImage():
+	m_WX(0), m_WY(0), m_WZ(0),
+	m_NBX(0), m_NBY(0), m_NBZ(0),
+	m_SX(1.0f), m_SY(1.0f), m_SZ(1.0f),
+	m_fileData(NULL),
+	m_nbStoredBricks(0)
+{}
+
+template< typename  DataType >
+BrickedImage<DataType>::~BrickedImage()
+{
+	clear();
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::clear()
+{
+	for (typename std::vector<DataType*>::iterator it = m_bricks.begin(); it != m_bricks.end(); ++it)
+		delete[] *it;
+	m_bricks.clear();
+	m_uniform.clear();
+	std::vector< std::atomic<unsigned char> >().swap(m_state);
+	m_nbStoredBricks = 0;
+	m_file.close();
+	m_fileData = NULL;
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::initBricks()
+{
+	m_NBX = (m_WX + BRICK_SIZE - 1) / BRICK_SIZE;
+	m_NBY = (m_WY + BRICK_SIZE - 1) / BRICK_SIZE;
+	m_NBZ = (m_WZ + BRICK_SIZE - 1) / BRICK_SIZE;
+
+	unsigned int nb = (unsigned int)(m_NBX * m_NBY * m_NBZ);
+	m_bricks.assign(nb, NULL);
+	m_uniform.assign(nb, DataType());
+	std::vector< std::atomic<unsigned char> >(nb).swap(m_state);
+	for (unsigned int b = 0; b < nb; ++b)
+		m_state[b].store(BRICK_UNLOADED);
+	m_nbStoredBricks = 0;
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::storeBrick(unsigned int b, const DataType* data, int wx, int wxy) const
+{
+	int bx = int(b % m_NBX);
+	int by = int((b / m_NBX) % m_NBY);
+	int bz = int(b / (m_NBX * m_NBY));
+	int sx = std::min(BRICK_SIZE, m_WX - bx * BRICK_SIZE);
+	int sy = std::min(BRICK_SIZE, m_WY - by * BRICK_SIZE);
+	int sz = std::min(BRICK_SIZE, m_WZ - bz * BRICK_SIZE);
+
+	// uniform test on the voxels of the brick inside the image
+	const DataType* first = data + bx * BRICK_SIZE + std::size_t(by * BRICK_SIZE) * wx + std::size_t(bz * BRICK_SIZE) * wxy;
+	const DataType val = *first;
+	bool uniform = true;
+	for (int z = 0; z < sz && uniform; ++z)
+	{
+		for (int y = 0; y < sy && uniform; ++y)
+		{
+			const DataType* row = first + std::size_t(y) * wx + std::size_t(z) * wxy;
+			for (int x = 0; x < sx; ++x)
+			{
+				if (!(row[x] == val))
+				{
+					uniform = false;
+					break;
+				}
+			}
+		}
+	}
+
+	if (uniform)
+	{
+		m_uniform[b] = val;
+		return;
+	}
+
+	DataType* brick = new DataType[BRICK_SIZE * BRICK_SIZE * BRICK_SIZE];
+	for (int z = 0; z < sz; ++z)
+	{
+		for (int y = 0; y < sy; ++y)
+		{
+			const DataType* row = first + std::size_t(y) * wx + std::size_t(z) * wxy;
+			memcpy(brick + (y + z * BRICK_SIZE) * BRICK_SIZE, row, sx * sizeof(DataType));
+		}
+	}
+	m_bricks[b] = brick;
+	++m_nbStoredBricks;
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::loadBrick(unsigned int b) const
+{
+	storeBrick(b, m_fileData, m_WX, m_WX * m_WY);
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::ensureLoaded(unsigned int b) const
+{
+	std::atomic<unsigned char>& state = m_state[b];
+	if (state.load(std::memory_order_acquire) == BRICK_LOADED)
+		return;
+
+	unsigned char expected = BRICK_UNLOADED;
+	if (state.compare_exchange_strong(expected, BRICK_LOADING))
+	{
+		loadBrick(b);
+		state.store(BRICK_LOADED, std::memory_order_release);
+		return;
+	}
+
+	// another thread is reading the brick
+	while (state.load(std::memory_order_acquire) != BRICK_LOADED)
+		std::this_thread::yield();
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::create(const Image<DataType>& img)
+{
+	clear();
+	m_WX = img.getWidthX();
+	m_WY = img.getWidthY();
+	m_WZ = img.getWidthZ();
+	m_SX = img.getVoxSizeX();
+	m_SY = img.getVoxSizeY();
+	m_SZ = img.getVoxSizeZ();
+	initBricks();
+
+	for (unsigned int b = 0; b < m_bricks.size(); ++b)
+	{
+		storeBrick(b, img.getData(), m_WX, m_WX * m_WY);
+		m_state[b].store(BRICK_LOADED);
+	}
+}
+
+template< typename  DataType >
+bool BrickedImage<DataType>::openRaw(const std::string& filename)
+{
+	std::ifstream fp(filename.c_str(), std::ios::in|std::ios::binary);
+	int sizes[3];
+	fp.read(reinterpret_cast<char*>(sizes), 3 * sizeof(int));
+	if (!fp.good())
+	{
+		CGoGNerr << "BrickedImage::openRaw: Unable to read file " << filename << CGoGNendl;
+		return false;
+	}
+	return openRaw(filename, sizes[0], sizes[1], sizes[2], 3 * sizeof(int));
+}
+
+template< typename  DataType >
+bool BrickedImage<DataType>::openRaw(const std::string& filename, int wx, int wy, int wz, std::size_t offset)
+{
+	clear();
+	if (!m_file.open(filename))
+	{
+		CGoGNerr << "BrickedImage::openRaw: Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	if (wx <= 0 || wy <= 0 || wz <= 0 || m_file.size() < offset + std::size_t(wx) * wy * wz * sizeof(DataType))
+	{
+		CGoGNerr << "BrickedImage::openRaw: file " << filename << " too short" << CGoGNendl;
+		m_file.close();
+		return false;
+	}
+
+	m_WX = wx;
+	m_WY = wy;
+	m_WZ = wz;
+	m_SX = m_SY = m_SZ = 1.0f;
+	m_fileData = reinterpret_cast<const DataType*>(m_file.data() + offset);
+	initBricks();
+	return true;
+}
+
+template< typename  DataType >
+bool BrickedImage<DataType>::openInr(const std::string& filename)
+{
+	// header: "#INRIMAGE-4#{" then KEY=value lines, padded to a multiple of 256 bytes and ended by "##}\n"
+	std::ifstream fp(filename.c_str(), std::ios::in|std::ios::binary);
+	std::string header;
+	char block[256];
+	while (fp.read(block, 256))
+	{
+		header.append(block, 256);
+		if (header.find("##}") != std::string::npos)
+			break;
+	}
+	if (header.compare(0, 12, "#INRIMAGE-4#") != 0 || header.find("##}") == std::string::npos)
+	{
+		CGoGNerr << "BrickedImage::openInr: " << filename << " is not a non compressed inr file" << CGoGNendl;
+		return false;
+	}
+
+	int wx = 0, wy = 0, wz = 1, vdim = 1, pixsize = 0;
+	float vx = 1.0f, vy = 1.0f, vz = 1.0f;
+	std::string type("unsigned fixed");
+	std::istringstream iss(header);
+	std::string line;
+	while (std::getline(iss, line))
+	{
+		std::size_t eq = line.find('=');
+		if (eq == std::string::npos)
+			continue;
+		std::string key = line.substr(0, eq);
+		std::istringstream value(line.substr(eq + 1));
+		if (key == "XDIM") value >> wx;
+		else if (key == "YDIM") value >> wy;
+		else if (key == "ZDIM") value >> wz;
+		else if (key == "VDIM") value >> vdim;
+		else if (key == "TYPE") type = line.substr(eq + 1);
+		else if (key == "PIXSIZE") value >> pixsize;
+		else if (key == "VX") value >> vx;
+		else if (key == "VY") value >> vy;
+		else if (key == "VZ") value >> vz;
+	}
+
+	// the voxels are read as DataType: TYPE and PIXSIZE must describe it
+	bool typeOk;
+	if (type == "float")
+		typeOk = !std::numeric_limits<DataType>::is_integer;
+	else if (type == "unsigned fixed")
+		typeOk = std::numeric_limits<DataType>::is_integer && !std::numeric_limits<DataType>::is_signed;
+	else if (type == "signed fixed")
+		typeOk = std::numeric_limits<DataType>::is_integer && std::numeric_limits<DataType>::is_signed;
+	else
+		typeOk = false;
+
+	if (vdim != 1 || !typeOk || pixsize != int(8 * sizeof(DataType)))
+	{
+		CGoGNerr << "BrickedImage::openInr: voxels of " << filename << " do not match the type of the image" << CGoGNendl;
+		return false;
+	}
+
+	std::size_t offset = header.size();
+	if (!openRaw(filename, wx, wy, wz, offset))
+		return false;
+	setVoxelSize(vx, vy, vz);
+	return true;
+}
+
+template< typename  DataType >
+DataType BrickedImage<DataType>::getVoxel(int x, int y, int z) const
+{
+	unsigned int b = brickIndex(x / BRICK_SIZE, y / BRICK_SIZE, z / BRICK_SIZE);
+	ensureLoaded(b);
+	const DataType* brick = m_bricks[b];
+	if (brick == NULL)
+		return m_uniform[b];
+	return brick[(x % BRICK_SIZE) + BRICK_SIZE * ((y % BRICK_SIZE) + BRICK_SIZE * (z % BRICK_SIZE))];
+}
+
+template< typename  DataType >
+bool BrickedImage<DataType>::isUniform(int bx, int by, int bz, DataType& val) const
+{
+	unsigned int b = brickIndex(bx, by, bz);
+	ensureLoaded(b);
+	val = m_uniform[b];
+	return m_bricks[b] == NULL;
+}
+
+template< typename  DataType >
+void BrickedImage<DataType>::copyBox(int x0, int y0, int z0, int sx, int sy, int sz, DataType* dst) const
+{
+	// copy brick by brick
+	for (int bz = z0 / BRICK_SIZE; bz * BRICK_SIZE < z0 + sz; ++bz)
+	{
+		int za = std::max(z0, bz * BRICK_SIZE);
+		int zb = std::min(z0 + sz, bz * BRICK_SIZE + BRICK_SIZE);
+		for (int by = y0 / BRICK_SIZE; by * BRICK_SIZE < y0 + sy; ++by)
+		{
+			int ya = std::max(y0, by * BRICK_SIZE);
+			int yb = std::min(y0 + sy, by * BRICK_SIZE + BRICK_SIZE);
+			for (int bx = x0 / BRICK_SIZE; bx * BRICK_SIZE < x0 + sx; ++bx)
+			{
+				int xa = std::max(x0, bx * BRICK_SIZE);
+				int xb = std::min(x0 + sx, bx * BRICK_SIZE + BRICK_SIZE);
+
+				unsigned int b = brickIndex(bx, by, bz);
+				ensureLoaded(b);
+				const DataType* brick = m_bricks[b];
+				for (int z = za; z < zb; ++z)
+				{
+					for (int y = ya; y < yb; ++y)
+					{
+						DataType* d = dst + (xa - x0) + sx * ((y - y0) + sy * (z - z0));
+						if (brick == NULL)
+							std::fill(d, d + (xb - xa), m_uniform[b]);
+						else
+							memcpy(d, brick + (xa - bx * BRICK_SIZE) + BRICK_SIZE * ((y - by * BRICK_SIZE) + BRICK_SIZE * (z - bz * BRICK_SIZE)), (xb - xa) * sizeof(DataType));
+					}
+				}
+			}
+		}
+	}
+}
+
+} // namespace MC
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
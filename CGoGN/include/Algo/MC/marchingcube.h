@@ -26,10 +26,15 @@
 #define MARCHINGCUBE_H
 
 #include "Algo/MC/image.h"
+#include "Algo/MC/brickedImage.h"
 #include "Algo/MC/buffer.h"
 #include "Algo/MC/tables.h"
 
 #include "Geometry/vector_gen.h"
+#include "Utils/threadPool.h"
+
+#include <vector>
+#include <utility>
 
 namespace CGoGN
 {
@@ -70,6 +75,11 @@ protected:
 	*/
 	Image<DataType>* m_Image;
 
+	/**
+	* bricked voxel image (used instead of m_Image by parallelMeshing)
+	*/
+	BrickedImage<DataType>* m_Bricked;
+
 	/**
 	 *  the windowing class that define inside from outside
 	 */
@@ -104,6 +114,11 @@ protected:
 	*/
 	unsigned char computeIndex(const DataType* const _ucData) const;
 
+	/**
+	* compute the index of a cube in an array of voxels of widths lTx and lTxy (for X and XY)
+	*/
+	unsigned char computeIndex(const DataType* const _ucData, int lTx, int lTxy) const;
+
 	/**
 	 * tag boundary to b removed or not
 	 */
@@ -205,6 +220,37 @@ protected:
 
 	L_DART createTriEmb(unsigned int e1, unsigned int e2, unsigned int e3);
 
+	/**
+	* vertices and triangles extracted from a slab of cube layers (parallel version)
+	*/
+	struct Slab
+	{
+		/// positions of the vertices created by the slab
+		std::vector<VEC3> positions;
+		/// triangles (local vertex indices)
+		std::vector<unsigned int> triangles;
+		/// (x/y edge, local vertex) on the lowest and highest planes, shared with the neighbour slabs
+		std::vector< std::pair<unsigned int, unsigned int> > bottom;
+		std::vector< std::pair<unsigned int, unsigned int> > top;
+	};
+
+	/**
+	* mesh the layers of cubes [z0,z1) in a slab, without modifying the map
+	* (can be called concurrently on different slabs)
+	*/
+	void meshSlab(int z0, int z1, Slab& slab) const;
+
+	/**
+	* mesh the layer of bricks bz of the bricked image in a slab:
+	* only the cubes of bricks that are not uniform (or whose neighbours
+	* are not uniform on the same side of the surface) are visited
+	*/
+	void meshBrickLayer(int bz, Slab& slab) const;
+
+	int widthX() const { return (m_Image != NULL) ? m_Image->getWidthX() : m_Bricked->getWidthX(); }
+	int widthY() const { return (m_Image != NULL) ? m_Image->getWidthY() : m_Bricked->getWidthY(); }
+	int widthZ() const { return (m_Image != NULL) ? m_Image->getWidthZ() : m_Bricked->getWidthZ(); }
+
 public:
 	/**
 	* constructor from filename
@@ -230,6 +276,16 @@ public:
 	*/
 	MarchingCube(Image<DataType>* img, L_MAP* map, VertexAttribute<VEC3, L_MAP>& position, Windowing<DataType> wind, bool boundRemoved);
 
+	/**
+	* constructor from a bricked image (simpleMeshing runs parallelMeshing on one thread)
+	* @param img bricked voxel image
+	* @param map ptr to the map use to store the mesh
+	* @param position attribute of position
+	* @param wind the windowing class (for inside/outside distinguish)
+	* @param boundRemoved true is bound is going to be removed
+	*/
+	MarchingCube(BrickedImage<DataType>* img, L_MAP* map, VertexAttribute<VEC3, L_MAP>& position, Windowing<DataType> wind, bool boundRemoved);
+
 	/**
 	* destructor
 	*/
@@ -242,9 +298,21 @@ public:
 
 	/**
 	* simple version of Marching Cubes algorithm
+	* (on a bricked image: parallelMeshing on one thread)
 	*/
 	void simpleMeshing();
 
+	/**
+	* parallel version of Marching Cubes algorithm:
+	* slabs of cube layers are meshed independently by nbth threads,
+	* vertices of the planes between slabs are merged and the map is
+	* built and sewn at once. The resulting mesh is the same as the
+	* one of simpleMeshing (up to the order of cells).
+	* With a bricked image, slabs are layers of bricks and uniform regions are skipped
+	* @param nbth number of threads
+	*/
+	void parallelMeshing(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
 	/**
 	 * get pointer on result mesh after processing
 	 * @return the mesh
@@ -252,19 +320,24 @@ public:
 	L_MAP* getMesh() const { return m_map; }
 
 	/**
-	 * get the image
+	 * get the image (NULL when built from a bricked image)
 	 */
 	Image<DataType>* getImg() { return m_Image; }
 
 	/**
 	 * Get the lower corner of bounding AABB
 	 */
-	Geom::Vec3f boundMin() const { return m_Image->boundMin(); }
+	Geom::Vec3f boundMin() const { return (m_Image != NULL) ? m_Image->boundMin() : Geom::Vec3f(0.0f, 0.0f, 0.0f); }
 
 	/**
 	 * Get the upper corner of bounding AABB
 	 */
-	Geom::Vec3f boundMax() const { return m_Image->boundMax(); }
+	Geom::Vec3f boundMax() const
+	{
+		if (m_Image != NULL)
+			return m_Image->boundMax();
+		return Geom::Vec3f(m_Bricked->getVoxSizeX() * m_Bricked->getWidthX(), m_Bricked->getVoxSizeY() * m_Bricked->getWidthY(), m_Bricked->getVoxSizeZ() * m_Bricked->getWidthZ());
+	}
 
 	void removeFacesOfBoundary(VertexAttribute<unsigned char, L_MAP>& boundVertices, unsigned int frameWidth);
 
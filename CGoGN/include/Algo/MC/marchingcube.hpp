@@ -24,7 +24,11 @@
 
 #include "Algo/MC/windowing.h"
 #include "Topology/generic/dartmarker.h"
+#include "Algo/Import/orientedPairing.h"
 #include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
 
 namespace CGoGN
 {
@@ -74,6 +78,25 @@ namespace MC
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 MarchingCube<DataType, Windowing, PFP>::MarchingCube(Image<DataType>* img, L_MAP* map, VertexAttribute<VEC3, L_MAP>& position, Windowing<DataType> wind, bool boundRemoved):
 	m_Image(img),
+	m_Bricked(NULL),
+	m_windowFunc(wind),
+	m_Buffer(NULL),
+	m_map(map),
+	m_positions(position),
+	m_fOrigin(VEC3(0.0,0.0,0.0)),
+	m_fScal(VEC3(1.0,1.0,1.0)),
+	m_brem(boundRemoved)
+{
+	#ifdef MC_WIDTH_EDGE_Z_EMBEDED
+		m_currentZSlice = 0;
+		m_zslice = NULL;
+	#endif
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+MarchingCube<DataType, Windowing, PFP>::MarchingCube(BrickedImage<DataType>* img, L_MAP* map, VertexAttribute<VEC3, L_MAP>& position, Windowing<DataType> wind, bool boundRemoved):
+	m_Image(NULL),
+	m_Bricked(img),
 	m_windowFunc(wind),
 	m_Buffer(NULL),
 	m_map(map),
@@ -138,6 +161,13 @@ Dart  MarchingCube<DataType, Windowing, PFP>::createTriEmb(unsigned int e1, unsi
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 {
+	// the cube by cube traversal reads the voxels of a dense image
+	if (m_Image == NULL)
+	{
+		parallelMeshing(1);
+		return;
+	}
+
 	// create the mesh if needed
 	if (m_map == NULL)
 	{
@@ -249,15 +279,351 @@ void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 	CGoGNout << "Taille carte:"<<m_map->getNbDarts()<<" brins"<<CGoGNendl;
 }
 
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::meshSlab(int z0, int z1, Slab& slab) const
+{
+	// position (dx,dy,dz) of the first voxel and axis of the 12 edges of a cube
+	static const int edgeDesc[12][4] = {
+		{0,0,0,0}, {1,0,0,1}, {0,1,0,0}, {0,0,0,1},
+		{0,0,1,0}, {1,0,1,1}, {0,1,1,0}, {0,0,1,1},
+		{0,0,0,2}, {1,0,0,2}, {1,1,0,2}, {0,1,0,2} };
+
+	const int lTx = m_Image->getWidthX();
+	const int lTy = m_Image->getWidthY();
+	const int lTz = m_Image->getWidthZ();
+	const int lTxy = m_Image->getWidthXY();
+	const int stride[3] = { 1, lTx, lTxy };
+	const DataType* ucData = m_Image->getData();
+
+	// vertices of the x/y edges of the lower and upper planes of the current layer, and of its z edges
+	std::vector<unsigned int> planes[2];
+	planes[0].assign(2 * lTxy, EMBNULL);
+	planes[1].assign(2 * lTxy, EMBNULL);
+	std::vector<unsigned int> zEdges(lTxy, EMBNULL);
+
+	for (int lZ = z0; lZ < z1; ++lZ)
+	{
+		for (int lY = 0; lY < lTy - 1; ++lY)
+		{
+			const DataType* vox = ucData + lY * lTx + lZ * lTxy;
+			for (int lX = 0; lX < lTx - 1; ++lX, ++vox)
+			{
+				unsigned char ucCubeIndex = computeIndex(vox);
+				if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
+					continue;
+
+				const char* cTriangle = accelMCTable::m_TriTable[ucCubeIndex];
+				for (int i = 0; cTriangle[i] != -1; ++i)
+				{
+					const int* edge = edgeDesc[int(cTriangle[i])];
+					const int eX = lX + edge[0];
+					const int eY = lY + edge[1];
+					const int axis = edge[3];
+					const unsigned int key = 2 * (eX + eY * lTx) + axis;
+					unsigned int& v = (axis == 2) ? zEdges[eX + eY * lTx] : planes[edge[2]][key];
+
+					if (v == EMBNULL)
+					{
+						const int eZ = lZ + edge[2];
+						const DataType* p = ucData + eX + eY * lTx + eZ * lTxy;
+						VEC3 dec(0, 0, 0);
+						dec[axis] = m_windowFunc.interpole(*p, p[stride[axis]]);
+
+						v = uint32(slab.positions.size());
+						slab.positions.push_back(recalPoint(VEC3(REAL(eX), REAL(eY), REAL(eZ)), dec));
+
+						if (axis != 2)
+						{
+							if (eZ == z0 && z0 > 0)
+								slab.bottom.push_back(std::make_pair(key, v));
+							else if (eZ == z1 && z1 < lTz - 1)
+								slab.top.push_back(std::make_pair(key, v));
+						}
+					}
+					slab.triangles.push_back(v);
+				}
+			}
+		}
+
+		planes[0].swap(planes[1]);
+		std::fill(planes[1].begin(), planes[1].end(), EMBNULL);
+		std::fill(zEdges.begin(), zEdges.end(), EMBNULL);
+	}
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::meshBrickLayer(int bz, Slab& slab) const
+{
+	// position (dx,dy,dz) of the first voxel and axis of the 12 edges of a cube
+	static const int edgeDesc[12][4] = {
+		{0,0,0,0}, {1,0,0,1}, {0,1,0,0}, {0,0,0,1},
+		{0,0,1,0}, {1,0,1,1}, {0,1,1,0}, {0,0,1,1},
+		{0,0,0,2}, {1,0,0,2}, {1,1,0,2}, {0,1,0,2} };
+
+	const int bs = BrickedImage<DataType>::BRICK_SIZE;
+	const int lTx = m_Bricked->getWidthX();
+	const int lTy = m_Bricked->getWidthY();
+	const int lTz = m_Bricked->getWidthZ();
+	const int nbx = m_Bricked->getNbBricksX();
+	const int nby = m_Bricked->getNbBricksY();
+	const int nbz = m_Bricked->getNbBricksZ();
+
+	const int z0 = bz * bs;
+	const int z1 = std::min(z0 + bs, lTz - 1);
+
+	// vertices of the edges of the layer (key: edge of the image)
+	std::unordered_map<unsigned long long, unsigned int> vertices;
+
+	// voxels of the cubes of a brick (the brick and one voxel of the next ones)
+	std::vector<DataType> block((bs + 1) * (bs + 1) * (bs + 1));
+
+	for (int by = 0; by * bs < lTy - 1; ++by)
+	{
+		for (int bx = 0; bx * bs < lTx - 1; ++bx)
+		{
+			// skip the bricks whose cubes only touch uniform bricks on the same side of the surface
+			bool skip = true;
+			bool first = true;
+			bool side = false;
+			for (int k = bz; k <= std::min(bz + 1, nbz - 1) && skip; ++k)
+			{
+				for (int j = by; j <= std::min(by + 1, nby - 1) && skip; ++j)
+				{
+					for (int i = bx; i <= std::min(bx + 1, nbx - 1) && skip; ++i)
+					{
+						DataType val;
+						if (!m_Bricked->isUniform(i, j, k, val))
+							skip = false;
+						else if (first)
+						{
+							side = m_windowFunc.inside(val);
+							first = false;
+						}
+						else if (m_windowFunc.inside(val) != side)
+							skip = false;
+					}
+				}
+			}
+			if (skip)
+				continue;
+
+			const int x0 = bx * bs;
+			const int y0 = by * bs;
+			const int cx = std::min(bs, lTx - 1 - x0);
+			const int cy = std::min(bs, lTy - 1 - y0);
+			const int cz = z1 - z0;
+			const int sx = cx + 1;
+			const int sxy = sx * (cy + 1);
+			const int stride[3] = { 1, sx, sxy };
+			m_Bricked->copyBox(x0, y0, z0, cx + 1, cy + 1, cz + 1, &block[0]);
+
+			for (int lZ = 0; lZ < cz; ++lZ)
+			{
+				for (int lY = 0; lY < cy; ++lY)
+				{
+					const DataType* vox = &block[lY * sx + lZ * sxy];
+					for (int lX = 0; lX < cx; ++lX, ++vox)
+					{
+						unsigned char ucCubeIndex = computeIndex(vox, sx, sxy);
+						if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
+							continue;
+
+						const char* cTriangle = accelMCTable::m_TriTable[ucCubeIndex];
+						for (int i = 0; cTriangle[i] != -1; ++i)
+						{
+							const int* edge = edgeDesc[int(cTriangle[i])];
+							const int eX = x0 + lX + edge[0];
+							const int eY = y0 + lY + edge[1];
+							const int eZ = z0 + lZ + edge[2];
+							const int axis = edge[3];
+							const unsigned long long key = 3ULL * (eX + lTx * (eY + (unsigned long long)(lTy) * eZ)) + axis;
+
+							std::pair<typename std::unordered_map<unsigned long long, unsigned int>::iterator, bool> ins = vertices.insert(std::make_pair(key, uint32(slab.positions.size())));
+							const unsigned int v = ins.first->second;
+							if (ins.second)
+							{
+								const DataType* p = vox + edge[0] + edge[1] * sx + edge[2] * sxy;
+								VEC3 dec(0, 0, 0);
+								dec[axis] = m_windowFunc.interpole(*p, p[stride[axis]]);
+								slab.positions.push_back(recalPoint(VEC3(REAL(eX), REAL(eY), REAL(eZ)), dec));
+
+								if (axis != 2)
+								{
+									const unsigned int planeKey = 2 * (eX + eY * lTx) + axis;
+									if (eZ == z0 && z0 > 0)
+										slab.bottom.push_back(std::make_pair(planeKey, v));
+									else if (eZ == z1 && z1 < lTz - 1)
+										slab.top.push_back(std::make_pair(planeKey, v));
+								}
+							}
+							slab.triangles.push_back(v);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::parallelMeshing(unsigned int nbth)
+{
+	// create the mesh if needed
+	if (m_map == NULL)
+	{
+		m_map = new L_MAP();
+	}
+
+	if (m_Image != NULL)
+	{
+		m_fOrigin   =  VEC3((float)(m_Image->getOrigin()[0]),(float)(m_Image->getOrigin()[1]),(float)(m_Image->getOrigin()[2]));
+
+		m_fScal[0] = m_Image->getVoxSizeX();
+		m_fScal[1] = m_Image->getVoxSizeY();
+		m_fScal[2] = m_Image->getVoxSizeZ();
+	}
+	else
+	{
+		m_fOrigin = VEC3(0.0, 0.0, 0.0);
+
+		m_fScal[0] = m_Bricked->getVoxSizeX();
+		m_fScal[1] = m_Bricked->getVoxSizeY();
+		m_fScal[2] = m_Bricked->getVoxSizeZ();
+	}
+
+	const int nbLayers = widthZ() - 1;
+	if (nbLayers <= 0)
+		return;
+	if (nbth == 0)
+		nbth = 1;
+
+	// dense image: more slabs than threads to balance the load
+	// bricked image: one slab per layer of bricks
+	const int bs = BrickedImage<DataType>::BRICK_SIZE;
+	const unsigned int nbSlabs = (m_Bricked != NULL) ? unsigned((nbLayers + bs - 1) / bs) : std::min(unsigned(nbLayers), 4 * nbth);
+	std::vector<Slab> slabs(nbSlabs);
+	auto meshSlabI = [&] (unsigned int s)
+	{
+		if (m_Bricked != NULL)
+			meshBrickLayer(int(s), slabs[s]);
+		else
+			meshSlab(int((long long)(nbLayers) * s / nbSlabs), int((long long)(nbLayers) * (s + 1) / nbSlabs), slabs[s]);
+	};
+
+	if (nbth == 1)
+	{
+		for (unsigned int s = 0; s < nbSlabs; ++s)
+			meshSlabI(s);
+	}
+	else
+	{
+		Utils::WorkStealingRange range(nbSlabs, nbth);
+		std::function<void(unsigned int)> job = [&] (unsigned int th)
+		{
+			unsigned int s;
+			while (range.next(th, s))
+				meshSlabI(s);
+		};
+		Utils::ThreadPool::getInstance().run(nbth, job);
+	}
+
+	// stitch the slabs: vertices of a common plane are those of the slab below
+	std::vector< std::vector<unsigned int> > globalIndex(nbSlabs);
+	unsigned int nbVertices = 0;
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+	{
+		Slab& slab = slabs[s];
+		std::vector<unsigned int>& gi = globalIndex[s];
+		gi.assign(slab.positions.size(), EMBNULL);
+
+		if (s > 0)
+		{
+			std::vector< std::pair<unsigned int, unsigned int> >& top = slabs[s - 1].top;
+			std::sort(top.begin(), top.end());
+			std::sort(slab.bottom.begin(), slab.bottom.end());
+			unsigned int t = 0;
+			for (unsigned int b = 0; b < slab.bottom.size(); ++b)
+			{
+				while (t < top.size() && top[t].first < slab.bottom[b].first)
+					++t;
+				if (t < top.size() && top[t].first == slab.bottom[b].first)
+					gi[slab.bottom[b].second] = globalIndex[s - 1][top[t].second];
+			}
+		}
+
+		for (unsigned int i = 0; i < gi.size(); ++i)
+		{
+			if (gi[i] == EMBNULL)
+				gi[i] = nbVertices++;
+		}
+	}
+
+	// create the vertices
+	std::vector<unsigned int> emb(nbVertices, EMBNULL);
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+	{
+		const std::vector<unsigned int>& gi = globalIndex[s];
+		for (unsigned int i = 0; i < gi.size(); ++i)
+		{
+			if (emb[gi[i]] == EMBNULL)
+			{
+				emb[gi[i]] = m_map->template newCell<VERTEX>();
+				m_positions[emb[gi[i]]] = slabs[s].positions[i];
+			}
+		}
+	}
+
+	// create the triangles and pair their opposite edges
+	std::size_t nbDarts = 0;
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+		nbDarts += slabs[s].triangles.size();
+	std::vector<L_DART> darts;
+	std::vector<Algo::Import::OrientedKey> keys;
+	darts.reserve(nbDarts);
+	keys.reserve(nbDarts);
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+	{
+		const std::vector<unsigned int>& tri = slabs[s].triangles;
+		const std::vector<unsigned int>& gi = globalIndex[s];
+		for (unsigned int t = 0; t < tri.size(); t += 3)
+		{
+			unsigned int e[3] = { emb[gi[tri[t]]], emb[gi[tri[t+1]]], emb[gi[tri[t+2]]] };
+			L_DART d = createTriEmb(e[0], e[1], e[2]);
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				darts.push_back(d);
+				keys.push_back(Algo::Import::OrientedKey(e[j], e[(j + 1) % 3]));
+				d = m_map->phi1(d);
+			}
+		}
+		// free the memory of the slab
+		std::vector<VEC3>().swap(slabs[s].positions);
+		std::vector<unsigned int>().swap(slabs[s].triangles);
+	}
+
+	std::vector<unsigned int> partner;
+	Algo::Import::pairOpposite(keys, m_map->template getAttributeContainer<VERTEX>().end(), partner, nbth);
+	for (unsigned int i = 0; i < darts.size(); ++i)
+	{
+		if (partner[i] != EMBNULL && i < partner[i])
+			setNeighbourSimple(darts[i], darts[partner[i]]);
+	}
+
+	CGoGNout << "Taille carte:"<<m_map->getNbDarts()<<" brins"<<CGoGNendl;
+}
+
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 unsigned char MarchingCube<DataType, Windowing, PFP>::computeIndex(const DataType* const _ucData) const
+{
+	return computeIndex(_ucData, m_Image->getWidthX(), m_Image->getWidthXY());
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+unsigned char MarchingCube<DataType, Windowing, PFP>::computeIndex(const DataType* const _ucData, int lTx, int lTxy) const
 {
 	unsigned char ucCubeIndex = 0;
 	const DataType* ucDataLocal = _ucData;
 
-	int lTx = m_Image->getWidthX();
-	int lTxy = m_Image->getWidthXY();
-
 	if ( m_windowFunc.inside(*ucDataLocal) )
 		ucCubeIndex = 1; // point 0
 	ucDataLocal ++;
@@ -1159,11 +1525,11 @@ template< typename  DataType, template < typename D2 > class Windowing, typename
 void MarchingCube<DataType, Windowing, PFP>::removeFacesOfBoundary(VertexAttribute<unsigned char, L_MAP>& boundVertices, unsigned int frameWidth)
 {
 	float xmin = float(frameWidth);
-	float xmax = float(m_Image->getWidthX() - frameWidth - 1);
+	float xmax = float(widthX() - frameWidth - 1);
 	float ymin = float(frameWidth);
-	float ymax = float(m_Image->getWidthY() - frameWidth - 1);
+	float ymax = float(widthY() - frameWidth - 1);
 	float zmin = float(frameWidth);
-	float zmax = float(m_Image->getWidthZ() - frameWidth - 1);
+	float zmax = float(widthZ() - frameWidth - 1);
 
 	// traverse position and create bound attrib
 	for(unsigned int it = m_positions.begin(); it != m_positions.end(); m_positions.next(it))
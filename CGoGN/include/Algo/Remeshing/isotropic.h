@@ -0,0 +1,174 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_REMESHING_ISOTROPIC_H__
+#define __ALGO_REMESHING_ISOTROPIC_H__
+
+#include <vector>
+#include <functional>
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Algo/Geometry/bvh.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Remeshing
+{
+
+/**
+ * Isotropic remeshing of a triangle mesh (Botsch & Kobbelt 2004) driven by a target edge
+ * length per vertex (the target of an edge is the mean of the targets of its ends).
+ * Each iteration:
+ * - splits the edges longer than 4/3 of their target,
+ * - collapses the edges shorter than 4/5 of their target (when no edge longer than 4/3
+ *   of its target is created and no face is flipped),
+ * - flips the edges that bring the valences of their 4 vertices closer to 6 (4 on the boundary),
+ * - moves the vertices toward the centroid of their neighbours in their tangent plane
+ *   and projects them on a copy of the input surface (through a BVH).
+ * The edges to process are evaluated in parallel; the collapses and flips of a round are chosen
+ * with disjoint neighbourhoods so that these evaluations stay valid while the calling thread
+ * applies them (topological operations are not thread safe). Boundary vertices are not moved.
+ * The result does not depend on the number of threads.
+ */
+template <typename PFP>
+class IsotropicRemesher
+{
+public:
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	MAP& m_map ;
+	VertexAttribute<VEC3, MAP>& m_position ;
+	VertexAttribute<REAL, MAP>& m_targetLength ;
+	unsigned int m_nbThreads ;
+
+	// frozen copy of the input surface
+	MAP m_reference ;
+	VertexAttribute<VEC3, MAP> m_referencePosition ;
+	Algo::Geometry::BVH<PFP>* m_bvh ;
+
+	VertexAttribute<unsigned int, MAP> m_vertexStep ;
+	VertexAttribute<VEC3, MAP> m_relaxed ;
+	unsigned int m_step ;
+
+	std::vector<Dart> m_edges ;
+	std::vector<unsigned char> m_selected ;
+
+	void parallelFor(unsigned int nb, const std::function<void(unsigned int)>& func) ;
+
+	void parallelForVertices(const std::function<void(Vertex)>& func) ;
+
+	void collectEdges() ;
+
+	REAL edgeTarget(Dart d) const ;
+
+	REAL edgeLength(Dart d) const ;
+
+	VEC3 faceNormal(Dart d) const ;
+
+	// dart of smallest index of the vertex
+	Dart firstDart(Vertex v) const ;
+
+	VEC3 vertexNormal(Vertex v) const ;
+
+	unsigned int targetDegree(Vertex v) const ;
+
+	// mark the vertices adjacent to the given ones, false if one of them is already marked for this round
+	bool markNeighbourhood(const Dart* vertices, unsigned int nb, bool oneRing) ;
+
+	bool canCollapse(Dart d) const ;
+
+	bool canFlip(Dart d) const ;
+
+	void splitEdge(Dart d) ;
+
+public:
+	/**
+	 * @param map the triangle mesh to remesh (copied as reference surface)
+	 * @param position the vertex positions
+	 * @param targetLength the target edge length at each vertex (interpolated on new vertices)
+	 * @param nbth number of threads
+	 */
+	IsotropicRemesher(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& targetLength, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+	~IsotropicRemesher() ;
+
+	/// @return the number of split edges
+	unsigned int splitLongEdges() ;
+
+	/// @return the number of collapsed edges
+	unsigned int collapseShortEdges() ;
+
+	/// @return the number of flipped edges
+	unsigned int equalizeValences() ;
+
+	/// tangential relaxation then projection on the reference surface
+	void relaxVertices() ;
+
+	/// nbIterations iterations of the 4 steps
+	void remesh(unsigned int nbIterations) ;
+} ;
+
+/**
+ * isotropic remeshing with a target edge length per vertex (see IsotropicRemesher)
+ */
+template <typename PFP>
+void isotropicRemeshing(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& targetLength,
+	unsigned int nbIterations = 5,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * isotropic remeshing with a uniform target edge length (see IsotropicRemesher)
+ */
+template <typename PFP>
+void isotropicRemeshing(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	typename PFP::REAL targetLength,
+	unsigned int nbIterations = 5,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Remeshing
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Remeshing/isotropic.hpp"
+
+#endif
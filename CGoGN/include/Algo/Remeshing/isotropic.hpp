@@ -0,0 +1,509 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <cmath>
+#include <algorithm>
+
+#include "Utils/threadPool.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Remeshing
+{
+
+template <typename PFP>
+IsotropicRemesher<PFP>::IsotropicRemesher(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& targetLength, unsigned int nbth) :
+	m_map(map),
+	m_position(position),
+	m_targetLength(targetLength),
+	m_nbThreads(nbth == 0 ? 1 : nbth),
+	m_bvh(NULL),
+	m_step(0)
+{
+	m_reference.copyFrom(map) ;
+	m_referencePosition = m_reference.template getAttribute<VEC3, VERTEX, MAP>(position.name()) ;
+	m_bvh = new Algo::Geometry::BVH<PFP>(m_reference, m_referencePosition) ;
+
+	m_vertexStep = map.template addAttribute<unsigned int, VERTEX, MAP>("isotropicRemeshingStep") ;
+	m_vertexStep.setAllValues(0) ;
+	m_relaxed = map.template addAttribute<VEC3, VERTEX, MAP>("isotropicRemeshingRelaxed") ;
+}
+
+template <typename PFP>
+IsotropicRemesher<PFP>::~IsotropicRemesher()
+{
+	delete m_bvh ;
+	m_map.removeAttribute(m_vertexStep) ;
+	m_map.removeAttribute(m_relaxed) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::parallelFor(unsigned int nb, const std::function<void(unsigned int)>& func)
+{
+	const unsigned int chunkSize = 256 ;
+	const unsigned int nbChunks = (nb + chunkSize - 1) / chunkSize ;
+	if (m_nbThreads == 1 || nbChunks <= 1)
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			func(i) ;
+		return ;
+	}
+
+	Utils::WorkStealingRange range(nbChunks, m_nbThreads) ;
+	std::function<void(unsigned int)> job = [&] (unsigned int th)
+	{
+		unsigned int c ;
+		while (range.next(th, c))
+		{
+			const unsigned int end = std::min(nb, (c + 1) * chunkSize) ;
+			for (unsigned int i = c * chunkSize; i < end; ++i)
+				func(i) ;
+		}
+	} ;
+	Utils::ThreadPool::getInstance().run(m_nbThreads, job) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::parallelForVertices(const std::function<void(Vertex)>& func)
+{
+	if (m_nbThreads > 1)
+		CGoGN::Parallel::foreach_cell<VERTEX>(m_map, [&] (Vertex v, unsigned int /*thr*/) { func(v) ; }, FORCE_CELL_MARKING, m_nbThreads) ;
+	else
+		foreach_cell<VERTEX>(m_map, func) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::collectEdges()
+{
+	m_edges.clear() ;
+	foreach_cell<EDGE>(m_map, [&] (Edge e)
+	{
+		// the dart of an edge is taken in a face of the mesh
+		m_edges.push_back(m_map.template isBoundaryMarked<2>(e.dart) ? m_map.phi2(e.dart) : e.dart) ;
+	}) ;
+	m_selected.assign(m_edges.size(), 0) ;
+}
+
+template <typename PFP>
+inline typename PFP::REAL IsotropicRemesher<PFP>::edgeTarget(Dart d) const
+{
+	return REAL(0.5) * (m_targetLength[d] + m_targetLength[m_map.phi1(d)]) ;
+}
+
+template <typename PFP>
+inline typename PFP::REAL IsotropicRemesher<PFP>::edgeLength(Dart d) const
+{
+	return (m_position[m_map.phi1(d)] - m_position[d]).norm() ;
+}
+
+template <typename PFP>
+inline typename PFP::VEC3 IsotropicRemesher<PFP>::faceNormal(Dart d) const
+{
+	const VEC3& p = m_position[d] ;
+	return (m_position[m_map.phi1(d)] - p) ^ (m_position[m_map.phi_1(d)] - p) ;
+}
+
+template <typename PFP>
+Dart IsotropicRemesher<PFP>::firstDart(Vertex v) const
+{
+	Dart first = v.dart ;
+	Dart it = m_map.phi2_1(v.dart) ;
+	while (it != v.dart)
+	{
+		if (it.index < first.index)
+			first = it ;
+		it = m_map.phi2_1(it) ;
+	}
+	return first ;
+}
+
+template <typename PFP>
+typename PFP::VEC3 IsotropicRemesher<PFP>::vertexNormal(Vertex v) const
+{
+	VEC3 n(0) ;
+	Dart it = v.dart ;
+	do
+	{
+		if (!m_map.template isBoundaryMarked<2>(it))
+			n += faceNormal(it) ;
+		it = m_map.phi2_1(it) ;
+	} while (it != v.dart) ;
+	REAL l = n.norm() ;
+	if (l > 0)
+		n /= l ;
+	return n ;
+}
+
+template <typename PFP>
+inline unsigned int IsotropicRemesher<PFP>::targetDegree(Vertex v) const
+{
+	return m_map.isBoundaryVertex(v.dart) ? 4 : 6 ;
+}
+
+template <typename PFP>
+bool IsotropicRemesher<PFP>::markNeighbourhood(const Dart* vertices, unsigned int nb, bool oneRing)
+{
+	for (unsigned int k = 0; k < nb; ++k)
+	{
+		if (!oneRing)
+		{
+			if (m_vertexStep[vertices[k]] == m_step)
+				return false ;
+			continue ;
+		}
+		Dart it = vertices[k] ;
+		do
+		{
+			if (m_vertexStep[m_map.phi1(it)] == m_step)
+				return false ;
+			it = m_map.phi2_1(it) ;
+		} while (it != vertices[k]) ;
+	}
+
+	for (unsigned int k = 0; k < nb; ++k)
+	{
+		if (!oneRing)
+		{
+			m_vertexStep[vertices[k]] = m_step ;
+			continue ;
+		}
+		Dart it = vertices[k] ;
+		do
+		{
+			m_vertexStep[m_map.phi1(it)] = m_step ;
+			it = m_map.phi2_1(it) ;
+		} while (it != vertices[k]) ;
+	}
+	return true ;
+}
+
+template <typename PFP>
+bool IsotropicRemesher<PFP>::canCollapse(Dart d) const
+{
+	const Dart ends[2] = { d, m_map.phi1(d) } ;
+	if (m_map.isBoundaryVertex(ends[0]) || m_map.isBoundaryVertex(ends[1]))
+		return false ;
+	if (edgeLength(d) >= REAL(0.8) * edgeTarget(d))
+		return false ;
+	if (!m_map.edgeCanCollapse(d))
+		return false ;
+
+	const VEC3 m = REAL(0.5) * (m_position[ends[0]] + m_position[ends[1]]) ;
+	const REAL t = REAL(0.5) * (m_targetLength[ends[0]] + m_targetLength[ends[1]]) ;
+	const REAL maxRatio = REAL(4) / REAL(3) ;
+
+	for (unsigned int k = 0; k < 2; ++k)
+	{
+		const unsigned int other = m_map.template getEmbedding<VERTEX>(ends[1 - k]) ;
+		Dart it = ends[k] ;
+		do
+		{
+			Dart n = m_map.phi1(it) ;
+			Dart p = m_map.phi_1(it) ;
+			if (m_map.template getEmbedding<VERTEX>(n) != other)
+			{
+				// no new edge too long
+				if ((m_position[n] - m).norm() > maxRatio * REAL(0.5) * (t + m_targetLength[n]))
+					return false ;
+				// no flipped face (the faces of the edge disappear)
+				if (m_map.template getEmbedding<VERTEX>(p) != other)
+				{
+					VEC3 nf = (m_position[n] - m) ^ (m_position[p] - m) ;
+					if (nf * faceNormal(it) <= 0)
+						return false ;
+				}
+			}
+			it = m_map.phi2_1(it) ;
+		} while (it != ends[k]) ;
+	}
+	return true ;
+}
+
+template <typename PFP>
+bool IsotropicRemesher<PFP>::canFlip(Dart d) const
+{
+	Dart e = m_map.phi2(d) ;
+	if (m_map.template isBoundaryMarked<2>(e))
+		return false ;
+
+	// faces (a,b,c) and (b,a,f) become (a,f,c) and (f,b,c)
+	const Dart a = d ;
+	const Dart b = m_map.phi1(d) ;
+	const Dart c = m_map.phi_1(d) ;
+	const Dart f = m_map.phi_1(e) ;
+
+	const int da = int(m_map.vertexDegree(a)) ;
+	const int db = int(m_map.vertexDegree(b)) ;
+	const int dc = int(m_map.vertexDegree(c)) ;
+	const int df = int(m_map.vertexDegree(f)) ;
+	if (da <= 3 || db <= 3)
+		return false ;
+
+	const int ta = int(targetDegree(a)) ;
+	const int tb = int(targetDegree(b)) ;
+	const int tc = int(targetDegree(c)) ;
+	const int tf = int(targetDegree(f)) ;
+	const int before = std::abs(da - ta) + std::abs(db - tb) + std::abs(dc - tc) + std::abs(df - tf) ;
+	const int after = std::abs(da - 1 - ta) + std::abs(db - 1 - tb) + std::abs(dc + 1 - tc) + std::abs(df + 1 - tf) ;
+	if (after >= before)
+		return false ;
+
+	// c and f must not be already adjacent
+	const unsigned int ef = m_map.template getEmbedding<VERTEX>(f) ;
+	Dart it = c ;
+	do
+	{
+		if (m_map.template getEmbedding<VERTEX>(m_map.phi1(it)) == ef)
+			return false ;
+		it = m_map.phi2_1(it) ;
+	} while (it != c) ;
+
+	// the new faces keep the orientation of the old ones
+	const VEC3& pa = m_position[a] ;
+	const VEC3& pb = m_position[b] ;
+	const VEC3& pc = m_position[c] ;
+	const VEC3& pf = m_position[f] ;
+	const VEC3 n = faceNormal(d) + faceNormal(e) ;
+	return ((pf - pa) ^ (pc - pa)) * n > 0 && ((pb - pf) ^ (pc - pf)) * n > 0 ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::splitEdge(Dart d)
+{
+	Dart dd = m_map.phi2(d) ;
+	const bool boundary = m_map.template isBoundaryMarked<2>(dd) ;
+	const VEC3 p = REAL(0.5) * (m_position[d] + m_position[dd]) ;
+	const REAL t = edgeTarget(d) ;
+
+	m_map.cutEdge(d) ;
+	Dart v = m_map.phi1(d) ;
+	m_position[v] = p ;
+	m_targetLength[v] = t ;
+	m_vertexStep[v] = 0 ;
+
+	m_map.splitFace(v, m_map.phi_1(d)) ;
+	if (!boundary)
+		m_map.splitFace(m_map.phi1(dd), m_map.phi_1(dd)) ;
+}
+
+template <typename PFP>
+unsigned int IsotropicRemesher<PFP>::splitLongEdges()
+{
+	const REAL maxRatio = REAL(4) / REAL(3) ;
+	unsigned int nbSplits = 0 ;
+
+	// the halves of a split edge may still be too long
+	for (unsigned int round = 0; round < 16; ++round)
+	{
+		collectEdges() ;
+		parallelFor(uint32(m_edges.size()), [&] (unsigned int i)
+		{
+			m_selected[i] = edgeLength(m_edges[i]) > maxRatio * edgeTarget(m_edges[i]) ;
+		}) ;
+
+		// a split does not modify the other edges: no conflict between them
+		unsigned int nb = 0 ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+		{
+			if (m_selected[i])
+			{
+				splitEdge(m_edges[i]) ;
+				++nb ;
+			}
+		}
+		nbSplits += nb ;
+		if (nb == 0)
+			break ;
+	}
+	return nbSplits ;
+}
+
+template <typename PFP>
+unsigned int IsotropicRemesher<PFP>::collapseShortEdges()
+{
+	unsigned int nbCollapses = 0 ;
+
+	for (unsigned int round = 0; round < 8; ++round)
+	{
+		collectEdges() ;
+		parallelFor(uint32(m_edges.size()), [&] (unsigned int i)
+		{
+			m_selected[i] = canCollapse(m_edges[i]) ;
+		}) ;
+
+		// collapses whose neighbourhoods (the vertices adjacent to their ends) are disjoint
+		++m_step ;
+		unsigned int nb = 0 ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+		{
+			if (!m_selected[i])
+				continue ;
+			Dart d = m_edges[i] ;
+			const Dart ends[2] = { d, m_map.phi1(d) } ;
+			if (!markNeighbourhood(ends, 2, true))
+				continue ;
+
+			const VEC3 p = REAL(0.5) * (m_position[ends[0]] + m_position[ends[1]]) ;
+			const REAL t = edgeTarget(d) ;
+			Dart v = m_map.collapseEdge(d) ;
+			m_position[v] = p ;
+			m_targetLength[v] = t ;
+			++nb ;
+		}
+		nbCollapses += nb ;
+		if (nb == 0)
+			break ;
+	}
+	return nbCollapses ;
+}
+
+template <typename PFP>
+unsigned int IsotropicRemesher<PFP>::equalizeValences()
+{
+	unsigned int nbFlips = 0 ;
+
+	for (unsigned int round = 0; round < 8; ++round)
+	{
+		collectEdges() ;
+		parallelFor(uint32(m_edges.size()), [&] (unsigned int i)
+		{
+			m_selected[i] = canFlip(m_edges[i]) ;
+		}) ;
+
+		// flips whose 4 vertices are disjoint
+		++m_step ;
+		unsigned int nb = 0 ;
+		for (unsigned int i = 0; i < m_edges.size(); ++i)
+		{
+			if (!m_selected[i])
+				continue ;
+			Dart d = m_edges[i] ;
+			const Dart vertices[4] = { d, m_map.phi1(d), m_map.phi_1(d), m_map.phi_1(m_map.phi2(d)) } ;
+			if (!markNeighbourhood(vertices, 4, false))
+				continue ;
+			m_map.flipEdge(d) ;
+			++nb ;
+		}
+		nbFlips += nb ;
+		if (nb == 0)
+			break ;
+	}
+	return nbFlips ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::relaxVertices()
+{
+	// tangential relaxation (computed from the positions before the pass)
+	parallelForVertices([&] (Vertex v)
+	{
+		const VEC3& p = m_position[v] ;
+		if (m_map.isBoundaryVertex(v.dart))
+		{
+			m_relaxed[v] = p ;
+			return ;
+		}
+		// sums start at the same dart whatever the traversal (and the number of threads)
+		v = firstDart(v) ;
+		VEC3 q(0) ;
+		unsigned int nb = 0 ;
+		Dart it = v.dart ;
+		do
+		{
+			q += m_position[m_map.phi1(it)] ;
+			++nb ;
+			it = m_map.phi2_1(it) ;
+		} while (it != v.dart) ;
+		q /= REAL(nb) ;
+		VEC3 n = vertexNormal(v) ;
+		m_relaxed[v] = q + n * ((p - q) * n) ;
+	}) ;
+
+	// projection on the reference surface
+	parallelForVertices([&] (Vertex v)
+	{
+		if (m_map.isBoundaryVertex(v.dart))
+			return ;
+		Face f ;
+		VEC3 closest ;
+		m_bvh->closestPoint(m_relaxed[v], f, closest) ;
+		m_position[v] = closest ;
+	}) ;
+}
+
+template <typename PFP>
+void IsotropicRemesher<PFP>::remesh(unsigned int nbIterations)
+{
+	for (unsigned int i = 0; i < nbIterations; ++i)
+	{
+		splitLongEdges() ;
+		collapseShortEdges() ;
+		equalizeValences() ;
+		relaxVertices() ;
+	}
+}
+
+template <typename PFP>
+void isotropicRemeshing(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& targetLength,
+	unsigned int nbIterations,
+	unsigned int nbth)
+{
+	IsotropicRemesher<PFP> remesher(map, position, targetLength, nbth) ;
+	remesher.remesh(nbIterations) ;
+}
+
+template <typename PFP>
+void isotropicRemeshing(
+	typename PFP::MAP& map,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	typename PFP::REAL targetLength,
+	unsigned int nbIterations,
+	unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::REAL REAL ;
+
+	VertexAttribute<REAL, MAP> sizing = map.template addAttribute<REAL, VERTEX, MAP>("isotropicRemeshingTargetLength") ;
+	sizing.setAllValues(targetLength) ;
+	isotropicRemeshing<PFP>(map, position, sizing, nbIterations, nbth) ;
+	map.removeAttribute(sizing) ;
+}
+
+} // namespace Remeshing
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -189,7 +189,7 @@ void Collector_OneRing_AroundEdge<PFP>::collectAll(Dart d)
 	this->insideFaces.reserve(16);
 	this->border.reserve(16);
 
-	CellMarkerStore<MAP, FACE> fm(this->map);
+	CellMarkerEpoch<MAP, FACE> fm(this->map);
 	fm.mark(d);
 	fm.mark(d2);
 
@@ -218,7 +218,7 @@ void Collector_OneRing_AroundEdge<PFP>::collectBorder(Dart d)
 
 	this->border.reserve(16);
 
-	CellMarkerStore<MAP, FACE> fm (this->map);
+	CellMarkerEpoch<MAP, FACE> fm (this->map);
 	fm.mark(d);
 	fm.mark(d2);
 
@@ -277,9 +277,9 @@ void Collector_WithinSphere<PFP>::collectAll(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + border-faces
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + border-faces
 
 	this->insideVertices.push_back(d);
 	vm.mark(d);
@@ -335,8 +335,8 @@ void Collector_WithinSphere<PFP>::collectBorder(Dart d)
 	this->border.reserve(128);
 	this->insideVertices.reserve(128);
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
 
 	this->insideVertices.push_back(d);
 	vm.mark(d);
@@ -451,9 +451,9 @@ void Collector_NormalAngle<PFP>::collectAll(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + border-faces
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + border-faces
 
 	this->insideVertices.push_back(this->centerDart);
 	vm.mark(this->centerDart);
@@ -513,8 +513,8 @@ void Collector_NormalAngle<PFP>::collectBorder(Dart d)
 	this->border.reserve(128);
 	this->insideVertices.reserve(128);
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
 
 	this->insideVertices.push_back(this->centerDart);
 	vm.mark(this->centerDart);
@@ -568,8 +568,8 @@ void Collector_NormalAngle_Triangles<PFP>::collectAll(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
-	CellMarkerStore<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
+	CellMarkerEpoch<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
 
 	std::queue<Dart> front;
 	front.push(this->centerDart);
@@ -599,8 +599,8 @@ void Collector_NormalAngle_Triangles<PFP>::collectAll(Dart d)
 		}
 	}
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark inside-vertices and border-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark inside-vertices and border-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
 	std::vector<Face>::iterator f_it;
 	for (f_it = this->insideFaces.begin(); f_it != this->insideFaces.end(); f_it++)
 	{ // collect insideVertices, insideEdges, and border
@@ -648,8 +648,8 @@ void Collector_NormalAngle_Triangles<PFP>::collectBorder(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
-	CellMarkerStore<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
+	CellMarkerEpoch<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
 
 	std::queue<Dart> front;
 	front.push(this->centerDart);
@@ -678,7 +678,7 @@ void Collector_NormalAngle_Triangles<PFP>::collectBorder(Dart d)
 		}
 	}
 
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
 	std::vector<Face>::iterator f_it;
 	for (f_it = this->insideFaces.begin(); f_it != this->insideFaces.end(); f_it++)
 	{ // collect border (edges)
@@ -712,9 +712,9 @@ void Collector_Vertices<PFP>::collectAll(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + border-faces
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + border-faces
 
 	this->insideVertices.push_back(this->centerDart);
 	vm.mark(this->centerDart);
@@ -770,8 +770,8 @@ void Collector_Vertices<PFP>::collectBorder(Dart d)
 	this->border.reserve(128);
 	this->insideVertices.reserve(128);
 
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark the collected inside-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark the collected inside-edges + border-edges
 
 	this->insideVertices.push_back(this->centerDart);
 	vm.mark(this->centerDart);
@@ -823,8 +823,8 @@ void Collector_Triangles<PFP>::collectAll(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
-	CellMarkerStore<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
+	CellMarkerEpoch<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
 
 	std::queue<Dart> front;
 	front.push(this->centerDart);
@@ -850,8 +850,8 @@ void Collector_Triangles<PFP>::collectAll(Dart d)
 			}
 		}
 	}
-	CellMarkerStore<MAP, VERTEX> vm(this->map);	// mark inside-vertices and border-vertices
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
+	CellMarkerEpoch<MAP, VERTEX> vm(this->map);	// mark inside-vertices and border-vertices
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
 	std::vector<Face>::iterator f_it;
 	for (f_it = this->insideFaces.begin(); f_it != this->insideFaces.end(); f_it++)
 	{ // collect insideVertices, insideEdges, and border
@@ -890,8 +890,8 @@ void Collector_Triangles<PFP>::collectBorder(Dart d)
 	this->insideFaces.reserve(32);
 	this->border.reserve(32);
 
-	CellMarkerStore<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
-	CellMarkerStore<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
+	CellMarkerEpoch<MAP, FACE> fm(this->map);	// mark the collected inside-faces + front-faces
+	CellMarkerEpoch<MAP, FACE> fminside(this->map);	// mark the collected inside-faces
 
 	std::queue<Dart> front;
 	front.push(this->centerDart);
@@ -917,7 +917,7 @@ void Collector_Triangles<PFP>::collectBorder(Dart d)
 			}
 		}
 	}
-	CellMarkerStore<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
+	CellMarkerEpoch<MAP, EDGE> em(this->map);	// mark inside-edges and border-edges
 	std::vector<Face>::iterator f_it;
 	for (f_it = this->insideFaces.begin(); f_it != this->insideFaces.end(); f_it++)
 	{ // collect border (edges)
@@ -947,7 +947,7 @@ void Collector_Dijkstra_Vertices<PFP>::collectAll(Dart dinit)
 	init(dinit);
 	this->isInsideCollected = true;
 
-	CellMarkerStore<MAP, VERTEX> vmReached (this->map);
+	CellMarkerEpoch<MAP, VERTEX> vmReached (this->map);
 	vertexInfo[this->centerDart].it = front.insert(std::pair<REAL,Dart>(0.0f, this->centerDart));
 	vertexInfo[this->centerDart].valid = true;
 	vmReached.mark(this->centerDart);
@@ -993,8 +993,8 @@ void Collector_Dijkstra_Vertices<PFP>::collectAll(Dart dinit)
 		front.erase(front.begin());
 	}
 
-	CellMarkerStore<MAP, EDGE> em (this->map);
-	CellMarkerStore<MAP, FACE> fm (this->map);
+	CellMarkerEpoch<MAP, EDGE> em (this->map);
+	CellMarkerEpoch<MAP, FACE> fm (this->map);
 	for (std::vector<Vertex>::iterator e_it = this->insideVertices.begin(); e_it != this->insideVertices.end() ; e_it++)
 	{
 		// collect insideEdges
@@ -1032,7 +1032,7 @@ void Collector_Dijkstra_Vertices<PFP>::collectBorder(Dart dinit)
 {
 	init(dinit);
 
-	CellMarkerStore<MAP, VERTEX> vmReached (this->map);
+	CellMarkerEpoch<MAP, VERTEX> vmReached (this->map);
 	vertexInfo[this->centerDart].it = front.insert(std::pair<REAL,Dart>(0.0f, this->centerDart));
 	vertexInfo[this->centerDart].valid = true;
 	vmReached.mark(this->centerDart);
@@ -1075,7 +1075,7 @@ void Collector_Dijkstra_Vertices<PFP>::collectBorder(Dart dinit)
 		vmReached.unmark(front.begin()->second);
 		front.erase(front.begin());
 	}
-	CellMarkerStore<MAP, FACE> fm (this->map);
+	CellMarkerEpoch<MAP, FACE> fm (this->map);
 	for (std::vector<Vertex>::iterator e_it = this->insideVertices.begin(); e_it != this->insideVertices.end() ; e_it++)
 	{
 		// collect border
@@ -1106,7 +1106,7 @@ void Collector_Dijkstra<PFP>::collectAll(Dart dinit)
 	init(dinit);
 	this->isInsideCollected = true;
 
-	CellMarkerStore<MAP, VERTEX> vmReached (this->map);
+	CellMarkerEpoch<MAP, VERTEX> vmReached (this->map);
 	vertexInfo[this->centerDart].it = front.insert(std::pair<REAL,Dart>(0.0f, this->centerDart));
 	vertexInfo[this->centerDart].valid = true;
 	vmReached.mark(this->centerDart);
@@ -1150,8 +1150,8 @@ void Collector_Dijkstra<PFP>::collectAll(Dart dinit)
 		front.erase(front.begin());
 	}
 
-	CellMarkerStore<MAP, EDGE> em (this->map);
-	CellMarkerStore<MAP, FACE> fm (this->map);
+	CellMarkerEpoch<MAP, EDGE> em (this->map);
+	CellMarkerEpoch<MAP, FACE> fm (this->map);
 	for (std::vector<Vertex>::iterator e_it = this->insideVertices.begin(); e_it != this->insideVertices.end() ; e_it++)
 	{
 		// collect insideEdges
@@ -1189,7 +1189,7 @@ void Collector_Dijkstra<PFP>::collectBorder(Dart dinit)
 {
 	init(dinit);
 
-	CellMarkerStore<MAP, VERTEX> vmReached (this->map);
+	CellMarkerEpoch<MAP, VERTEX> vmReached (this->map);
 	vertexInfo[this->centerDart].it = front.insert(std::pair<REAL,Dart>(0.0f, this->centerDart));
 	vertexInfo[this->centerDart].valid = true;
 	vmReached.mark(this->centerDart);
@@ -1233,7 +1233,7 @@ void Collector_Dijkstra<PFP>::collectBorder(Dart dinit)
 		front.erase(front.begin());
 	}
 
-	CellMarkerStore<MAP, FACE> fm (this->map);
+	CellMarkerEpoch<MAP, FACE> fm (this->map);
 	for (std::vector<Vertex>::iterator e_it = this->insideVertices.begin(); e_it != this->insideVertices.end() ; e_it++)
 	{
 		// collect border
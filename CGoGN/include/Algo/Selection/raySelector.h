@@ -27,6 +27,7 @@
 
 #include <vector>
 #include "Algo/Selection/raySelectFunctor.hpp"
+#include "Algo/Geometry/bvh.h"
 
 namespace CGoGN
 {
@@ -237,6 +238,131 @@ Edge edgesBubbleSelection(
 		const typename PFP::VEC3& cursor,
 		typename PFP::REAL radiusMax);
 
+/*********************************************************
+ * Same selections accelerated by a BVH built on the faces
+ * (only the cells incident to the faces of the BVH are selectable)
+ *********************************************************/
+
+/**
+ * Function that does the selection of faces using a BVH, returned faces are sorted from closest to farthest
+ * @param map the map we want to test
+ * @param position the vertex attribute storing positions
+ * @param bvh the BVH built on the faces of the map
+ * @param rayA first point of ray (user side)
+ * @param rayAB direction of ray (directed to the scene)
+ * @param vecFaces (out) vector to store the intersected faces
+ * @param iPoints (out) vector to store the intersection points
+ */
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces,
+		std::vector<typename PFP::VEC3>& iPoints);
+
+/**
+ * Function that does the selection of faces using a BVH, returned faces are sorted from closest to farthest
+ */
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces);
+
+/**
+ * Function that does the selection of one face using a BVH
+ */
+template<typename PFP>
+void faceRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Face& face);
+
+/**
+ * Function that does the selection of edges using a BVH, returned edges are sorted from closest to farthest
+ */
+template<typename PFP>
+void edgesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Edge>& vecEdges,
+		float distMax);
+
+/**
+ * Function that does the selection of one edge using a BVH
+ */
+template<typename PFP>
+void edgeRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Edge& edge);
+
+/**
+ * Function that does the selection of vertices using a BVH, returned vertices are sorted from closest to farthest
+ */
+template<typename PFP>
+void verticesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Vertex>& vecVertices,
+		float dist);
+
+/**
+ * Function that does the selection of one vertex using a BVH
+ */
+template<typename PFP>
+void vertexRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Vertex& vertex);
+
+/**
+ * Function that does the selection of vertices in a cone using a BVH, returned vertices are sorted from closest to farthest
+ */
+template<typename PFP>
+void verticesConeSelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		float angle,
+		std::vector<Vertex>& vecVertices);
+
+/**
+ * Function that does the selection of edges in a cone using a BVH, returned edges are sorted from closest to farthest
+ */
+template<typename PFP>
+void edgesConeSelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		float angle,
+		std::vector<Edge>& vecEdges);
+
 /**
  * Fonction that do the selection of darts, returned darts are sorted from closest to farthest
  * Dart is here considered as a triangle formed by the 2 end vertices of the edge and the face centroid
@@ -52,6 +52,110 @@ struct FaceInter
 	FaceInter() {}
 };
 
+/**
+ * sort intersected faces and intersection points from closest to farthest of rayA
+ */
+template<typename PFP>
+void sortFacesFromPoint(
+		const typename PFP::VEC3& rayA,
+		std::vector<Face>& vecFaces,
+		std::vector<typename PFP::VEC3>& iPoints)
+{
+	if(vecFaces.size() > 0)
+	{
+		// compute all distances to observer for each intersected face
+		// and put them in a vector for sorting
+		typedef std::pair<typename PFP::REAL, FaceInter<PFP> > faceInterDist;
+		std::vector<faceInterDist> dist;
+
+		unsigned int nbi = (unsigned int)(vecFaces.size());
+		dist.resize(nbi);
+		for (unsigned int i = 0; i < nbi; ++i)
+		{
+			dist[i].first = (iPoints[i] - rayA).norm2();
+			dist[i].second = FaceInter<PFP>(vecFaces[i], iPoints[i]);
+		}
+
+		// sort the vector of pair dist/dart
+		std::sort(dist.begin(), dist.end(), distOrdering<typename PFP::REAL, FaceInter<PFP> >);
+
+		// store result in returned vectors
+		for (unsigned int i = 0; i < nbi; ++i)
+		{
+			vecFaces[i] = dist[i].second.f;
+			iPoints[i] = dist[i].second.i;
+		}
+	}
+}
+
+/**
+ * sort edges from closest to farthest (middle of edge) of rayA
+ */
+template<typename PFP>
+void sortEdgesFromPoint(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const typename PFP::VEC3& rayA,
+		std::vector<Edge>& vecEdges)
+{
+	typedef std::pair<typename PFP::REAL, Edge> EdgeDist;
+	std::vector<EdgeDist> distnedge;
+
+	unsigned int nbi = (unsigned int)(vecEdges.size());
+	distnedge.resize(nbi);
+
+	// compute all distances to observer for each middle of intersected edge
+	// and put them in a vector for sorting
+	for (unsigned int i = 0; i < nbi; ++i)
+	{
+		Edge e = vecEdges[i];
+		distnedge[i].second = e;
+		typename PFP::VEC3 V = (position[e.dart] + position[map.phi1(e.dart)]) / typename PFP::REAL(2);
+		V -= rayA;
+		distnedge[i].first = V.norm2();
+	}
+
+	// sort the vector of pair dist/edge
+	std::sort(distnedge.begin(), distnedge.end(), distOrdering<typename PFP::REAL, Edge>);
+
+	// store sorted edges in returned vector
+	for (unsigned int i = 0; i < nbi; ++i)
+		vecEdges[i] = distnedge[i].second;
+}
+
+/**
+ * sort vertices from closest to farthest of rayA
+ */
+template<typename PFP>
+void sortVerticesFromPoint(
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const typename PFP::VEC3& rayA,
+		std::vector<Vertex>& vecVertices)
+{
+	typedef std::pair<typename PFP::REAL, Vertex> VertexDist;
+	std::vector<VertexDist> distnvertex;
+
+	unsigned int nbi = (unsigned int)(vecVertices.size());
+	distnvertex.resize(nbi);
+
+	// compute all distances to observer for each intersected vertex
+	// and put them in a vector for sorting
+	for (unsigned int i = 0; i < nbi; ++i)
+	{
+		Vertex v = vecVertices[i];
+		distnvertex[i].second = v;
+		typename PFP::VEC3 V = position[v] - rayA;
+		distnvertex[i].first = V.norm2();
+	}
+
+	// sort the vector of pair dist/vertex
+	std::sort(distnvertex.begin(), distnvertex.end(), distOrdering<typename PFP::REAL, Vertex>);
+
+	// store sorted vertices in returned vector
+	for (unsigned int i = 0; i < nbi; ++i)
+		vecVertices[i] = distnvertex[i].second;
+}
+
 /**
  * Function that does the selection of faces, returned faces and intersection points are sorted from closest to farthest
  * @param map the map we want to test
@@ -99,31 +203,7 @@ void facesRaySelection(
 		} while ((ddd != f.dart) && notfound);
 	});
 
-	if(vecFaces.size() > 0)
-	{
-		// compute all distances to observer for each intersected face
-		// and put them in a vector for sorting
-		typedef std::pair<typename PFP::REAL, FaceInter<PFP> > faceInterDist;
-		std::vector<faceInterDist> dist;
-
-		unsigned int nbi = (unsigned int)(vecFaces.size());
-		dist.resize(nbi);
-		for (unsigned int i = 0; i < nbi; ++i)
-		{
-			dist[i].first = (iPoints[i] - rayA).norm2();
-			dist[i].second = FaceInter<PFP>(vecFaces[i], iPoints[i]);
-		}
-
-		// sort the vector of pair dist/dart
-		std::sort(dist.begin(), dist.end(), distOrdering<typename PFP::REAL, FaceInter<PFP> >);
-
-		// store result in returned vectors
-		for (unsigned int i = 0; i < nbi; ++i)
-		{
-			vecFaces[i] = dist[i].second.f;
-			iPoints[i] = dist[i].second.i;
-		}
-	}
+	sortFacesFromPoint<PFP>(rayA, vecFaces, iPoints);
 }
 
 /**
@@ -212,32 +292,7 @@ void edgesRaySelection(
 			vecEdges.push_back(e);
 	});
 
-	if(vecEdges.size() > 0)
-	{
-		typedef std::pair<typename PFP::REAL, Edge> EdgeDist;
-		std::vector<EdgeDist> distnedge;
-
-		unsigned int nbi = (unsigned int)(vecEdges.size());
-		distnedge.resize(nbi);
-
-		// compute all distances to observer for each middle of intersected edge
-		// and put them in a vector for sorting
-		for (unsigned int i = 0; i < nbi; ++i)
-		{
-			Edge e = vecEdges[i];
-			distnedge[i].second = e;
-			typename PFP::VEC3 V = (position[e.dart] + position[map.phi1(e.dart)]) / typename PFP::REAL(2);
-			V -= rayA;
-			distnedge[i].first = V.norm2();
-		}
-
-		// sort the vector of pair dist/edge
-		std::sort(distnedge.begin(), distnedge.end(), distOrdering<typename PFP::REAL, Edge>);
-
-		// store sorted darts in returned vector
-		for (unsigned int i = 0; i < nbi; ++i)
-			vecEdges[i] = distnedge[i].second;
-	}
+	sortEdgesFromPoint<PFP>(map, position, rayA, vecEdges);
 }
 
 /**
@@ -323,31 +378,7 @@ void verticesRaySelection(
 			vecVertices.push_back(v);
 	});
 
-	if(vecVertices.size() > 0)
-	{
-		typedef std::pair<typename PFP::REAL, Vertex> VertexDist;
-		std::vector<VertexDist> distnvertex;
-
-		unsigned int nbi = (unsigned int)(vecVertices.size());
-		distnvertex.resize(nbi);
-
-		// compute all distances to observer for each intersected vertex
-		// and put them in a vector for sorting
-		for (unsigned int i = 0; i < nbi; ++i)
-		{
-			Vertex v = vecVertices[i];
-			distnvertex[i].second = v;
-			typename PFP::VEC3 V = position[v] - rayA;
-			distnvertex[i].first = V.norm2();
-		}
-
-		// sort the vector of pair dist/dart
-		std::sort(distnvertex.begin(), distnvertex.end(), distOrdering<typename PFP::REAL, Vertex>);
-
-		// store sorted darts in returned vector
-		for (unsigned int i = 0; i < nbi; ++i)
-			vecVertices[i] = distnvertex[i].second;
-	}
+	sortVerticesFromPoint<PFP>(position, rayA, vecVertices);
 }
 
 /**
@@ -521,28 +552,7 @@ void verticesConeSelection(
 			vecVertices.push_back(v);
 	});
 
-	typedef std::pair<typename PFP::REAL, Vertex> VertexDist;
-	std::vector<VertexDist> distnvertex;
-
-	unsigned int nbi = (unsigned int)(vecVertices.size());
-	distnvertex.resize(nbi);
-
-	// compute all distances to observer for each intersected vertex
-	// and put them in a vector for sorting
-	for (unsigned int i = 0; i < nbi; ++i)
-	{
-		Vertex v = vecVertices[i];
-		distnvertex[i].second = v;
-		typename PFP::VEC3 V = position[v] - rayA;
-		distnvertex[i].first = V.norm2();
-	}
-
-	// sort the vector of pair dist/vertex
-	std::sort(distnvertex.begin(), distnvertex.end(), distOrdering<typename PFP::REAL, Vertex>);
-
-	// store sorted vertices in returned vector
-	for (unsigned int i = 0; i < nbi; ++i)
-		vecVertices[i] = distnvertex[i].second;
+	sortVerticesFromPoint<PFP>(position, rayA, vecVertices);
 }
 
 /**
@@ -585,29 +595,7 @@ void edgesConeSelection(
 			vecEdges.push_back(e);
 	});
 
-	typedef std::pair<typename PFP::REAL, Edge> EdgeDist;
-	std::vector<EdgeDist> distnedge;
-
-	unsigned int nbi = (unsigned int)(vecEdges.size());
-	distnedge.resize(nbi);
-
-	// compute all distances to observer for each middle of intersected edge
-	// and put them in a vector for sorting
-	for (unsigned int i = 0; i < nbi; ++i)
-	{
-		Edge e = vecEdges[i];
-		distnedge[i].second = e;
-		typename PFP::VEC3 V = (position[e.dart] + position[map.phi1(e.dart)]) / typename PFP::REAL(2);
-		V -= rayA;
-		distnedge[i].first = V.norm2();
-	}
-
-	// sort the vector of pair dist/edge
-	std::sort(distnedge.begin(), distnedge.end(), distOrdering<typename PFP::REAL, Edge>);
-
-	// store sorted edges in returned vector
-	for (unsigned int i = 0; i < nbi; ++i)
-		vecEdges[i] = distnedge[i].second;
+	sortEdgesFromPoint<PFP>(map, position, rayA, vecEdges);
 }
 
 template<typename PFP>
@@ -659,6 +647,298 @@ Edge edgesBubbleSelection(
 }
 
 
+/*********************************************************
+ * Selections accelerated by a BVH
+ *********************************************************/
+
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& /*map*/,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& /*position*/,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces,
+		std::vector<typename PFP::VEC3>& iPoints)
+{
+	vecFaces.clear();
+	iPoints.clear();
+
+	bvh.rayIntersection(rayA, rayAB, vecFaces, iPoints);
+
+	sortFacesFromPoint<PFP>(rayA, vecFaces, iPoints);
+}
+
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces)
+{
+	std::vector<typename PFP::VEC3> iPoints;
+	facesRaySelection<PFP>(map, position, bvh, rayA, rayAB, vecFaces, iPoints);
+}
+
+template<typename PFP>
+void faceRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& /*position*/,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Face& face)
+{
+	if (map.dimension() > 2)
+		CGoGNerr << "faceRaySelection only on map of dimension 2" << CGoGNendl;
+
+	typename PFP::VEC3 ip;
+	if (!bvh.closestRayIntersection(rayA, rayAB, face, ip))
+		face = NIL;
+}
+
+template<typename PFP>
+void edgesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Edge>& vecEdges,
+		float distMax)
+{
+	typename PFP::REAL dist2 = distMax * distMax;
+	typename PFP::REAL AB2 = rayAB * rayAB;
+
+	vecEdges.clear();
+
+	std::vector<Face> candidates;
+	bvh.facesNearLine(rayA, rayAB, distMax, candidates);
+
+	DartMarkerStore<typename PFP::MAP> em(map);
+	for (std::vector<Face>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		Dart d = it->dart;
+		do
+		{
+			if (!em.isMarked(d))
+			{
+				em.markOrbit(Edge(d));
+				const typename PFP::VEC3& P = position[d];
+				const typename PFP::VEC3& Q = position[map.phi1(d)];
+				typename PFP::REAL ld2 = Geom::squaredDistanceLine2Seg(rayA, rayAB, AB2, P, Q);
+				if (ld2 < dist2)
+					vecEdges.push_back(Edge(d));
+			}
+			d = map.phi1(d);
+		} while (d != it->dart);
+	}
+
+	sortEdgesFromPoint<PFP>(map, position, rayA, vecEdges);
+}
+
+template<typename PFP>
+void edgeRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Edge& edge)
+{
+	if (map.dimension() > 2)
+		CGoGNerr << "edgeRaySelection only on map of dimension 2" << CGoGNendl;
+
+	Face f;
+	typename PFP::VEC3 ip;
+
+	if (bvh.closestRayIntersection(rayA, rayAB, f, ip))
+	{
+		// recuperation de l'arete la plus proche du point d'intersection
+		Dart it = f.dart;
+		typename PFP::REAL minDist = squaredDistanceLine2Point(position[it], position[map.phi1(it)], ip);
+		edge = it;
+		it = map.phi1(it);
+		while(it != f.dart)
+		{
+			typename PFP::REAL dist = squaredDistanceLine2Point(position[it], position[map.phi1(it)], ip);
+			if(dist < minDist)
+			{
+				minDist = dist;
+				edge = it;
+			}
+			it = map.phi1(it);
+		}
+	}
+	else
+		edge = NIL;
+}
+
+template<typename PFP>
+void verticesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Vertex>& vecVertices,
+		float dist)
+{
+	typename PFP::REAL dist2 = dist * dist;
+	typename PFP::REAL AB2 = rayAB * rayAB;
+
+	vecVertices.clear();
+
+	std::vector<Face> candidates;
+	bvh.facesNearLine(rayA, rayAB, dist, candidates);
+
+	CellMarkerStore<typename PFP::MAP, VERTEX> vm(map);
+	for (std::vector<Face>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		Dart d = it->dart;
+		do
+		{
+			if (!vm.isMarked(d))
+			{
+				vm.mark(d);
+				typename PFP::REAL ld2 = Geom::squaredDistanceLine2Point(rayA, rayAB, AB2, position[d]);
+				if (ld2 < dist2)
+					vecVertices.push_back(Vertex(d));
+			}
+			d = map.phi1(d);
+		} while (d != it->dart);
+	}
+
+	sortVerticesFromPoint<PFP>(position, rayA, vecVertices);
+}
+
+template<typename PFP>
+void vertexRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Vertex& vertex)
+{
+	if (map.dimension() > 2)
+		CGoGNerr << "vertexRaySelection only on map of dimension 2" << CGoGNendl;
+
+	Face f;
+	typename PFP::VEC3 ip;
+
+	if (bvh.closestRayIntersection(rayA, rayAB, f, ip))
+	{
+		// recuperation du sommet le plus proche du point d'intersection
+		Dart it = f.dart;
+		typename PFP::REAL minDist = (ip - position[it]).norm2();
+		vertex = it;
+		it = map.phi1(it);
+		while(it != f.dart)
+		{
+			typename PFP::REAL dist = (ip - position[it]).norm2();
+			if(dist < minDist)
+			{
+				minDist = dist;
+				vertex = it;
+			}
+			it = map.phi1(it);
+		}
+	}
+	else
+		vertex = NIL;
+}
+
+template<typename PFP>
+void verticesConeSelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		float angle,
+		std::vector<Vertex>& vecVertices)
+{
+	typename PFP::REAL AB2 = rayAB * rayAB;
+
+	double sin2 = sin(M_PI/180.0 * angle);
+	sin2 = sin2*sin2;
+
+	vecVertices.clear();
+
+	std::vector<Face> candidates;
+	bvh.facesInCone(rayA, rayAB, angle, candidates);
+
+	CellMarkerStore<typename PFP::MAP, VERTEX> vm(map);
+	for (std::vector<Face>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		Dart d = it->dart;
+		do
+		{
+			if (!vm.isMarked(d))
+			{
+				vm.mark(d);
+				const typename PFP::VEC3& P = position[d];
+				typename PFP::REAL ld2 = Geom::squaredDistanceLine2Point(rayA, rayAB, AB2, P);
+				typename PFP::VEC3 V = P - rayA;
+				double s2 = double(ld2) / double(V*V);
+				if (s2 < sin2)
+					vecVertices.push_back(Vertex(d));
+			}
+			d = map.phi1(d);
+		} while (d != it->dart);
+	}
+
+	sortVerticesFromPoint<PFP>(position, rayA, vecVertices);
+}
+
+template<typename PFP>
+void edgesConeSelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Algo::Geometry::BVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		float angle,
+		std::vector<Edge>& vecEdges)
+{
+	typename PFP::REAL AB2 = rayAB * rayAB;
+
+	double sin2 = sin(M_PI/180.0 * angle);
+	sin2 = sin2*sin2;
+
+	vecEdges.clear();
+
+	std::vector<Face> candidates;
+	bvh.facesInCone(rayA, rayAB, angle, candidates);
+
+	DartMarkerStore<typename PFP::MAP> em(map);
+	for (std::vector<Face>::const_iterator it = candidates.begin(); it != candidates.end(); ++it)
+	{
+		Dart d = it->dart;
+		do
+		{
+			if (!em.isMarked(d))
+			{
+				em.markOrbit(Edge(d));
+				const typename PFP::VEC3& P = position[d];
+				const typename PFP::VEC3& Q = position[map.phi1(d)];
+				typename PFP::REAL ld2 = Geom::squaredDistanceLine2Seg(rayA, rayAB, AB2, P, Q);
+				typename PFP::VEC3 V = (P+Q)/2.0f - rayA;
+				double s2 = double(ld2) / double(V*V);
+				if (s2 < sin2)
+					vecEdges.push_back(Edge(d));
+			}
+			d = map.phi1(d);
+		} while (d != it->dart);
+	}
+
+	sortEdgesFromPoint<PFP>(map, position, rayA, vecEdges);
+}
+
+
 //namespace Parallel
 //{
 //
@@ -0,0 +1,203 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_TOPO_CONNECTIVITY_SNAPSHOT__
+#define __ALGO_TOPO_CONNECTIVITY_SNAPSHOT__
+
+#include <cassert>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "Topology/generic/genericmap.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Algo/Topo/embedding.h"
+#include "Utils/threadPool.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Topo
+{
+
+/**
+ * Flat copy of the vertex connectivity of a map (Map2, Map3 ...), built once and read
+ * by kernels iterated many times on a fixed topology (smoothing, laplacians ...)
+ * instead of following phi chains at each iteration.
+ * The vertices of the map must be embedded.
+ * All indices are lines of the attribute containers:
+ * - vertices: vertex lines, boundary: 1 for the boundary vertices
+ * - neighbours of vertex i (vertices linked by an edge, sorted by line):
+ *   neighbours[neighbourBegin[i], neighbourBegin[i+1][, and the lines of the
+ *   corresponding edges in neighbourEdges (EMBNULL if edges are not embedded)
+ * - incident faces of vertex i (only if faces are embedded):
+ *   faces[faceBegin[i], faceBegin[i+1][
+ * The snapshot is valid as long as the topology version of the map does not change
+ * (see GenericMap::getTopologyVersion).
+ */
+class ConnectivitySnapshot
+{
+protected:
+	const GenericMap* m_map;
+	unsigned int m_version;
+
+public:
+	std::vector<unsigned int> vertices;
+	std::vector<unsigned char> boundary;
+	std::vector<unsigned int> neighbourBegin;
+	std::vector<unsigned int> neighbours;
+	std::vector<unsigned int> neighbourEdges;
+	std::vector<unsigned int> faceBegin;
+	std::vector<unsigned int> faces;
+
+	ConnectivitySnapshot() : m_map(NULL), m_version(0) {}
+
+	template <typename MAP>
+	ConnectivitySnapshot(MAP& map) : m_map(NULL), m_version(0) { build(map); }
+
+	unsigned int nbVertices() const { return (unsigned int)(vertices.size()); }
+
+	unsigned int degree(unsigned int i) const { return neighbourBegin[i + 1] - neighbourBegin[i]; }
+
+	/**
+	 * true if the snapshot has been built from map and the topology of map has not changed since
+	 */
+	bool isUpToDate(const GenericMap& map) const
+	{
+		return m_map == &map && m_version == map.getTopologyVersion();
+	}
+
+	/**
+	 * embedding of the cell of d, cells not embedded yet are given a new line
+	 */
+	template <unsigned int ORBIT, typename MAP>
+	static unsigned int embedding(MAP& map, Dart d)
+	{
+		unsigned int e = map.template getEmbedding<ORBIT>(d);
+		if (e == EMBNULL)
+			e = Algo::Topo::setOrbitEmbeddingOnNewCell<ORBIT>(map, d);
+		return e;
+	}
+
+	/**
+	 * (re)build the snapshot from the current topology of the map.
+	 * Side effect: the vertices, edges and faces (if their orbit is embedded) that have
+	 * no line yet are given a new line, as done by the attribute handlers on access;
+	 * the topology and the existing lines are not changed
+	 */
+	template <typename MAP>
+	void build(MAP& map)
+	{
+		assert(map.template isOrbitEmbedded<VERTEX>() || !"ConnectivitySnapshot: vertices must be embedded") ;
+
+		const bool edgeEmb = map.template isOrbitEmbedded<EDGE>();
+		const bool faceEmb = map.template isOrbitEmbedded<FACE>();
+
+		vertices.clear();
+		boundary.clear();
+		neighbourBegin.assign(1, 0);
+		neighbours.clear();
+		neighbourEdges.clear();
+		faceBegin.assign(1, 0);
+		faces.clear();
+
+		std::vector<std::pair<unsigned int, unsigned int> > adj;
+		std::vector<unsigned int> inc;
+		foreach_cell<VERTEX>(map, [&] (Vertex v)
+		{
+			vertices.push_back(embedding<VERTEX>(map, v));
+			boundary.push_back(map.isBoundaryVertex(v) ? 1 : 0);
+
+			adj.clear();
+			inc.clear();
+			map.foreach_dart_of_orbit(v, [&] (Dart d)
+			{
+				adj.push_back(std::make_pair(embedding<VERTEX>(map, map.phi1(d)), edgeEmb ? embedding<EDGE>(map, d) : EMBNULL));
+				if (faceEmb && !map.isBoundaryMarkedCurrent(d))
+					inc.push_back(embedding<FACE>(map, d));
+			});
+
+			// each neighbour (and face) is reached from several darts in dimension 3
+			std::sort(adj.begin(), adj.end());
+			for (unsigned int k = 0; k < adj.size(); ++k)
+			{
+				if (k == 0 || adj[k].first != adj[k - 1].first)
+				{
+					neighbours.push_back(adj[k].first);
+					neighbourEdges.push_back(adj[k].second);
+				}
+			}
+			neighbourBegin.push_back((unsigned int)(neighbours.size()));
+
+			std::sort(inc.begin(), inc.end());
+			faces.insert(faces.end(), inc.begin(), std::unique(inc.begin(), inc.end()));
+			faceBegin.push_back((unsigned int)(faces.size()));
+		});
+
+		m_map = &map;
+		m_version = map.getTopologyVersion();
+	}
+
+	/**
+	 * apply func(i) on the indices i of all vertices, with nbth threads
+	 */
+	template <typename FUNC>
+	void foreach_vertex(FUNC func, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const
+	{
+		const unsigned int nbv = nbVertices();
+		if (nbth <= 1 || nbv < 1024)
+		{
+			for (unsigned int i = 0; i < nbv; ++i)
+				func(i);
+			return;
+		}
+
+		const unsigned int cs = 512;
+		Utils::WorkStealingRange range((nbv + cs - 1) / cs, nbth);
+		std::function<void(unsigned int)> job = [&] (unsigned int th)
+		{
+			unsigned int chunk;
+			while (range.next(th, chunk))
+			{
+				unsigned int e = std::min(chunk * cs + cs, nbv);
+				for (unsigned int i = chunk * cs; i < e; ++i)
+					func(i);
+			}
+		};
+		Utils::ThreadPool::getInstance().run(nbth, job);
+	}
+};
+
+} // namespace Topo
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#endif
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_TOPO_REORDER__
+#define __ALGO_TOPO_REORDER__
+
+#include <vector>
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/dartmarker.h"
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Topo
+{
+
+/**
+ * @brief compute a dart order for GenericMap::reorder: vertices are visited in
+ * breadth first order (from neighbour to neighbour through edges) and darts are
+ * grouped by vertex
+ * @param map a map with phi1 (Map2, Map3, GMap2 ...)
+ * @param dartOrder (out) indices of darts in the DART container in their new order
+ */
+template <typename MAP>
+void dartOrderBFS(MAP& map, std::vector<unsigned int>& dartOrder);
+
+/**
+ * @brief compute a dart order for GenericMap::reorder: vertices are sorted along
+ * a 3D Hilbert curve over their positions and darts are grouped by vertex
+ * @param map a map with embedded vertices
+ * @param position position of vertices
+ * @param dartOrder (out) indices of darts in the DART container in their new order
+ */
+template <typename PFP>
+void dartOrderHilbert(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, std::vector<unsigned int>& dartOrder);
+
+/**
+ * @brief renumber darts and cells of the map in breadth first order
+ */
+template <typename MAP>
+void reorderBFS(MAP& map);
+
+/**
+ * @brief renumber darts and cells of the map along a Hilbert curve over vertex positions
+ */
+template <typename PFP>
+void reorderHilbert(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position);
+
+/**
+ * index of a point of the grid [0,2^bits)^3 along the Hilbert curve (bits <= 21)
+ */
+inline unsigned long long hilbertIndex(unsigned int x, unsigned int y, unsigned int z, unsigned int bits);
+
+} // namespace Topo
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Topo/reorder.hpp"
+
+#endif
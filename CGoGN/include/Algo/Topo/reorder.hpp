@@ -0,0 +1,184 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Topo
+{
+
+inline unsigned long long hilbertIndex(unsigned int x, unsigned int y, unsigned int z, unsigned int bits)
+{
+	// Skilling's transform of the coordinates ("Programming the Hilbert curve", 2004)
+	unsigned int X[3] = { x, y, z };
+	unsigned int M = 1u << (bits - 1);
+
+	for (unsigned int Q = M; Q > 1; Q >>= 1)
+	{
+		unsigned int P = Q - 1;
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			if (X[i] & Q)
+				X[0] ^= P;
+			else
+			{
+				unsigned int t = (X[0] ^ X[i]) & P;
+				X[0] ^= t;
+				X[i] ^= t;
+			}
+		}
+	}
+
+	// Gray encode
+	X[1] ^= X[0];
+	X[2] ^= X[1];
+	unsigned int t = 0;
+	for (unsigned int Q = M; Q > 1; Q >>= 1)
+	{
+		if (X[2] & Q)
+			t ^= Q - 1;
+	}
+	for (unsigned int i = 0; i < 3; ++i)
+		X[i] ^= t;
+
+	// interleave the bits of the transposed index
+	unsigned long long key = 0;
+	for (int b = int(bits) - 1; b >= 0; --b)
+	{
+		for (unsigned int i = 0; i < 3; ++i)
+			key = (key << 1) | ((X[i] >> b) & 1u);
+	}
+	return key;
+}
+
+template <typename MAP>
+void dartOrderBFS(MAP& map, std::vector<unsigned int>& dartOrder)
+{
+	dartOrder.clear();
+	dartOrder.reserve(map.template getAttributeContainer<DART>().size());
+
+	DartMarker<MAP> dm(map);
+	std::vector<Dart> queue;
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		if (dm.isMarked(v.dart))
+			return;
+
+		// breadth first traversal of the connected component of v
+		dm.markOrbit(v);
+		queue.clear();
+		queue.push_back(v.dart);
+		for (unsigned int k = 0; k < queue.size(); ++k)
+		{
+			map.foreach_dart_of_orbit(Vertex(queue[k]), [&] (Dart d)
+			{
+				dartOrder.push_back(map.dartIndex(d));
+				Dart e = map.phi1(d); // dart of the adjacent vertex
+				if (!dm.isMarked(e))
+				{
+					dm.markOrbit(Vertex(e));
+					queue.push_back(e);
+				}
+			});
+		}
+	});
+}
+
+template <typename PFP>
+void dartOrderHilbert(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, std::vector<unsigned int>& dartOrder)
+{
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+	const unsigned int BITS = 21;
+
+	// bounding box
+	VEC3 bbMin, bbMax;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		bbMin[i] = std::numeric_limits<REAL>::max();
+		bbMax[i] = -std::numeric_limits<REAL>::max();
+	}
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		const VEC3& P = position[v];
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			bbMin[i] = std::min(bbMin[i], P[i]);
+			bbMax[i] = std::max(bbMax[i], P[i]);
+		}
+	});
+
+	REAL scale[3];
+	for (unsigned int i = 0; i < 3; ++i)
+		scale[i] = (bbMax[i] > bbMin[i]) ? REAL((1u << BITS) - 1) / (bbMax[i] - bbMin[i]) : REAL(0);
+
+	// vertices sorted by Hilbert index
+	std::vector<std::pair<unsigned long long, Dart> > vertices;
+	vertices.reserve(map.template getAttributeContainer<VERTEX>().size());
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		const VEC3& P = position[v];
+		unsigned int c[3];
+		for (unsigned int i = 0; i < 3; ++i)
+			c[i] = (unsigned int)((P[i] - bbMin[i]) * scale[i]);
+		vertices.push_back(std::make_pair(hilbertIndex(c[0], c[1], c[2], BITS), v.dart));
+	});
+	std::sort(vertices.begin(), vertices.end(),
+		[] (const std::pair<unsigned long long, Dart>& a, const std::pair<unsigned long long, Dart>& b) { return a.first < b.first; });
+
+	dartOrder.clear();
+	dartOrder.reserve(map.template getAttributeContainer<DART>().size());
+	for (unsigned int k = 0; k < vertices.size(); ++k)
+		map.foreach_dart_of_orbit(Vertex(vertices[k].second), [&] (Dart d) { dartOrder.push_back(map.dartIndex(d)); });
+}
+
+template <typename MAP>
+void reorderBFS(MAP& map)
+{
+	std::vector<unsigned int> dartOrder;
+	dartOrderBFS<MAP>(map, dartOrder);
+	map.reorder(dartOrder);
+}
+
+template <typename PFP>
+void reorderHilbert(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+{
+	std::vector<unsigned int> dartOrder;
+	dartOrderHilbert<PFP>(map, position, dartOrder);
+	map.reorder(dartOrder);
+}
+
+} // namespace Topo
+
+} // namespace Algo
+
+} // namespace CGoGN
@@ -140,6 +140,16 @@ protected:
 	*/
 	unsigned int m_lineCost;
 
+	/**
+	* max number of lines of the contiguous storage of new attributes (0: separated blocks)
+	*/
+	unsigned int m_contiguousCapacity;
+
+	/**
+	* pool of the blocks of the attributes (NULL: the pool of the process)
+	*/
+	Utils::BlockPool* m_blockPool;
+
 	/**
 	 * map pointer (shared for all container of the same map) for attribute registration
 	 */
@@ -158,7 +168,7 @@ public:
 
 	void setContainerBrowser(ContainerBrowser* bro) { m_currentBrowser = bro; }
 
-	bool hasBrowser() { return m_currentBrowser != NULL; }
+	bool hasBrowser() const { return m_currentBrowser != NULL; }
 
 	/**************************************
 	 *          BASIC FEATURES            *
@@ -195,6 +205,14 @@ protected:
 	template <typename T>
 	void addAttribute(const std::string& attribName, const std::string& typeName, unsigned int index);
 
+	/**
+	 * false if a new block would not fit in the contiguous storage of the attributes
+	 */
+	bool canAddBlock() const
+	{
+		return m_contiguousCapacity == 0 || m_holesBlocks.size() < (m_contiguousCapacity + _BLOCKSIZE_ - 1) / _BLOCKSIZE_;
+	}
+
 public:
 	/**
 	* Remove an attribute (destroys data)
@@ -356,6 +374,27 @@ public:
 	 */
 	void swap(AttributeContainer& cont);
 
+	/**
+	* store the attributes (existing and future ones, markers excepted) in contiguous
+	* ranges of addresses reserved for maxNbLines lines, 0 to go back to separated blocks
+	* (see AttributeMultiVectorGen::setContiguous). Inserting more lines throws std::bad_alloc
+	* @return false if the storage of an attribute could not be changed
+	*/
+	bool setContiguousStorage(unsigned int maxNbLines);
+
+	/**
+	* max number of lines of the contiguous storage of the attributes (0 if separated blocks)
+	*/
+	unsigned int getContiguousStorage() const { return m_contiguousCapacity; }
+
+	/**
+	* allocate the blocks of the attributes (existing and future ones) in a pool,
+	* NULL for the pool of the process (see AttributeMultiVectorGen::setBlockPool)
+	*/
+	void setBlockPool(Utils::BlockPool* pool);
+
+	Utils::BlockPool* getBlockPool() const { return m_blockPool; }
+
 	/**
 	 * clear the container
 	 * @param removeAttrib remove the attributes (not only their data)
@@ -368,6 +407,14 @@ public:
 	 */
 	void compact(std::vector<unsigned int>& mapOldNew);
 
+	/**
+	 * container reordering: the container is compacted and its lines are renumbered
+	 * in the given order, lines that are not in order follow in their current order
+	 * @param order indices of used lines (without duplicates) in their new order
+	 * @param mapOldNew table that contains a map from old indices to new indices (holes -> 0xffffffff)
+	 */
+	void permute(const std::vector<unsigned int>& order, std::vector<unsigned int>& mapOldNew);
+
 	/**
 	 * Test the fragmentation of container,
 	 * in fact just size/max_size
@@ -375,6 +422,12 @@ public:
 	 */
 	inline float fragmentation();
 
+	/**
+	 * memory used by the holes of the container (lines freed before the last used one)
+	 * in bytes, i.e. (1 - fragmentation) * maxSize * cost of a line
+	 */
+	inline std::size_t fragmentationBytes() const;
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -406,6 +459,11 @@ public:
 	 */
 	inline void copyLine(unsigned int dstIndex, unsigned int srcIndex);
 
+	/**
+	 * swap the content (and the ref counters) of lines index1 and index2
+	 */
+	inline void swapLines(unsigned int index1, unsigned int index2);
+
 	/**
 	* increment the ref counter of the given line
 	* @param index index of the line
@@ -527,6 +585,53 @@ public:
 	*/
 	bool loadBin(CGoGNistream& fs);
 
+	/**
+	* save in an uncompressed binary file, with the data blocks
+	* of each attribute stored contiguously at aligned positions
+	* @param fs a file stream
+	* @param id the id to save
+	*/
+	void saveBinRaw(std::ostream& fs, unsigned int id) const;
+
+	/**
+	* get id from a mapped file
+	* @param mf the mapped file
+	* @param offset position in the file (moved forward)
+	* @return the id of attribute container
+	*/
+	static unsigned int loadBinRawId(const Utils::MappedFile& mf, std::size_t& offset);
+
+	/**
+	* load from a file saved with saveBinRaw and mapped in memory:
+	* the attribute blocks point directly into the mapping (copy on write)
+	* @param mf the mapped file
+	* @param offset position in the file (moved forward)
+	*/
+	bool loadBinRaw(const std::shared_ptr<Utils::MappedFile>& mf, std::size_t& offset);
+
+	/**
+	* save in a chunked compressed format: the blocks of each attribute are
+	* compressed by groups in independent zlib streams on several threads,
+	* each attribute being preceded by the table of its compressed chunk sizes
+	* @param fs a binary (not compressing) file stream
+	* @param id the id to save
+	* @param nbThreads number of threads (0 for hardware concurrency)
+	*/
+	void saveBinChunked(std::ostream& fs, unsigned int id, unsigned int nbThreads = 0) const;
+
+	/**
+	* get id from a stream written by saveBinChunked
+	*/
+	static unsigned int loadBinChunkedId(std::istream& fs);
+
+	/**
+	* load from a stream written by saveBinChunked, chunks are uncompressed in parallel
+	* @param fs a binary file stream
+	* @param attributeNames if not NULL only these attributes are loaded, others are skipped without decompression
+	* @param nbThreads number of threads (0 for hardware concurrency)
+	*/
+	bool loadBinChunked(std::istream& fs, const std::vector<std::string>* attributeNames = NULL, unsigned int nbThreads = 0);
+
 	/**
 	 * copy container
 	 * TODO a version that compact on the fly ?
@@ -77,6 +77,7 @@ AttributeMultiVector<T>* AttributeContainer::addAttribute(const std::string& att
 	// create the new attribute
 	std::string typeName = nameOfType(T()) ;
 	AttributeMultiVector<T>* amv = new AttributeMultiVector<T>(attribName, typeName) ;
+	amv->setBlockPool(m_blockPool) ;
 
 	if(!m_freeIndices.empty())
 	{
@@ -105,6 +106,8 @@ AttributeMultiVector<T>* AttributeContainer::addAttribute(const std::string& att
 	m_lineCost += sizeof(T) ;
 
 	// resize the new attribute so that it has the same size than others
+	if (m_contiguousCapacity > 0)
+		amv->setContiguous(m_contiguousCapacity) ;
 	amv->setNbBlocks(uint32(m_holesBlocks.size())) ;
 
 	m_nbAttributes++ ;
@@ -125,6 +128,9 @@ void AttributeContainer::addAttribute(const std::string& attribName, const std::
 
 	// create the new attribute
 	AttributeMultiVector<T>* amv = new AttributeMultiVector<T>(attribName, nametype);
+	amv->setBlockPool(m_blockPool) ;
+	if (m_contiguousCapacity > 0)
+		amv->setContiguous(m_contiguousCapacity) ;
 
 	m_tableAttribs[index] = amv;
 	amv->setOrbit(m_orbit) ;
@@ -247,6 +253,11 @@ inline float AttributeContainer::fragmentation()
 	return float(m_size) / float(m_maxSize);
 }
 
+inline std::size_t AttributeContainer::fragmentationBytes() const
+{
+	return std::size_t(m_maxSize - m_size) * m_lineCost;
+}
+
 /**************************************
  *         CONTAINER TRAVERSAL        *
  **************************************/
@@ -371,6 +382,24 @@ inline void AttributeContainer::copyLine(unsigned int dstIndex, unsigned int src
 	}
 }
 
+inline void AttributeContainer::swapLines(unsigned int index1, unsigned int index2)
+{
+	for(unsigned int i = 0; i < m_tableAttribs.size(); ++i)
+	{
+		if (m_tableAttribs[i] != NULL)
+			m_tableAttribs[i]->swapElt(index1, index2);
+	}
+
+	for(unsigned int i = 0; i < m_tableMarkerAttribs.size(); ++i)
+	{
+		m_tableMarkerAttribs[i]->swapElt(index1, index2);
+	}
+
+	unsigned int nb = getNbRefs(index1);
+	setNbRefs(index1, getNbRefs(index2));
+	setNbRefs(index2, nb);
+}
+
 inline void AttributeContainer::refLine(unsigned int index)
 {
 	m_holesBlocks[index / _BLOCKSIZE_]->ref(index % _BLOCKSIZE_);
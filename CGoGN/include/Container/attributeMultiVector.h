@@ -30,10 +30,16 @@
 #include <sstream>
 #include <fstream>
 #include <cstring>
+#include <memory>
+#include <new>
+#include <algorithm>
 
 #include <typeinfo>
 
 #include "Container/sizeblock.h"
+#include "Utils/mappedFile.h"
+#include "Utils/reservedMemory.h"
+#include "Utils/blockPool.h"
 
 namespace CGoGN
 {
@@ -79,6 +85,16 @@ protected:
 	 */
 	unsigned int m_index;
 
+	/**
+	 * pool of the blocks (NULL: the pool of the process)
+	 */
+	Utils::BlockPool* m_pool;
+
+	/**
+	 * pool in which blocks are allocated
+	 */
+	Utils::BlockPool& blockPool() const;
+
 public:
 	AttributeMultiVectorGen(const std::string& strName, const std::string& strType);
 
@@ -161,12 +177,45 @@ public:
 	 */
 	virtual int getSizeOfType() const = 0;
 
+	/**
+	 * store all the blocks in one contiguous range of addresses reserved for
+	 * maxNbLines lines (0 for separated blocks), existing data is moved.
+	 * Addresses stay valid when blocks are added: the block API still works
+	 * and the data can also be accessed as a flat array (getContiguousPointer).
+	 * Adding a block past maxNbLines throws std::bad_alloc
+	 * @return false if not possible (range too small or not available, markers)
+	 */
+	virtual bool setContiguous(unsigned int maxNbLines) = 0;
+
+	/**
+	 * max number of lines of the contiguous storage (0 if blocks are separated)
+	 */
+	virtual unsigned int getContiguousCapacity() const = 0;
+
+	/**
+	 * address of the first element if the storage is contiguous, NULL otherwise
+	 */
+	virtual void* getContiguousPointer() const = 0;
+
+	/**
+	 * allocate the blocks in a pool (NULL: the pool of the process),
+	 * existing blocks are moved in the new pool (mapped and contiguous blocks are not)
+	 */
+	virtual void setBlockPool(Utils::BlockPool* pool) = 0;
+
+	Utils::BlockPool* getBlockPool() const { return m_pool; }
+
 	/**************************************
 	 *             DATA ACCESS            *
 	 **************************************/
 
 	virtual unsigned int getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize) const = 0;
 
+	/**
+	 * get the addresses of the storage blocks (bit blocks for markers), used by save & load
+	 */
+	virtual unsigned int getStorageBlocks(std::vector<void*>& addr, unsigned int& byteBlockSize) const = 0;
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -192,6 +241,25 @@ public:
 
 	static bool skipLoadBin(CGoGNistream& fs);
 
+	/**
+	 * uncompressed save, data blocks are aligned for mapping (see loadBinRaw)
+	 * @param fs filestream
+	 * @param id id of mv
+	 */
+	virtual void saveBinRaw(std::ostream& fs, unsigned int id) = 0;
+
+	static unsigned int loadBinRawInfos(const Utils::MappedFile& mf, std::size_t& offset, std::string& name, std::string& type);
+
+	/**
+	 * load from a mapped file saved with saveBinRaw:
+	 * data blocks are not copied, they point directly into the mapping
+	 * @param mf the mapped file (kept alive as long as its blocks are used)
+	 * @param offset position in the file (moved after the attribute)
+	 */
+	virtual bool loadBinRaw(const std::shared_ptr<Utils::MappedFile>& mf, std::size_t& offset) = 0;
+
+	static bool skipLoadBinRaw(const Utils::MappedFile& mf, std::size_t& offset);
+
 	/**
 	 * lecture binaire
 	 * @param fs filestream
@@ -214,6 +282,36 @@ class AttributeMultiVector : public AttributeMultiVectorGen
 	*/
 	std::vector<T*> m_tableData;
 
+	/**
+	 * file in which some blocks are mapped (NULL if none)
+	 */
+	std::shared_ptr<Utils::MappedFile> m_mappedFile;
+
+	/**
+	 * contiguous storage: first element (NULL if blocks are separated),
+	 * reserved range of addresses and max number of blocks in it.
+	 * m_tableData then points to consecutive blocks of the range, so that
+	 * the block API is the same in both modes
+	 */
+	T* m_contiguousData;
+	Utils::ReservedMemory m_reserved;
+	unsigned int m_maxNbBlocks;
+
+	/**
+	 * get a block of the pool with default constructed elements
+	 */
+	T* newBlock();
+
+	/**
+	 * free a block (mapped blocks are not owned)
+	 */
+	void deleteBlock(T* ptr);
+
+	/**
+	 * swap the storage of two vectors (blocks, pool, mapping and reserved range)
+	 */
+	void swapStorage(AttributeMultiVector<T>& amv);
+
 	inline void setTypeCode();
 
 public:
@@ -247,6 +345,19 @@ public:
 
 	int getSizeOfType() const;
 
+	bool setContiguous(unsigned int maxNbLines);
+
+	unsigned int getContiguousCapacity() const;
+
+	void* getContiguousPointer() const;
+
+	void setBlockPool(Utils::BlockPool* pool);
+
+	/**
+	 * first element of the contiguous storage (NULL if blocks are separated)
+	 */
+	T* getContiguousData() const;
+
 	/**************************************
 	 *             DATA ACCESS            *
 	 **************************************/
@@ -268,6 +379,8 @@ public:
 	 */
 	unsigned int getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize) const;
 
+	unsigned int getStorageBlocks(std::vector<void*>& addr, unsigned int& byteBlockSize) const;
+
 	/**************************************
 	 *          LINES MANAGEMENT          *
 	 **************************************/
@@ -320,6 +433,10 @@ public:
 	 */
 	bool loadBin(CGoGNistream& fs);
 
+	void saveBinRaw(std::ostream& fs, unsigned int id);
+
+	bool loadBinRaw(const std::shared_ptr<Utils::MappedFile>& mf, std::size_t& offset);
+
 	/**
 	 * lecture binaire
 	 * @param fs filestream
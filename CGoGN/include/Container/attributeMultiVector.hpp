@@ -27,10 +27,11 @@ namespace CGoGN
 {
 
 inline AttributeMultiVectorGen::AttributeMultiVectorGen(const std::string& strName, const std::string& strType):
-	m_attrName(strName), m_typeName(strType)
+	m_attrName(strName), m_typeName(strType), m_pool(NULL)
 {}
 
-inline AttributeMultiVectorGen::AttributeMultiVectorGen()
+inline AttributeMultiVectorGen::AttributeMultiVectorGen():
+	m_pool(NULL)
 {}
 
 inline AttributeMultiVectorGen::~AttributeMultiVectorGen()
@@ -90,19 +91,28 @@ inline CGoGNCodeType AttributeMultiVectorGen::getTypeCode() const
 	return m_typeCode;
 }
 
+inline Utils::BlockPool& AttributeMultiVectorGen::blockPool() const
+{
+	return (m_pool != NULL) ? *m_pool : Utils::BlockPool::getInstance();
+}
+
 /***************************************************************************************************/
 /***************************************************************************************************/
 
 
 template <typename T>
 AttributeMultiVector<T>::AttributeMultiVector(const std::string& strName, const std::string& strType):
-	AttributeMultiVectorGen(strName, strType)
+	AttributeMultiVectorGen(strName, strType),
+	m_contiguousData(NULL),
+	m_maxNbBlocks(0)
 {
 	m_tableData.reserve(1024);
 }
 
 template <typename T>
-AttributeMultiVector<T>::AttributeMultiVector()
+AttributeMultiVector<T>::AttributeMultiVector():
+	m_contiguousData(NULL),
+	m_maxNbBlocks(0)
 {
 	m_tableData.reserve(1024);
 }
@@ -111,7 +121,44 @@ template <typename T>
 AttributeMultiVector<T>::~AttributeMultiVector()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
+}
+
+template <typename T>
+inline T* AttributeMultiVector<T>::newBlock()
+{
+	T* ptr = static_cast<T*>(blockPool().allocate(_BLOCKSIZE_ * sizeof(T)));
+	for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+		new (ptr + i) T;
+	return ptr;
+}
+
+template <typename T>
+inline void AttributeMultiVector<T>::deleteBlock(T* ptr)
+{
+	if (m_contiguousData != NULL)
+	{
+		// elements are destroyed, memory is given back by m_reserved
+		for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+			ptr[i].~T();
+	}
+	else if (!m_mappedFile || !m_mappedFile->contains(ptr))
+	{
+		for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+			ptr[i].~T();
+		blockPool().release(ptr, _BLOCKSIZE_ * sizeof(T));
+	}
+}
+
+template <typename T>
+void AttributeMultiVector<T>::swapStorage(AttributeMultiVector<T>& amv)
+{
+	m_tableData.swap(amv.m_tableData);
+	std::swap(m_pool, amv.m_pool);
+	m_mappedFile.swap(amv.m_mappedFile);
+	m_reserved.swap(amv.m_reserved);
+	std::swap(m_contiguousData, amv.m_contiguousData);
+	std::swap(m_maxNbBlocks, amv.m_maxNbBlocks);
 }
 
 template <typename T>
@@ -119,6 +166,7 @@ inline AttributeMultiVectorGen* AttributeMultiVector<T>::new_obj()
 {
 	AttributeMultiVectorGen* ptr = new AttributeMultiVector<T>;
 	ptr->setTypeName(m_typeName);
+	ptr->setBlockPool(m_pool);
 	return ptr;
 }
 
@@ -129,8 +177,23 @@ inline AttributeMultiVectorGen* AttributeMultiVector<T>::new_obj()
 template <typename T>
 inline void AttributeMultiVector<T>::addBlock()
 {
-	T* ptr = new T[_BLOCKSIZE_];
-	m_tableData.push_back(ptr);
+	if (m_contiguousData != NULL)
+	{
+		unsigned int nb = uint32(m_tableData.size());
+		if (nb < m_maxNbBlocks && m_reserved.commit(std::size_t(nb + 1) * _BLOCKSIZE_ * sizeof(T)))
+		{
+			T* ptr = m_contiguousData + std::size_t(nb) * _BLOCKSIZE_;
+			for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+				new (ptr + i) T;
+			m_tableData.push_back(ptr);
+			return;
+		}
+		// addresses of the lines must stay valid: the range is neither moved nor left
+		CGoGNerr << "Contiguous storage of attribute " << m_attrName << " is full (" << m_maxNbBlocks * _BLOCKSIZE_ << " lines)" << CGoGNendl;
+		throw std::bad_alloc();
+	}
+
+	m_tableData.push_back(newBlock());
 	// init
 //	T* endPtr = ptr + _BLOCKSIZE_;
 //	while (ptr != endPtr)
@@ -148,8 +211,10 @@ void AttributeMultiVector<T>::setNbBlocks(unsigned int nbb)
 	else
 	{
 		for (size_t i = nbb; i < m_tableData.size(); ++i)
-			delete[] m_tableData[i];
+			deleteBlock(m_tableData[i]);
 		m_tableData.resize(nbb);
+		if (m_contiguousData != NULL)
+			m_reserved.commit(std::size_t(nbb) * _BLOCKSIZE_ * sizeof(T));
 	}
 }
 
@@ -162,6 +227,25 @@ unsigned int AttributeMultiVector<T>::getNbBlocks() const
 template <typename T>
 void AttributeMultiVector<T>::addBlocksBefore(unsigned int nbb)
 {
+	if (m_contiguousData != NULL)
+	{
+		// blocks can not be inserted before: data is moved nbb blocks further
+		unsigned int nb = uint32(m_tableData.size());
+		for (unsigned int i = 0; i < nbb; ++i)
+			addBlock();
+		for (unsigned int b = nb; b > 0; --b)
+		{
+			for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+				m_tableData[b - 1 + nbb][i] = std::move(m_tableData[b - 1][i]);
+		}
+		for (unsigned int b = 0; b < nbb && b < nb; ++b)
+		{
+			for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+				m_tableData[b][i] = T();
+		}
+		return;
+	}
+
 	std::vector<T*> tempo;
 	tempo.reserve(1024);
 
@@ -212,7 +296,7 @@ bool AttributeMultiVector<T>::swap(AttributeMultiVectorGen* atmvg)
 		return false;
 	}
 
-	m_tableData.swap(atmv->m_tableData) ;
+	swapStorage(*atmv);
 	return true;
 }
 
@@ -232,8 +316,35 @@ bool AttributeMultiVector<T>::merge(const AttributeMultiVectorGen& att)
 		return false;
 	}
 
+	if (m_contiguousData != NULL)
+	{
+		// data is copied in new blocks of the contiguous range
+		for (typename std::vector<T*>::const_iterator it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
+		{
+			addBlock();
+			T* ptr = m_tableData.back();
+			for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+				ptr[i] = (*it)[i];
+		}
+		return true;
+	}
+
+	// mapped blocks are shared, owned blocks are copied (they are freed with attrib)
 	for (typename std::vector<T*>::const_iterator it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
-		m_tableData.push_back(*it);
+	{
+		if (attrib->m_mappedFile && attrib->m_mappedFile->contains(*it) && (!m_mappedFile || m_mappedFile == attrib->m_mappedFile))
+		{
+			m_mappedFile = attrib->m_mappedFile;
+			m_tableData.push_back(*it);
+		}
+		else
+		{
+			T* ptr = newBlock();
+			for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+				ptr[i] = (*it)[i];
+			m_tableData.push_back(ptr);
+		}
+	}
 
 	return true;
 }
@@ -242,8 +353,11 @@ template <typename T>
 inline void AttributeMultiVector<T>::clear()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
 	m_tableData.clear();
+	m_mappedFile.reset();
+	if (m_contiguousData != NULL)
+		m_reserved.commit(0);
 }
 
 template <typename T>
@@ -252,6 +366,89 @@ inline int AttributeMultiVector<T>::getSizeOfType() const
 	return sizeof(T);
 }
 
+template <typename T>
+bool AttributeMultiVector<T>::setContiguous(unsigned int maxNbLines)
+{
+	unsigned int maxNbBlocks = (maxNbLines + _BLOCKSIZE_ - 1) / _BLOCKSIZE_;
+	unsigned int nb = uint32(m_tableData.size());
+
+	if (maxNbBlocks == 0 && m_contiguousData == NULL)
+		return true;
+	if (maxNbBlocks != 0 && maxNbBlocks < nb)
+	{
+		CGoGNerr << "Contiguous storage too small for attribute " << m_attrName << CGoGNendl;
+		return false;
+	}
+
+	// new storage, then data is moved in it
+	AttributeMultiVector<T> tmp;
+	tmp.m_pool = m_pool;
+	if (maxNbBlocks != 0)
+	{
+		if (!tmp.m_reserved.reserve(std::size_t(maxNbBlocks) * _BLOCKSIZE_ * sizeof(T)))
+		{
+			CGoGNerr << "Unable to reserve contiguous storage for attribute " << m_attrName << CGoGNendl;
+			return false;
+		}
+		tmp.m_contiguousData = reinterpret_cast<T*>(tmp.m_reserved.data());
+		tmp.m_maxNbBlocks = maxNbBlocks;
+	}
+	tmp.setNbBlocks(nb);
+
+	for (unsigned int b = 0; b < nb; ++b)
+	{
+		for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+			tmp.m_tableData[b][i] = std::move(m_tableData[b][i]);
+	}
+
+	// old storage is freed with tmp
+	swapStorage(tmp);
+	return true;
+}
+
+template <typename T>
+inline unsigned int AttributeMultiVector<T>::getContiguousCapacity() const
+{
+	return (m_contiguousData != NULL) ? m_maxNbBlocks * _BLOCKSIZE_ : 0;
+}
+
+template <typename T>
+inline void* AttributeMultiVector<T>::getContiguousPointer() const
+{
+	return m_contiguousData;
+}
+
+template <typename T>
+inline T* AttributeMultiVector<T>::getContiguousData() const
+{
+	return m_contiguousData;
+}
+
+template <typename T>
+void AttributeMultiVector<T>::setBlockPool(Utils::BlockPool* pool)
+{
+	Utils::BlockPool& from = blockPool();
+	m_pool = pool;
+	Utils::BlockPool& to = blockPool();
+	if (&from == &to || m_contiguousData != NULL)
+		return;
+
+	// owned blocks are moved in blocks of the new pool
+	for (typename std::vector<T*>::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
+	{
+		if (m_mappedFile && m_mappedFile->contains(*it))
+			continue;
+		T* ptr = static_cast<T*>(to.allocate(_BLOCKSIZE_ * sizeof(T)));
+		for (unsigned int i = 0; i < _BLOCKSIZE_; ++i)
+		{
+			new (ptr + i) T(std::move((*it)[i]));
+			(*it)[i].~T();
+		}
+		from.release(*it, _BLOCKSIZE_ * sizeof(T));
+		*it = ptr;
+	}
+}
+
 /**************************************
  *             DATA ACCESS            *
  **************************************/
@@ -259,12 +456,16 @@ inline int AttributeMultiVector<T>::getSizeOfType() const
 template <typename T>
 inline T& AttributeMultiVector<T>::operator[](unsigned int i)
 {
+	if (m_contiguousData != NULL)
+		return m_contiguousData[i];
 	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
 }
 
 template <typename T>
 inline const T& AttributeMultiVector<T>::operator[](unsigned int i) const
 {
+	if (m_contiguousData != NULL)
+		return m_contiguousData[i];
 	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
 }
 
@@ -282,6 +483,12 @@ unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr
 	return uint32(addr.size());
 }
 
+template <typename T>
+inline unsigned int AttributeMultiVector<T>::getStorageBlocks(std::vector<void*>& addr, unsigned int& byteBlockSize) const
+{
+	return getBlocksPointers(addr, byteBlockSize);
+}
+
 /**************************************
  *          LINES MANAGEMENT          *
  **************************************/
@@ -372,11 +579,19 @@ bool AttributeMultiVector<T>::loadBin(CGoGNistream& fs)
 
 	unsigned int nb = nbs[0];
 
-	// load data blocks
+	// load data blocks (in the contiguous range if any)
+	if (m_contiguousData != NULL)
+	{
+		setNbBlocks(nb);
+		for(unsigned int i = 0; i < nb; ++i)
+			fs.read(reinterpret_cast<char*>(m_tableData[i]),_BLOCKSIZE_*sizeof(T));
+		return true;
+	}
+
 	m_tableData.resize(nb);
 	for(unsigned int i = 0; i < nb; ++i)
 	{
-		T* ptr = new T[_BLOCKSIZE_];
+		T* ptr = newBlock();
 		fs.read(reinterpret_cast<char*>(ptr),_BLOCKSIZE_*sizeof(T));
 		m_tableData[i] = ptr;
 	}
@@ -384,6 +599,101 @@ bool AttributeMultiVector<T>::loadBin(CGoGNistream& fs)
 	return true;
 }
 
+template <typename T>
+void AttributeMultiVector<T>::saveBinRaw(std::ostream& fs, unsigned int id)
+{
+	unsigned int nbs[3];
+	nbs[0] = id;
+	unsigned int len1 = uint32(m_attrName.size()+1);
+	unsigned int len2 = uint32(m_typeName.size()+1);
+	nbs[1] = len1;
+	nbs[2] = len2;
+	fs.write(reinterpret_cast<const char*>(nbs), 3*sizeof(unsigned int));
+	fs.write(m_attrName.c_str(), len1);
+	fs.write(m_typeName.c_str(), len2);
+
+	// number of blocks and size of a block
+	nbs[0] = uint32(m_tableData.size());
+	nbs[1] = _BLOCKSIZE_ * sizeof(T);
+	fs.write(reinterpret_cast<const char*>(nbs), 2*sizeof(unsigned int));
+
+	// store data blocks contiguously from an aligned position
+	Utils::MappedFile::writePadding(fs);
+	for (unsigned int i = 0; i < nbs[0]; ++i)
+		fs.write(reinterpret_cast<const char*>(m_tableData[i]), _BLOCKSIZE_*sizeof(T));
+}
+
+inline unsigned int AttributeMultiVectorGen::loadBinRawInfos(const Utils::MappedFile& mf, std::size_t& offset, std::string& name, std::string& type)
+{
+	unsigned int nbs[3];
+	// both names must be null terminated inside the file
+	if (!mf.read(offset, nbs, 3*sizeof(unsigned int)) || nbs[1] == 0 || nbs[2] == 0 || offset + nbs[1] + nbs[2] > mf.size()
+		|| mf.data()[offset + nbs[1] - 1] != '\0' || mf.data()[offset + nbs[1] + nbs[2] - 1] != '\0')
+	{
+		offset = mf.size();
+		return 0xffffffff;
+	}
+
+	name = std::string(mf.data() + offset);
+	type = std::string(mf.data() + offset + nbs[1]);
+	offset += nbs[1] + nbs[2];
+
+	return nbs[0];
+}
+
+template <typename T>
+bool AttributeMultiVector<T>::loadBinRaw(const std::shared_ptr<Utils::MappedFile>& mf, std::size_t& offset)
+{
+	unsigned int nbs[2];
+	if (!mf->read(offset, nbs, 2*sizeof(unsigned int)))
+		return false;
+
+	if (nbs[1] != _BLOCKSIZE_ * sizeof(T))
+	{
+		CGoGNerr << "Wrong block size for attribute " << m_attrName << CGoGNendl;
+		return false;
+	}
+
+	offset = Utils::MappedFile::align(offset);
+	const std::size_t nb = nbs[0];
+	if (offset + nb * nbs[1] > mf->size())
+	{
+		CGoGNerr << "Truncated file when loading attribute " << m_attrName << CGoGNendl;
+		return false;
+	}
+
+	// contiguous storage: data is copied from the mapping
+	if (m_contiguousData != NULL)
+	{
+		clear();
+		setNbBlocks(uint32(nb));
+		for (std::size_t i = 0; i < nb; ++i)
+			std::memcpy(reinterpret_cast<void*>(m_tableData[i]), mf->data() + offset + i * nbs[1], nbs[1]);
+		offset += nb * nbs[1];
+		return true;
+	}
+
+	// blocks point into the mapping
+	clear();
+	m_mappedFile = mf;
+	m_tableData.resize(nb);
+	for (std::size_t i = 0; i < nb; ++i)
+		m_tableData[i] = reinterpret_cast<T*>(mf->data() + offset + i * nbs[1]);
+	offset += nb * nbs[1];
+
+	return true;
+}
+
+inline bool AttributeMultiVectorGen::skipLoadBinRaw(const Utils::MappedFile& mf, std::size_t& offset)
+{
+	unsigned int nbs[2];
+	if (!mf.read(offset, nbs, 2*sizeof(unsigned int)))
+		return false;
+
+	offset = Utils::MappedFile::align(offset) + std::size_t(nbs[0]) * nbs[1];
+	return offset <= mf.size();
+}
+
 inline bool AttributeMultiVectorGen::skipLoadBin(CGoGNistream& fs)
 {
 	unsigned int nbs[2];
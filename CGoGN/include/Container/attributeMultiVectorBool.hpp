@@ -45,6 +45,16 @@ class AttributeMultiVector<MarkerBool> : public AttributeMultiVectorGen
 	*/
 	std::vector< unsigned int* > m_tableData;
 
+	unsigned int* newBlock()
+	{
+		return static_cast<unsigned int*>(blockPool().allocate(_BLOCKSIZE_/8));
+	}
+
+	void deleteBlock(unsigned int* ptr)
+	{
+		blockPool().release(ptr, _BLOCKSIZE_/8);
+	}
+
 public:
 	AttributeMultiVector(const std::string& strName, const std::string& strType):
 		AttributeMultiVectorGen(strName, strType)
@@ -57,12 +67,16 @@ public:
 		m_tableData.reserve(1024);
 	}
 
-	~AttributeMultiVector() {}
+	~AttributeMultiVector()
+	{
+		clear();
+	}
 
 	inline AttributeMultiVectorGen* new_obj()
 	{
 		AttributeMultiVectorGen* ptr = new AttributeMultiVector<MarkerBool>;
 		ptr->setTypeName(m_typeName);
+		ptr->setBlockPool(m_pool);
 		return ptr;
 	}
 
@@ -72,7 +86,7 @@ public:
 
 	void addBlock()
 	{
-		unsigned int* ptr = new unsigned int[_BLOCKSIZE_/32];
+		unsigned int* ptr = newBlock();
 		memset(ptr,0,_BLOCKSIZE_/8);
 		m_tableData.push_back(ptr);
 //		std::cout << "Marker "<<this->getName()<<" - addBlock"<< std::endl;
@@ -87,8 +101,8 @@ public:
 		}
 		else
 		{
-			for (size_t i = m_tableData.size()-1; i>=nbb; --i)
-				delete[] m_tableData[i];
+			for (size_t i = nbb; i < m_tableData.size(); ++i)
+				deleteBlock(m_tableData[i]);
 
 			m_tableData.resize(nbb);
 		}
@@ -139,6 +153,7 @@ public:
 		}
 
 		m_tableData.swap(atmv->m_tableData) ;
+		std::swap(m_pool, atmv->m_pool);
 		return true;
 	}
 
@@ -157,8 +172,13 @@ public:
 			return false;
 		}
 
+		// blocks are copied (they are freed with attrib)
 		for (auto it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
-			m_tableData.push_back(*it);
+		{
+			unsigned int* ptr = newBlock();
+			memcpy(ptr, *it, _BLOCKSIZE_/8);
+			m_tableData.push_back(ptr);
+		}
 
 		return true;
 	}
@@ -166,7 +186,7 @@ public:
 	void clear()
 	{
 		for (auto it=m_tableData.begin(); it !=m_tableData.end(); ++it)
-			delete[] *it;
+			deleteBlock(*it);
 		m_tableData.clear();
 	}
 
@@ -175,6 +195,39 @@ public:
 		return sizeof(bool); // ?
 	}
 
+	// markers are always stored in separated blocks
+	bool setContiguous(unsigned int maxNbLines)
+	{
+		return maxNbLines == 0;
+	}
+
+	unsigned int getContiguousCapacity() const
+	{
+		return 0;
+	}
+
+	void* getContiguousPointer() const
+	{
+		return NULL;
+	}
+
+	void setBlockPool(Utils::BlockPool* pool)
+	{
+		Utils::BlockPool& from = blockPool();
+		m_pool = pool;
+		Utils::BlockPool& to = blockPool();
+		if (&from == &to)
+			return;
+
+		for (auto it = m_tableData.begin(); it != m_tableData.end(); ++it)
+		{
+			unsigned int* ptr = static_cast<unsigned int*>(to.allocate(_BLOCKSIZE_/8));
+			memcpy(ptr, *it, _BLOCKSIZE_/8);
+			from.release(*it, _BLOCKSIZE_/8);
+			*it = ptr;
+		}
+	}
+
 	inline void allFalse()
 	{
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
@@ -291,6 +344,13 @@ public:
 		return uint32(addr.size());
 	}
 
+	unsigned int getStorageBlocks(std::vector<void*>& addr, unsigned int& byteBlockSize) const
+	{
+		byteBlockSize = _BLOCKSIZE_/8;
+		addr.assign(m_tableData.begin(), m_tableData.end());
+		return uint32(addr.size());
+	}
+
 
 	/**************************************
 	 *          LINES MANAGEMENT          *
@@ -385,13 +445,57 @@ public:
 
 		for(unsigned int i = 0; i < nb; ++i)
 		{
-			m_tableData[i] = new unsigned int[_BLOCKSIZE_/32];
+			m_tableData[i] = newBlock();
 			fs.read(reinterpret_cast<char*>(m_tableData[i]),_BLOCKSIZE_/8);
 		}
 
 		return true;
 	}
 
+	void saveBinRaw(std::ostream& fs, unsigned int id)
+	{
+		unsigned int nbs[3];
+		nbs[0] = id;
+		unsigned int len1 = uint32(m_attrName.size()+1);
+		unsigned int len2 = uint32(m_typeName.size()+1);
+		nbs[1] = len1;
+		nbs[2] = len2;
+		fs.write(reinterpret_cast<const char*>(nbs),3*sizeof(unsigned int));
+		fs.write(m_attrName.c_str(), len1);
+		fs.write(m_typeName.c_str(), len2);
+
+		nbs[0] = uint32(m_tableData.size());
+		nbs[1] = _BLOCKSIZE_/8;
+		fs.write(reinterpret_cast<const char*>(nbs),2*sizeof(unsigned int));
+
+		Utils::MappedFile::writePadding(fs);
+		for (auto ptrIt = m_tableData.begin(); ptrIt!=m_tableData.end(); ++ptrIt)
+			fs.write(reinterpret_cast<const char*>(*ptrIt),_BLOCKSIZE_/8);
+	}
+
+	/**
+	 * markers are small and often written: their blocks are copied, not mapped
+	 */
+	bool loadBinRaw(const std::shared_ptr<Utils::MappedFile>& mf, std::size_t& offset)
+	{
+		unsigned int nbs[2];
+		if (!mf->read(offset, nbs, 2*sizeof(unsigned int)) || nbs[1] != _BLOCKSIZE_/8)
+			return false;
+
+		offset = Utils::MappedFile::align(offset);
+
+		unsigned int nb = nbs[0];
+		m_tableData.resize(nb);
+		for(unsigned int i = 0; i < nb; ++i)
+		{
+			m_tableData[i] = newBlock();
+			if (!mf->read(offset, m_tableData[i], _BLOCKSIZE_/8))
+				return false;
+		}
+
+		return true;
+	}
+
 	/**
 	 * lecture binaire
 	 * @param fs filestream
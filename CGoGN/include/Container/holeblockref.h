@@ -30,6 +30,7 @@
 #include <assert.h>
 
 #include "Container/sizeblock.h"
+#include "Utils/mappedFile.h"
 
 
 namespace CGoGN
@@ -55,6 +56,11 @@ protected:
 	*/
 	unsigned int m_nb;
 
+	/**
+	* are all the free indices in the table of refs (after loading)
+	*/
+	bool validTableFree() const;
+
 public:
 	/**
 	* constructor
@@ -187,9 +193,18 @@ public:
 
 	bool updateHoles(unsigned int nb);
 
-	void saveBin(CGoGNostream& fs);
+	void saveBin(std::ostream& fs);
+
+	/**
+	* load from a stream
+	* @return false if the stream is truncated or the values are not valid
+	*/
+	bool loadBin(std::istream& fs);
 
-	bool loadBin(CGoGNistream& fs);
+	/**
+	* load from a mapped file (the block data are copied)
+	*/
+	bool loadBinRaw(const Utils::MappedFile& mf, std::size_t& offset);
 
 	unsigned int* getTableFree(unsigned int & nb) {nb =m_nbfree; return m_tableFree;}
 };
@@ -22,7 +22,7 @@
 *                                                                              *
 *******************************************************************************/
 
-#include "Utils/threadbarrier.h"
+#include "Utils/threadPool.h"
 #include "Algo/Topo/embedding.h"
 
 
@@ -279,109 +279,58 @@ inline AttributeHandlerIter<T,ORB,MAP> AttributeHandler<T, ORB, MAP>::iterable()
 namespace Parallel
 {
 
-template <typename FUNC>
-class ThreadFunctionAttrib
-{
-protected:
-	std::vector<unsigned int>& m_ids;
-	Utils::Barrier& m_sync1;
-	Utils::Barrier& m_sync2;
-	bool& m_finished;
-	unsigned int m_id;
-	FUNC m_lambda;
-public:
-	ThreadFunctionAttrib(FUNC func, std::vector<unsigned int>& vid, Utils::Barrier& s1, Utils::Barrier& s2, bool& finished, unsigned int id):
-		m_ids(vid), m_sync1(s1), m_sync2(s2), m_finished(finished), m_id(id), m_lambda(func)
-	{
-	}
-
-	ThreadFunctionAttrib(const ThreadFunctionAttrib& tf):
-		m_ids(tf.m_ids), m_sync1(tf.m_sync1), m_sync2(tf.m_sync2), m_finished(tf.m_finished), m_id(tf.m_id), m_lambda(tf.m_lambda){}
-
-	void operator()()
-	{
-		while (!m_finished)
-		{
-			for (std::vector<unsigned int>::const_iterator it = m_ids.begin(); it != m_ids.end(); ++it)
-				m_lambda(*it,m_id);
-			m_sync1.wait();
-			m_sync2.wait();
-		}
-	}
-};
-
-
-
 template <typename ATTR, typename FUNC>
 void foreach_attribute(ATTR& attribute, FUNC func, unsigned int nbthread)
 {
-	// thread 0 is for attribute traversal
-	unsigned int nbth = nbthread -1;
-
-	std::vector< unsigned int >* vd = new std::vector< unsigned int >[nbth];
-	for (unsigned int i = 0; i < nbth; ++i)
-		vd[i].reserve(SIZE_BUFFER_THREAD);
-
-	unsigned int nb = 0;
-	unsigned int attIdx = attribute.begin();
-	while ((attIdx != attribute.end()) && (nb < nbth*SIZE_BUFFER_THREAD) )
-	{
-		vd[nb%nbth].push_back(attIdx);
-		nb++;
-		attribute.next(attIdx);
-	}
-	Utils::Barrier sync1(nbth+1);
-	Utils::Barrier sync2(nbth+1);
-	bool finished=false;
-
+	// thread 0 only waits, ids [0,nbth) are given to func
+	unsigned int nbth = nbthread > 1 ? nbthread - 1 : 1;
 
-	std::thread** threads = new std::thread*[nbth];
-	ThreadFunctionAttrib<FUNC>** tfs = new ThreadFunctionAttrib<FUNC>*[nbth];
+	const AttributeContainer& cont = attribute.map()->template getAttributeContainer<ATTR::ORBIT>();
 
-	for (unsigned int i = 0; i < nbth; ++i)
+	// lines to process: whole container or lines given by the browser
+	std::vector<unsigned int> lines;
+	unsigned int nbLines = cont.realEnd();
+	if (cont.hasBrowser())
 	{
-		tfs[i] = new ThreadFunctionAttrib<FUNC>(func, vd[i], sync1,sync2,finished,i);
-		threads[i] = new std::thread( std::ref( *(tfs[i]) ) );
+		for (unsigned int i = attribute.begin(); i != attribute.end(); attribute.next(i))
+			lines.push_back(i);
+		nbLines = uint32(lines.size());
 	}
 
-	// and continue to traverse the map
-	std::vector< unsigned int >* tempo = new std::vector< unsigned int >[nbth];
-	for (unsigned int i = 0; i < nbth; ++i)
-		tempo[i].reserve(SIZE_BUFFER_THREAD);
+	unsigned int cs = nbLines / (8 * nbth);
+	if (cs > 256)
+		cs = 256;
+	else if (cs == 0)
+		cs = 1;
+	Utils::WorkStealingRange range((nbLines + cs - 1) / cs, nbth);
 
-	while (attIdx != attribute.end())
+	std::function<void(unsigned int)> job = [&] (unsigned int th)
 	{
-		for (unsigned int i = 0; i < nbth; ++i)
-			tempo[i].clear();
-		unsigned int nb = 0;
+		if (th == 0)
+			return;
 
-		while ((attIdx != attribute.end()) && (nb < nbth*SIZE_BUFFER_THREAD) )
+		FUNC f(func);
+		unsigned int chunk;
+		while (range.next(th - 1, chunk))
 		{
-			tempo[nb%nbth].push_back(attIdx);
-			nb++;
-			attribute.next(attIdx);
+			unsigned int b = chunk * cs;
+			unsigned int e = std::min(b + cs, nbLines);
+			if (lines.empty())
+			{
+				for (unsigned int i = b; i < e; ++i)
+				{
+					if (cont.used(i))
+						f(i, th - 1);
+				}
+			}
+			else
+			{
+				for (unsigned int i = b; i < e; ++i)
+					f(lines[i], th - 1);
+			}
 		}
-		sync1.wait();// wait for all thread to finish its vector
-		for (unsigned int i = 0; i < nbth; ++i)
-			vd[i].swap(tempo[i]);
-		sync2.wait();// everybody refilled then go
-	}
-
-	sync1.wait();// wait for all thread to finish its vector
-	finished = true;// say finsih to everyone
-	sync2.wait(); // just wait for last barrier wait !
-
-	//wait for all theads to be finished
-	for (unsigned int i = 0; i < nbth; ++i)
-	{
-		threads[i]->join();
-		delete threads[i];
-		delete tfs[i];
-	}
-	delete[] tfs;
-	delete[] threads;
-	delete[] vd;
-	delete[] tempo;
+	};
+	Utils::ThreadPool::getInstance().run(nbth + 1, job);
 }
 
 }
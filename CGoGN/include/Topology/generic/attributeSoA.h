@@ -0,0 +1,135 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ATTRIBUTE_SOA_H__
+#define __ATTRIBUTE_SOA_H__
+
+#include <vector>
+#include <cassert>
+
+#include "Container/sizeblock.h"
+#include "Topology/generic/attributeHandler.h"
+#include "Geometry/vector_gen.h"
+#include "Utils/simd.h"
+
+namespace CGoGN
+{
+
+/**
+ * Structure of arrays copy of an attribute of Geom::Vector<DIM,T>:
+ * for each block of _BLOCKSIZE_ lines of the container, the DIM components
+ * are stored in DIM separate arrays aligned for SIMD processing.
+ * Values are indexed by the lines of the attribute container (as the attribute),
+ * so that a sequence of SIMD kernels can work on the view and copy the result
+ * back to the attribute only once.
+ */
+template <typename T, unsigned int DIM>
+class AttributeSoA
+{
+protected:
+	// DIM consecutive arrays of _BLOCKSIZE_ values per block
+	std::vector<T*> m_blocks;
+
+	AttributeSoA(const AttributeSoA&);
+	AttributeSoA& operator=(const AttributeSoA&);
+
+public:
+	AttributeSoA() {}
+
+	~AttributeSoA() { clear(); }
+
+	/**
+	 * allocate the blocks needed to store the lines [0,nbLines)
+	 */
+	void resize(unsigned int nbLines)
+	{
+		unsigned int nbBlocks = (nbLines + _BLOCKSIZE_ - 1) / _BLOCKSIZE_;
+		while (m_blocks.size() < nbBlocks)
+			m_blocks.push_back(static_cast<T*>(Utils::alignedMalloc(DIM * _BLOCKSIZE_ * sizeof(T))));
+	}
+
+	void clear()
+	{
+		for (unsigned int i = 0; i < m_blocks.size(); ++i)
+			Utils::alignedFree(m_blocks[i]);
+		m_blocks.clear();
+	}
+
+	unsigned int getNbBlocks() const { return (unsigned int)(m_blocks.size()); }
+
+	/**
+	 * aligned array of the component c of the lines of a block
+	 */
+	T* component(unsigned int block, unsigned int c) { return m_blocks[block] + c * _BLOCKSIZE_; }
+
+	const T* component(unsigned int block, unsigned int c) const { return m_blocks[block] + c * _BLOCKSIZE_; }
+
+	T& operator()(unsigned int line, unsigned int c) { return m_blocks[line / _BLOCKSIZE_][c * _BLOCKSIZE_ + line % _BLOCKSIZE_]; }
+
+	const T& operator()(unsigned int line, unsigned int c) const { return m_blocks[line / _BLOCKSIZE_][c * _BLOCKSIZE_ + line % _BLOCKSIZE_]; }
+
+	/**
+	 * copy the component c of nb lines in out
+	 */
+	void gather(const unsigned int* lines, unsigned int nb, unsigned int c, T* out) const
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			out[i] = (*this)(lines[i], c);
+	}
+
+	/**
+	 * copy the values of the attribute in the view
+	 */
+	template <unsigned int ORBIT, typename MAP>
+	void load(const AttributeHandler<Geom::Vector<DIM, T>, ORBIT, MAP>& att)
+	{
+		resize(att.end());
+		for (unsigned int i = att.begin(); i != att.end(); att.next(i))
+		{
+			const Geom::Vector<DIM, T>& x = att[i];
+			for (unsigned int c = 0; c < DIM; ++c)
+				(*this)(i, c) = x[c];
+		}
+	}
+
+	/**
+	 * copy the values of the view in the attribute
+	 */
+	template <unsigned int ORBIT, typename MAP>
+	void store(AttributeHandler<Geom::Vector<DIM, T>, ORBIT, MAP>& att) const
+	{
+		assert(att.end() <= m_blocks.size() * _BLOCKSIZE_ || !"AttributeSoA::store: view smaller than the attribute");
+		for (unsigned int i = att.begin(); i != att.end(); att.next(i))
+		{
+			Geom::Vector<DIM, T>& x = att[i];
+			for (unsigned int c = 0; c < DIM; ++c)
+				x[c] = (*this)(i, c);
+		}
+	}
+};
+
+} // namespace CGoGN
+
+#endif
@@ -491,6 +491,123 @@ public:
 #endif
 };
 
+/**
+ * class that allows the marking of cells with stamps (see EpochMarkVector):
+ * the unmarking of all the cells, at destruction or by unmarkAll, is only a
+ * change of epoch, which suits the many small local traversals (neighbourhood queries)
+ * \warning a cell created while the marker is used may appear marked
+ * (its line may have been marked before the deletion of a cell)
+ * \warning no default constructor
+ */
+template <typename MAP, unsigned int CELL>
+class CellMarkerEpoch
+{
+protected:
+	MAP& m_map ;
+	EpochMarkVector* m_stamps ;
+
+public:
+	CellMarkerEpoch(MAP& map) :
+		m_map(map)
+	{
+		if(!m_map.template isOrbitEmbedded<CELL>())
+			m_map.template addEmbedding<CELL>() ;
+		m_stamps = m_map.template askEpochMarkVector<CELL>() ;
+	}
+
+	CellMarkerEpoch(const MAP& map) :
+		m_map(const_cast<MAP&>(map))
+	{
+		if(!m_map.template isOrbitEmbedded<CELL>())
+			m_map.template addEmbedding<CELL>() ;
+		m_stamps = m_map.template askEpochMarkVector<CELL>() ;
+	}
+
+	~CellMarkerEpoch()
+	{
+		if (GenericMap::alive(&m_map))
+			m_map.template releaseEpochMarkVector<CELL>(m_stamps) ;
+		else
+			delete m_stamps ;
+	}
+
+protected:
+	// protected copy constructor to forbid its usage
+	CellMarkerEpoch(const CellMarkerEpoch& cm) ;
+
+public:
+	/**
+	 * mark the cell of dart
+	 */
+	inline void mark(Cell<CELL> c)
+	{
+		unsigned int a = m_map.getEmbedding(c) ;
+
+		if (a == EMBNULL)
+			a = Algo::Topo::setOrbitEmbeddingOnNewCell(m_map, c) ;
+
+		m_stamps->mark(a) ;
+	}
+
+	/**
+	 * unmark the cell of dart
+	 */
+	inline void unmark(Cell<CELL> c)
+	{
+		unsigned int a = m_map.getEmbedding(c) ;
+
+		if (a != EMBNULL)
+			m_stamps->unmark(a) ;
+	}
+
+	/**
+	 * test if cell of dart is marked
+	 */
+	inline bool isMarked(Cell<CELL> c) const
+	{
+		unsigned int a = m_map.getEmbedding(c) ;
+
+		if (a == EMBNULL)
+			return false ;
+
+		return m_stamps->isMarked(a) ;
+	}
+
+	/**
+	 * mark the cell
+	 */
+	inline void mark(unsigned int em)
+	{
+		m_stamps->mark(em) ;
+	}
+
+	/**
+	 * unmark the cell
+	 */
+	inline void unmark(unsigned int em)
+	{
+		m_stamps->unmark(em) ;
+	}
+
+	/**
+	 * test if cell is marked
+	 */
+	inline bool isMarked(unsigned int em) const
+	{
+		if (em == EMBNULL)
+			return false ;
+		return m_stamps->isMarked(em) ;
+	}
+
+	/**
+	 * unmark all the cells (in constant time)
+	 */
+	inline void unmarkAll()
+	{
+		m_stamps->unmarkAll() ;
+	}
+};
+
 // Selector and count functors testing for marker existence
 /********************************************************/
 
@@ -41,9 +41,11 @@
 #include "Topology/generic/cells.h"
 #include "Topology/generic/marker.h"
 #include "Topology/generic/functor.h"
+#include "Topology/generic/quickTraversal.h"
 
 #include <thread>
 #include <mutex>
+#include <atomic>
 
 #include "Topology/dll.h"
 
@@ -104,6 +106,20 @@ protected:
 	// protected copy constructor to prevent the copy of map
 	GenericMap(const GenericMap& ) {}
 
+public:
+	/**
+	 * resources of a thread that uses the map:
+	 * buffers and free mark vectors
+	 */
+	struct ThreadResources
+	{
+		std::vector< std::vector<Dart>* > dartsBuffers;
+		std::vector< std::vector<unsigned int>* > uintsBuffers;
+		std::vector< AttributeMultiVector<MarkerBool>* > markVectorsFree[NB_ORBITS];
+		std::vector< EpochMarkVector* > epochVectorsFree[NB_ORBITS];
+	};
+
+protected:
 	/**
 	 * @brief m_thread_ids
 	 * vector of known thread ids, i.e. threads for which a mark vector,
@@ -111,12 +127,36 @@ protected:
 	 */
 	mutable std::vector<std::thread::id> m_thread_ids;
 
+	/**
+	 * @brief m_threadResources
+	 * resources of the threads, same indices as m_thread_ids (grows when needed)
+	 */
+	mutable std::vector<ThreadResources*> m_threadResources;
+
+	/// protect m_thread_ids and m_threadResources
+	mutable std::mutex m_threadIdsMutex;
+
+	/// changed each time the index of a known thread may change (invalidates the cached indices)
+	std::atomic<unsigned int> m_threadIdsVersion;
+
+	/// unique identifier of the map for the thread indices cached in each thread
+	unsigned long long m_mapId;
+
 	/**
 	 * @brief m_authorizeExternalThreads
 	 * if true, getCurrentThreadIndex will give an index to an unknown thread
 	 */
 	bool m_authorizeExternalThreads;
 
+	/// index and resources of the current thread (cached in the thread)
+	unsigned int lookupCurrentThread(ThreadResources*& res) const;
+
+	/// create the resources of threads [0,nb) (m_threadIdsMutex must be locked)
+	void reserveThreadResources(unsigned int nb) const;
+
+	/// resources of the current thread
+	inline ThreadResources& getCurrentThreadResources() const;
+
 public:
 	/// compute thread index in the table of thread
 	inline unsigned int getCurrentThreadIndex() const;
@@ -130,6 +170,12 @@ public:
 	/// add room for a new thread ID (will be set on thread start)
 	inline std::thread::id& addEmptyThreadId();
 
+	/// add room for nb new thread IDs, return the index of the first one
+	inline unsigned int addEmptyThreadIds(unsigned int nb);
+
+	/// set the thread ID at the given index (room added by addEmptyThreadIds)
+	inline void setThreadId(unsigned int index, const std::thread::id id);
+
 	/// get a threadId based on its index
 	inline std::thread::id getThreadId(unsigned int index) const;
 
@@ -149,10 +195,6 @@ protected:
 
 	static std::map<std::string, RegisteredBaseAttribute*>* m_attributes_registry_map;
 
-	/// buffer for less memory allocation
-	mutable std::vector< std::vector<Dart>* > s_vdartsBuffers[NB_THREADS];
-	mutable std::vector< std::vector<unsigned int>* > s_vintsBuffers[NB_THREADS];
-
 public:
 	/// table of instancied maps for Dart/CellMarker release
 	static std::vector<GenericMap*>* s_instances;
@@ -169,10 +211,9 @@ protected:
 	 * (initialized by enableQuickTraversal function)
 	 */
 	AttributeMultiVector<Dart>* m_quickTraversal[NB_ORBITS] ;
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* m_quickLocalIncidentTraversal[NB_ORBITS][NB_ORBITS] ;
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* m_quickLocalAdjacentTraversal[NB_ORBITS][NB_ORBITS] ;
+	QuickLocalTraversal* m_quickLocalIncidentTraversal[NB_ORBITS][NB_ORBITS] ;
+	QuickLocalTraversal* m_quickLocalAdjacentTraversal[NB_ORBITS][NB_ORBITS] ;
 
-	std::vector< AttributeMultiVector<MarkerBool>* > m_markVectors_free[NB_ORBITS][NB_THREADS] ;
 	std::mutex m_MarkerStorageMutex[NB_ORBITS];
 
 	unsigned int m_nextMarkerId;
@@ -286,7 +327,19 @@ protected:
 	 */
 	void deleteDartLine(unsigned int index) ;
 
+	/// incremented by each topological modification and each renumbering of darts or cells
+	unsigned int m_topologyVersion;
+
+	inline void topologyChanged() { ++m_topologyVersion; }
+
 public:
+	/**
+	 * version of the topology: changes with each sewing/unsewing, dart insertion or removal
+	 * and each renumbering of darts or cells (compact, reorder, load).
+	 * Structures built from the connectivity remain valid while it does not change.
+	 */
+	unsigned int getTopologyVersion() const { return m_topologyVersion; }
+
 	/****************************************
 	 *          ORBITS TRAVERSALS           *
 	 ****************************************/
@@ -385,6 +438,18 @@ public:
 	template <unsigned int ORBIT>
 	void releaseMarkVector(AttributeMultiVector<MarkerBool>* amv);
 
+	/**
+	 * @brief ask for the stamps of an epoch marker (not stored in the attribute container)
+	 */
+	template <unsigned int ORBIT>
+	EpochMarkVector* askEpochMarkVector() const;
+
+	/**
+	 * @brief release the stamps of an epoch marker: all the cells are unmarked by a change of epoch
+	 */
+	template <unsigned int ORBIT>
+	void releaseEpochMarkVector(EpochMarkVector* emv) const;
+
 protected:
 	/**
 	 * @brief scan attributes for MarkerBool, clean them and store as free in thread 0
@@ -473,6 +538,42 @@ public:
 	 */
 	virtual bool loadMapBin(const std::string& filename) = 0 ;
 
+	/**
+	 * Save map in an uncompressed binary file that can be mapped in memory
+	 * (see loadMapBinRaw)
+	 * @param filename the file name
+	 * @return true if OK
+	 */
+	virtual bool saveMapBinRaw(const std::string& filename) const ;
+
+	/**
+	 * Load map from a file written by saveMapBinRaw. The file is mapped in
+	 * memory and the attribute blocks point directly into the mapping:
+	 * pages are read on demand and copied when written (the file is never modified)
+	 * @param filename the file name
+	 * @return true if OK
+	 */
+	virtual bool loadMapBinRaw(const std::string& filename) ;
+
+	/**
+	 * Save map in a chunked compressed binary file: attribute blocks are
+	 * compressed by groups in independent zlib streams on several threads
+	 * @param filename the file name
+	 * @param nbThreads number of threads (0 for hardware concurrency)
+	 * @return true if OK
+	 */
+	virtual bool saveMapBinChunked(const std::string& filename, unsigned int nbThreads = 0) const ;
+
+	/**
+	 * Load map from a file written by saveMapBinChunked (parallel decompression)
+	 * @param filename the file name
+	 * @param attributeNames if not empty, only the cell attributes with these names are
+	 * loaded, the others are skipped (dart attributes are always loaded)
+	 * @param nbThreads number of threads (0 for hardware concurrency)
+	 * @return true if OK
+	 */
+	virtual bool loadMapBinChunked(const std::string& filename, const std::vector<std::string>& attributeNames = std::vector<std::string>(), unsigned int nbThreads = 0) ;
+
 	/**
 	 * copy from another map (of same type)
 	 */
@@ -489,6 +590,12 @@ protected:
 	 */
 	virtual void compactTopo() = 0 ;
 
+	/**
+	 * renumber the darts (lines of the DART container) in the given order
+	 * and update topo relations
+	 */
+	virtual void reorderTopo(const std::vector<unsigned int>& dartOrder) = 0 ;
+
 public:
 	/**
 	 * compact the map
@@ -513,6 +620,17 @@ public:
 	 */
 	void compactIfNeeded(float frag, bool topoOnly = false) ;
 
+	/**
+	 * @brief renumber the lines of all containers to improve locality of traversals
+	 * darts are renumbered in the given order (the other darts follow) and the cells
+	 * of each embedded orbit in the order of their first dart, containers are compacted.
+	 * All attributes, markers, topo relations and embeddings are updated.
+	 * (see Algo::Topo::reorderBFS and Algo::Topo::reorderHilbert to compute dart orders)
+	 * @warning the quickTraversals needs to be updated
+	 * @param dartOrder indices of darts in the DART container (dartIndex) in their new order
+	 */
+	void reorder(const std::vector<unsigned int>& dartOrder) ;
+
 	/**
 	 * test if containers are fragmented
 	 *  ~1.0 (full filled) no need to compact
@@ -520,6 +638,20 @@ public:
 	 */
 	inline float fragmentation(unsigned int orbit);
 
+	/**
+	 * memory used by the holes of all the containers in bytes
+	 * (see AttributeContainer::fragmentationBytes)
+	 */
+	std::size_t fragmentationBytes() const;
+
+	/**
+	 * allocate the blocks of all the attributes of the map (existing and future ones,
+	 * topology and markers included) in a pool, NULL for the pool of the process.
+	 * A pool can be shared by several maps that are often built and cleared.
+	 * @warning the pool must live longer than the map
+	 */
+	void setBlockPool(Utils::BlockPool* pool);
+
 	/**
 	 * @brief dump all attributes of map in CSV format  (; separated columns)
 	 */
@@ -33,22 +33,16 @@ namespace CGoGN
 
 inline unsigned int GenericMap::getCurrentThreadIndex() const
 {
-	std::thread::id id = std::this_thread::get_id();
-	for (unsigned int i = 0; i < m_thread_ids.size(); ++i)
-	{
-		if (id == m_thread_ids[i])
-			return i;
-	}
-	assert(m_thread_ids.size() < NB_THREADS + 1);
-	if (m_authorizeExternalThreads)
-	{
-		m_thread_ids.push_back(id);
-		return m_thread_ids.size() - 1;
-	}
-	else
-	{
-		return -1;
-	}
+	ThreadResources* res;
+	return lookupCurrentThread(res);
+}
+
+inline GenericMap::ThreadResources& GenericMap::getCurrentThreadResources() const
+{
+	ThreadResources* res;
+	lookupCurrentThread(res);
+	assert(res != NULL || !"Thread not authorized to use the map");
+	return *res;
 }
 
 //inline void GenericMap::addThreadId(const std::thread::id id)
@@ -58,19 +52,24 @@ inline unsigned int GenericMap::getCurrentThreadIndex() const
 //		if (m_thread_ids[i] == id)
 //			return;
 //	}
-//	assert(m_thread_ids.size() < NB_THREADS + 1);
 //	if (m_authorizeExternalThreads)
 //		m_thread_ids.push_back(id);
 //}
 
 inline void GenericMap::removeThreadId(const std::thread::id id)
 {
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
 	for (unsigned int i = 0; i < m_thread_ids.size(); ++i)
 	{
 		if (m_thread_ids[i] == id)
 		{
-			m_thread_ids[i] = m_thread_ids.back();
+			// resources follow their thread
+			unsigned int last = uint32(m_thread_ids.size()) - 1;
+			m_thread_ids[i] = m_thread_ids[last];
 			m_thread_ids.pop_back();
+			if (last < m_threadResources.size())
+				std::swap(m_threadResources[i], m_threadResources[last]);
+			++m_threadIdsVersion;
 			break;
 		}
 	}
@@ -78,26 +77,47 @@ inline void GenericMap::removeThreadId(const std::thread::id id)
 
 inline std::thread::id& GenericMap::addEmptyThreadId()
 {
-	assert(m_thread_ids.size() < NB_THREADS + 1);
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
 	unsigned int size = uint32(m_thread_ids.size());
 	m_thread_ids.resize(size + 1);
+	reserveThreadResources(size + 1);
 	return m_thread_ids.back();
 }
 
+inline unsigned int GenericMap::addEmptyThreadIds(unsigned int nb)
+{
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
+	unsigned int size = uint32(m_thread_ids.size());
+	m_thread_ids.resize(size + nb);
+	reserveThreadResources(size + nb);
+	return size;
+}
+
+inline void GenericMap::setThreadId(unsigned int index, const std::thread::id id)
+{
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
+	assert(index < m_thread_ids.size());
+	m_thread_ids[index] = id;
+	++m_threadIdsVersion;
+}
+
 inline std::thread::id GenericMap::getThreadId(unsigned int index) const
 {
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
 	assert(index < m_thread_ids.size());
 	return m_thread_ids[index];
 }
 
 inline void GenericMap::setExternalThreadsAuthorization(bool b)
 {
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
 	m_authorizeExternalThreads = b;
 	if (!m_authorizeExternalThreads)
 	{
 		// keep only the thread that created the map
 		while (m_thread_ids.size() > 1)
 			m_thread_ids.pop_back();
+		++m_threadIdsVersion;
 	}
 }
 
@@ -108,24 +128,22 @@ inline void GenericMap::setExternalThreadsAuthorization(bool b)
 
 inline std::vector<Dart>* GenericMap::askDartBuffer() const
 {
-	unsigned int thread = getCurrentThreadIndex();
+	std::vector< std::vector<Dart>* >& buffers = getCurrentThreadResources().dartsBuffers;
 
-	if (s_vdartsBuffers[thread].empty())
+	if (buffers.empty())
 	{
 		std::vector<Dart>* vd = new std::vector<Dart>;
 		vd->reserve(128);
 		return vd;
 	}
 
-	std::vector<Dart>* vd = s_vdartsBuffers[thread].back();
-	s_vdartsBuffers[thread].pop_back();
+	std::vector<Dart>* vd = buffers.back();
+	buffers.pop_back();
 	return vd;
 }
 
 inline void GenericMap::releaseDartBuffer(std::vector<Dart>* vd) const
 {
-	unsigned int thread = getCurrentThreadIndex();
-
 	if (vd->capacity() > 1024)
 	{
 		std::vector<Dart> v;
@@ -133,29 +151,27 @@ inline void GenericMap::releaseDartBuffer(std::vector<Dart>* vd) const
 		vd->reserve(128);
 	}
 	vd->clear();
-	s_vdartsBuffers[thread].push_back(vd);
+	getCurrentThreadResources().dartsBuffers.push_back(vd);
 }
 
 inline std::vector<unsigned int>* GenericMap::askUIntBuffer() const
 {
-	unsigned int thread = getCurrentThreadIndex();
+	std::vector< std::vector<unsigned int>* >& buffers = getCurrentThreadResources().uintsBuffers;
 
-	if (s_vintsBuffers[thread].empty())
+	if (buffers.empty())
 	{
 		std::vector<unsigned int>* vui = new std::vector<unsigned int>;
 		vui->reserve(128);
 		return vui;
 	}
 
-	std::vector<unsigned int>* vui = s_vintsBuffers[thread].back();
-	s_vintsBuffers[thread].pop_back();
+	std::vector<unsigned int>* vui = buffers.back();
+	buffers.pop_back();
 	return vui;
 }
 
 inline void GenericMap::releaseUIntBuffer(std::vector<unsigned int>* vui) const
 {
-	unsigned int thread = getCurrentThreadIndex();
-
 	if (vui->capacity() > 1024)
 	{
 		std::vector<unsigned int> v;
@@ -163,7 +179,7 @@ inline void GenericMap::releaseUIntBuffer(std::vector<unsigned int>* vui) const
 		vui->reserve(128);
 	}
 	vui->clear();
-	s_vintsBuffers[thread].push_back(vui);
+	getCurrentThreadResources().uintsBuffers.push_back(vui);
 }
 
 
@@ -173,6 +189,7 @@ inline void GenericMap::releaseUIntBuffer(std::vector<unsigned int>* vui) const
 
 inline Dart GenericMap::newDart()
 {
+	topologyChanged();
 	unsigned int di = m_attribs[DART].insertLine();		// insert a new dart line
 	m_attribs[DART].initMarkersOfLine(di);
 	for(unsigned int i = 0; i < NB_ORBITS; ++i)
@@ -186,6 +203,7 @@ inline Dart GenericMap::newDart()
 
 inline void GenericMap::deleteDartLine(unsigned int index)
 {
+	topologyChanged();
 	m_attribs[DART].removeLine(index) ;	// free the dart line
 
 	for(unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
@@ -201,6 +219,7 @@ inline void GenericMap::deleteDartLine(unsigned int index)
 
 inline unsigned int GenericMap::copyDartLine(unsigned int index)
 {
+	topologyChanged();
 	unsigned int newindex = m_attribs[DART].insertLine() ;	// create a new dart line
 	m_attribs[DART].copyLine(newindex, index) ;				// copy the given dart line
 	for(unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
@@ -301,13 +320,13 @@ AttributeMultiVector<MarkerBool>* GenericMap::askMarkVector()
 {
 	assert(isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded") ;
 
-	// get current thread index for table of markers
-	unsigned int thread = getCurrentThreadIndex();
+	// free mark vectors of the current thread
+	std::vector< AttributeMultiVector<MarkerBool>* >& markVectors = getCurrentThreadResources().markVectorsFree[ORBIT];
 
-	if (!m_markVectors_free[ORBIT][thread].empty())
+	if (!markVectors.empty())
 	{
-		AttributeMultiVector<MarkerBool>* amv = m_markVectors_free[ORBIT][thread].back();
-		m_markVectors_free[ORBIT][thread].pop_back();
+		AttributeMultiVector<MarkerBool>* amv = markVectors.back();
+		markVectors.pop_back();
 		return amv;
 	}
 	else
@@ -332,8 +351,33 @@ inline void GenericMap::releaseMarkVector(AttributeMultiVector<MarkerBool>* amv)
 {
 	assert(isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded") ;
 
-	unsigned int thread = getCurrentThreadIndex();
-	m_markVectors_free[ORBIT][thread].push_back(amv);
+	getCurrentThreadResources().markVectorsFree[ORBIT].push_back(amv);
+}
+
+template <unsigned int ORBIT>
+inline EpochMarkVector* GenericMap::askEpochMarkVector() const
+{
+	std::vector<EpochMarkVector*>& epochVectors = getCurrentThreadResources().epochVectorsFree[ORBIT];
+
+	EpochMarkVector* emv;
+	if (!epochVectors.empty())
+	{
+		emv = epochVectors.back();
+		epochVectors.pop_back();
+	}
+	else
+		emv = new EpochMarkVector;
+
+	// no reallocation when marking the existing cells
+	emv->reserve(m_attribs[ORBIT].realEnd());
+	return emv;
+}
+
+template <unsigned int ORBIT>
+inline void GenericMap::releaseEpochMarkVector(EpochMarkVector* emv) const
+{
+	emv->unmarkAll();
+	getCurrentThreadResources().epochVectorsFree[ORBIT].push_back(emv);
 }
 
 
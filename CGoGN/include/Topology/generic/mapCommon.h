@@ -226,7 +226,7 @@ public:
 	void updateQuickIncidentTraversal();
 
 	template <unsigned int ORBIT, unsigned int INCI>
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* getQuickIncidentTraversal() const;
+	const QuickLocalTraversal* getQuickIncidentTraversal() const;
 
 	template <unsigned int ORBIT, unsigned int INCI>
 	void disableQuickIncidentTraversal();
@@ -238,10 +238,34 @@ public:
 	void updateQuickAdjacentTraversal();
 
 	template <unsigned int ORBIT, unsigned int INCI>
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* getQuickAdjacentTraversal() const;
+	const QuickLocalTraversal* getQuickAdjacentTraversal() const;
 
 	template <unsigned int ORBIT, unsigned int ADJ>
 	void disableQuickAdjacentTraversal();
+
+	/**
+	 * is any quick traversal table enabled
+	 */
+	bool hasQuickTraversal() const;
+
+	/**
+	 * update the quick traversal tables after a local modification of the map:
+	 * the cells that contain one of the given darts are updated, and for the
+	 * adjacent tables, the cells adjacent to them.
+	 * The given darts must contain all the faces (volumes in 3D) in which
+	 * a dart has been modified.
+	 * Called by the topological operators of the embedded maps (after the
+	 * embeddings have been updated).
+	 * @param darts the darts of the modified area
+	 */
+	void updateQuickTraversals(const std::vector<Dart>& darts);
+
+protected:
+	template <typename MAP, unsigned int ORBIT, unsigned int INCI>
+	static void quickIncidentCells(GenericMap& map, Dart d, std::vector<Dart>& darts);
+
+	template <typename MAP, unsigned int ORBIT, unsigned int ADJ>
+	static void quickAdjacentCells(GenericMap& map, Dart d, std::vector<Dart>& darts);
 };
 
 } //namespace CGoGN
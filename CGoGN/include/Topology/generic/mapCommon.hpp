@@ -22,6 +22,8 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <algorithm>
+
 #include "Topology/generic/traversor/traversorFactory.h"
 namespace CGoGN
 {
@@ -325,6 +327,28 @@ inline void MapCommon<MAP_IMPL>::disableQuickTraversal()
 	}
 }
 
+template <typename MAP_IMPL>
+template <typename MAP, unsigned int ORBIT, unsigned int INCI>
+void MapCommon<MAP_IMPL>::quickIncidentCells(GenericMap& map, Dart d, std::vector<Dart>& darts)
+{
+	MAP& m = static_cast<MAP&>(map);
+	Traversor* tra_loc = TraversorFactory<MAP>::createIncident(m, d, m.dimension(), ORBIT, INCI);
+	for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
+		darts.push_back(e);
+	delete tra_loc;
+}
+
+template <typename MAP_IMPL>
+template <typename MAP, unsigned int ORBIT, unsigned int ADJ>
+void MapCommon<MAP_IMPL>::quickAdjacentCells(GenericMap& map, Dart d, std::vector<Dart>& darts)
+{
+	MAP& m = static_cast<MAP&>(map);
+	Traversor* tra_loc = TraversorFactory<MAP>::createAdjacent(m, d, m.dimension(), ORBIT, ADJ);
+	for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
+		darts.push_back(e);
+	delete tra_loc;
+}
+
 template <typename MAP_IMPL>
 template <typename MAP, unsigned int ORBIT, unsigned int INCI>
 inline void MapCommon<MAP_IMPL>::enableQuickIncidentTraversal()
@@ -335,7 +359,8 @@ inline void MapCommon<MAP_IMPL>::enableQuickIncidentTraversal()
 			this->template addEmbedding<ORBIT>() ;
 		std::stringstream ss;
 		ss << "quickIncidentTraversal_" << INCI;
-		this->m_quickLocalIncidentTraversal[ORBIT][INCI] = this->m_attribs[ORBIT].template addAttribute<NoTypeNameAttribute<std::vector<Dart> > >(ss.str()) ;
+		AttributeMultiVector<NoTypeNameAttribute<QuickLocalTraversal::Range> >* ranges = this->m_attribs[ORBIT].template addAttribute<NoTypeNameAttribute<QuickLocalTraversal::Range> >(ss.str()) ;
+		this->m_quickLocalIncidentTraversal[ORBIT][INCI] = new QuickLocalTraversal(this->m_attribs[ORBIT], ranges, &MapCommon<MAP_IMPL>::template quickIncidentCells<MAP, ORBIT, INCI>) ;
 	}
 	updateQuickIncidentTraversal<MAP, ORBIT, INCI>() ;
 }
@@ -346,32 +371,22 @@ inline void MapCommon<MAP_IMPL>::updateQuickIncidentTraversal()
 {
 	assert(this->m_quickLocalIncidentTraversal[ORBIT][INCI] != NULL || !"updateQuickTraversal on a disabled orbit") ;
 
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* ptrVD = this->m_quickLocalIncidentTraversal[ORBIT][INCI];
+	QuickLocalTraversal* qlt = this->m_quickLocalIncidentTraversal[ORBIT][INCI];
 	this->m_quickLocalIncidentTraversal[ORBIT][INCI] = NULL;
 
-	std::vector<Dart> buffer;
-	buffer.reserve(100);
-
-	TraversorCell<MAP, ORBIT> tra_glob(*this);
+	std::vector<std::pair<unsigned int, Dart> > cells;
+	cells.reserve(this->m_attribs[ORBIT].size());
+	TraversorCell<MAP, ORBIT> tra_glob(static_cast<MAP&>(*this));
 	for (Dart d = tra_glob.begin(); d != tra_glob.end(); d = tra_glob.next())
-	{
-		buffer.clear();
-		Traversor* tra_loc = TraversorFactory<MAP>::createIncident(*this, d, this->dimension(), ORBIT, INCI);
-		for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
-			buffer.push_back(e);
-		delete tra_loc;
-		buffer.push_back(NIL);
-		std::vector<Dart>& vd = (*ptrVD)[getEmbedding<ORBIT>(d)];
-		vd.reserve(buffer.size());
-		vd.assign(buffer.begin(), buffer.end());
-	}
+		cells.push_back(std::make_pair(getEmbedding<ORBIT>(d), d));
+	qlt->build(*this, cells);
 
-	this->m_quickLocalIncidentTraversal[ORBIT][INCI] = ptrVD;
+	this->m_quickLocalIncidentTraversal[ORBIT][INCI] = qlt;
 }
 
 template <typename MAP_IMPL>
 template <unsigned int ORBIT, unsigned int INCI>
-inline const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* MapCommon<MAP_IMPL>::getQuickIncidentTraversal() const
+inline const QuickLocalTraversal* MapCommon<MAP_IMPL>::getQuickIncidentTraversal() const
 {
 	return this->m_quickLocalIncidentTraversal[ORBIT][INCI] ;
 }
@@ -382,7 +397,8 @@ inline void MapCommon<MAP_IMPL>::disableQuickIncidentTraversal()
 {
 	if(this->m_quickLocalIncidentTraversal[ORBIT][INCI] != NULL)
 	{
-		this->m_attribs[ORBIT].template removeAttribute<Dart>(this->m_quickLocalIncidentTraversal[ORBIT][INCI]->getIndex()) ;
+		this->m_attribs[ORBIT].template removeAttribute<QuickLocalTraversal::Range>(this->m_quickLocalIncidentTraversal[ORBIT][INCI]->getRanges()->getIndex()) ;
+		delete this->m_quickLocalIncidentTraversal[ORBIT][INCI] ;
 		this->m_quickLocalIncidentTraversal[ORBIT][INCI] = NULL ;
 	}
 }
@@ -397,7 +413,8 @@ inline void MapCommon<MAP_IMPL>::enableQuickAdjacentTraversal()
 			this->template addEmbedding<ORBIT>() ;
 		std::stringstream ss;
 		ss << "quickAdjacentTraversal" << ADJ;
-		this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = this->m_attribs[ORBIT].template addAttribute<NoTypeNameAttribute<std::vector<Dart> > >(ss.str()) ;
+		AttributeMultiVector<NoTypeNameAttribute<QuickLocalTraversal::Range> >* ranges = this->m_attribs[ORBIT].template addAttribute<NoTypeNameAttribute<QuickLocalTraversal::Range> >(ss.str()) ;
+		this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = new QuickLocalTraversal(this->m_attribs[ORBIT], ranges, &MapCommon<MAP_IMPL>::template quickAdjacentCells<MAP, ORBIT, ADJ>) ;
 	}
 	updateQuickAdjacentTraversal<MAP, ORBIT, ADJ>() ;
 }
@@ -408,32 +425,22 @@ inline void MapCommon<MAP_IMPL>::updateQuickAdjacentTraversal()
 {
 	assert(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] != NULL || !"updateQuickTraversal on a disabled orbit") ;
 
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* ptrVD = this->m_quickLocalAdjacentTraversal[ORBIT][ADJ];
+	QuickLocalTraversal* qlt = this->m_quickLocalAdjacentTraversal[ORBIT][ADJ];
 	this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = NULL;
 
-	std::vector<Dart> buffer;
-	buffer.reserve(100);
-
-	TraversorCell<MAP, ORBIT> tra_glob(*this);
+	std::vector<std::pair<unsigned int, Dart> > cells;
+	cells.reserve(this->m_attribs[ORBIT].size());
+	TraversorCell<MAP, ORBIT> tra_glob(static_cast<MAP&>(*this));
 	for (Dart d = tra_glob.begin(); d != tra_glob.end(); d = tra_glob.next())
-	{
-		buffer.clear();
-		Traversor* tra_loc = TraversorFactory<MAP>::createAdjacent(*this, d, this->dimension(), ORBIT, ADJ);
-		for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
-			buffer.push_back(e);
-		buffer.push_back(NIL);
-		delete tra_loc;
-		std::vector<Dart>& vd = (*ptrVD)[getEmbedding<ORBIT>(d)];
-		vd.reserve(buffer.size());
-		vd.assign(buffer.begin(),buffer.end());
-	}
+		cells.push_back(std::make_pair(getEmbedding<ORBIT>(d), d));
+	qlt->build(*this, cells);
 
-	this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = ptrVD;
+	this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = qlt;
 }
 
 template <typename MAP_IMPL>
 template <unsigned int ORBIT, unsigned int ADJ>
-inline const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* MapCommon<MAP_IMPL>::getQuickAdjacentTraversal() const
+inline const QuickLocalTraversal* MapCommon<MAP_IMPL>::getQuickAdjacentTraversal() const
 {
 	return this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] ;
 }
@@ -444,9 +451,122 @@ inline void MapCommon<MAP_IMPL>::disableQuickAdjacentTraversal()
 {
 	if(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] != NULL)
 	{
-		this->m_attribs[ORBIT].template removeAttribute<Dart>(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ]->getIndex()) ;
+		this->m_attribs[ORBIT].template removeAttribute<QuickLocalTraversal::Range>(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ]->getRanges()->getIndex()) ;
+		delete this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] ;
 		this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = NULL ;
 	}
 }
 
+template <typename MAP_IMPL>
+bool MapCommon<MAP_IMPL>::hasQuickTraversal() const
+{
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		if (this->m_quickTraversal[i] != NULL)
+			return true;
+		for (unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			if (this->m_quickLocalIncidentTraversal[i][j] != NULL || this->m_quickLocalAdjacentTraversal[i][j] != NULL)
+				return true;
+		}
+	}
+	return false;
+}
+
+template <typename MAP_IMPL>
+void MapCommon<MAP_IMPL>::updateQuickTraversals(const std::vector<Dart>& darts)
+{
+	// tables are disabled during the update so that the local traversors
+	// that compute the lists do not use them
+	QuickLocalTraversal* incident[NB_ORBITS][NB_ORBITS];
+	QuickLocalTraversal* adjacent[NB_ORBITS][NB_ORBITS];
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		for (unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			incident[i][j] = this->m_quickLocalIncidentTraversal[i][j];
+			adjacent[i][j] = this->m_quickLocalAdjacentTraversal[i][j];
+			this->m_quickLocalIncidentTraversal[i][j] = NULL;
+			this->m_quickLocalAdjacentTraversal[i][j] = NULL;
+		}
+	}
+
+	std::vector<Dart>* buffer = this->askDartBuffer();
+	std::vector<std::pair<unsigned int, Dart> > cells;
+	std::vector<std::pair<unsigned int, Dart> > neighbours;
+
+	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+	{
+		if (this->m_embeddings[orbit] == NULL)
+			continue;
+
+		AttributeMultiVector<Dart>* quick = this->m_quickTraversal[orbit];
+		bool local = false;
+		for (unsigned int j = 0; j < NB_ORBITS; ++j)
+			local = local || incident[orbit][j] != NULL || adjacent[orbit][j] != NULL;
+		if (quick == NULL && !local)
+			continue;
+
+		// cells of the orbit that contain one of the darts
+		cells.clear();
+		for (std::vector<Dart>::const_iterator it = darts.begin(); it != darts.end(); ++it)
+		{
+			unsigned int emb = (*this->m_embeddings[orbit])[this->dartIndex(*it)];
+			if (emb != EMBNULL)
+				cells.push_back(std::make_pair(emb, *it));
+		}
+		std::sort(cells.begin(), cells.end());
+		cells.erase(std::unique(cells.begin(), cells.end(), [] (const std::pair<unsigned int, Dart>& a, const std::pair<unsigned int, Dart>& b) { return a.first == b.first; }), cells.end());
+
+		if (quick != NULL)
+		{
+			for (std::vector<std::pair<unsigned int, Dart> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+				(*quick)[it->first] = it->second;
+		}
+
+		for (unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			if (incident[orbit][j] != NULL)
+			{
+				for (std::vector<std::pair<unsigned int, Dart> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+					incident[orbit][j]->update(*this, it->first, it->second, *buffer);
+			}
+
+			if (adjacent[orbit][j] != NULL)
+			{
+				for (std::vector<std::pair<unsigned int, Dart> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+					adjacent[orbit][j]->update(*this, it->first, it->second, *buffer);
+
+				// the cells adjacent to the modified ones share a modified cell with them:
+				// they are found in the new lists
+				neighbours.clear();
+				for (std::vector<std::pair<unsigned int, Dart> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+				{
+					for (const Dart* n = (*adjacent[orbit][j])[it->first]; *n != NIL; ++n)
+					{
+						unsigned int emb = (*this->m_embeddings[orbit])[this->dartIndex(*n)];
+						if (!std::binary_search(cells.begin(), cells.end(), std::make_pair(emb, Dart()), [] (const std::pair<unsigned int, Dart>& a, const std::pair<unsigned int, Dart>& b) { return a.first < b.first; }))
+							neighbours.push_back(std::make_pair(emb, *n));
+					}
+				}
+				std::sort(neighbours.begin(), neighbours.end());
+				neighbours.erase(std::unique(neighbours.begin(), neighbours.end(), [] (const std::pair<unsigned int, Dart>& a, const std::pair<unsigned int, Dart>& b) { return a.first == b.first; }), neighbours.end());
+				for (std::vector<std::pair<unsigned int, Dart> >::const_iterator it = neighbours.begin(); it != neighbours.end(); ++it)
+					adjacent[orbit][j]->update(*this, it->first, it->second, *buffer);
+			}
+		}
+	}
+
+	this->releaseDartBuffer(buffer);
+
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		for (unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			this->m_quickLocalIncidentTraversal[i][j] = incident[i][j];
+			this->m_quickLocalAdjacentTraversal[i][j] = adjacent[i][j];
+		}
+	}
+}
+
 } // namespace CGoGN
@@ -108,6 +108,8 @@ protected:
 
 	virtual void compactTopo();
 
+	virtual void reorderTopo(const std::vector<unsigned int>& dartOrder);
+
 	/****************************************
 	 *           DARTS TRAVERSALS           *
 	 ****************************************/
@@ -149,6 +151,14 @@ public:
 
 	bool loadMapBin(const std::string& filename);
 
+	bool saveMapBinRaw(const std::string& filename) const;
+
+	bool loadMapBinRaw(const std::string& filename);
+
+	bool saveMapBinChunked(const std::string& filename, unsigned int nbThreads = 0) const;
+
+	bool loadMapBinChunked(const std::string& filename, const std::vector<std::string>& attributeNames = std::vector<std::string>(), unsigned int nbThreads = 0);
+
 	bool copyFrom(const GenericMap& map);
 
 	void restore_topo_shortcuts();
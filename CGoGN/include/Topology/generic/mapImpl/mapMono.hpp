@@ -150,6 +150,7 @@ inline Dart MapMono::getPermutationInv(Dart d) const
 template <int I>
 inline void MapMono::involutionSew(Dart d, Dart e)
 {
+	this->topologyChanged();
 	assert((*m_involution[I])[d.index] == d) ;
 	assert((*m_involution[I])[e.index] == e) ;
 	(*m_involution[I])[d.index] = e ;
@@ -159,6 +160,7 @@ inline void MapMono::involutionSew(Dart d, Dart e)
 template <int I>
 inline void MapMono::involutionUnsew(Dart d)
 {
+	this->topologyChanged();
 	Dart e = (*m_involution[I])[d.index] ;
 	(*m_involution[I])[d.index] = d ;
 	(*m_involution[I])[e.index] = e ;
@@ -167,6 +169,7 @@ inline void MapMono::involutionUnsew(Dart d)
 template <int I>
 inline void MapMono::permutationSew(Dart d, Dart e)
 {
+	this->topologyChanged();
 	Dart f = (*m_permutation[I])[d.index] ;
 	Dart g = (*m_permutation[I])[e.index] ;
 	(*m_permutation[I])[d.index] = g ;
@@ -178,6 +181,7 @@ inline void MapMono::permutationSew(Dart d, Dart e)
 template <int I>
 inline void MapMono::permutationUnsew(Dart d)
 {
+	this->topologyChanged();
 	Dart e = (*m_permutation[I])[d.index] ;
 	Dart f = (*m_permutation[I])[e.index] ;
 	(*m_permutation[I])[d.index] = f ;
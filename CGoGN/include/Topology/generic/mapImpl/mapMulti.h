@@ -171,6 +171,8 @@ protected:
 
 	virtual void compactTopo();
 
+	virtual void reorderTopo(const std::vector<unsigned int>& dartOrder);
+
 	/****************************************
 	 *      MR CONTAINER MANAGEMENT         *
 	 ****************************************/
@@ -256,6 +256,7 @@ inline Dart MapMulti::getPermutationInv(Dart d) const
 template <int I>
 inline void MapMulti::involutionSew(Dart d, Dart e)
 {
+	this->topologyChanged();
 	assert((*m_involution[I])[dartIndex(d)] == d) ;
 	assert((*m_involution[I])[dartIndex(e)] == e) ;
 	(*m_involution[I])[dartIndex(d)] = e ;
@@ -265,6 +266,7 @@ inline void MapMulti::involutionSew(Dart d, Dart e)
 template <int I>
 inline void MapMulti::involutionUnsew(Dart d)
 {
+	this->topologyChanged();
 	unsigned int d_index = dartIndex(d);
 	Dart e = (*m_involution[I])[d_index] ;
 	(*m_involution[I])[d_index] = d ;
@@ -274,6 +276,7 @@ inline void MapMulti::involutionUnsew(Dart d)
 template <int I>
 inline void MapMulti::permutationSew(Dart d, Dart e)
 {
+	this->topologyChanged();
 	unsigned int d_index = dartIndex(d);
 	unsigned int e_index = dartIndex(e);
 	Dart f = (*m_permutation[I])[d_index] ;
@@ -287,6 +290,7 @@ inline void MapMulti::permutationSew(Dart d, Dart e)
 template <int I>
 inline void MapMulti::permutationUnsew(Dart d)
 {
+	this->topologyChanged();
 	unsigned int d_index = dartIndex(d);
 	Dart e = (*m_permutation[I])[d_index] ;
 	unsigned int e_index = dartIndex(e);
@@ -25,6 +25,9 @@
 #ifndef _MARKER_H_
 #define _MARKER_H_
 
+#include <vector>
+#include <algorithm>
+
 #include "Utils/mark.h"
 
 namespace CGoGN
@@ -64,6 +67,60 @@ public:
 	}
 };
 
+/**
+ * Stamps of the cells of an orbit used by the epoch markers:
+ * a cell is marked when its stamp is the current epoch, so that
+ * unmarking all the cells is only an increment of the epoch.
+ * The stamps are not stored in the attribute container: the vector
+ * grows (with unmarked stamps) when a cell beyond its size is marked.
+ */
+class EpochMarkVector
+{
+protected:
+	std::vector<unsigned int> m_stamps;
+	unsigned int m_epoch;
+
+public:
+	EpochMarkVector() : m_epoch(1)
+	{}
+
+	//! give room for the cells [0,nb)
+	void reserve(unsigned int nb)
+	{
+		if (nb > m_stamps.size())
+			m_stamps.resize(nb, 0);
+	}
+
+	void mark(unsigned int i)
+	{
+		if (i >= m_stamps.size())
+			m_stamps.resize(std::max<std::size_t>(i + 1, 2 * m_stamps.size()), 0);
+		m_stamps[i] = m_epoch;
+	}
+
+	//! 0 is never an epoch
+	void unmark(unsigned int i)
+	{
+		if (i < m_stamps.size())
+			m_stamps[i] = 0;
+	}
+
+	bool isMarked(unsigned int i) const
+	{
+		return i < m_stamps.size() && m_stamps[i] == m_epoch;
+	}
+
+	//! next epoch (the stamps are only reset when the counter wraps around)
+	void unmarkAll()
+	{
+		if (++m_epoch == 0)
+		{
+			std::fill(m_stamps.begin(), m_stamps.end(), 0u);
+			m_epoch = 1;
+		}
+	}
+};
+
 } //namespace CGoGN
 
 #endif
@@ -0,0 +1,138 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __QUICK_TRAVERSAL__
+#define __QUICK_TRAVERSAL__
+
+#include <vector>
+
+#include "Container/attributeContainer.h"
+#include "Container/fakeAttribute.h"
+#include "Topology/generic/dart.h"
+
+#include "Topology/dll.h"
+
+namespace CGoGN
+{
+
+class GenericMap;
+
+/**
+ * Table of the incident (or adjacent) cells of each cell of an orbit,
+ * used by the local traversors when quick traversal is enabled.
+ * The lists of all cells are stored in a single array (CSR like layout):
+ * each list is a run of darts terminated by NIL, preceded by a header that
+ * stores the index of the cell that owns the run, and followed by some
+ * free space so that a list can grow in place.
+ * The position of the run of each cell is stored in an attribute of the
+ * orbit container, so that it follows the cells when lines are moved.
+ */
+class CGoGN_TOPO_API QuickLocalTraversal
+{
+public:
+	/**
+	 * function that fills the list of incident (adjacent) cells of the cell of d
+	 */
+	typedef void (*CellTraversal)(GenericMap& map, Dart d, std::vector<Dart>& darts) ;
+
+	struct Range
+	{
+		unsigned int begin ;
+		unsigned int capacity ;
+		Range() : begin(0), capacity(0) {}
+	} ;
+
+protected:
+	AttributeContainer* m_cont ;
+
+	AttributeMultiVector<NoTypeNameAttribute<Range> >* m_ranges ;
+
+	std::vector<Dart> m_darts ;
+
+	/// size of the array after the last full build or compaction
+	unsigned int m_compactSize ;
+
+	CellTraversal m_traversal ;
+
+	/**
+	 * is the run designated by the range of the cell owned by the cell
+	 */
+	bool owns(unsigned int emb) const ;
+
+	void allocate(unsigned int emb, unsigned int nb) ;
+
+	QuickLocalTraversal(const QuickLocalTraversal&) ;
+	QuickLocalTraversal& operator=(const QuickLocalTraversal&) ;
+
+public:
+	QuickLocalTraversal(AttributeContainer& cont, AttributeMultiVector<NoTypeNameAttribute<Range> >* ranges, CellTraversal traversal) ;
+
+	AttributeMultiVector<NoTypeNameAttribute<Range> >* getRanges() const { return m_ranges ; }
+
+	/**
+	 * set the container of the orbit (when containers of maps are swapped)
+	 */
+	void setContainer(AttributeContainer& cont) { m_cont = &cont ; }
+
+	/**
+	 * NIL terminated list of the cell of embedding emb
+	 * (the pointer is invalidated by the next modification of the table)
+	 */
+	const Dart* operator[](unsigned int emb) const
+	{
+		return &m_darts[(*m_ranges)[emb].begin + 1] ;
+	}
+
+	/**
+	 * compute the lists of all the cells of the container
+	 * @param map the map
+	 * @param cells embedding and one dart of each cell
+	 */
+	void build(GenericMap& map, const std::vector<std::pair<unsigned int, Dart> >& cells) ;
+
+	/**
+	 * recompute the list of one cell (new or modified cell)
+	 * @param map the map
+	 * @param emb embedding of the cell
+	 * @param d a dart of the cell
+	 * @param buffer buffer used to compute the list (avoid allocations)
+	 */
+	void update(GenericMap& map, unsigned int emb, Dart d, std::vector<Dart>& buffer) ;
+
+	/**
+	 * copy the lists of the living cells in a new array without the space
+	 * lost by deleted cells and relocated lists
+	 */
+	void compact() ;
+
+	/**
+	 * size of the array of lists (in darts)
+	 */
+	unsigned int memorySize() const { return (unsigned int)(m_darts.size()) ; }
+} ;
+
+} // namespace CGoGN
+
+#endif
@@ -34,10 +34,10 @@ namespace CGoGN
 template <typename MAP>
 Traversor2VE<MAP>::Traversor2VE(const MAP& map, Vertex v) : m(map), start(v),m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,EDGE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,EDGE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(v)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(v)];
 	}
 }
 
@@ -46,7 +46,7 @@ Edge Traversor2VE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return Edge(*m_ItDarts++);
 	}
 
@@ -83,10 +83,10 @@ Edge Traversor2VE<MAP>::next()
 template <typename MAP>
 Traversor2VF<MAP>::Traversor2VF(const MAP& map, Vertex v) : m(map), start(v),m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(v)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(v)];
 	}
 	else
 	{
@@ -100,7 +100,7 @@ Face Traversor2VF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return Face(*m_ItDarts++);
 	}
 
@@ -137,10 +137,10 @@ Face Traversor2VF<MAP>::next()
 template <typename MAP>
 Traversor2VVaE<MAP>::Traversor2VVaE(const MAP& map, Vertex v) : m(map), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,EDGE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,EDGE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(v)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(v)];
 	}
 	else
 	{
@@ -153,7 +153,7 @@ Vertex Traversor2VVaE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -188,10 +188,10 @@ Vertex Traversor2VVaE<MAP>::next()
 template <typename MAP>
 Traversor2VVaF<MAP>::Traversor2VVaF(const MAP& map, Vertex v) : m(map), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(v)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(v)];
 	}
 	else
 	{
@@ -209,7 +209,7 @@ Vertex Traversor2VVaF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return Vertex(*m_ItDarts++);
 	}
 
@@ -262,10 +262,10 @@ Vertex Traversor2VVaF<MAP>::next()
 template <typename MAP>
 Traversor2EV<MAP>::Traversor2EV(const MAP& map, Edge e) : m(map), start(e), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<EDGE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<EDGE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(e)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(e)];
 	}
 }
 
@@ -274,7 +274,7 @@ Vertex Traversor2EV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -309,10 +309,10 @@ Vertex Traversor2EV<MAP>::next()
 template <typename MAP>
 Traversor2EF<MAP>::Traversor2EF(const MAP& map, Edge e) : m(map), start(e),m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<EDGE,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<EDGE,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(e)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(e)];
 	}
 	else
 	{
@@ -326,7 +326,7 @@ Face Traversor2EF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -361,10 +361,10 @@ Face Traversor2EF<MAP>::next()
 template <typename MAP>
 Traversor2EEaV<MAP>::Traversor2EEaV(const MAP& map, Edge e) : m(map), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(e)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(e)];
 	}
 	else
 	{
@@ -379,7 +379,7 @@ Edge Traversor2EEaV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -416,10 +416,10 @@ Edge Traversor2EEaV<MAP>::next()
 template <typename MAP>
 Traversor2EEaF<MAP>::Traversor2EEaF(const MAP& map, Edge e) : m(map), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(e)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(e)];
 	}
 	else
 	{
@@ -437,7 +437,7 @@ Edge Traversor2EEaF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -483,10 +483,10 @@ Edge Traversor2EEaF<MAP>::next()
 template <typename MAP>
 Traversor2FV<MAP>::Traversor2FV(const MAP& map, Face f) : m(map), start(f), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<FACE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<FACE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(f)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(f)];
 	}
 }
 
@@ -495,7 +495,7 @@ Vertex Traversor2FV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -530,10 +530,10 @@ Vertex Traversor2FV<MAP>::next()
 template <typename MAP>
 Traversor2FE<MAP>::Traversor2FE(const MAP& map, Face f) : m(map), start(f), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<FACE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<FACE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(f)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(f)];
 	}
 }
 
@@ -542,7 +542,7 @@ Edge Traversor2FE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -577,10 +577,10 @@ Edge Traversor2FE<MAP>::next()
 template <typename MAP>
 Traversor2FFaV<MAP>::Traversor2FFaV(const MAP& map, Face f) : m(map), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<FACE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<FACE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(f)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(f)];
 	}
 	else
 	{
@@ -602,7 +602,7 @@ Face Traversor2FFaV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -653,10 +653,10 @@ Face Traversor2FFaV<MAP>::next()
 template <typename MAP>
 Traversor2FFaE<MAP>::Traversor2FFaE(const MAP& map, Face f) : m(map), m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<FACE,EDGE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<FACE,EDGE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(f)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(f)];
 	}
 	else
 	{
@@ -675,7 +675,7 @@ Face Traversor2FFaE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -72,8 +72,8 @@ private:
 	Cell<ORBY> m_current ;
 	TraversorDartsOfOrbit<MAP, ORBX> m_tradoo;
 
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 
 	bool m_allocated;
 	bool m_first;
@@ -112,8 +112,8 @@ private:
 	std::vector<Dart> m_vecDarts;
 	std::vector<Dart>::iterator m_iter;
 
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 
 public:
 	Traversor3XXaY(const MAP& map, Cell<ORBX> c, bool forceDartMarker = false);
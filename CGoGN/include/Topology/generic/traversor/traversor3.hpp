@@ -105,10 +105,10 @@ Traversor3XY<MAP, ORBX, ORBY>::Traversor3XY(const MAP& map, Cell<ORBX> c, bool f
 	m_allocated(true),
 	m_first(true)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<ORBX,ORBY>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<ORBX,ORBY>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(c)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(c)];
 	}
 	else
 	{
@@ -148,7 +148,7 @@ Cell<ORBY> Traversor3XY<MAP, ORBX, ORBY>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -259,10 +259,10 @@ Traversor3XXaY<MAP, ORBX, ORBY>::Traversor3XXaY(const MAP& map, Cell<ORBX> c, bo
 	m_map(map),
 	m_QLT(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal =  map.template getQuickAdjacentTraversal<ORBX,ORBY>() ;
+	const QuickLocalTraversal* quickTraversal =  map.template getQuickAdjacentTraversal<ORBX,ORBY>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.getEmbedding(c)));
+		m_QLT  = (*quickTraversal)[map.getEmbedding(c)];
 	}
 	else
 	{
@@ -285,7 +285,7 @@ Cell<ORBX> Traversor3XXaY<MAP, ORBX, ORBY>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -130,9 +130,11 @@ namespace Parallel
 
 /**
  * @brief foreach_cell
+ * Threads of a persistent pool process chunks of container lines and steal
+ * chunks from each other (quick traversal or embedded orbit of a MapMono),
+ * otherwise thread 0 traverses the map and queues buffers of cells
  * @param map
  * @param func function to apply on cells
- * @param needMarkers func need markers ?
  * @param opt optimization param of traversal
  * @param nbth number of used thread (0:for traversal, [1,nbth-1] for func computing
 */
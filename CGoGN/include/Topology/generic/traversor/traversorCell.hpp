@@ -23,11 +23,17 @@
 *******************************************************************************/
 
 #include "Utils/threadbarrier.h"
+#include "Utils/threadPool.h"
 #include <vector>
+#include <deque>
+#include <atomic>
+#include <type_traits>
 
 namespace CGoGN
 {
 
+class MapMono;
+
 template <typename MAP, unsigned int ORBIT, TraversalOptim OPT>
 TraversorCell<MAP, ORBIT, OPT>::TraversorCell(const MAP& map, bool forceDartMarker) :
 	m(map),
@@ -648,124 +654,252 @@ inline void foreach_cell_until(const MAP& map, FUNC f, TraversalOptim opt)
 namespace Parallel
 {
 
-/// internal functor for boost call
-template <unsigned int ORBIT, typename FUNC>
-class ThreadFunction
+/**
+ * size of the chunks of container lines given to a thread at once:
+ * at most 256 lines, and at least 8 chunks per thread for load balancing
+ */
+inline unsigned int chunkSize(unsigned int nbLines, unsigned int nbth)
 {
-protected:
-	typedef Cell<ORBIT> CELL;
-	std::vector<CELL>& m_cells;
-	Utils::Barrier& m_sync1;
-	Utils::Barrier& m_sync2;
-	bool& m_finished;
-	unsigned int m_id;
-	FUNC m_lambda;
-	std::thread::id& m_threadId; // ref on thread::id in table of threads in genericMap for init at operator()
-
-public:
-	ThreadFunction(FUNC func, std::vector<CELL>& vd, Utils::Barrier& s1, Utils::Barrier& s2, bool& finished, unsigned int id, std::thread::id& threadId) :
-		m_cells(vd), m_sync1(s1), m_sync2(s2), m_finished(finished), m_id(id), m_lambda(func), m_threadId(threadId)
+	unsigned int sz = nbLines / (8 * nbth);
+	if (sz > 256)
+		return 256;
+	if (sz == 0)
+		return 1;
+	return sz;
+}
+
+/**
+ * run job(i) for i in [0,nbth] on the thread pool, threads 1..nbth being
+ * registered in the map (job(0) is executed by the calling thread)
+ */
+template <typename MAP>
+void runOnMapThreads(MAP& map, unsigned int nbth, const std::function<void(unsigned int)>& job)
+{
+	unsigned int first = map.addEmptyThreadIds(nbth);
+	std::vector<std::thread::id> ids(nbth);
+	Utils::Barrier sync(nbth + 1);
+
+	std::function<void(unsigned int)> f = [&] (unsigned int i)
 	{
-	}
+		if (i > 0)
+		{
+			ids[i - 1] = std::this_thread::get_id();
+			map.setThreadId(first + i - 1, ids[i - 1]);
+		}
+		sync.wait(); // all ids are set before any access to the table of threads
+		job(i);
+	};
+	Utils::ThreadPool::getInstance().run(nbth + 1, f);
 
-	ThreadFunction(const ThreadFunction<ORBIT, FUNC>& tf):
-		m_cells(tf.m_cells), m_sync1(tf.m_sync1), m_sync2(tf.m_sync2), m_finished(tf.m_finished), m_id(tf.m_id), m_lambda(tf.m_lambda){}
+	for (unsigned int i = 0; i < nbth; ++i)
+		map.removeThreadId(ids[i]);
+}
 
-	std::thread::id& getThreadId() { return m_threadId; }
+/**
+ * apply job(begin, end, thr) on the chunks of lines [0,nbLines)
+ * with threads 1..nbth (each one with its own copy of job),
+ * chunks are stolen by idle threads
+ */
+template <typename MAP, typename JOB>
+void foreach_chunk(MAP& map, unsigned int nbLines, unsigned int nbth, JOB job)
+{
+	unsigned int cs = chunkSize(nbLines, nbth);
+	Utils::WorkStealingRange range((nbLines + cs - 1) / cs, nbth);
 
-	void operator()()
+	runOnMapThreads(map, nbth, [&] (unsigned int i)
 	{
-		// first thing to do set the thread id in genericMap
-		m_threadId = std::this_thread::get_id();
+		if (i == 0)
+			return; // calling thread has nothing to traverse
 
-		while (!m_finished)
+		JOB threadJob(job);
+		unsigned int chunk;
+		while (range.next(i - 1, chunk))
 		{
-			for (typename std::vector<CELL>::const_iterator it = m_cells.begin(); it != m_cells.end(); ++it)
-				m_lambda(*it, m_id);
-			m_cells.clear();
-			m_sync1.wait(); // wait every body has finished
-			m_sync2.wait(); // wait vectors has been refilled
+			unsigned int b = chunk * cs;
+			threadJob(b, std::min(b + cs, nbLines), i);
 		}
-	}
-};
-
+	});
+}
 
-template <TraversalOptim OPT, unsigned int ORBIT, typename MAP, typename FUNC>
-void foreach_cell_tmpl(MAP& map, FUNC func, unsigned int nbth)
+/// cells given by the quick traversal table, chunks of the orbit container
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_quick(MAP& map, FUNC& func, unsigned int nbth, const AttributeContainer& cont, const AttributeMultiVector<Dart>& quickTraversal)
 {
-	// buffer for cell traversing
-	std::vector< Cell<ORBIT> >* vd = new std::vector< Cell<ORBIT> >[nbth];
-	for (unsigned int i = 0; i < nbth; ++i)
-		vd[i].reserve(SIZE_BUFFER_THREAD);
+	foreach_chunk(map, cont.realEnd(), nbth, [func, &cont, &quickTraversal] (unsigned int b, unsigned int e, unsigned int thr) mutable
+	{
+		for (unsigned int i = b; i < e; ++i)
+		{
+			if (cont.used(i))
+				func(Cell<ORBIT>(quickTraversal[i]), thr);
+		}
+	});
+}
 
-	unsigned int nb = 0;
-	TraversorCell<MAP, ORBIT, OPT> trav(map);
-	Cell<ORBIT> cell = trav.begin();
-	Cell<ORBIT> c_end = trav.end();
-	while ((cell.dart != c_end.dart) && (nb < nbth*SIZE_BUFFER_THREAD) )
+/// darts of a MapMono, chunks of the dart container
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_darts(MAP& map, FUNC& func, unsigned int nbth)
+{
+	const AttributeContainer& cont = map.template getAttributeContainer<DART>();
+	unsigned int dim = map.dimension();
+	foreach_chunk(map, cont.realEnd(), nbth, [func, &cont, &map, dim] (unsigned int b, unsigned int e, unsigned int thr) mutable
 	{
-		vd[nb%nbth].push_back(cell);
-		nb++;
-		cell = trav.next();
-	}
-	Utils::Barrier sync1(nbth+1);
-	Utils::Barrier sync2(nbth+1);
-	bool finished=false;
+		for (unsigned int i = b; i < e; ++i)
+		{
+			Dart d = Dart::create(i);
+			if (cont.used(i) && !map.isBoundaryMarked(dim, d))
+				func(Cell<ORBIT>(d), thr);
+		}
+	});
+}
 
-	// launch threads
-	std::thread** threads = new std::thread*[nbth];
-	ThreadFunction<ORBIT,FUNC>** tfs = new ThreadFunction<ORBIT,FUNC>*[nbth];
+/**
+ * embedded cells of a MapMono, chunks of the dart container:
+ * the first thread that sets the bit of the embedding of a cell applies func on it
+ */
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_embedded(MAP& map, FUNC& func, unsigned int nbth)
+{
+	const AttributeContainer& cont = map.template getAttributeContainer<DART>();
+	unsigned int dim = map.dimension();
 
-	// add place for nbth new threads in the table of threadId in genericmap
-//	unsigned int firstThread = map.addEmptyThreadIds(nbth);
+	std::vector< std::atomic<unsigned int> > visited((map.template getAttributeContainer<ORBIT>().realEnd() + 31) / 32);
+	for (unsigned int i = 0; i < visited.size(); ++i)
+		visited[i].store(0, std::memory_order_relaxed);
 
-	for (unsigned int i = 0; i < nbth; ++i)
+	foreach_chunk(map, cont.realEnd(), nbth, [func, &cont, &map, &visited, dim] (unsigned int b, unsigned int e, unsigned int thr) mutable
 	{
-		std::thread::id& threadId = map.addEmptyThreadId();
-		tfs[i] = new ThreadFunction<ORBIT,FUNC>(func, vd[i], sync1, sync2, finished, 1+i, threadId);
-		threads[i] = new std::thread( std::ref( *(tfs[i]) ) );
-	}
+		for (unsigned int i = b; i < e; ++i)
+		{
+			Dart d = Dart::create(i);
+			if (!cont.used(i) || map.isBoundaryMarked(dim, d))
+				continue;
+			unsigned int emb = map.template getEmbedding<ORBIT>(Cell<ORBIT>(d));
+			if (emb == EMBNULL)
+				continue;
+			std::atomic<unsigned int>& word = visited[emb / 32];
+			unsigned int bit = 1u << (emb % 32);
+			if ((word.load(std::memory_order_relaxed) & bit) == 0 && (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0)
+				func(Cell<ORBIT>(d), thr);
+		}
+	});
+}
 
-	// and continue to traverse the map
-	std::vector< Cell<ORBIT> >* tempo = new std::vector< Cell<ORBIT> >[nbth];
-	for (unsigned int i = 0; i < nbth; ++i)
-		tempo[i].reserve(SIZE_BUFFER_THREAD);
+/**
+ * cells given by a sequential traversal in the calling thread,
+ * buffers of SIZE_BUFFER_THREAD cells are queued for threads 1..nbth
+ */
+template <TraversalOptim OPT, unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_queue(MAP& map, FUNC& func, unsigned int nbth)
+{
+	typedef std::vector< Cell<ORBIT> > Buffer;
+
+	std::deque<Buffer*> full;
+	std::vector<Buffer*> empty;
+	std::mutex mutex;
+	std::condition_variable cond;
+	bool finished = false;
 
-	while (cell.dart != c_end.dart)
+	runOnMapThreads(map, nbth, [&] (unsigned int i)
 	{
-		for (unsigned int i = 0; i < nbth; ++i)
-			tempo[i].clear();
-		unsigned int nb = 0;
+		if (i == 0)
+		{
+			TraversorCell<MAP, ORBIT, OPT> trav(map);
+			Buffer* buffer = NULL;
+			for (Cell<ORBIT> c = trav.begin(), e = trav.end(); c.dart != e.dart; c = trav.next())
+			{
+				if (buffer == NULL)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					if (empty.empty())
+					{
+						buffer = new Buffer;
+						buffer->reserve(SIZE_BUFFER_THREAD);
+					}
+					else
+					{
+						buffer = empty.back();
+						empty.pop_back();
+					}
+				}
+				buffer->push_back(c);
+				if (buffer->size() == SIZE_BUFFER_THREAD)
+				{
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						full.push_back(buffer);
+					}
+					cond.notify_one();
+					buffer = NULL;
+				}
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (buffer != NULL)
+					full.push_back(buffer);
+				finished = true;
+			}
+			cond.notify_all();
+			return;
+		}
 
-		while ((cell.dart != c_end.dart) && (nb < nbth*SIZE_BUFFER_THREAD) )
+		FUNC f(func);
+		while (true)
 		{
-			tempo[nb%nbth].push_back(cell);
-			nb++;
-			cell = trav.next();
+			Buffer* buffer;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cond.wait(lock, [&] () { return finished || !full.empty(); });
+				if (full.empty())
+					return;
+				buffer = full.front();
+				full.pop_front();
+			}
+			for (typename Buffer::const_iterator it = buffer->begin(); it != buffer->end(); ++it)
+				f(*it, i);
+			buffer->clear();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			empty.push_back(buffer);
 		}
-		sync1.wait();// wait for all thread to finish its vector
-		for (unsigned int i = 0; i < nbth; ++i)
-			vd[i].swap(tempo[i]);
-		sync2.wait();// everybody refilled then go
-	}
+	});
 
-	sync1.wait(); // wait for all thread to finish its vector
-	finished = true; // say finsih to everyone
-	sync2.wait(); // just wait for last barrier wait !
+	for (typename std::vector<Buffer*>::iterator it = empty.begin(); it != empty.end(); ++it)
+		delete *it;
+}
 
-	// wait for all theads to be finished
-	for (unsigned int i = 0; i < nbth; ++i)
+template <TraversalOptim OPT, unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_tmpl(MAP& map, FUNC func, unsigned int nbth)
+{
+	// quick traversal table: chunks of the orbit container
+	const AttributeMultiVector<Dart>* quickTraversal = NULL;
+	if (OPT == FORCE_QUICK_TRAVERSAL || OPT == AUTO)
+		quickTraversal = map.template getQuickTraversal<ORBIT>();
+	if (quickTraversal != NULL)
+	{
+		const AttributeContainer& cont = map.template getAttributeContainer<ORBIT>();
+		if (!cont.hasBrowser())
+		{
+			foreach_cell_quick<ORBIT>(map, func, nbth, cont, *quickTraversal);
+			return;
+		}
+	}
+	// darts of MapMono are lines of the dart container: chunks of darts
+	else if (std::is_base_of<MapMono, MAP>::value && !map.template getAttributeContainer<DART>().hasBrowser())
 	{
-		threads[i]->join();
-		delete threads[i];
-		map.removeThreadId(tfs[i]->getThreadId());
-		delete tfs[i];
+		if (ORBIT == DART)
+		{
+			foreach_cell_darts<ORBIT>(map, func, nbth);
+			return;
+		}
+		if (OPT != FORCE_DART_MARKING && map.template isOrbitEmbedded<ORBIT>())
+		{
+			foreach_cell_embedded<ORBIT>(map, func, nbth);
+			return;
+		}
 	}
 
-	delete[] tfs;
-	delete[] threads;
-	delete[] vd;
-	delete[] tempo;
+	// otherwise the cells are given by the sequential traversal
+	foreach_cell_queue<OPT, ORBIT>(map, func, nbth);
 }
 
 template <unsigned int ORBIT, typename MAP, typename FUNC>
@@ -171,6 +171,15 @@ public:
 	 *
 	 */
 	bool check() ;
+
+protected:
+	/**
+	 * Update the quick traversal tables (if any) after a local modification:
+	 * the cells that intersect the faces of the given darts are updated
+	 */
+	void updateQuickTraversalsInFaces(const std::vector<Dart>& darts) ;
+
+	void updateQuickTraversalsInFaces(Dart d, Dart e = NIL) ;
 } ;
 
 } // namespace CGoGN
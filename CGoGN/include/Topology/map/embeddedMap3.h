@@ -148,6 +148,15 @@ public:
 	/*!
 	 */
 	virtual bool check();
+
+protected:
+	/**
+	 * Update the quick traversal tables (if any) after a local modification:
+	 * the cells that intersect the volumes around the given vertices are updated
+	 */
+	void updateQuickTraversalsAround(const std::vector<Dart>& vertices);
+
+	void updateQuickTraversalsAround(Dart d, Dart e = NIL, Dart f = NIL, Dart g = NIL);
 } ;
 
 } // namespace CGoGN
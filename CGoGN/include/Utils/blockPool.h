@@ -0,0 +1,147 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _CGOGN_BLOCK_POOL_H_
+#define _CGOGN_BLOCK_POOL_H_
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Pool of memory blocks shared by the attributes of one or several maps:
+* released blocks are kept in a free list per block size and given back by
+* the next allocations of the same size, so that maps that are repeatedly
+* built and cleared do not go through the system allocator.
+* With huge pages, blocks are cut in 2MB aligned slabs that are given to
+* the system as transparent huge pages and only freed with the pool.
+* @warning a pool must live longer than the attributes that use it
+*/
+class CGoGN_UTILS_API BlockPool
+{
+public:
+	/**
+	* alignment of the blocks (one cache line)
+	*/
+	static const std::size_t ALIGNMENT = 64;
+
+	/**
+	* size of the huge page slabs
+	*/
+	static const std::size_t SLAB_SIZE = 2 * 1024 * 1024;
+
+	struct Stats
+	{
+		std::size_t nbLiveBlocks;   // allocated and not released blocks
+		std::size_t nbPooledBlocks; // released blocks kept for reuse
+		std::size_t liveBytes;
+		std::size_t pooledBytes;
+		std::size_t slabBytes;      // memory of the huge page slabs
+	};
+
+protected:
+	struct SizeClass
+	{
+		std::size_t size;
+		std::size_t nbLive;
+		std::vector<void*> freeBlocks;
+	};
+
+	mutable std::mutex m_mutex;
+
+	std::vector<SizeClass> m_classes;
+
+	std::size_t m_maxPooledBytes;
+	std::size_t m_pooledBytes;
+
+	bool m_hugePages;
+	std::vector<std::pair<char*, std::size_t> > m_slabs;
+	std::size_t m_slabUsed;
+
+	SizeClass& sizeClass(std::size_t nbBytes);
+
+	void* allocateSystem(std::size_t nbBytes);
+
+	void releaseSystem(void* ptr);
+
+	bool inSlab(const void* ptr) const;
+
+	BlockPool(const BlockPool&);
+	BlockPool& operator=(const BlockPool&);
+
+public:
+	/**
+	* @param hugePages cut the blocks in huge page slabs (if the system provides them)
+	*/
+	BlockPool(bool hugePages = false);
+
+	~BlockPool();
+
+	/**
+	* the pool used by the attributes of the maps that have no pool of their own
+	* (never destroyed, so that static maps can free their attributes)
+	*/
+	static BlockPool& getInstance();
+
+	/**
+	* get a block of nbBytes bytes aligned on ALIGNMENT
+	*/
+	void* allocate(std::size_t nbBytes);
+
+	/**
+	* give back a block obtained with allocate(nbBytes)
+	*/
+	void release(void* ptr, std::size_t nbBytes);
+
+	/**
+	* free the pooled blocks that are not in huge page slabs
+	*/
+	void trim();
+
+	/**
+	* max number of bytes kept in the free lists, blocks released beyond it are freed
+	* (default 256MB, slab blocks are always kept)
+	*/
+	void setMaxPooledSize(std::size_t nbBytes);
+
+	std::size_t getMaxPooledSize() const { return m_maxPooledBytes; }
+
+	bool useHugePages() const { return m_hugePages; }
+
+	Stats getStats() const;
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
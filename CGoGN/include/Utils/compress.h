@@ -27,6 +27,11 @@
 
 
 #include <fstream>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "Utils/dll.h"
 
 namespace CGoGN
 {
@@ -35,6 +40,29 @@ namespace Utils
 
 void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout);
 
+/**
+* compress a set of memory blocks in parallel: each group of groupSize
+* consecutive blocks is compressed in its own independent zlib stream
+* @param blocks the blocks (pointer, size in bytes)
+* @param groupSize number of blocks per zlib stream
+* @param outputs (out) one compressed buffer per group
+* @param nbThreads number of threads (0 for hardware concurrency)
+* @param level zlib compression level
+*/
+CGoGN_UTILS_API void zlibCompressGroups(const std::vector<std::pair<const char*, std::size_t> >& blocks, unsigned int groupSize,
+										std::vector<std::string>& outputs, unsigned int nbThreads = 0, int level = 6);
+
+/**
+* uncompress in parallel buffers written by zlibCompressGroups
+* @param inputs one compressed buffer per group
+* @param blocks the destination blocks (pointer, size in bytes), groupSize blocks per input
+* @param groupSize number of blocks per zlib stream
+* @param nbThreads number of threads (0 for hardware concurrency)
+* @return false if a stream is corrupted or does not match the block sizes
+*/
+CGoGN_UTILS_API bool zlibUncompressGroups(const std::vector<std::string>& inputs, const std::vector<std::pair<char*, std::size_t> >& blocks,
+										  unsigned int groupSize, unsigned int nbThreads = 0);
+
 }
 }
 
@@ -0,0 +1,256 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __CGOGN_INDEXED_HEAP__
+#define __CGOGN_INDEXED_HEAP__
+
+#include <vector>
+#include <cassert>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Min priority queue (4-ary heap) of (key,value) pairs accessed through handles:
+* an element can be removed or its key changed without searching it.
+* Handles of removed elements are recycled, so storage is allocated only when the
+* queue grows (no allocation per insertion as in std::multimap).
+* Elements with the same key are ordered by insertion, as in std::multimap.
+*/
+template <typename KEY, typename VALUE>
+class IndexedHeap
+{
+public:
+	typedef unsigned int Handle ;
+
+	static const Handle NIL_HANDLE = 0xffffffff ;
+
+protected:
+	static const unsigned int ARITY = 4 ;
+
+	struct Node
+	{
+		KEY key ;
+		unsigned long long order ;
+		Handle handle ;
+	} ;
+
+	std::vector<Node> m_heap ;
+	std::vector<unsigned int> m_positions ;	// position in m_heap of each handle (NIL_HANDLE if free)
+	std::vector<VALUE> m_values ;
+	std::vector<Handle> m_freeHandles ;
+	unsigned long long m_nbInsertions ;
+
+	static bool less(const Node& a, const Node& b)
+	{
+		return (a.key < b.key) || (!(b.key < a.key) && a.order < b.order) ;
+	}
+
+	void place(unsigned int pos, const Node& n)
+	{
+		m_heap[pos] = n ;
+		m_positions[n.handle] = pos ;
+	}
+
+	void siftUp(unsigned int pos)
+	{
+		Node n = m_heap[pos] ;
+		while (pos > 0)
+		{
+			unsigned int parent = (pos - 1) / ARITY ;
+			if (!less(n, m_heap[parent]))
+				break ;
+			place(pos, m_heap[parent]) ;
+			pos = parent ;
+		}
+		place(pos, n) ;
+	}
+
+	void siftDown(unsigned int pos)
+	{
+		Node n = m_heap[pos] ;
+		unsigned int size = (unsigned int)(m_heap.size()) ;
+		for (;;)
+		{
+			unsigned int first = pos * ARITY + 1 ;
+			if (first >= size)
+				break ;
+			unsigned int last = (first + ARITY < size) ? first + ARITY : size ;
+			unsigned int best = first ;
+			for (unsigned int c = first + 1; c < last; ++c)
+			{
+				if (less(m_heap[c], m_heap[best]))
+					best = c ;
+			}
+			if (!less(m_heap[best], n))
+				break ;
+			place(pos, m_heap[best]) ;
+			pos = best ;
+		}
+		place(pos, n) ;
+	}
+
+public:
+	IndexedHeap() : m_nbInsertions(0)
+	{}
+
+	/**
+	* reserve memory for nb elements
+	*/
+	void reserve(unsigned int nb)
+	{
+		m_heap.reserve(nb) ;
+		m_positions.reserve(nb) ;
+		m_values.reserve(nb) ;
+	}
+
+	void clear()
+	{
+		m_heap.clear() ;
+		m_positions.clear() ;
+		m_values.clear() ;
+		m_freeHandles.clear() ;
+		m_nbInsertions = 0 ;
+	}
+
+	bool empty() const { return m_heap.empty() ; }
+
+	unsigned int size() const { return (unsigned int)(m_heap.size()) ; }
+
+	/**
+	* insert an element
+	* @return the handle of the element (valid until the element is removed)
+	*/
+	Handle insert(const KEY& key, const VALUE& value)
+	{
+		Handle h ;
+		if (!m_freeHandles.empty())
+		{
+			h = m_freeHandles.back() ;
+			m_freeHandles.pop_back() ;
+			m_values[h] = value ;
+		}
+		else
+		{
+			h = Handle(m_positions.size()) ;
+			m_positions.push_back(NIL_HANDLE) ;
+			m_values.push_back(value) ;
+		}
+
+		Node n ;
+		n.key = key ;
+		n.order = m_nbInsertions++ ;
+		n.handle = h ;
+		m_heap.push_back(n) ;
+		siftUp((unsigned int)(m_heap.size()) - 1) ;
+		return h ;
+	}
+
+	/**
+	* remove an element
+	*/
+	void erase(Handle h)
+	{
+		assert(contains(h) || !"IndexedHeap: erase of a removed element") ;
+		unsigned int pos = m_positions[h] ;
+		m_positions[h] = NIL_HANDLE ;
+		m_freeHandles.push_back(h) ;
+
+		Node last = m_heap.back() ;
+		m_heap.pop_back() ;
+		if (pos < m_heap.size())
+		{
+			place(pos, last) ;
+			if (pos > 0 && less(last, m_heap[(pos - 1) / ARITY]))
+				siftUp(pos) ;
+			else
+				siftDown(pos) ;
+		}
+	}
+
+	/**
+	* change the key of an element (decrease or increase)
+	* the element is placed after the elements with the same key
+	*/
+	void update(Handle h, const KEY& key)
+	{
+		assert(contains(h) || !"IndexedHeap: update of a removed element") ;
+		unsigned int pos = m_positions[h] ;
+		Node& n = m_heap[pos] ;
+		bool decrease = key < n.key ;
+		n.key = key ;
+		n.order = m_nbInsertions++ ;
+		if (decrease)
+			siftUp(pos) ;
+		else
+			siftDown(pos) ;
+	}
+
+	bool contains(Handle h) const
+	{
+		return h < m_positions.size() && m_positions[h] != NIL_HANDLE ;
+	}
+
+	const KEY& key(Handle h) const { return m_heap[m_positions[h]].key ; }
+
+	const VALUE& value(Handle h) const { return m_values[h] ; }
+
+	/**
+	* element of smallest key
+	*/
+	const VALUE& top() const
+	{
+		assert(!empty()) ;
+		return m_values[m_heap[0].handle] ;
+	}
+
+	const KEY& topKey() const
+	{
+		assert(!empty()) ;
+		return m_heap[0].key ;
+	}
+
+	Handle topHandle() const
+	{
+		assert(!empty()) ;
+		return m_heap[0].handle ;
+	}
+
+	void pop()
+	{
+		erase(topHandle()) ;
+	}
+} ;
+
+template <typename KEY, typename VALUE>
+const typename IndexedHeap<KEY, VALUE>::Handle IndexedHeap<KEY, VALUE>::NIL_HANDLE ;
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
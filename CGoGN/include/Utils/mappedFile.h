@@ -0,0 +1,117 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _CGOGN_MAPPED_FILE_H_
+#define _CGOGN_MAPPED_FILE_H_
+
+#include <string>
+#include <cstddef>
+#include <ostream>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Read-only file mapped in memory with copy-on-write pages:
+* data can be modified in place, modifications are private
+* to the process and never written back to the file.
+* (on systems without mmap the file is read in memory)
+*/
+class CGoGN_UTILS_API MappedFile
+{
+public:
+	/**
+	* alignment (in bytes) of the data blocks stored in mappable files
+	*/
+	static const std::size_t ALIGNMENT = 4096;
+
+protected:
+	char* m_data;
+	std::size_t m_size;
+	bool m_mapped;
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+public:
+	MappedFile();
+
+	~MappedFile();
+
+	/**
+	* map a file (a previously opened file is closed)
+	* @return true if OK
+	*/
+	bool open(const std::string& filename);
+
+	/**
+	* unmap the file
+	*/
+	void close();
+
+	bool isOpen() const { return m_data != NULL; }
+
+	char* data() const { return m_data; }
+
+	std::size_t size() const { return m_size; }
+
+	/**
+	* is ptr an address inside the mapped file
+	*/
+	bool contains(const void* ptr) const
+	{
+		const char* p = static_cast<const char*>(ptr);
+		return m_data != NULL && p >= m_data && p < m_data + m_size;
+	}
+
+	/**
+	* copy nb bytes at offset in dst and move offset forward
+	* @return false if the file is too short
+	*/
+	bool read(std::size_t& offset, void* dst, std::size_t nb) const;
+
+	/**
+	* move offset forward to the next aligned position
+	*/
+	static std::size_t align(std::size_t offset)
+	{
+		return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	}
+
+	/**
+	* write zeros until the stream position is aligned
+	*/
+	static void writePadding(std::ostream& fs);
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
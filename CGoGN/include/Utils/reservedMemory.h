@@ -0,0 +1,94 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _CGOGN_RESERVED_MEMORY_H_
+#define _CGOGN_RESERVED_MEMORY_H_
+
+#include <cstddef>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Range of virtual addresses reserved once, in which memory is committed
+* on demand: the range never moves, so addresses inside it stay valid
+* while the committed part grows or shrinks.
+* (large ranges use transparent huge pages when the system provides them)
+*/
+class CGoGN_UTILS_API ReservedMemory
+{
+protected:
+	char* m_data;
+	std::size_t m_reserved;
+	std::size_t m_committed;
+
+	ReservedMemory(const ReservedMemory&);
+	ReservedMemory& operator=(const ReservedMemory&);
+
+public:
+	ReservedMemory();
+
+	~ReservedMemory();
+
+	/**
+	* reserve a range of nbBytes addresses (no memory is used), a previous range is released
+	* @return false if the range can not be reserved
+	*/
+	bool reserve(std::size_t nbBytes);
+
+	/**
+	* make the first nbBytes of the range usable, memory after them is given back to the system
+	* @return false if nbBytes is greater than the reserved size or if memory is not available
+	*/
+	bool commit(std::size_t nbBytes);
+
+	/**
+	* release the whole range
+	*/
+	void release();
+
+	char* data() const { return m_data; }
+
+	std::size_t reservedSize() const { return m_reserved; }
+
+	std::size_t committedSize() const { return m_committed; }
+
+	void swap(ReservedMemory& rm);
+
+	/**
+	* size of the pages of the system
+	*/
+	static std::size_t pageSize();
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
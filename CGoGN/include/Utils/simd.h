@@ -0,0 +1,235 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __CGOGN_SIMD__
+#define __CGOGN_SIMD__
+
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* alignment (in bytes) of the arrays processed with SimdPack
+*/
+const std::size_t SIMD_ALIGNMENT = 32;
+
+/**
+* allocate nb bytes aligned on SIMD_ALIGNMENT (free with alignedFree)
+*/
+inline void* alignedMalloc(std::size_t nb)
+{
+	char* raw = static_cast<char*>(malloc(nb + SIMD_ALIGNMENT + sizeof(void*)));
+	if (raw == NULL)
+		return NULL;
+	std::size_t addr = reinterpret_cast<std::size_t>(raw + sizeof(void*));
+	char* ptr = reinterpret_cast<char*>((addr + SIMD_ALIGNMENT - 1) & ~(SIMD_ALIGNMENT - 1));
+	reinterpret_cast<void**>(ptr)[-1] = raw;
+	return ptr;
+}
+
+inline void alignedFree(void* ptr)
+{
+	if (ptr != NULL)
+		free(reinterpret_cast<void**>(ptr)[-1]);
+}
+
+/**
+* Pack of SIZE values of type T processed by one SIMD instruction:
+* AVX or SSE registers when the compiler targets them, plain arrays otherwise
+* (that the compiler may still vectorize).
+* Memory accesses (load/store) must be aligned on SIMD_ALIGNMENT.
+*/
+template <typename T>
+class SimdPack
+{
+public:
+	static const unsigned int SIZE = 4;
+
+	T v[SIZE];
+
+	SimdPack() {}
+
+	explicit SimdPack(T x) { for (unsigned int i = 0; i < SIZE; ++i) v[i] = x; }
+
+	static SimdPack load(const T* p) { SimdPack r; for (unsigned int i = 0; i < SIZE; ++i) r.v[i] = p[i]; return r; }
+
+	void store(T* p) const { for (unsigned int i = 0; i < SIZE; ++i) p[i] = v[i]; }
+
+	SimdPack operator+(const SimdPack& p) const { SimdPack r; for (unsigned int i = 0; i < SIZE; ++i) r.v[i] = v[i] + p.v[i]; return r; }
+	SimdPack operator-(const SimdPack& p) const { SimdPack r; for (unsigned int i = 0; i < SIZE; ++i) r.v[i] = v[i] - p.v[i]; return r; }
+	SimdPack operator*(const SimdPack& p) const { SimdPack r; for (unsigned int i = 0; i < SIZE; ++i) r.v[i] = v[i] * p.v[i]; return r; }
+	SimdPack operator/(const SimdPack& p) const { SimdPack r; for (unsigned int i = 0; i < SIZE; ++i) r.v[i] = v[i] / p.v[i]; return r; }
+
+	SimdPack sqrt() const { SimdPack r; for (unsigned int i = 0; i < SIZE; ++i) r.v[i] = std::sqrt(v[i]); return r; }
+
+	/**
+	* num / den where den > 0, 0 elsewhere
+	*/
+	static SimdPack divPositive(const SimdPack& num, const SimdPack& den)
+	{
+		SimdPack r;
+		for (unsigned int i = 0; i < SIZE; ++i)
+			r.v[i] = den.v[i] > T(0) ? num.v[i] / den.v[i] : T(0);
+		return r;
+	}
+};
+
+#if defined(__AVX__)
+
+template <>
+class SimdPack<float>
+{
+public:
+	static const unsigned int SIZE = 8;
+
+	__m256 v;
+
+	SimdPack() {}
+	explicit SimdPack(float x) : v(_mm256_set1_ps(x)) {}
+	SimdPack(__m256 x) : v(x) {}
+
+	static SimdPack load(const float* p) { return SimdPack(_mm256_load_ps(p)); }
+	void store(float* p) const { _mm256_store_ps(p, v); }
+
+	SimdPack operator+(const SimdPack& p) const { return SimdPack(_mm256_add_ps(v, p.v)); }
+	SimdPack operator-(const SimdPack& p) const { return SimdPack(_mm256_sub_ps(v, p.v)); }
+	SimdPack operator*(const SimdPack& p) const { return SimdPack(_mm256_mul_ps(v, p.v)); }
+	SimdPack operator/(const SimdPack& p) const { return SimdPack(_mm256_div_ps(v, p.v)); }
+
+	SimdPack sqrt() const { return SimdPack(_mm256_sqrt_ps(v)); }
+
+	static SimdPack divPositive(const SimdPack& num, const SimdPack& den)
+	{
+		__m256 mask = _mm256_cmp_ps(den.v, _mm256_setzero_ps(), _CMP_GT_OQ);
+		return SimdPack(_mm256_and_ps(mask, _mm256_div_ps(num.v, den.v)));
+	}
+};
+
+template <>
+class SimdPack<double>
+{
+public:
+	static const unsigned int SIZE = 4;
+
+	__m256d v;
+
+	SimdPack() {}
+	explicit SimdPack(double x) : v(_mm256_set1_pd(x)) {}
+	SimdPack(__m256d x) : v(x) {}
+
+	static SimdPack load(const double* p) { return SimdPack(_mm256_load_pd(p)); }
+	void store(double* p) const { _mm256_store_pd(p, v); }
+
+	SimdPack operator+(const SimdPack& p) const { return SimdPack(_mm256_add_pd(v, p.v)); }
+	SimdPack operator-(const SimdPack& p) const { return SimdPack(_mm256_sub_pd(v, p.v)); }
+	SimdPack operator*(const SimdPack& p) const { return SimdPack(_mm256_mul_pd(v, p.v)); }
+	SimdPack operator/(const SimdPack& p) const { return SimdPack(_mm256_div_pd(v, p.v)); }
+
+	SimdPack sqrt() const { return SimdPack(_mm256_sqrt_pd(v)); }
+
+	static SimdPack divPositive(const SimdPack& num, const SimdPack& den)
+	{
+		__m256d mask = _mm256_cmp_pd(den.v, _mm256_setzero_pd(), _CMP_GT_OQ);
+		return SimdPack(_mm256_and_pd(mask, _mm256_div_pd(num.v, den.v)));
+	}
+};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+template <>
+class SimdPack<float>
+{
+public:
+	static const unsigned int SIZE = 4;
+
+	__m128 v;
+
+	SimdPack() {}
+	explicit SimdPack(float x) : v(_mm_set1_ps(x)) {}
+	SimdPack(__m128 x) : v(x) {}
+
+	static SimdPack load(const float* p) { return SimdPack(_mm_load_ps(p)); }
+	void store(float* p) const { _mm_store_ps(p, v); }
+
+	SimdPack operator+(const SimdPack& p) const { return SimdPack(_mm_add_ps(v, p.v)); }
+	SimdPack operator-(const SimdPack& p) const { return SimdPack(_mm_sub_ps(v, p.v)); }
+	SimdPack operator*(const SimdPack& p) const { return SimdPack(_mm_mul_ps(v, p.v)); }
+	SimdPack operator/(const SimdPack& p) const { return SimdPack(_mm_div_ps(v, p.v)); }
+
+	SimdPack sqrt() const { return SimdPack(_mm_sqrt_ps(v)); }
+
+	static SimdPack divPositive(const SimdPack& num, const SimdPack& den)
+	{
+		__m128 mask = _mm_cmpgt_ps(den.v, _mm_setzero_ps());
+		return SimdPack(_mm_and_ps(mask, _mm_div_ps(num.v, den.v)));
+	}
+};
+
+template <>
+class SimdPack<double>
+{
+public:
+	static const unsigned int SIZE = 2;
+
+	__m128d v;
+
+	SimdPack() {}
+	explicit SimdPack(double x) : v(_mm_set1_pd(x)) {}
+	SimdPack(__m128d x) : v(x) {}
+
+	static SimdPack load(const double* p) { return SimdPack(_mm_load_pd(p)); }
+	void store(double* p) const { _mm_store_pd(p, v); }
+
+	SimdPack operator+(const SimdPack& p) const { return SimdPack(_mm_add_pd(v, p.v)); }
+	SimdPack operator-(const SimdPack& p) const { return SimdPack(_mm_sub_pd(v, p.v)); }
+	SimdPack operator*(const SimdPack& p) const { return SimdPack(_mm_mul_pd(v, p.v)); }
+	SimdPack operator/(const SimdPack& p) const { return SimdPack(_mm_div_pd(v, p.v)); }
+
+	SimdPack sqrt() const { return SimdPack(_mm_sqrt_pd(v)); }
+
+	static SimdPack divPositive(const SimdPack& num, const SimdPack& den)
+	{
+		__m128d mask = _mm_cmpgt_pd(den.v, _mm_setzero_pd());
+		return SimdPack(_mm_and_pd(mask, _mm_div_pd(num.v, den.v)));
+	}
+};
+
+#endif
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
@@ -61,6 +61,8 @@ public :
 	// I/O
 	const Tcoef& get_coef (int l, int m) const {assert ((l>=0 && l <=resolution) || !" maybe you forgot to call set_level()"); assert (m >= (-l) && m <= l); return get_coef(index(l,m));}
 	Tcoef& get_coef (int l, int m) {assert ((l>=0 && l <=resolution) || !" maybe you forgot to call set_level()"); assert (m >= (-l) && m <= l); return get_coef(index(l,m));}
+	const Tcoef* get_coef_tab () const { return coefs; }                                        // the nb_coefs coefs, indexed as in SphericalHarmonicsBatch
+	Tcoef* get_coef_tab () { return coefs; }
 	template <typename TS,typename TC> friend std::ostream & operator<< (std::ostream & os, const SphericalHarmonics<TS,TC> & sh);
 
 	// operators
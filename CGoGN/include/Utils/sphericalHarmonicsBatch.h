@@ -0,0 +1,148 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __SPHERICAL_HARMONICS_BATCH__
+#define __SPHERICAL_HARMONICS_BATCH__
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <Eigen/Dense>
+
+#include "Utils/simd.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Real spherical harmonics basis evaluated at a set of directions, with the same
+* basis functions as SphericalHarmonics but without static state: the resolution
+* belongs to the object and each thread uses its own batch (or shares a const one).
+*
+* The basis values are stored coefficient major (one aligned row of directions per
+* coefficient) and computed with SimdPack over the directions, so that evaluating
+* a function at all the directions is a sequence of SIMD multiply-adds.
+*
+* Coefficient types (Tcoef) are Geom::Vector of any dimension (as SphericalHarmonics::fit_to_data)
+*/
+template <typename Tscalar>
+class SphericalHarmonicsBatch
+{
+public:
+	typedef SimdPack<Tscalar> Pack;
+
+	static const int max_resolution = 10;
+
+protected:
+	int m_resolution;
+	int m_nbCoefs;
+	std::vector<Tscalar> m_K;
+
+	unsigned int m_nbDirections;
+	unsigned int m_stride;         // padded number of directions (multiple of Pack::SIZE)
+	unsigned int m_capacity;       // allocated number of directions
+	Tscalar* m_directions;         // x row, y row, z row
+	Tscalar* m_basis;              // nbCoefs rows of m_stride values
+
+	// fitting
+	double m_fitLambda;
+	bool m_fitReady;
+	Eigen::MatrixXd m_fitBasis;
+	Eigen::LDLT<Eigen::MatrixXd> m_fitSolver;
+
+	static inline int index(int l, int m) { return l*(l+1)+m; }
+
+	void initK();
+
+	void reserve(unsigned int nb);
+
+	void computeBasis();
+
+	SphericalHarmonicsBatch(const SphericalHarmonicsBatch&);
+	SphericalHarmonicsBatch& operator=(const SphericalHarmonicsBatch&);
+
+public:
+	SphericalHarmonicsBatch(int resolution);
+
+	~SphericalHarmonicsBatch();
+
+	int getResolution() const { return m_resolution; }
+
+	int getNbCoefs() const { return m_nbCoefs; }
+
+	unsigned int getNbDirections() const { return m_nbDirections; }
+
+	/**
+	* set the directions (unit vectors) and compute the basis values
+	*/
+	template <typename Tdirection>
+	void setDirections(unsigned int nb, const Tdirection* x, const Tdirection* y, const Tdirection* z);
+
+	template <typename VEC3>
+	void setDirections(const std::vector<VEC3>& directions);
+
+	/**
+	* value of the basis function i (index of SphericalHarmonics) at direction p
+	*/
+	Tscalar basis(int i, unsigned int p) const { assert(i < m_nbCoefs && p < m_nbDirections); return m_basis[i * m_stride + p]; }
+
+	/**
+	* evaluate a function (its m_nbCoefs coefficients) at all the directions
+	*/
+	template <typename Tcoef>
+	void evaluate(const Tcoef* coefs, Tcoef* values) const;
+
+	/**
+	* squared norm of a function (its m_nbCoefs coefficients) at all the directions
+	*/
+	template <typename Tcoef>
+	void evaluateSquaredNorm(const Tcoef* coefs, Tscalar* values) const;
+
+	/**
+	* factorize the fitting system of the current directions (see SphericalHarmonics::fit_to_data),
+	* to call before fit, again when the directions change
+	*/
+	void prepareFit(double lambda);
+
+	/**
+	* fit nbFunctions functions sampled at the current directions, with one solve
+	* @param values nbFunctions x nbDirections values (function major)
+	* @param coefs (out) nbFunctions x nbCoefs coefficients (function major)
+	*/
+	template <typename Tcoef>
+	void fit(unsigned int nbFunctions, const Tcoef* values, Tcoef* coefs) const;
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#include "Utils/sphericalHarmonicsBatch.hpp"
+
+#endif
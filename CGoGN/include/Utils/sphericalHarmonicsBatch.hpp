@@ -0,0 +1,283 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+template <typename Tscalar>
+SphericalHarmonicsBatch<Tscalar>::SphericalHarmonicsBatch(int resolution) :
+	m_resolution(resolution),
+	m_nbCoefs((resolution + 1) * (resolution + 1)),
+	m_nbDirections(0),
+	m_stride(0),
+	m_capacity(0),
+	m_directions(NULL),
+	m_basis(NULL),
+	m_fitLambda(0),
+	m_fitReady(false)
+{
+	assert(resolution >= 0 && resolution < max_resolution);
+	initK();
+}
+
+template <typename Tscalar>
+SphericalHarmonicsBatch<Tscalar>::~SphericalHarmonicsBatch()
+{
+	alignedFree(m_directions);
+	alignedFree(m_basis);
+}
+
+template <typename Tscalar>
+void SphericalHarmonicsBatch<Tscalar>::initK()
+{
+	std::vector<double> K(m_nbCoefs);
+	for (int l = 0; l <= m_resolution; ++l)
+	{
+		// recursive computation of the squares (as SphericalHarmonics::init_K_tab)
+		K[index(l,0)] = (2*l+1) / (4*M_PI);
+		for (int m = 1; m <= l; ++m)
+			K[index(l,m)] = K[index(l,m-1)] / (l-m+1) / (l+m);
+		for (int m = 0; m <= l; ++m)
+			K[index(l,-m)] = K[index(l,m)] = std::sqrt(K[index(l,m)]);
+	}
+	m_K.assign(K.begin(), K.end());
+}
+
+template <typename Tscalar>
+void SphericalHarmonicsBatch<Tscalar>::reserve(unsigned int nb)
+{
+	m_nbDirections = nb;
+	m_stride = (nb + Pack::SIZE - 1) / Pack::SIZE * Pack::SIZE;
+	if (m_stride <= m_capacity)
+		return;
+
+	alignedFree(m_directions);
+	alignedFree(m_basis);
+	m_capacity = m_stride;
+	m_directions = static_cast<Tscalar*>(alignedMalloc(3 * m_capacity * sizeof(Tscalar)));
+	m_basis = static_cast<Tscalar*>(alignedMalloc(m_nbCoefs * m_capacity * sizeof(Tscalar)));
+}
+
+template <typename Tscalar>
+template <typename Tdirection>
+void SphericalHarmonicsBatch<Tscalar>::setDirections(unsigned int nb, const Tdirection* x, const Tdirection* y, const Tdirection* z)
+{
+	reserve(nb);
+
+	Tscalar* dx = m_directions;
+	Tscalar* dy = m_directions + m_stride;
+	Tscalar* dz = m_directions + 2 * m_stride;
+	for (unsigned int p = 0; p < nb; ++p)
+	{
+		dx[p] = Tscalar(x[p]);
+		dy[p] = Tscalar(y[p]);
+		dz[p] = Tscalar(z[p]);
+	}
+	// padding directions
+	for (unsigned int p = nb; p < m_stride; ++p)
+	{
+		dx[p] = Tscalar(0);
+		dy[p] = Tscalar(0);
+		dz[p] = Tscalar(1);
+	}
+
+	computeBasis();
+	m_fitReady = false;
+}
+
+template <typename Tscalar>
+template <typename VEC3>
+void SphericalHarmonicsBatch<Tscalar>::setDirections(const std::vector<VEC3>& directions)
+{
+	const unsigned int nb = (unsigned int)(directions.size());
+	std::vector<Tscalar> xyz(3 * nb);
+	for (unsigned int p = 0; p < nb; ++p)
+	{
+		xyz[p] = Tscalar(directions[p][0]);
+		xyz[nb + p] = Tscalar(directions[p][1]);
+		xyz[2 * nb + p] = Tscalar(directions[p][2]);
+	}
+	setDirections(nb, nb > 0 ? &xyz[0] : NULL, nb > 0 ? &xyz[nb] : NULL, nb > 0 ? &xyz[2 * nb] : NULL);
+}
+
+template <typename Tscalar>
+void SphericalHarmonicsBatch<Tscalar>::computeBasis()
+{
+	const unsigned int stride = m_stride;
+
+	for (unsigned int p = 0; p < stride; p += Pack::SIZE)
+	{
+		Tscalar* b = m_basis + p;
+
+		Pack x = Pack::load(m_directions + p);
+		Pack y = Pack::load(m_directions + stride + p);
+		Pack t = Pack::load(m_directions + 2 * stride + p);
+		Pack s = (x * x + y * y).sqrt(); // sin(theta) for unit directions
+
+		// associated Legendre polynomials at cos(theta) (m >= 0)
+		Pack(Tscalar(1)).store(b + index(0,0) * stride);
+		for (int l = 1; l <= m_resolution; ++l)
+		{
+			Pack pll = Pack::load(b + index(l-1,l-1) * stride);
+			(Pack(Tscalar(1-2*l)) * s * pll).store(b + index(l,l) * stride);
+			(t * Pack(Tscalar(2*l-1)) * pll).store(b + index(l,l-1) * stride);
+			for (int m = 0; m <= l-2; ++m)
+			{
+				Pack a = t * Pack(Tscalar(2*l-1) / Tscalar(l-m)) * Pack::load(b + index(l-1,m) * stride);
+				Pack c = Pack(Tscalar(l+m-1) / Tscalar(l-m)) * Pack::load(b + index(l-2,m) * stride);
+				(a - c).store(b + index(l,m) * stride);
+			}
+		}
+
+		// real basis functions: cos(m phi) and sin(m phi) by rotation from (cos(phi), sin(phi))
+		for (int l = 0; l <= m_resolution; ++l)
+			(Pack::load(b + index(l,0) * stride) * Pack(m_K[index(l,0)])).store(b + index(l,0) * stride);
+
+		Pack cosPhi = Pack::divPositive(x, s);
+		Pack sinPhi = Pack::divPositive(y, s);
+		Pack cosM = cosPhi;
+		Pack sinM = sinPhi;
+		for (int m = 1; m <= m_resolution; ++m)
+		{
+			for (int l = m; l <= m_resolution; ++l)
+			{
+				Pack v = Pack::load(b + index(l,m) * stride) * Pack(Tscalar(M_SQRT2) * m_K[index(l,m)]);
+				(v * sinM).store(b + index(l,-m) * stride);
+				(v * cosM).store(b + index(l,m) * stride);
+			}
+			Pack c = cosM * cosPhi - sinM * sinPhi;
+			sinM = sinM * cosPhi + cosM * sinPhi;
+			cosM = c;
+		}
+	}
+}
+
+template <typename Tscalar>
+template <typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar>::evaluate(const Tcoef* coefs, Tcoef* values) const
+{
+	const unsigned int dim = Tcoef::DIMENSION;
+
+	for (unsigned int p = 0; p < m_stride; p += Pack::SIZE)
+	{
+		Pack acc[dim];
+		for (unsigned int c = 0; c < dim; ++c)
+			acc[c] = Pack(Tscalar(0));
+		for (int i = 0; i < m_nbCoefs; ++i)
+		{
+			Pack b = Pack::load(m_basis + i * m_stride + p);
+			for (unsigned int c = 0; c < dim; ++c)
+				acc[c] = acc[c] + Pack(Tscalar(coefs[i][c])) * b;
+		}
+
+		unsigned int nb = std::min(Pack::SIZE, m_nbDirections - p);
+		for (unsigned int c = 0; c < dim; ++c)
+		{
+			const Tscalar* lanes = reinterpret_cast<const Tscalar*>(&acc[c]);
+			for (unsigned int k = 0; k < nb; ++k)
+				values[p + k][c] = lanes[k];
+		}
+	}
+}
+
+template <typename Tscalar>
+template <typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar>::evaluateSquaredNorm(const Tcoef* coefs, Tscalar* values) const
+{
+	const unsigned int dim = Tcoef::DIMENSION;
+
+	for (unsigned int p = 0; p < m_stride; p += Pack::SIZE)
+	{
+		Pack acc[dim];
+		for (unsigned int c = 0; c < dim; ++c)
+			acc[c] = Pack(Tscalar(0));
+		for (int i = 0; i < m_nbCoefs; ++i)
+		{
+			Pack b = Pack::load(m_basis + i * m_stride + p);
+			for (unsigned int c = 0; c < dim; ++c)
+				acc[c] = acc[c] + Pack(Tscalar(coefs[i][c])) * b;
+		}
+
+		Pack n2 = acc[0] * acc[0];
+		for (unsigned int c = 1; c < dim; ++c)
+			n2 = n2 + acc[c] * acc[c];
+
+		unsigned int nb = std::min(Pack::SIZE, m_nbDirections - p);
+		const Tscalar* lanes = reinterpret_cast<const Tscalar*>(&n2);
+		for (unsigned int k = 0; k < nb; ++k)
+			values[p + k] = lanes[k];
+	}
+}
+
+template <typename Tscalar>
+void SphericalHarmonicsBatch<Tscalar>::prepareFit(double lambda)
+{
+	assert(m_nbDirections > 0);
+	const double n = double(m_nbDirections);
+
+	typedef Eigen::Matrix<Tscalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> RowMatrix;
+	Eigen::Map<const RowMatrix, 0, Eigen::OuterStride<> > B(m_basis, m_nbCoefs, m_nbDirections, Eigen::OuterStride<>(m_stride));
+	m_fitBasis = B.template cast<double>();
+
+	// system of SphericalHarmonics::fit_to_data: data term + lambda * smoothness
+	Eigen::MatrixXd A = ((1.0 - lambda) / n) * (m_fitBasis * m_fitBasis.transpose());
+	for (int l = 0; l <= m_resolution; ++l)
+		for (int m = -l; m <= l; ++m)
+			A(index(l,m), index(l,m)) += lambda * l * (l+1) / (4.0*M_PI);
+
+	m_fitSolver.compute(A);
+	m_fitLambda = lambda;
+	m_fitReady = true;
+}
+
+template <typename Tscalar>
+template <typename Tcoef>
+void SphericalHarmonicsBatch<Tscalar>::fit(unsigned int nbFunctions, const Tcoef* values, Tcoef* coefs) const
+{
+	assert(m_fitReady || !"maybe you forgot to call prepareFit()");
+	const unsigned int dim = Tcoef::DIMENSION;
+	const unsigned int n = m_nbDirections;
+
+	// all the channels of all the functions are solved together
+	Eigen::MatrixXd V(n, dim * nbFunctions);
+	for (unsigned int f = 0; f < nbFunctions; ++f)
+		for (unsigned int p = 0; p < n; ++p)
+			for (unsigned int c = 0; c < dim; ++c)
+				V(p, f * dim + c) = values[f * n + p][c];
+
+	Eigen::MatrixXd R = ((1.0 - m_fitLambda) / double(n)) * (m_fitBasis * V);
+	Eigen::MatrixXd C = m_fitSolver.solve(R);
+
+	for (unsigned int f = 0; f < nbFunctions; ++f)
+		for (int i = 0; i < m_nbCoefs; ++i)
+			for (unsigned int c = 0; c < dim; ++c)
+				coefs[f * m_nbCoefs + i][c] = C(i, f * dim + c);
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
@@ -0,0 +1,231 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef _CGOGN_TEXT_PARSER_H_
+#define _CGOGN_TEXT_PARSER_H_
+
+#include <cstddef>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <locale>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Parsing of numbers in a text buffer [p,end) independent of the locale
+* (the decimal separator is always '.'), without copy of the text.
+* Each function moves p after what it has read.
+*/
+namespace TextParser
+{
+
+inline bool isSpace(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r';
+}
+
+inline bool isDigit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/**
+* skip spaces and tabs (not end of lines)
+*/
+inline void skipSpaces(const char*& p, const char* end)
+{
+	while (p < end && isSpace(*p))
+		++p;
+}
+
+/**
+* skip the current token (until a space or an end of line)
+*/
+inline void skipToken(const char*& p, const char* end)
+{
+	while (p < end && !isSpace(*p) && *p != '\n')
+		++p;
+}
+
+/**
+* move p to the beginning of the next line
+*/
+inline void nextLine(const char*& p, const char* end)
+{
+	while (p < end && *p != '\n')
+		++p;
+	if (p < end)
+		++p;
+}
+
+/**
+* is the rest of the current line empty (spaces only)
+*/
+inline bool endOfLine(const char*& p, const char* end)
+{
+	skipSpaces(p, end);
+	return p == end || *p == '\n';
+}
+
+/**
+* read an integer
+* @return false if there is no integer at p
+*/
+inline bool parseInt(const char*& p, const char* end, long long& v)
+{
+	skipSpaces(p, end);
+	const char* q = p;
+	bool neg = false;
+	if (q < end && (*q == '-' || *q == '+'))
+		neg = (*q++ == '-');
+	if (q == end || !isDigit(*q))
+		return false;
+	long long x = 0;
+	while (q < end && isDigit(*q))
+		x = x * 10 + (*q++ - '0');
+	v = neg ? -x : x;
+	p = q;
+	return true;
+}
+
+/**
+* read a floating point value
+* values with at most 15 significant digits and a small exponent are computed exactly,
+* the others (and nan, inf) are read by a stream with the classic locale
+* @return false if there is no value at p
+*/
+inline bool parseFloat(const char*& p, const char* end, double& v)
+{
+	static const double pow10[23] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	skipSpaces(p, end);
+	const char* q = p;
+	bool neg = false;
+	if (q < end && (*q == '-' || *q == '+'))
+		neg = (*q++ == '-');
+
+	unsigned long long m = 0;
+	int nbDigits = 0;
+	int exp10 = 0;
+	bool digits = false;
+	while (q < end && isDigit(*q))
+	{
+		digits = true;
+		if (nbDigits < 19)
+		{
+			m = m * 10 + (*q - '0');
+			if (m != 0)
+				++nbDigits;
+		}
+		else
+			++exp10;
+		++q;
+	}
+	if (q < end && *q == '.')
+	{
+		++q;
+		while (q < end && isDigit(*q))
+		{
+			digits = true;
+			if (nbDigits < 19)
+			{
+				m = m * 10 + (*q - '0');
+				if (m != 0)
+					++nbDigits;
+				--exp10;
+			}
+			++q;
+		}
+	}
+
+	bool slow = !digits;
+	if (digits && q < end && (*q == 'e' || *q == 'E'))
+	{
+		const char* r = q + 1;
+		if (r < end && (isDigit(*r) || ((*r == '-' || *r == '+') && r + 1 < end && isDigit(r[1]))))
+		{
+			long long e = 0;
+			parseInt(r, end, e);
+			if (e > 1000 || e < -1000)
+				slow = true;
+			else
+				exp10 += int(e);
+			q = r;
+		}
+	}
+
+	if (!slow && m == 0)
+	{
+		v = neg ? -0.0 : 0.0;
+		p = q;
+		return true;
+	}
+
+	if (!slow && nbDigits <= 15 && exp10 >= -22 && exp10 <= 22)
+	{
+		double x = double(m);
+		x = exp10 < 0 ? x / pow10[-exp10] : x * pow10[exp10];
+		v = neg ? -x : x;
+		p = q;
+		return true;
+	}
+
+	// general case
+	q = p;
+	skipToken(q, end);
+	if (q == p)
+		return false;
+	std::istringstream iss(std::string(p, q));
+	iss.imbue(std::locale::classic());
+	iss >> v;
+	if (iss.fail())
+		return false;
+	p = q;
+	return true;
+}
+
+/**
+* split a text buffer in nbChunks parts that begin at the beginning of a line
+* @param bounds (out) the chunk i is [bounds[i], bounds[i+1][ (nbChunks + 1 values)
+*/
+CGoGN_UTILS_API void splitInChunks(const char* data, std::size_t size, unsigned int nbChunks, std::vector<std::size_t>& bounds);
+
+} // namespace TextParser
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
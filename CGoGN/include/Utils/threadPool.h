@@ -0,0 +1,183 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __CGOGN_THREAD_POOL__
+#define __CGOGN_THREAD_POOL__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <vector>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Pool of persistent threads used by the parallel traversals:
+* threads are created on first use and then sleep between jobs.
+* A job launched from a thread of the pool (nested parallelism) or while
+* the pool is busy runs on temporary threads instead.
+*/
+class CGoGN_UTILS_API ThreadPool
+{
+protected:
+	std::vector<std::thread> m_threads;
+
+	std::mutex m_runMutex;
+	std::mutex m_mutex;
+	std::condition_variable m_cvStart;
+	std::condition_variable m_cvEnd;
+
+	const std::function<void(unsigned int)>* m_job;
+	unsigned int m_nbJobThreads;
+	unsigned int m_nbRunning;
+	unsigned long long m_generation;
+	bool m_stop;
+
+	void workerLoop(unsigned int i);
+
+	ThreadPool(const ThreadPool&);
+	ThreadPool& operator=(const ThreadPool&);
+
+public:
+	ThreadPool();
+
+	~ThreadPool();
+
+	/**
+	* the pool shared by all parallel traversals
+	*/
+	static ThreadPool& getInstance();
+
+	/**
+	* execute job(i) for i in [0,nb), each on its own thread, and wait for all of them
+	* job(0) is executed by the calling thread, the others by the threads of the pool
+	*/
+	void run(unsigned int nb, const std::function<void(unsigned int)>& job);
+
+	/**
+	* number of threads currently created in the pool
+	*/
+	unsigned int getNbThreads() const { return (unsigned int)(m_threads.size()); }
+};
+
+
+/**
+* Range of chunks [0,nbChunks) shared by several threads: the range is first
+* split evenly, each thread then takes the chunks of its part from the front
+* and, when its part is empty, steals the upper half of the part of another thread.
+*/
+class WorkStealingRange
+{
+protected:
+	struct Part
+	{
+		std::atomic<unsigned long long> range; // first chunk in high bits, end in low bits
+		char padding[64 - sizeof(std::atomic<unsigned long long>)]; // one cache line per part
+	};
+
+	Part* m_parts;
+	unsigned int m_nbParts;
+
+	static unsigned long long pack(unsigned int b, unsigned int e) { return (static_cast<unsigned long long>(b) << 32) | e; }
+
+	WorkStealingRange(const WorkStealingRange&);
+	WorkStealingRange& operator=(const WorkStealingRange&);
+
+public:
+	WorkStealingRange(unsigned int nbChunks, unsigned int nbThreads) :
+		m_parts(new Part[nbThreads]),
+		m_nbParts(nbThreads)
+	{
+		for (unsigned int i = 0; i < nbThreads; ++i)
+		{
+			unsigned int b = (unsigned int)((unsigned long long)(nbChunks) * i / nbThreads);
+			unsigned int e = (unsigned int)((unsigned long long)(nbChunks) * (i + 1) / nbThreads);
+			m_parts[i].range.store(pack(b, e));
+		}
+	}
+
+	~WorkStealingRange()
+	{
+		delete[] m_parts;
+	}
+
+	/**
+	* get the next chunk to process for a thread
+	* @param thread index of the thread in [0,nbThreads)
+	* @param chunk (out) the chunk
+	* @return false when all chunks have been given
+	*/
+	bool next(unsigned int thread, unsigned int& chunk)
+	{
+		// own part first
+		std::atomic<unsigned long long>& own = m_parts[thread].range;
+		unsigned long long r = own.load();
+		while ((r >> 32) < (r & 0xffffffffULL))
+		{
+			if (own.compare_exchange_weak(r, r + (1ULL << 32)))
+			{
+				chunk = (unsigned int)(r >> 32);
+				return true;
+			}
+		}
+
+		// then steal from the others
+		for (unsigned int k = 1; k < m_nbParts; ++k)
+		{
+			std::atomic<unsigned long long>& victim = m_parts[(thread + k) % m_nbParts].range;
+			r = victim.load();
+			unsigned int b = (unsigned int)(r >> 32);
+			unsigned int e = (unsigned int)(r & 0xffffffffULL);
+			while (b < e)
+			{
+				unsigned int mid = b + (e - b) / 2;
+				if (victim.compare_exchange_weak(r, pack(b, mid)))
+				{
+					// own part is empty: nobody else modifies it
+					own.store(pack(mid + 1, e));
+					chunk = mid;
+					return true;
+				}
+				b = (unsigned int)(r >> 32);
+				e = (unsigned int)(r & 0xffffffffULL);
+			}
+		}
+
+		return false;
+	}
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
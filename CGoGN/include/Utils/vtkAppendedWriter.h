@@ -0,0 +1,147 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef _CGOGN_VTK_APPENDED_WRITER_H_
+#define _CGOGN_VTK_APPENDED_WRITER_H_
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <memory>
+#include <cstddef>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Writer of VTK XML files whose arrays are appended in binary after the xml
+* (AppendedData element, raw encoding, UInt64 headers), either uncompressed
+* or cut in blocks compressed in parallel by zlib (vtkZLibDataCompressor format).
+* The data of an array is given as a list of memory blocks (e.g. the blocks of
+* an attribute) that are written or compressed without any copy: they must stay
+* valid until write. The compressed blocks are written by batches, so that the
+* memory used does not depend on the size of the arrays.
+*/
+class CGoGN_UTILS_API VTKAppendedWriter
+{
+public:
+	enum Compression { RAW, ZLIB };
+
+	/**
+	* size of the blocks in which the arrays given as vectors are cut
+	*/
+	static const std::size_t BLOCK_SIZE = 1 << 20;
+
+protected:
+	struct Array
+	{
+		std::vector<std::pair<const char*, std::size_t> > blocks;
+		std::size_t blockSize;
+		std::size_t offsetPos; // position of the offset value in the xml
+	};
+
+	Compression m_compression;
+	unsigned int m_nbThreads;
+	int m_level;
+
+	std::string m_type;
+	std::string m_xml;
+	std::vector<Array> m_arrays;
+
+	// vectors given to dataArray, kept until write
+	std::vector<std::shared_ptr<void> > m_owned;
+
+	void addArray(const std::string& vtkType, const std::string& name, unsigned int nbComp, Array& a);
+
+	VTKAppendedWriter(const VTKAppendedWriter&);
+	VTKAppendedWriter& operator=(const VTKAppendedWriter&);
+
+public:
+	/**
+	* @param compression RAW or ZLIB
+	* @param nbThreads number of threads used for compression (0 for hardware concurrency)
+	* @param level zlib compression level (1: fastest)
+	*/
+	VTKAppendedWriter(Compression compression = ZLIB, unsigned int nbThreads = 0, int level = 1);
+
+	/**
+	* start the file (VTKFile element)
+	* @param type the type of dataset (UnstructuredGrid, PolyData...)
+	*/
+	void begin(const std::string& type);
+
+	/**
+	* add xml text (elements without data)
+	*/
+	void xml(const std::string& text);
+
+	/**
+	* add an appended DataArray element
+	* @param vtkType Float32/Int32/...
+	* @param name the name of the array
+	* @param nbComp number of components
+	* @param blocks addresses of the blocks of data, all of blockSize bytes but the last one
+	* @param blockSize size of the blocks in bytes
+	* @param nbBytes size of the data: the last used block may be partially written
+	*/
+	void dataArray(const std::string& vtkType, const std::string& name, unsigned int nbComp,
+				   const std::vector<void*>& blocks, std::size_t blockSize, std::size_t nbBytes);
+
+	/**
+	* add an appended DataArray element whose data is taken from a vector
+	* (swapped with an empty one, no copy)
+	*/
+	template <typename T>
+	void dataArray(const std::string& vtkType, const std::string& name, unsigned int nbComp, std::vector<T>& data)
+	{
+		std::shared_ptr<std::vector<T> > owned = std::make_shared<std::vector<T> >();
+		owned->swap(data);
+		m_owned.push_back(owned);
+
+		const std::size_t nbBytes = owned->size() * sizeof(T);
+		Array a;
+		a.blockSize = BLOCK_SIZE;
+		for (std::size_t pos = 0; pos < nbBytes; pos += BLOCK_SIZE)
+			a.blocks.push_back(std::make_pair(reinterpret_cast<const char*>(&(*owned)[0]) + pos, std::min(BLOCK_SIZE, nbBytes - pos)));
+		addArray(vtkType, name, nbComp, a);
+	}
+
+	/**
+	* close the xml and write the file with the data of the arrays
+	* @return true if ok
+	*/
+	bool write(const std::string& filename);
+};
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#endif
@@ -26,8 +26,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <new>
 
 #include "Topology/generic/dart.h"
+#include "Utils/compress.h"
 
 #define CGoGN_CONTAINER_DLL_EXPORT 1
 #include "Container/attributeContainer.h"
@@ -43,6 +47,8 @@ namespace CGoGN
 	m_size(0),
 	m_maxSize(0),
 	m_lineCost(0),
+	m_contiguousCapacity(0),
+	m_blockPool(NULL),
 	m_attributes_registry_map(NULL)
 {
 	m_holesBlocks.reserve(512);
@@ -154,6 +160,44 @@ namespace CGoGN
 	temp = m_lineCost;
 	m_lineCost = cont.m_lineCost;
 	cont.m_lineCost = temp;
+
+	temp = m_contiguousCapacity;
+	m_contiguousCapacity = cont.m_contiguousCapacity;
+	cont.m_contiguousCapacity = temp;
+
+	std::swap(m_blockPool, cont.m_blockPool);
+}
+
+bool AttributeContainer::setContiguousStorage(unsigned int maxNbLines)
+{
+	if (maxNbLines != 0 && (maxNbLines + _BLOCKSIZE_ - 1) / _BLOCKSIZE_ < m_holesBlocks.size())
+	{
+		CGoGNerr << "setContiguousStorage: " << maxNbLines << " lines is less than the current capacity" << CGoGNendl;
+		return false;
+	}
+
+	m_contiguousCapacity = maxNbLines;
+
+	bool ok = true;
+	for (std::vector<AttributeMultiVectorGen*>::iterator it = m_tableAttribs.begin(); it != m_tableAttribs.end(); ++it)
+	{
+		if (*it != NULL)
+			ok &= (*it)->setContiguous(maxNbLines);
+	}
+	return ok;
+}
+
+void AttributeContainer::setBlockPool(Utils::BlockPool* pool)
+{
+	m_blockPool = pool;
+
+	for (std::vector<AttributeMultiVectorGen*>::iterator it = m_tableAttribs.begin(); it != m_tableAttribs.end(); ++it)
+	{
+		if (*it != NULL)
+			(*it)->setBlockPool(pool);
+	}
+	for (std::vector<AttributeMultiVector<MarkerBool>*>::iterator it = m_tableMarkerAttribs.begin(); it != m_tableMarkerAttribs.end(); ++it)
+		(*it)->setBlockPool(pool);
 }
 
  void AttributeContainer::clear(bool removeAttrib)
@@ -298,6 +342,50 @@ namespace CGoGN
 }
 
 
+void AttributeContainer::permute(const std::vector<unsigned int>& order, std::vector<unsigned int>& mapOldNew)
+{
+	// new index of each used line
+	mapOldNew.clear();
+	mapOldNew.resize(realEnd(), 0xffffffff);
+	unsigned int nb = 0;
+	for (std::vector<unsigned int>::const_iterator it = order.begin(); it != order.end(); ++it)
+	{
+		assert(used(*it) || !"permute: order contains a hole");
+		if (mapOldNew[*it] == UNKNOWN)
+			mapOldNew[*it] = nb++;
+	}
+	for (unsigned int i = realBegin(); i != realEnd(); realNext(i))
+	{
+		if (mapOldNew[i] == UNKNOWN)
+			mapOldNew[i] = nb++;
+	}
+
+	// remove the holes, then move each line to its new place following the cycles of the permutation
+	std::vector<unsigned int> compactOldNew;
+	compact(compactOldNew);
+
+	std::vector<unsigned int> target(m_size);
+	for (unsigned int i = 0; i < mapOldNew.size(); ++i)
+	{
+		if (mapOldNew[i] != UNKNOWN)
+		{
+			unsigned int pos = (compactOldNew[i] == UNKNOWN) ? i : compactOldNew[i];
+			target[pos] = mapOldNew[i];
+		}
+	}
+
+	for (unsigned int i = 0; i < m_size; ++i)
+	{
+		while (target[i] != i)
+		{
+			unsigned int j = target[i];
+			swapLines(i, j);
+			std::swap(target[i], target[j]);
+		}
+	}
+}
+
+
 /**************************************
  *          LINES MANAGEMENT          *
  **************************************/
@@ -344,6 +432,13 @@ namespace CGoGN
 	// if no more rooms
 	if (m_tableBlocksWithFree.empty())
 	{
+		// contiguous storage full: fail before anything is changed
+		if (!canAddBlock())
+		{
+			CGoGNerr << "insertLine: contiguous storage full (" << m_contiguousCapacity << " lines)" << CGoGNendl;
+			throw std::bad_alloc();
+		}
+
 		HoleBlockRef* ptr = new HoleBlockRef();					// new block
 		unsigned int numBlock = uint32(m_holesBlocks.size());
 		m_tableBlocksWithFree.push_back(numBlock);	// add its future position to block_free
@@ -383,7 +478,8 @@ namespace CGoGN
 
 	if (ne == _BLOCKSIZE_-1)
 	{
-		if (bf == (m_holesBlocks.size()-1))
+		// (no block in advance if the contiguous storage is full)
+		if (bf == (m_holesBlocks.size()-1) && canAddBlock())
 		{
 			// we are filling the last line of capacity
 			HoleBlockRef* ptr = new HoleBlockRef();					// new block
@@ -582,7 +678,11 @@ namespace CGoGN
 	for (unsigned int i = 0; i < szHB; ++i)
 	{
 		m_holesBlocks[i] = new HoleBlockRef;
-		m_holesBlocks[i]->loadBin(fs);
+		if (!m_holesBlocks[i]->loadBin(fs))
+		{
+			CGoGNerr << "Corrupted hole blocks data" << CGoGNendl;
+			return false;
+		}
 	}
 
 	// les indices des blocks libres
@@ -592,6 +692,431 @@ namespace CGoGN
 	return true;
 }
 
+void AttributeContainer::saveBinRaw(std::ostream& fs, unsigned int id) const
+{
+	std::vector<AttributeMultiVectorGen*> bufferamv;
+	bufferamv.reserve(m_tableAttribs.size());
+	for(std::vector<AttributeMultiVectorGen*>::const_iterator it = m_tableAttribs.begin(); it != m_tableAttribs.end(); ++it)
+	{
+		if (*it != NULL)
+			bufferamv.push_back(*it);
+	}
+
+	// same header as saveBin
+	std::vector<unsigned int> bufferui;
+	bufferui.reserve(10);
+
+	bufferui.push_back(id);
+	bufferui.push_back(_BLOCKSIZE_);
+	bufferui.push_back(uint32(m_holesBlocks.size()));
+	bufferui.push_back(uint32(m_tableBlocksWithFree.size()));
+	bufferui.push_back(uint32(bufferamv.size()));
+	bufferui.push_back(m_size);
+	bufferui.push_back(m_maxSize);
+	bufferui.push_back(m_orbit);
+	bufferui.push_back(m_nbUnknown);
+
+	for(std::vector<AttributeMultiVector<MarkerBool>*>::const_iterator it = m_tableMarkerAttribs.begin(); it != m_tableMarkerAttribs.end(); ++it)
+	{
+		if ((*it)->getName()[0] == 'B') // for BoundaryMark0/1
+			bufferui[4]++;
+	}
+
+	fs.write(reinterpret_cast<const char*>(&bufferui[0]), bufferui.size()*sizeof(unsigned int));
+
+	unsigned int i = 0;
+
+	for(std::vector<AttributeMultiVector<MarkerBool>*>::const_iterator it = m_tableMarkerAttribs.begin(); it != m_tableMarkerAttribs.end(); ++it)
+	{
+		if ((*it)->getName()[0] == 'B') // for BoundaryMark0/1
+			(*it)->saveBinRaw(fs, i++);
+	}
+
+	for(std::vector<AttributeMultiVectorGen*>::const_iterator it = bufferamv.begin(); it != bufferamv.end(); ++it)
+		(*it)->saveBinRaw(fs, i++);
+
+	for (std::vector<HoleBlockRef*>::const_iterator it = m_holesBlocks.begin(); it != m_holesBlocks.end(); ++it)
+		(*it)->saveBin(fs);
+
+	if (!m_tableBlocksWithFree.empty())
+		fs.write(reinterpret_cast<const char*>(&m_tableBlocksWithFree[0]), m_tableBlocksWithFree.size() * sizeof(unsigned int));
+}
+
+unsigned int AttributeContainer::loadBinRawId(const Utils::MappedFile& mf, std::size_t& offset)
+{
+	unsigned int id = 0xffffffff;
+	mf.read(offset, &id, sizeof(unsigned int));
+	return id;
+}
+
+bool AttributeContainer::loadBinRaw(const std::shared_ptr<Utils::MappedFile>& mf, std::size_t& offset)
+{
+	if (m_attributes_registry_map == NULL)
+	{
+		CGoGNerr << "Attribute Registry non initialized"<< CGoGNendl;
+		return false;
+	}
+
+	unsigned int bufferui[8];
+	if (!mf->read(offset, bufferui, 8*sizeof(unsigned int)))
+	{
+		CGoGNerr << "Truncated file" << CGoGNendl;
+		return false;
+	}
+
+	unsigned int bs = bufferui[0];
+	unsigned int szHB = bufferui[1];
+	unsigned int szBWF = bufferui[2];
+	unsigned int nbAtt = bufferui[3];
+	m_size = bufferui[4];
+	m_maxSize = bufferui[5];
+	m_orbit = bufferui[6];
+	m_nbUnknown = bufferui[7];
+
+	if (bs != _BLOCKSIZE_)
+	{
+		CGoGNerr << "Loading unavailable, different block sizes: "<<_BLOCKSIZE_<<" / " << bs << CGoGNendl;
+		return false;
+	}
+
+	// the sizes are checked against the file before any allocation
+	if (m_size > m_maxSize || m_maxSize > (unsigned long long)(szHB) * _BLOCKSIZE_ || m_orbit >= NB_ORBITS || szBWF > szHB
+		|| (unsigned long long)(szHB) * _BLOCKSIZE_ * sizeof(unsigned int) > mf->size() - offset)
+	{
+		CGoGNerr << "Invalid container header" << CGoGNendl;
+		return false;
+	}
+
+	for (unsigned int j = 0; j < nbAtt; ++j)
+	{
+		std::string nameAtt;
+		std::string typeAtt;
+		if (AttributeMultiVectorGen::loadBinRawInfos(*mf, offset, nameAtt, typeAtt) == 0xffffffff)
+		{
+			CGoGNerr << "Truncated file" << CGoGNendl;
+			return false;
+		}
+
+		std::map<std::string, RegisteredBaseAttribute*>::iterator itAtt = m_attributes_registry_map->find(typeAtt);
+		bool ok;
+		if (itAtt == m_attributes_registry_map->end())
+		{
+			CGoGNout << "Skipping non registred attribute of type name"<< typeAtt <<CGoGNendl;
+			ok = AttributeMultiVectorGen::skipLoadBinRaw(*mf, offset);
+		}
+		else if (typeAtt == "MarkerBool")
+		{
+			// use j because BM are saved first
+			ok = j < m_tableMarkerAttribs.size() && m_tableMarkerAttribs[j]->loadBinRaw(mf, offset)
+				&& m_tableMarkerAttribs[j]->getNbBlocks() == szHB;
+		}
+		else
+		{
+			RegisteredBaseAttribute* ra = itAtt->second;
+			AttributeMultiVectorGen* amvg = ra->addAttribute(*this, nameAtt);
+			ok = amvg != NULL && amvg->loadBinRaw(mf, offset) && amvg->getNbBlocks() == szHB;
+		}
+		if (!ok)
+		{
+			CGoGNerr << "Error loading attribute " << nameAtt << CGoGNendl;
+			return false;
+		}
+	}
+
+	m_holesBlocks.resize(szHB);
+	for (unsigned int i = 0; i < szHB; ++i)
+	{
+		m_holesBlocks[i] = new HoleBlockRef;
+		if (!m_holesBlocks[i]->loadBinRaw(*mf, offset))
+		{
+			CGoGNerr << "Truncated file" << CGoGNendl;
+			return false;
+		}
+	}
+
+	m_tableBlocksWithFree.resize(szBWF);
+	if (szBWF > 0 && !mf->read(offset, &m_tableBlocksWithFree[0], szBWF*sizeof(unsigned int)))
+	{
+		CGoGNerr << "Truncated file" << CGoGNendl;
+		return false;
+	}
+	for (unsigned int i = 0; i < szBWF; ++i)
+	{
+		if (m_tableBlocksWithFree[i] >= szHB)
+		{
+			CGoGNerr << "Invalid table of blocks with free lines" << CGoGNendl;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * number of blocks compressed in the same zlib stream by saveBinChunked
+ */
+static const unsigned int CHUNK_NB_BLOCKS = 16;
+
+/**
+ * size of the pieces in which non block data are cut before compression
+ */
+static const std::size_t CHUNK_PIECE_SIZE = 65536;
+
+static void saveChunks(std::ostream& fs, const std::vector<std::pair<const char*, std::size_t> >& blocks, unsigned int nbThreads)
+{
+	std::vector<std::string> chunks;
+	Utils::zlibCompressGroups(blocks, CHUNK_NB_BLOCKS, chunks, nbThreads);
+
+	// index table then compressed data
+	unsigned int nbChunks = uint32(chunks.size());
+	fs.write(reinterpret_cast<const char*>(&nbChunks), sizeof(unsigned int));
+	std::vector<unsigned long long> sizes(nbChunks);
+	for (unsigned int i = 0; i < nbChunks; ++i)
+		sizes[i] = chunks[i].size();
+	if (nbChunks > 0)
+		fs.write(reinterpret_cast<const char*>(&sizes[0]), nbChunks * sizeof(unsigned long long));
+	for (unsigned int i = 0; i < nbChunks; ++i)
+		fs.write(chunks[i].data(), chunks[i].size());
+}
+
+static bool readChunks(std::istream& fs, std::vector<std::string>* chunks)
+{
+	unsigned int nbChunks = 0;
+	fs.read(reinterpret_cast<char*>(&nbChunks), sizeof(unsigned int));
+	std::vector<unsigned long long> sizes(nbChunks);
+	if (nbChunks > 0)
+		fs.read(reinterpret_cast<char*>(&sizes[0]), nbChunks * sizeof(unsigned long long));
+	if (!fs)
+		return false;
+
+	// skip without reading when chunks are not wanted
+	if (chunks == NULL)
+	{
+		unsigned long long total = 0;
+		for (unsigned int i = 0; i < nbChunks; ++i)
+			total += sizes[i];
+		fs.seekg(std::streamoff(total), std::ios::cur);
+		return bool(fs);
+	}
+
+	chunks->resize(nbChunks);
+	for (unsigned int i = 0; i < nbChunks; ++i)
+	{
+		(*chunks)[i].resize(std::size_t(sizes[i]));
+		if (sizes[i] > 0)
+			fs.read(&(*chunks)[i][0], std::streamsize(sizes[i]));
+	}
+	return bool(fs);
+}
+
+static void cutInPieces(char* data, std::size_t size, std::vector<std::pair<char*, std::size_t> >& pieces)
+{
+	pieces.clear();
+	for (std::size_t pos = 0; pos < size; pos += CHUNK_PIECE_SIZE)
+		pieces.push_back(std::make_pair(data + pos, std::min(CHUNK_PIECE_SIZE, size - pos)));
+}
+
+void AttributeContainer::saveBinChunked(std::ostream& fs, unsigned int id, unsigned int nbThreads) const
+{
+	// markers of boundary first, as in saveBin
+	std::vector<AttributeMultiVectorGen*> bufferamv;
+	bufferamv.reserve(m_tableAttribs.size() + m_tableMarkerAttribs.size());
+	for(std::vector<AttributeMultiVector<MarkerBool>*>::const_iterator it = m_tableMarkerAttribs.begin(); it != m_tableMarkerAttribs.end(); ++it)
+	{
+		if ((*it)->getName()[0] == 'B') // for BoundaryMark0/1
+			bufferamv.push_back(*it);
+	}
+	for(std::vector<AttributeMultiVectorGen*>::const_iterator it = m_tableAttribs.begin(); it != m_tableAttribs.end(); ++it)
+	{
+		if (*it != NULL)
+			bufferamv.push_back(*it);
+	}
+
+	unsigned int bufferui[9];
+	bufferui[0] = id;
+	bufferui[1] = _BLOCKSIZE_;
+	bufferui[2] = uint32(m_holesBlocks.size());
+	bufferui[3] = uint32(m_tableBlocksWithFree.size());
+	bufferui[4] = uint32(bufferamv.size());
+	bufferui[5] = m_size;
+	bufferui[6] = m_maxSize;
+	bufferui[7] = m_orbit;
+	bufferui[8] = m_nbUnknown;
+	fs.write(reinterpret_cast<const char*>(bufferui), 9*sizeof(unsigned int));
+
+	for (unsigned int i = 0; i < bufferamv.size(); ++i)
+	{
+		AttributeMultiVectorGen* amv = bufferamv[i];
+
+		unsigned int nbs[3];
+		nbs[0] = i;
+		nbs[1] = uint32(amv->getName().size()+1);
+		nbs[2] = uint32(amv->getTypeName().size()+1);
+		fs.write(reinterpret_cast<const char*>(nbs), 3*sizeof(unsigned int));
+		fs.write(amv->getName().c_str(), nbs[1]);
+		fs.write(amv->getTypeName().c_str(), nbs[2]);
+
+		std::vector<void*> addr;
+		unsigned int byteBlockSize;
+		nbs[0] = amv->getStorageBlocks(addr, byteBlockSize);
+		nbs[1] = byteBlockSize;
+		fs.write(reinterpret_cast<const char*>(nbs), 2*sizeof(unsigned int));
+
+		std::vector<std::pair<const char*, std::size_t> > blocks(addr.size());
+		for (unsigned int j = 0; j < addr.size(); ++j)
+			blocks[j] = std::make_pair(static_cast<const char*>(addr[j]), std::size_t(byteBlockSize));
+		saveChunks(fs, blocks, nbThreads);
+	}
+
+	// hole blocks are serialized in memory and compressed as a whole
+	std::ostringstream holes;
+	for (std::vector<HoleBlockRef*>::const_iterator it = m_holesBlocks.begin(); it != m_holesBlocks.end(); ++it)
+		(*it)->saveBin(holes);
+	std::string holesData = holes.str();
+	unsigned long long holesSize = holesData.size();
+	fs.write(reinterpret_cast<const char*>(&holesSize), sizeof(unsigned long long));
+
+	std::vector<std::pair<char*, std::size_t> > pieces;
+	cutInPieces(holesData.empty() ? NULL : &holesData[0], holesData.size(), pieces);
+	std::vector<std::pair<const char*, std::size_t> > cpieces(pieces.begin(), pieces.end());
+	saveChunks(fs, cpieces, nbThreads);
+
+	if (!m_tableBlocksWithFree.empty())
+		fs.write(reinterpret_cast<const char*>(&m_tableBlocksWithFree[0]), m_tableBlocksWithFree.size() * sizeof(unsigned int));
+}
+
+unsigned int AttributeContainer::loadBinChunkedId(std::istream& fs)
+{
+	unsigned int id = 0xffffffff;
+	fs.read(reinterpret_cast<char*>(&id), sizeof(unsigned int));
+	return id;
+}
+
+bool AttributeContainer::loadBinChunked(std::istream& fs, const std::vector<std::string>* attributeNames, unsigned int nbThreads)
+{
+	if (m_attributes_registry_map == NULL)
+	{
+		CGoGNerr << "Attribute Registry non initialized"<< CGoGNendl;
+		return false;
+	}
+
+	unsigned int bufferui[8];
+	fs.read(reinterpret_cast<char*>(bufferui), 8*sizeof(unsigned int));
+
+	unsigned int bs = bufferui[0];
+	unsigned int szHB = bufferui[1];
+	unsigned int szBWF = bufferui[2];
+	unsigned int nbAtt = bufferui[3];
+	m_size = bufferui[4];
+	m_maxSize = bufferui[5];
+	m_orbit = bufferui[6];
+	m_nbUnknown = bufferui[7];
+
+	if (!fs || bs != _BLOCKSIZE_)
+	{
+		CGoGNerr << "Loading unavailable, different block sizes: "<<_BLOCKSIZE_<<" / " << bs << CGoGNendl;
+		return false;
+	}
+
+	std::vector<std::string> chunks;
+	for (unsigned int j = 0; j < nbAtt; ++j)
+	{
+		unsigned int nbs[3];
+		fs.read(reinterpret_cast<char*>(nbs), 3*sizeof(unsigned int));
+		std::string names(nbs[1] + nbs[2], '\0');
+		fs.read(&names[0], names.size());
+		std::string nameAtt(names.c_str());
+		std::string typeAtt(names.c_str() + nbs[1]);
+
+		fs.read(reinterpret_cast<char*>(nbs), 2*sizeof(unsigned int));
+		unsigned int nbBlocks = nbs[0];
+		unsigned int byteBlockSize = nbs[1];
+		if (!fs)
+		{
+			CGoGNerr << "Truncated file" << CGoGNendl;
+			return false;
+		}
+
+		AttributeMultiVectorGen* amvg = NULL;
+		std::map<std::string, RegisteredBaseAttribute*>::iterator itAtt = m_attributes_registry_map->find(typeAtt);
+		if (itAtt == m_attributes_registry_map->end())
+		{
+			CGoGNout << "Skipping non registred attribute of type name"<< typeAtt <<CGoGNendl;
+		}
+		else if (typeAtt == "MarkerBool")
+		{
+			assert(j<m_tableMarkerAttribs.size());
+			amvg = m_tableMarkerAttribs[j]; // use j because BM are saved first
+		}
+		else if (attributeNames == NULL || std::find(attributeNames->begin(), attributeNames->end(), nameAtt) != attributeNames->end())
+		{
+			amvg = itAtt->second->addAttribute(*this, nameAtt);
+		}
+
+		if (amvg == NULL)
+		{
+			if (!readChunks(fs, NULL))
+				return false;
+			continue;
+		}
+
+		if (!readChunks(fs, &chunks))
+		{
+			CGoGNerr << "Truncated file" << CGoGNendl;
+			return false;
+		}
+
+		amvg->setNbBlocks(nbBlocks);
+		std::vector<void*> addr;
+		unsigned int localByteBlockSize;
+		amvg->getStorageBlocks(addr, localByteBlockSize);
+		if (localByteBlockSize != byteBlockSize)
+		{
+			CGoGNerr << "Wrong block size for attribute " << nameAtt << CGoGNendl;
+			return false;
+		}
+
+		std::vector<std::pair<char*, std::size_t> > blocks(addr.size());
+		for (unsigned int k = 0; k < addr.size(); ++k)
+			blocks[k] = std::make_pair(static_cast<char*>(addr[k]), std::size_t(byteBlockSize));
+		if (!Utils::zlibUncompressGroups(chunks, blocks, CHUNK_NB_BLOCKS, nbThreads))
+		{
+			CGoGNerr << "Corrupted data for attribute " << nameAtt << CGoGNendl;
+			return false;
+		}
+	}
+
+	// hole blocks
+	unsigned long long holesSize = 0;
+	fs.read(reinterpret_cast<char*>(&holesSize), sizeof(unsigned long long));
+	std::string holesData(std::size_t(holesSize), '\0');
+	std::vector<std::pair<char*, std::size_t> > pieces;
+	cutInPieces(holesData.empty() ? NULL : &holesData[0], holesData.size(), pieces);
+	if (!readChunks(fs, &chunks) || !Utils::zlibUncompressGroups(chunks, pieces, CHUNK_NB_BLOCKS, nbThreads))
+	{
+		CGoGNerr << "Corrupted hole blocks data" << CGoGNendl;
+		return false;
+	}
+
+	std::istringstream holes(holesData);
+	m_holesBlocks.resize(szHB);
+	for (unsigned int i = 0; i < szHB; ++i)
+	{
+		m_holesBlocks[i] = new HoleBlockRef;
+		if (!m_holesBlocks[i]->loadBin(holes))
+		{
+			CGoGNerr << "Corrupted hole blocks data" << CGoGNendl;
+			return false;
+		}
+	}
+
+	m_tableBlocksWithFree.resize(szBWF);
+	if (szBWF > 0)
+		fs.read(reinterpret_cast<char*>(&(m_tableBlocksWithFree[0])), szBWF*sizeof(unsigned int));
+
+	return bool(fs);
+}
+
  void  AttributeContainer::copyFrom(const AttributeContainer& cont)
 {
 // 	clear is done from the map
@@ -602,6 +1127,7 @@ namespace CGoGN
 	m_nbUnknown = cont.m_nbUnknown;
 	m_nbAttributes = cont.m_nbAttributes;
 	m_lineCost = cont.m_lineCost;
+	m_contiguousCapacity = cont.m_contiguousCapacity;
 
 	// blocks
 	unsigned int sz = uint32(cont.m_holesBlocks.size());
@@ -635,9 +1161,11 @@ namespace CGoGN
 		if (cont.m_tableAttribs[i] != NULL)
 		{
 			AttributeMultiVectorGen* ptr = cont.m_tableAttribs[i]->new_obj();
+			ptr->setBlockPool(m_blockPool);
 			ptr->setName(cont.m_tableAttribs[i]->getName());
 			ptr->setOrbit(cont.m_tableAttribs[i]->getOrbit());
 			ptr->setIndex(uint32(m_tableAttribs.size()));
+			ptr->setContiguous(cont.m_tableAttribs[i]->getContiguousCapacity());
 			ptr->setNbBlocks(cont.m_tableAttribs[i]->getNbBlocks());
 			ptr->copy(cont.m_tableAttribs[i]);
 			m_tableAttribs.push_back(ptr);
@@ -647,6 +1175,7 @@ namespace CGoGN
 	for (unsigned int i = 0; i < sz; ++i)
 	{
 		AttributeMultiVector<MarkerBool>* ptr = new AttributeMultiVector<MarkerBool>;
+		ptr->setBlockPool(m_blockPool);
 		ptr->setTypeName(cont.m_tableMarkerAttribs[i]->getTypeName());
 		ptr->setName(cont.m_tableMarkerAttribs[i]->getName());
 		ptr->setOrbit(cont.m_tableMarkerAttribs[i]->getOrbit());
@@ -797,6 +1326,7 @@ namespace CGoGN
 
 	// create the new attribute
 	AttributeMultiVector<MarkerBool>* amv = new AttributeMultiVector<MarkerBool>(attribName, "MarkerBool") ;
+	amv->setBlockPool(m_blockPool) ;
 
 	index = uint32(m_tableMarkerAttribs.size()) ;
 	m_tableMarkerAttribs.push_back(amv) ;
@@ -150,7 +150,7 @@ bool HoleBlockRef::updateHoles(unsigned int nb)
 	return notfull;
 }
 
-void HoleBlockRef::saveBin(CGoGNostream& fs)
+void HoleBlockRef::saveBin(std::ostream& fs)
 {
 //	CGoGNout << "save bf "<< m_nb<< " / "<< m_nbref<< " / "<< m_nbfree << CGoGNendl;
 
@@ -168,11 +168,32 @@ void HoleBlockRef::saveBin(CGoGNostream& fs)
 	fs.write(reinterpret_cast<const char*>(m_tableFree), m_nbfree*sizeof(unsigned int));
 }
 
-bool HoleBlockRef::loadBin(CGoGNistream& fs)
+/**
+* the numbers read from a file are used as sizes and indices: check them
+* (nb used lines, size of the table of refs, nb free lines)
+*/
+static bool validNumbers(const unsigned int* numbers)
+{
+	return numbers[1] <= _BLOCKSIZE_ && numbers[0] <= numbers[1] && numbers[2] <= numbers[1];
+}
+
+bool HoleBlockRef::validTableFree() const
+{
+	for (unsigned int i = 0; i < m_nbfree; ++i)
+	{
+		if (m_tableFree[i] >= m_nbref)
+			return false;
+	}
+	return true;
+}
+
+bool HoleBlockRef::loadBin(std::istream& fs)
 {
 	unsigned int numbers[3];
 
 	fs.read(reinterpret_cast<char*>(numbers), 3*sizeof(unsigned int));
+	if (!fs || !validNumbers(numbers))
+		return false;
 	m_nb = numbers[0];
 	m_nbref = numbers[1];
 	m_nbfree = numbers[2];
@@ -180,7 +201,22 @@ bool HoleBlockRef::loadBin(CGoGNistream& fs)
 	fs.read(reinterpret_cast<char*>(m_refCount), _BLOCKSIZE_*sizeof(unsigned int));
 	fs.read(reinterpret_cast<char*>(m_tableFree), m_nbfree*sizeof(unsigned int));
 
-	return true;
+	return bool(fs) && validTableFree();
+}
+
+bool HoleBlockRef::loadBinRaw(const Utils::MappedFile& mf, std::size_t& offset)
+{
+	unsigned int numbers[3];
+
+	if (!mf.read(offset, numbers, 3*sizeof(unsigned int)) || !validNumbers(numbers))
+		return false;
+	m_nb = numbers[0];
+	m_nbref = numbers[1];
+	m_nbfree = numbers[2];
+
+	return mf.read(offset, m_refCount, _BLOCKSIZE_*sizeof(unsigned int))
+		&& mf.read(offset, m_tableFree, m_nbfree*sizeof(unsigned int))
+		&& validTableFree();
 }
 
 } // namespace CGoGN
@@ -49,32 +49,51 @@ std::map<std::string, RegisteredBaseAttribute*>* GenericMap::m_attributes_regist
 
 std::vector<GenericMap*>*  GenericMap::s_instances = NULL;
 
+/// source of unique map identifiers (0 means no map)
+static std::atomic<unsigned long long> s_nextMapId(1);
+
+namespace
+{
+/// thread index of the current thread in a recently used map
+struct ThreadIndexCache
+{
+	unsigned long long mapId;
+	unsigned int version;
+	unsigned int index;
+	GenericMap::ThreadResources* resources;
+};
+
+const unsigned int THREAD_INDEX_CACHE_SIZE = 4;
+}
+
+static thread_local ThreadIndexCache s_threadIndexCache[THREAD_INDEX_CACHE_SIZE] = {};
+static thread_local unsigned int s_threadIndexCacheNext = 0;
+
 GenericMap::GenericMap():
+	m_threadIdsVersion(0),
+	m_mapId(s_nextMapId++),
 	m_nextMarkerId(0),
 	m_authorizeExternalThreads(false),
-	m_manipulator(NULL)
+	m_manipulator(NULL),
+	m_topologyVersion(0)
 {
 	if(m_attributes_registry_map == NULL)
 		initAllStatics(NULL); // no need here to store the pointers
 
 	s_instances->push_back(this);
 
-	m_thread_ids.reserve(NB_THREADS + 1);
 	m_thread_ids.push_back(std::this_thread::get_id());
+	reserveThreadResources(1);
 
 	for(unsigned int i = 0; i < NB_ORBITS; ++i)
 	{
 		m_attribs[i].setOrbit(i) ;
 		m_attribs[i].setRegistry(m_attributes_registry_map) ;
-	}
-
-	for(unsigned int i = 0; i < NB_THREADS; ++i)
-	{
-		s_vdartsBuffers[i].reserve(8);
-		s_vintsBuffers[i].reserve(8);
-
-//		for(unsigned int j = 0; j < NB_ORBITS; ++j)
-//			m_markVectors_free[i][j].reserve(8);
+		for(unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			m_quickLocalIncidentTraversal[i][j] = NULL ;
+			m_quickLocalAdjacentTraversal[i][j] = NULL ;
+		}
 	}
 
 	init();
@@ -142,6 +161,12 @@ GenericMap::~GenericMap()
 	{
 		if(isOrbitEmbedded(i))
 			m_attribs[i].clear(true) ;
+
+		for(unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			delete m_quickLocalIncidentTraversal[i][j] ;
+			delete m_quickLocalAdjacentTraversal[i][j] ;
+		}
 	}
 
 	for(std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*>::iterator it = attributeHandlers.begin(); it != attributeHandlers.end(); ++it)
@@ -153,6 +178,20 @@ GenericMap::~GenericMap()
 	*it = s_instances->back();
 	s_instances->pop_back();
 
+	for (std::vector<ThreadResources*>::iterator itr = m_threadResources.begin(); itr != m_threadResources.end(); ++itr)
+	{
+		for (auto itb = (*itr)->dartsBuffers.begin(); itb != (*itr)->dartsBuffers.end(); ++itb)
+			delete *itb;
+		for (auto itb = (*itr)->uintsBuffers.begin(); itb != (*itr)->uintsBuffers.end(); ++itb)
+			delete *itb;
+		for (unsigned int i = 0; i < NB_ORBITS; ++i)
+		{
+			for (auto ite = (*itr)->epochVectorsFree[i].begin(); ite != (*itr)->epochVectorsFree[i].end(); ++ite)
+				delete *ite;
+		}
+		delete *itr;
+	}
+
 	// clean type registry if necessary
 
 //	if (s_instances->size() == 0)
@@ -202,6 +241,66 @@ bool GenericMap::releaseManipulate(MapManipulator* ptr)
 	return true;
 }
 
+/****************************************
+ *           THREADS MANAGEMENT         *
+ ****************************************/
+
+unsigned int GenericMap::lookupCurrentThread(ThreadResources*& res) const
+{
+	// indices of the last used maps are cached in the thread
+	unsigned int version = m_threadIdsVersion.load();
+	for (unsigned int i = 0; i < THREAD_INDEX_CACHE_SIZE; ++i)
+	{
+		const ThreadIndexCache& c = s_threadIndexCache[i];
+		if (c.mapId == m_mapId && c.version == version)
+		{
+			res = c.resources;
+			return c.index;
+		}
+	}
+
+	std::thread::id id = std::this_thread::get_id();
+	std::lock_guard<std::mutex> lock(m_threadIdsMutex);
+	version = m_threadIdsVersion.load();
+
+	unsigned int index = uint32(std::find(m_thread_ids.begin(), m_thread_ids.end(), id) - m_thread_ids.begin());
+	if (index == m_thread_ids.size())
+	{
+		if (!m_authorizeExternalThreads)
+		{
+			res = NULL;
+			return -1;
+		}
+		m_thread_ids.push_back(id);
+	}
+	reserveThreadResources(index + 1);
+	res = m_threadResources[index];
+
+	// replace the outdated entry of this map, or the oldest one
+	unsigned int entry = s_threadIndexCacheNext;
+	for (unsigned int i = 0; i < THREAD_INDEX_CACHE_SIZE; ++i)
+	{
+		if (s_threadIndexCache[i].mapId == m_mapId)
+			entry = i;
+	}
+	if (entry == s_threadIndexCacheNext)
+		s_threadIndexCacheNext = (s_threadIndexCacheNext + 1) % THREAD_INDEX_CACHE_SIZE;
+
+	ThreadIndexCache& c = s_threadIndexCache[entry];
+	c.mapId = m_mapId;
+	c.version = version;
+	c.index = index;
+	c.resources = res;
+
+	return index;
+}
+
+void GenericMap::reserveThreadResources(unsigned int nb) const
+{
+	while (m_threadResources.size() < nb)
+		m_threadResources.push_back(new ThreadResources);
+}
+
 void GenericMap::init(bool addBoundaryMarkers)
 {
 	for(unsigned int i = 0; i < NB_ORBITS; ++i)
@@ -212,12 +311,21 @@ void GenericMap::init(bool addBoundaryMarkers)
 
 		for(unsigned int j = 0; j < NB_ORBITS; ++j)
 		{
+			delete m_quickLocalIncidentTraversal[i][j] ;
+			delete m_quickLocalAdjacentTraversal[i][j] ;
 			m_quickLocalIncidentTraversal[i][j] = NULL ;
 			m_quickLocalAdjacentTraversal[i][j] = NULL ;
 		}
 
-		for(unsigned int j = 0; j < NB_THREADS; ++j)
-			m_markVectors_free[i][j].clear();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_threadIdsMutex);
+		for (std::vector<ThreadResources*>::iterator it = m_threadResources.begin(); it != m_threadResources.end(); ++it)
+		{
+			for(unsigned int i = 0; i < NB_ORBITS; ++i)
+				(*it)->markVectorsFree[i].clear();
+		}
 	}
 
 	if (addBoundaryMarkers)
@@ -233,6 +341,8 @@ void GenericMap::init(bool addBoundaryMarkers)
 
 void GenericMap::clear(bool removeAttrib)
 {
+	topologyChanged();
+
 	if (removeAttrib)
 	{
 #ifndef NDEBUG
@@ -255,6 +365,8 @@ void GenericMap::clear(bool removeAttrib)
 
 void GenericMap::swapEmbeddingContainers(unsigned int orbit1, unsigned int orbit2)
 {
+	topologyChanged();
+
 	assert(orbit1 != orbit2 || !"Cannot swap a container with itself") ;
 	assert((orbit1 != DART && orbit2 != DART) || !"Cannot swap the darts container") ;
 
@@ -367,8 +479,34 @@ void GenericMap::printDartsTable()
  *             SAVE & LOAD              *
  ****************************************/
 
+bool GenericMap::saveMapBinRaw(const std::string& /*filename*/) const
+{
+	CGoGNerr << "saveMapBinRaw not available for " << mapTypeName() << CGoGNendl;
+	return false;
+}
+
+bool GenericMap::loadMapBinRaw(const std::string& /*filename*/)
+{
+	CGoGNerr << "loadMapBinRaw not available for " << mapTypeName() << CGoGNendl;
+	return false;
+}
+
+bool GenericMap::saveMapBinChunked(const std::string& /*filename*/, unsigned int /*nbThreads*/) const
+{
+	CGoGNerr << "saveMapBinChunked not available for " << mapTypeName() << CGoGNendl;
+	return false;
+}
+
+bool GenericMap::loadMapBinChunked(const std::string& /*filename*/, const std::vector<std::string>& /*attributeNames*/, unsigned int /*nbThreads*/)
+{
+	CGoGNerr << "loadMapBinChunked not available for " << mapTypeName() << CGoGNendl;
+	return false;
+}
+
 void GenericMap::restore_shortcuts()
 {
+	topologyChanged();
+
 	// EMBEDDING
 
 	// get container of dart orbit
@@ -407,14 +545,13 @@ void GenericMap::restore_shortcuts()
 	{
 		AttributeContainer& cont = m_attribs[orbit];
 		m_quickTraversal[orbit] = cont.getDataVector<Dart>("quick_traversal") ;
+		// local quick traversal tables are not saved: they must be enabled again after loading
 		for(unsigned int j = 0; j < NB_ORBITS; ++j)
 		{
-			std::stringstream ss;
-			ss << "quickLocalIncidentTraversal_" << j;
-			m_quickLocalIncidentTraversal[orbit][j] = cont.getDataVector< NoTypeNameAttribute<std::vector<Dart> > >(ss.str()) ;
-			std::stringstream ss2;
-			ss2 << "quickLocalAdjacentTraversal_" << j;
-			m_quickLocalAdjacentTraversal[orbit][j] = cont.getDataVector< NoTypeNameAttribute<std::vector<Dart> > >(ss2.str()) ;
+			delete m_quickLocalIncidentTraversal[orbit][j] ;
+			delete m_quickLocalAdjacentTraversal[orbit][j] ;
+			m_quickLocalIncidentTraversal[orbit][j] = NULL ;
+			m_quickLocalAdjacentTraversal[orbit][j] = NULL ;
 		}
 	}
 
@@ -467,6 +604,8 @@ void GenericMap::dumpAttributesAndMarkers()
 
 void GenericMap::compact(bool topoOnly)
 {
+	topologyChanged();
+
 	compactTopo();
 
 	if (topoOnly)
@@ -492,6 +631,8 @@ void GenericMap::compact(bool topoOnly)
 
 void GenericMap::compactOrbitContainer(unsigned int orbit, float frag)
 {
+	topologyChanged();
+
 	std::vector<unsigned int> oldnew;
 
 	if (isOrbitEmbedded(orbit) && (fragmentation(orbit)< frag))
@@ -507,9 +648,24 @@ void GenericMap::compactOrbitContainer(unsigned int orbit, float frag)
 	}
 }
 
+std::size_t GenericMap::fragmentationBytes() const
+{
+	std::size_t nb = 0;
+	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+		nb += m_attribs[orbit].fragmentationBytes();
+	return nb;
+}
+
+void GenericMap::setBlockPool(Utils::BlockPool* pool)
+{
+	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+		m_attribs[orbit].setBlockPool(pool);
+}
 
 void GenericMap::compactIfNeeded(float frag, bool topoOnly)
 {
+	topologyChanged();
+
 	if (fragmentation(DART)< frag)
 		compactTopo();
 
@@ -534,6 +690,48 @@ void GenericMap::compactIfNeeded(float frag, bool topoOnly)
 	}
 }
 
+void GenericMap::reorder(const std::vector<unsigned int>& dartOrder)
+{
+	topologyChanged();
+
+	AttributeContainer& dartCont = m_attribs[DART];
+
+	std::vector<unsigned int> order;
+	std::vector<unsigned int> oldnew;
+
+	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+	{
+		if ((orbit != DART) && (isOrbitEmbedded(orbit)))
+		{
+			// cells in the order of their first dart
+			AttributeContainer& cont = m_attribs[orbit];
+			AttributeMultiVector<unsigned int>* emb = m_embeddings[orbit];
+			std::vector<bool> found(cont.realEnd(), false);
+			order.clear();
+			order.reserve(cont.size());
+			for (std::vector<unsigned int>::const_iterator it = dartOrder.begin(); it != dartOrder.end(); ++it)
+			{
+				unsigned int idx = (*emb)[*it];
+				if ((idx != EMBNULL) && !found[idx])
+				{
+					found[idx] = true;
+					order.push_back(idx);
+				}
+			}
+
+			cont.permute(order, oldnew);
+			for (unsigned int i = dartCont.realBegin(); i != dartCont.realEnd(); dartCont.realNext(i))
+			{
+				unsigned int& idx = emb->operator[](i);
+				if (idx != EMBNULL)
+					idx = oldnew[idx];
+			}
+		}
+	}
+
+	// embeddings are stored in the DART container: they follow the darts
+	reorderTopo(dartOrder);
+}
 
 void GenericMap::dumpCSV() const
 {
@@ -548,6 +746,8 @@ void GenericMap::dumpCSV() const
 
 void GenericMap::moveData(GenericMap &mapf)
 {
+	topologyChanged();
+
 	GenericMap::init(false);
 
 	for (unsigned int i = 0; i < NB_ORBITS; ++i)
@@ -564,16 +764,22 @@ void GenericMap::moveData(GenericMap &mapf)
 			this->m_quickLocalAdjacentTraversal[i][j] = mapf.m_quickLocalAdjacentTraversal[i][j];
 			mapf.m_quickLocalIncidentTraversal[i][j] = NULL ;
 			mapf.m_quickLocalAdjacentTraversal[i][j] = NULL ;
+			// the tables follow their containers
+			if (this->m_quickLocalIncidentTraversal[i][j] != NULL)
+				this->m_quickLocalIncidentTraversal[i][j]->setContainer(this->m_attribs[i]) ;
+			if (this->m_quickLocalAdjacentTraversal[i][j] != NULL)
+				this->m_quickLocalAdjacentTraversal[i][j]->setContainer(this->m_attribs[i]) ;
 		}
 
-		for (unsigned int j = 0; j < NB_THREADS; ++j)
-			this->m_markVectors_free[i][j].swap(mapf.m_markVectors_free[i][j]);
 	}
 
-	for (unsigned int i = 0; i < NB_THREADS; ++i)
 	{
-		this->s_vdartsBuffers[i].swap(mapf.s_vdartsBuffers[i]);
-		this->s_vintsBuffers[i].swap(mapf.s_vintsBuffers[i]);
+		std::lock(m_threadIdsMutex, mapf.m_threadIdsMutex);
+		std::lock_guard<std::mutex> lock1(m_threadIdsMutex, std::adopt_lock);
+		std::lock_guard<std::mutex> lock2(mapf.m_threadIdsMutex, std::adopt_lock);
+		this->m_threadResources.swap(mapf.m_threadResources);
+		++this->m_threadIdsVersion;
+		++mapf.m_threadIdsVersion;
 	}
 
 	this->m_boundaryMarkers[0] = mapf.m_boundaryMarkers[0];
@@ -607,7 +813,7 @@ void GenericMap::garbageMarkVectors()
 					maxId = id;
 
 				amv->allFalse();
-				m_markVectors_free[orbit][0].push_back(amv);
+				m_threadResources[0]->markVectorsFree[orbit].push_back(amv);
 			}
 		}
 	}
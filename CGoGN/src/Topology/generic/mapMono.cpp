@@ -128,6 +128,198 @@ bool MapMono::loadMapBin(const std::string& filename)
 	return true;
 }
 
+/**
+ * version of the raw (mappable) binary format
+ */
+static const unsigned int RAW_MAP_VERSION = 1;
+
+bool MapMono::saveMapBinRaw(const std::string& filename) const
+{
+	std::ofstream fs(filename.c_str(), std::ios::out|std::ios::binary);
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for writing: " << filename << CGoGNendl;
+		return false;
+	}
+
+	// Entete
+	char buff[256];
+	for (int i = 0; i < 256; ++i)
+		buff[i] = char(255);
+
+	memcpy(buff, "CGoGN_RawMap", 13);
+
+	std::string mt = mapTypeName();
+	memcpy(buff+32, mt.c_str(), mt.size()+1);
+	unsigned int infos[3];
+	infos[0] = NB_ORBITS;
+	infos[1] = RAW_MAP_VERSION;
+	infos[2] = uint32(Utils::MappedFile::ALIGNMENT);
+	memcpy(buff+64, infos, 3*sizeof(unsigned int));
+	fs.write(buff, 256);
+
+	// save all attribs
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+		m_attribs[i].saveBinRaw(fs, i);
+
+	return fs.good();
+}
+
+bool MapMono::loadMapBinRaw(const std::string& filename)
+{
+	std::shared_ptr<Utils::MappedFile> mf(new Utils::MappedFile);
+	if (!mf->open(filename))
+	{
+		CGoGNerr << "Unable to open file for loading" << CGoGNendl;
+		return false;
+	}
+
+	// read info
+	char buff[256];
+	std::size_t offset = 0;
+	if (!mf->read(offset, buff, 256))
+	{
+		CGoGNerr << "Wrong binary file format" << CGoGNendl;
+		return false;
+	}
+
+	buff[31] = 0;
+	if (std::string(buff) != "CGoGN_RawMap")
+	{
+		CGoGNerr << "Wrong binary file format" << CGoGNendl;
+		return false;
+	}
+
+	buff[63] = 0;
+	std::string fileType(buff + 32);
+	std::string localType = this->mapTypeName();
+	if (fileType != localType)
+	{
+		CGoGNerr << "Not possible to load "<< fileType << " into " << localType << " object" << CGoGNendl;
+		return false;
+	}
+
+	unsigned int infos[3];
+	memcpy(infos, buff+64, 3*sizeof(unsigned int));
+	if (infos[0] != NB_ORBITS)
+	{
+		CGoGNerr << "Wrong max orbit number in file" << CGoGNendl;
+		return  false;
+	}
+	if (infos[1] != RAW_MAP_VERSION || infos[2] != Utils::MappedFile::ALIGNMENT)
+	{
+		CGoGNerr << "Unsupported raw map file version " << infos[1] << CGoGNendl;
+		return  false;
+	}
+
+	GenericMap::clear(true);
+
+	// load attrib container
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		unsigned int id = AttributeContainer::loadBinRawId(*mf, offset);
+		if (id >= NB_ORBITS || !m_attribs[id].loadBinRaw(mf, offset))
+		{
+			CGoGNerr << "Error while loading " << filename << CGoGNendl;
+			GenericMap::clear(true);
+			return false;
+		}
+	}
+
+	// restore shortcuts
+	GenericMap::restore_shortcuts();
+	restore_topo_shortcuts();
+
+	return true;
+}
+
+bool MapMono::saveMapBinChunked(const std::string& filename, unsigned int nbThreads) const
+{
+	std::ofstream fs(filename.c_str(), std::ios::out|std::ios::binary);
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for writing: " << filename << CGoGNendl;
+		return false;
+	}
+
+	// Entete
+	char buff[256];
+	for (int i = 0; i < 256; ++i)
+		buff[i] = char(255);
+
+	memcpy(buff, "CGoGN_ChunkMap", 15);
+
+	std::string mt = mapTypeName();
+	memcpy(buff+32, mt.c_str(), mt.size()+1);
+	unsigned int *buffi = reinterpret_cast<unsigned int*>(buff + 64);
+	*buffi = NB_ORBITS;
+	fs.write(buff, 256);
+
+	// save all attribs
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+		m_attribs[i].saveBinChunked(fs, i, nbThreads);
+
+	return fs.good();
+}
+
+bool MapMono::loadMapBinChunked(const std::string& filename, const std::vector<std::string>& attributeNames, unsigned int nbThreads)
+{
+	std::ifstream fs(filename.c_str(), std::ios::in|std::ios::binary);
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for loading" << CGoGNendl;
+		return false;
+	}
+
+	// read info
+	char buff[256];
+	fs.read(buff, 256);
+
+	buff[31] = 0;
+	if (!fs || std::string(buff) != "CGoGN_ChunkMap")
+	{
+		CGoGNerr << "Wrong binary file format" << CGoGNendl;
+		return false;
+	}
+
+	buff[63] = 0;
+	std::string fileType(buff + 32);
+	std::string localType = this->mapTypeName();
+	if (fileType != localType)
+	{
+		CGoGNerr << "Not possible to load "<< fileType << " into " << localType << " object" << CGoGNendl;
+		return false;
+	}
+
+	unsigned int *ptr_nbo = reinterpret_cast<unsigned int*>(buff + 64);
+	if (*ptr_nbo != NB_ORBITS)
+	{
+		CGoGNerr << "Wrong max orbit number in file" << CGoGNendl;
+		return  false;
+	}
+
+	GenericMap::clear(true);
+
+	// load attrib container (all dart attributes are needed for the topology)
+	const std::vector<std::string>* names = attributeNames.empty() ? NULL : &attributeNames;
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		unsigned int id = AttributeContainer::loadBinChunkedId(fs);
+		if (id >= NB_ORBITS || !m_attribs[id].loadBinChunked(fs, id == DART ? NULL : names, nbThreads))
+		{
+			CGoGNerr << "Error while loading " << filename << CGoGNendl;
+			GenericMap::clear(true);
+			return false;
+		}
+	}
+
+	// restore shortcuts
+	GenericMap::restore_shortcuts();
+	restore_topo_shortcuts();
+
+	return true;
+}
+
 bool MapMono::copyFrom(const GenericMap& map)
 {
 
@@ -224,6 +416,31 @@ void MapMono::compactTopo()
 	}
 }
 
+void MapMono::reorderTopo(const std::vector<unsigned int>& dartOrder)
+{
+	std::vector<unsigned int> oldnew;
+	m_attribs[DART].permute(dartOrder, oldnew);
+
+	for (unsigned int i = m_attribs[DART].realBegin(); i != m_attribs[DART].realEnd(); m_attribs[DART].realNext(i))
+	{
+		for (unsigned int j = 0; j < m_permutation.size(); ++j)
+		{
+			Dart& d = (*m_permutation[j])[i];
+			d = Dart(oldnew[d.index]);
+		}
+		for (unsigned int j = 0; j < m_permutation_inv.size(); ++j)
+		{
+			Dart& d = (*m_permutation_inv[j])[i];
+			d = Dart(oldnew[d.index]);
+		}
+		for (unsigned int j = 0; j < m_involution.size(); ++j)
+		{
+			Dart& d = (*m_involution[j])[i];
+			d = Dart(oldnew[d.index]);
+		}
+	}
+}
+
 
 
 } //namespace CGoGN
@@ -530,6 +530,24 @@ void MapMulti::compactTopo()
 	}
 }
 
+void MapMulti::reorderTopo(const std::vector<unsigned int>& dartOrder)
+{
+	// relations store MR darts: only the indices of darts at each level change
+	std::vector<unsigned int> oldnew;
+	m_attribs[DART].permute(dartOrder, oldnew);
+
+	unsigned int nbl = uint32(m_mrDarts.size());
+	for (unsigned int i = m_mrattribs.realBegin(); i != m_mrattribs.realEnd(); m_mrattribs.realNext(i))
+	{
+		for (unsigned int level = 0; level < nbl; ++level)
+		{
+			unsigned int& d = m_mrDarts[level]->operator[](i);
+			if (d != MRNULL)
+				d = oldnew[d];
+		}
+	}
+}
+
 
 void MapMulti::dumpCSV() const
 {
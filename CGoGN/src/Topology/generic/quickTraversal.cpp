@@ -0,0 +1,141 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#define CGoGN_TOPO_DLL_EXPORT 1
+
+#include <algorithm>
+
+#include "Topology/generic/quickTraversal.h"
+
+namespace CGoGN
+{
+
+/**
+ * size of the run of a list of nb darts: header + darts + NIL,
+ * rounded up so that each list can grow a little in place
+ */
+inline unsigned int runCapacity(unsigned int nb)
+{
+	return (nb + 2 + 4) & ~3u ;
+}
+
+QuickLocalTraversal::QuickLocalTraversal(AttributeContainer& cont, AttributeMultiVector<NoTypeNameAttribute<Range> >* ranges, CellTraversal traversal) :
+	m_cont(&cont),
+	m_ranges(ranges),
+	m_compactSize(2),
+	m_traversal(traversal)
+{
+	// run of the default range: empty list without owner
+	m_darts.push_back(NIL) ;
+	m_darts.push_back(NIL) ;
+}
+
+bool QuickLocalTraversal::owns(unsigned int emb) const
+{
+	const Range& r = (*m_ranges)[emb] ;
+	return r.capacity > 0 && r.begin < m_darts.size() && r.capacity <= m_darts.size() - r.begin && m_darts[r.begin].index == emb ;
+}
+
+void QuickLocalTraversal::allocate(unsigned int emb, unsigned int nb)
+{
+	Range& r = (*m_ranges)[emb] ;
+	r.begin = (unsigned int)(m_darts.size()) ;
+	r.capacity = runCapacity(nb) ;
+	m_darts.resize(m_darts.size() + r.capacity, NIL) ;
+	m_darts[r.begin] = Dart(emb) ;
+}
+
+void QuickLocalTraversal::build(GenericMap& map, const std::vector<std::pair<unsigned int, Dart> >& cells)
+{
+	m_darts.clear() ;
+	m_darts.push_back(NIL) ;
+	m_darts.push_back(NIL) ;
+
+	std::vector<Dart> buffer ;
+	buffer.reserve(128) ;
+	for (std::vector<std::pair<unsigned int, Dart> >::const_iterator it = cells.begin(); it != cells.end(); ++it)
+	{
+		buffer.clear() ;
+		m_traversal(map, it->second, buffer) ;
+		allocate(it->first, (unsigned int)(buffer.size())) ;
+		std::copy(buffer.begin(), buffer.end(), m_darts.begin() + (*m_ranges)[it->first].begin + 1) ;
+	}
+
+	m_compactSize = (unsigned int)(m_darts.size()) ;
+}
+
+void QuickLocalTraversal::update(GenericMap& map, unsigned int emb, Dart d, std::vector<Dart>& buffer)
+{
+	buffer.clear() ;
+	m_traversal(map, d, buffer) ;
+
+	// the range of a new cell may be uninitialized or copied from another cell:
+	// the run is reused only if its header designates the cell
+	Range& r = (*m_ranges)[emb] ;
+	bool owned = owns(emb) ;
+	if (!owned || buffer.size() + 2 > r.capacity)
+	{
+		if (owned)
+			m_darts[r.begin] = NIL ; // lost until next compaction
+		allocate(emb, (unsigned int)(buffer.size())) ;
+	}
+
+	std::vector<Dart>::iterator it = std::copy(buffer.begin(), buffer.end(), m_darts.begin() + r.begin + 1) ;
+	*it = NIL ;
+
+	if (m_darts.size() > 2 * m_compactSize + 1024)
+		compact() ;
+}
+
+void QuickLocalTraversal::compact()
+{
+	std::vector<Dart> darts ;
+	darts.reserve(m_compactSize + m_compactSize / 2) ;
+	darts.push_back(NIL) ;
+	darts.push_back(NIL) ;
+
+	for (unsigned int i = m_cont->begin(); i != m_cont->end(); m_cont->next(i))
+	{
+		Range& r = (*m_ranges)[i] ;
+		if (owns(i))
+		{
+			unsigned int nb = 0 ;
+			while (m_darts[r.begin + 1 + nb] != NIL)
+				++nb ;
+			unsigned int b = (unsigned int)(darts.size()) ;
+			darts.insert(darts.end(), m_darts.begin() + r.begin, m_darts.begin() + r.begin + 1 + nb) ;
+			r.begin = b ;
+			r.capacity = runCapacity(nb) ;
+			darts.resize(b + r.capacity, NIL) ;
+		}
+		else
+			r = Range() ;
+	}
+
+	m_darts.swap(darts) ;
+	m_compactSize = (unsigned int)(m_darts.size()) ;
+}
+
+} // namespace CGoGN
@@ -29,6 +29,7 @@
 
 #include "Topology/map/embeddedMap2.h"
 #include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/dartmarker.h"
 
 namespace CGoGN
 {
@@ -129,6 +130,8 @@ void EmbeddedMap2::splitVertex(Dart d, Dart e)
 		initDartEmbedding<FACE>(phi1(dd), getEmbedding<FACE>(dd)) ;
 		initDartEmbedding<FACE>(phi1(ee), getEmbedding<FACE>(ee)) ;
 	}
+
+	updateQuickTraversalsInFaces(phi2(d), phi2(e)) ;
 }
 
 Dart EmbeddedMap2::deleteVertex(Dart d)
@@ -140,6 +143,8 @@ Dart EmbeddedMap2::deleteVertex(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, f, getEmbedding<FACE>(f)) ;
 		}
+
+		updateQuickTraversalsInFaces(f) ;
 	}
 	return f ;
 }
@@ -186,6 +191,8 @@ Dart EmbeddedMap2::cutEdge(Dart d)
 		initDartEmbedding<FACE>(phi1(e), getEmbedding<FACE>(e)) ;
 	}
 
+	updateQuickTraversalsInFaces(d, phi2(d)) ;
+
 	return nd;
 }
 
@@ -197,6 +204,7 @@ bool EmbeddedMap2::uncutEdge(Dart d)
 		{
 			copyDartEmbedding<EDGE>(phi2(d), d) ;
 		}
+		updateQuickTraversalsInFaces(d, phi2(d)) ;
 		return true ;
 	}
 	return false ;
@@ -265,7 +273,15 @@ Dart EmbeddedMap2::collapseEdge(Dart d, bool delDegenerateFaces)
 	{
 		Algo::Topo::setOrbitEmbedding<VERTEX>(*this, dV, vEmb) ;
 	}
-	
+
+	// the faces around the resulting vertex contain all the modified darts
+	if (hasQuickTraversal())
+	{
+		std::vector<Dart> darts ;
+		foreach_dart_of_orbit(Vertex(dV), [&] (Dart e) { darts.push_back(e) ; }) ;
+		updateQuickTraversalsInFaces(darts) ;
+	}
+
 	return dV ;
 }
 
@@ -287,6 +303,8 @@ bool EmbeddedMap2::flipEdge(Dart d)
 			copyDartEmbedding<FACE>(phi_1(e), e) ;
 		}
 
+		updateQuickTraversalsInFaces(d, e) ;
+
 		return true ;
 	}
 	return false ;
@@ -310,6 +328,8 @@ bool EmbeddedMap2::flipBackEdge(Dart d)
 			copyDartEmbedding<FACE>(phi1(e), e) ;
 		}
 
+		updateQuickTraversalsInFaces(d, e) ;
+
 		return true ;
 	}
 	return false ;
@@ -502,6 +522,8 @@ void EmbeddedMap2::splitFace(Dart d, Dart e)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<FACE>(*this, e) ;
 		Algo::Topo::copyCellAttributes<FACE>(*this, e, d) ;
 	}
+
+	updateQuickTraversalsInFaces(d, e) ;
 }
 
 bool EmbeddedMap2::mergeFaces(Dart d)
@@ -514,6 +536,7 @@ bool EmbeddedMap2::mergeFaces(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, dNext, getEmbedding<FACE>(dNext)) ;
 		}
+		updateQuickTraversalsInFaces(dNext) ;
 		return true ;
 	}
 	return false ;
@@ -644,6 +667,33 @@ unsigned int EmbeddedMap2::closeHole(Dart d, bool forboundary)
 	return nbE ;
 }
 
+void EmbeddedMap2::updateQuickTraversalsInFaces(const std::vector<Dart>& darts)
+{
+	if (!hasQuickTraversal())
+		return ;
+
+	DartMarkerStore<EmbeddedMap2> mark(*this) ;
+	for (std::vector<Dart>::const_iterator it = darts.begin(); it != darts.end(); ++it)
+	{
+		if (!mark.isMarked(*it))
+			mark.markOrbit(Face(*it)) ;
+	}
+
+	updateQuickTraversals(mark.getDartVector()) ;
+}
+
+void EmbeddedMap2::updateQuickTraversalsInFaces(Dart d, Dart e)
+{
+	if (!hasQuickTraversal())
+		return ;
+
+	std::vector<Dart> darts ;
+	darts.push_back(d) ;
+	if (e != NIL)
+		darts.push_back(e) ;
+	updateQuickTraversalsInFaces(darts) ;
+}
+
 bool EmbeddedMap2::check()
 {
 	bool topo = Map2::check() ;
@@ -129,6 +129,8 @@ Dart EmbeddedMap3::cutEdge(Dart d)
 		} while(f != d);
 	}
 
+	updateQuickTraversalsAround(d, nd, phi1(nd));
+
 	return nd ;
 }
 
@@ -141,6 +143,7 @@ bool EmbeddedMap3::uncutEdge(Dart d)
 		{
 			Algo::Topo::setOrbitEmbedding<EDGE>(*this, d, getEmbedding<EDGE>(d)) ;
 		}
+		updateQuickTraversalsAround(d, phi1(d));
 		return true ;
 	}
 	return false ;
@@ -213,6 +216,8 @@ Dart EmbeddedMap3::collapseEdge(Dart d, bool delDegenerateVolumes)
 			Algo::Topo::setOrbitEmbedding<EDGE>(*this, d2, getEmbedding<EDGE>(d2));
 			Algo::Topo::setOrbitEmbedding<EDGE>(*this, dd2, getEmbedding<EDGE>(dd2));
 		}
+
+		updateQuickTraversalsAround(resV);
 	}
 
 	return resV;
@@ -270,11 +275,14 @@ void EmbeddedMap3::splitFace(Dart d, Dart e)
 		setDartEmbedding<VOLUME>(phi_1(dd),  vEmb2);
 		setDartEmbedding<VOLUME>(phi_1(ee),  vEmb2);
 	}
+
+	updateQuickTraversalsAround(d, e);
 }
 
 bool EmbeddedMap3::mergeFaces(Dart d)
 {
 	Dart d1 = phi1(d);
+	Dart d21 = phi1(phi2(d));
 
 	if(Map3::mergeFaces(d))
 	{
@@ -288,6 +296,8 @@ bool EmbeddedMap3::mergeFaces(Dart d)
 			Algo::Topo::setOrbitEmbedding<FACE>(*this, d1, getEmbedding<FACE>(d1)) ;
 		}
 
+		updateQuickTraversalsAround(d1, d21);
+
 		return true;
 	}
 
@@ -310,6 +320,8 @@ Dart EmbeddedMap3::collapseFace(Dart d, bool delDegenerateVolumes)
 		{
 			Algo::Topo::setOrbitEmbedding<VERTEX>(*this, resV, vEmb);
 		}
+
+		updateQuickTraversalsAround(resV);
 	}
 
 	return resV;
@@ -429,12 +441,18 @@ bool EmbeddedMap3::mergeVolumes(Dart d, bool deleteFace)
 {
 	Dart d2 = phi2(d);
 
+	// the darts of the face may be deleted: vertices are given by the adjacent faces
+	std::vector<Dart> vertices;
+	if (hasQuickTraversal())
+		foreach_dart_of_orbit(Cell<FACE2>(d), [&] (Dart e) { vertices.push_back(phi2(e)); });
+
 	if(Map3::mergeVolumes(d, deleteFace))
 	{
 		if (isOrbitEmbedded<VOLUME>())
 		{
 			Algo::Topo::setOrbitEmbedding<VOLUME>(*this, d2, getEmbedding<VOLUME>(d2)) ;
 		}
+		updateQuickTraversalsAround(vertices);
 		return true;
 	}
 	return false;
@@ -488,6 +506,8 @@ void EmbeddedMap3::splitVolume(std::vector<Dart>& vd)
 		Algo::Topo::setOrbitEmbeddingOnNewCell<VOLUME>(*this, v23) ;
 		Algo::Topo::copyCellAttributes<VOLUME>(*this, v23, v) ;
 	}
+
+	updateQuickTraversalsAround(vd);
 }
 
 void EmbeddedMap3::cutVolume(std::vector<Dart>& vd)
@@ -742,4 +762,54 @@ bool EmbeddedMap3::check()
 	return true ;
 }
 
+void EmbeddedMap3::updateQuickTraversalsAround(const std::vector<Dart>& vertices)
+{
+	if (!hasQuickTraversal())
+		return;
+
+	// darts of the volumes around the vertices (the boundary is not a volume of the lists)
+	DartMarkerStore<EmbeddedMap3> mark(*this);
+	for (std::vector<Dart>::const_iterator it = vertices.begin(); it != vertices.end(); ++it)
+	{
+		foreach_dart_of_orbit(Vertex(*it), [&] (Dart d)
+		{
+			if (!mark.isMarked(d) && !isBoundaryMarked<3>(d))
+				mark.markOrbit(Vol(d));
+		});
+	}
+
+	// some operators leave the new cells without embedding (e.g. the vertex of cutEdge):
+	// their lists can only be stored once they are embedded
+	const std::vector<Dart>& darts = mark.getDartVector();
+	for (std::vector<Dart>::const_iterator it = darts.begin(); it != darts.end(); ++it)
+	{
+		if (isOrbitEmbedded<VERTEX>() && getEmbedding<VERTEX>(*it) == EMBNULL)
+			Algo::Topo::setOrbitEmbeddingOnNewCell<VERTEX>(*this, *it);
+		if (isOrbitEmbedded<EDGE>() && getEmbedding<EDGE>(*it) == EMBNULL)
+			Algo::Topo::setOrbitEmbeddingOnNewCell<EDGE>(*this, *it);
+		if (isOrbitEmbedded<FACE>() && getEmbedding<FACE>(*it) == EMBNULL)
+			Algo::Topo::setOrbitEmbeddingOnNewCell<FACE>(*this, *it);
+		if (isOrbitEmbedded<VOLUME>() && getEmbedding<VOLUME>(*it) == EMBNULL)
+			Algo::Topo::setOrbitEmbeddingOnNewCell<VOLUME>(*this, *it);
+	}
+
+	updateQuickTraversals(darts);
+}
+
+void EmbeddedMap3::updateQuickTraversalsAround(Dart d, Dart e, Dart f, Dart g)
+{
+	if (!hasQuickTraversal())
+		return;
+
+	std::vector<Dart> vertices;
+	vertices.push_back(d);
+	if (e != NIL)
+		vertices.push_back(e);
+	if (f != NIL)
+		vertices.push_back(f);
+	if (g != NIL)
+		vertices.push_back(g);
+	updateQuickTraversalsAround(vertices);
+}
+
 } // namespace CGoGN
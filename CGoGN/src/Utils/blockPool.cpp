@@ -0,0 +1,255 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/blockPool.h"
+
+#include <cstdlib>
+#include <new>
+
+#ifdef WIN32
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+const std::size_t BlockPool::ALIGNMENT;
+const std::size_t BlockPool::SLAB_SIZE;
+
+BlockPool::BlockPool(bool hugePages) :
+	m_maxPooledBytes(std::size_t(256) * 1024 * 1024),
+	m_pooledBytes(0),
+	m_hugePages(hugePages),
+	m_slabUsed(0)
+{}
+
+BlockPool::~BlockPool()
+{
+	trim();
+	for (std::vector<std::pair<char*, std::size_t> >::iterator it = m_slabs.begin(); it != m_slabs.end(); ++it)
+	{
+#ifdef WIN32
+		VirtualFree(it->first, 0, MEM_RELEASE);
+#else
+		munmap(it->first, it->second);
+#endif
+	}
+}
+
+BlockPool& BlockPool::getInstance()
+{
+	static BlockPool* pool = new BlockPool();
+	return *pool;
+}
+
+BlockPool::SizeClass& BlockPool::sizeClass(std::size_t nbBytes)
+{
+	// few different sizes: linear search
+	for (std::vector<SizeClass>::iterator it = m_classes.begin(); it != m_classes.end(); ++it)
+	{
+		if (it->size == nbBytes)
+			return *it;
+	}
+	SizeClass sc;
+	sc.size = nbBytes;
+	sc.nbLive = 0;
+	m_classes.push_back(sc);
+	return m_classes.back();
+}
+
+bool BlockPool::inSlab(const void* ptr) const
+{
+	const char* p = static_cast<const char*>(ptr);
+	for (std::vector<std::pair<char*, std::size_t> >::const_iterator it = m_slabs.begin(); it != m_slabs.end(); ++it)
+	{
+		if (p >= it->first && p < it->first + it->second)
+			return true;
+	}
+	return false;
+}
+
+void* BlockPool::allocateSystem(std::size_t nbBytes)
+{
+	if (!m_hugePages)
+	{
+#ifdef WIN32
+		return _aligned_malloc(nbBytes, ALIGNMENT);
+#else
+		void* ptr = NULL;
+		if (posix_memalign(&ptr, ALIGNMENT, nbBytes) != 0)
+			return NULL;
+		return ptr;
+#endif
+	}
+
+	// cut the block in the last slab, or in a new one if it does not fit
+	nbBytes = (nbBytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	if (m_slabs.empty() || m_slabUsed + nbBytes > m_slabs.back().second)
+	{
+		std::size_t slabSize = (nbBytes + SLAB_SIZE - 1) / SLAB_SIZE * SLAB_SIZE;
+#ifdef WIN32
+		char* slab = static_cast<char*>(VirtualAlloc(NULL, slabSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+		if (slab == NULL)
+			return NULL;
+#else
+		// map one more slab to align the range on SLAB_SIZE, then unmap the excess
+		char* ptr = static_cast<char*>(mmap(NULL, slabSize + SLAB_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+		if (ptr == MAP_FAILED)
+			return NULL;
+		std::size_t head = (SLAB_SIZE - reinterpret_cast<std::size_t>(ptr) % SLAB_SIZE) % SLAB_SIZE;
+		char* slab = ptr + head;
+		if (head > 0)
+			munmap(ptr, head);
+		if (SLAB_SIZE - head > 0)
+			munmap(slab + slabSize, SLAB_SIZE - head);
+#ifdef MADV_HUGEPAGE
+		madvise(slab, slabSize, MADV_HUGEPAGE);
+#endif
+#endif
+		m_slabs.push_back(std::make_pair(slab, slabSize));
+		m_slabUsed = 0;
+	}
+
+	void* ptr = m_slabs.back().first + m_slabUsed;
+	m_slabUsed += nbBytes;
+	return ptr;
+}
+
+void BlockPool::releaseSystem(void* ptr)
+{
+#ifdef WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+void* BlockPool::allocate(std::size_t nbBytes)
+{
+	void* ptr = NULL;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		SizeClass& sc = sizeClass(nbBytes);
+		++sc.nbLive;
+		if (!sc.freeBlocks.empty())
+		{
+			ptr = sc.freeBlocks.back();
+			sc.freeBlocks.pop_back();
+			m_pooledBytes -= nbBytes;
+			return ptr;
+		}
+		// slabs are shared by all sizes: cut under the lock
+		if (m_hugePages)
+			ptr = allocateSystem(nbBytes);
+	}
+
+	if (!m_hugePages)
+		ptr = allocateSystem(nbBytes);
+
+	if (ptr == NULL)
+		throw std::bad_alloc();
+	return ptr;
+}
+
+void BlockPool::release(void* ptr, std::size_t nbBytes)
+{
+	if (ptr == NULL)
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		SizeClass& sc = sizeClass(nbBytes);
+		--sc.nbLive;
+		if (m_hugePages || m_pooledBytes + nbBytes <= m_maxPooledBytes)
+		{
+			sc.freeBlocks.push_back(ptr);
+			m_pooledBytes += nbBytes;
+			return;
+		}
+	}
+
+	releaseSystem(ptr);
+}
+
+void BlockPool::trim()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for (std::vector<SizeClass>::iterator it = m_classes.begin(); it != m_classes.end(); ++it)
+	{
+		std::vector<void*> kept;
+		for (std::vector<void*>::iterator b = it->freeBlocks.begin(); b != it->freeBlocks.end(); ++b)
+		{
+			if (inSlab(*b))
+				kept.push_back(*b);
+			else
+			{
+				releaseSystem(*b);
+				m_pooledBytes -= it->size;
+			}
+		}
+		it->freeBlocks.swap(kept);
+	}
+}
+
+void BlockPool::setMaxPooledSize(std::size_t nbBytes)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_maxPooledBytes = nbBytes;
+		if (m_pooledBytes <= m_maxPooledBytes)
+			return;
+	}
+	trim();
+}
+
+BlockPool::Stats BlockPool::getStats() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Stats s;
+	s.nbLiveBlocks = 0;
+	s.nbPooledBlocks = 0;
+	s.liveBytes = 0;
+	s.pooledBytes = m_pooledBytes;
+	s.slabBytes = 0;
+	for (std::vector<SizeClass>::const_iterator it = m_classes.begin(); it != m_classes.end(); ++it)
+	{
+		s.nbLiveBlocks += it->nbLive;
+		s.nbPooledBlocks += it->freeBlocks.size();
+		s.liveBytes += it->nbLive * it->size;
+	}
+	for (std::vector<std::pair<char*, std::size_t> >::const_iterator it = m_slabs.begin(); it != m_slabs.end(); ++it)
+		s.slabBytes += it->second;
+	return s;
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
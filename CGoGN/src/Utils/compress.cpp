@@ -22,10 +22,14 @@
 *                                                                              *
 *******************************************************************************/
 
+#define CGoGN_UTILS_DLL_EXPORT 1
 #include <cassert>
 #include "Utils/compress.h"
 #include "zlib.h"
 
+#include <atomic>
+#include <thread>
+
 #include <iostream>
 #include <vector>
 #include <string.h>
@@ -106,5 +110,132 @@ void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::of
 }
 
 
+/**
+* run func(i) for i in [0,nb) on nbThreads threads
+*/
+template <typename FUNC>
+static void parallelFor(unsigned int nb, unsigned int nbThreads, FUNC func)
+{
+	if (nbThreads == 0)
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	nbThreads = std::min(nbThreads, nb);
+
+	std::atomic<unsigned int> next(0);
+	auto work = [&] ()
+	{
+		for (unsigned int i = next++; i < nb; i = next++)
+			func(i);
+	};
+
+	std::vector<std::thread> threads;
+	for (unsigned int t = 1; t < nbThreads; ++t)
+		threads.push_back(std::thread(work));
+	work();
+	for (unsigned int t = 0; t < threads.size(); ++t)
+		threads[t].join();
+}
+
+void zlibCompressGroups(const std::vector<std::pair<const char*, std::size_t> >& blocks, unsigned int groupSize,
+						std::vector<std::string>& outputs, unsigned int nbThreads, int level)
+{
+	const unsigned int nbGroups = (unsigned int)((blocks.size() + groupSize - 1) / groupSize);
+	outputs.clear();
+	outputs.resize(nbGroups);
+
+	parallelFor(nbGroups, nbThreads, [&] (unsigned int g)
+	{
+		const std::size_t first = std::size_t(g) * groupSize;
+		const std::size_t last = std::min(first + groupSize, blocks.size());
+
+		uLong total = 0;
+		for (std::size_t b = first; b < last; ++b)
+			total += uLong(blocks[b].second);
+
+		z_stream strm;
+		strm.zalloc = Z_NULL;
+		strm.zfree = Z_NULL;
+		strm.opaque = Z_NULL;
+		int ret = deflateInit(&strm, level);
+		assert(ret == Z_OK);
+		if (ret != Z_OK)
+			return;
+
+		std::string& out = outputs[g];
+		out.resize(deflateBound(&strm, total));
+		strm.next_out = reinterpret_cast<Bytef*>(&out[0]);
+		strm.avail_out = uInt(out.size());
+
+		// feed the blocks of the group one after the other in the same stream
+		for (std::size_t b = first; b < last; ++b)
+		{
+			strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(blocks[b].first));
+			strm.avail_in = uInt(blocks[b].second);
+			ret = deflate(&strm, (b + 1 == last) ? Z_FINISH : Z_NO_FLUSH);
+			assert(ret != Z_STREAM_ERROR);
+		}
+		assert(ret == Z_STREAM_END);
+
+		out.resize(strm.total_out);
+		deflateEnd(&strm);
+	});
+}
+
+bool zlibUncompressGroups(const std::vector<std::string>& inputs, const std::vector<std::pair<char*, std::size_t> >& blocks,
+						  unsigned int groupSize, unsigned int nbThreads)
+{
+	const unsigned int nbGroups = (unsigned int)(inputs.size());
+	if (std::size_t(nbGroups) != (blocks.size() + groupSize - 1) / groupSize)
+		return false;
+
+	std::atomic<bool> ok(true);
+
+	parallelFor(nbGroups, nbThreads, [&] (unsigned int g)
+	{
+		const std::size_t first = std::size_t(g) * groupSize;
+		const std::size_t last = std::min(first + groupSize, blocks.size());
+
+		z_stream strm;
+		strm.zalloc = Z_NULL;
+		strm.zfree = Z_NULL;
+		strm.opaque = Z_NULL;
+		strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(inputs[g].data()));
+		strm.avail_in = uInt(inputs[g].size());
+		if (inflateInit(&strm) != Z_OK)
+		{
+			ok = false;
+			return;
+		}
+
+		// fill the blocks of the group one after the other from the same stream
+		int ret = Z_OK;
+		for (std::size_t b = first; b < last && ret == Z_OK; ++b)
+		{
+			strm.next_out = reinterpret_cast<Bytef*>(blocks[b].first);
+			strm.avail_out = uInt(blocks[b].second);
+			ret = inflate(&strm, Z_NO_FLUSH);
+			if (strm.avail_out != 0 && ret != Z_STREAM_END)
+				ret = Z_DATA_ERROR;
+			if (ret == Z_STREAM_END && (strm.avail_out != 0 || b + 1 != last))
+				ret = Z_DATA_ERROR;
+		}
+		if (ret == Z_OK)
+		{
+			// all blocks are full: only the end of the stream remains
+			char dummy;
+			strm.next_out = reinterpret_cast<Bytef*>(&dummy);
+			strm.avail_out = 1;
+			ret = inflate(&strm, Z_FINISH);
+			if (strm.avail_out != 1)
+				ret = Z_DATA_ERROR;
+		}
+		if (ret != Z_STREAM_END)
+			ok = false;
+
+		inflateEnd(&strm);
+	});
+
+	return ok;
+}
+
 }
 }
@@ -0,0 +1,144 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/mappedFile.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+const std::size_t MappedFile::ALIGNMENT;
+
+MappedFile::MappedFile() :
+	m_data(NULL),
+	m_size(0),
+	m_mapped(false)
+{}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+
+#ifndef WIN32
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size == 0)
+	{
+		::close(fd);
+		return false;
+	}
+
+	// private mapping: written pages are copied, the file is never modified
+	void* ptr = mmap(NULL, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (ptr == MAP_FAILED)
+		return false;
+
+	m_data = static_cast<char*>(ptr);
+	m_size = std::size_t(st.st_size);
+	m_mapped = true;
+#else
+	std::ifstream fs(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!fs)
+		return false;
+
+	fs.seekg(0, std::ios::end);
+	std::size_t sz = std::size_t(fs.tellg());
+	fs.seekg(0, std::ios::beg);
+	if (sz == 0)
+		return false;
+
+	m_data = new char[sz];
+	fs.read(m_data, sz);
+	m_size = sz;
+	m_mapped = false;
+#endif
+
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (m_data == NULL)
+		return;
+
+#ifndef WIN32
+	if (m_mapped)
+		munmap(m_data, m_size);
+	else
+		delete[] m_data;
+#else
+	delete[] m_data;
+#endif
+
+	m_data = NULL;
+	m_size = 0;
+	m_mapped = false;
+}
+
+bool MappedFile::read(std::size_t& offset, void* dst, std::size_t nb) const
+{
+	if (offset + nb > m_size)
+		return false;
+	memcpy(dst, m_data + offset, nb);
+	offset += nb;
+	return true;
+}
+
+void MappedFile::writePadding(std::ostream& fs)
+{
+	std::size_t pos = std::size_t(fs.tellp());
+	std::size_t nb = align(pos) - pos;
+	if (nb > 0)
+	{
+		std::vector<char> zeros(nb, 0);
+		fs.write(&zeros[0], nb);
+	}
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
@@ -0,0 +1,150 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/reservedMemory.h"
+
+#include <algorithm>
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+ReservedMemory::ReservedMemory() :
+	m_data(NULL),
+	m_reserved(0),
+	m_committed(0)
+{}
+
+ReservedMemory::~ReservedMemory()
+{
+	release();
+}
+
+std::size_t ReservedMemory::pageSize()
+{
+#ifdef WIN32
+	SYSTEM_INFO si;
+	GetSystemInfo(&si);
+	return std::size_t(si.dwPageSize);
+#else
+	return std::size_t(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+bool ReservedMemory::reserve(std::size_t nbBytes)
+{
+	release();
+
+	std::size_t ps = pageSize();
+	nbBytes = (nbBytes + ps - 1) / ps * ps;
+	if (nbBytes == 0)
+		return false;
+
+#ifdef WIN32
+	void* ptr = VirtualAlloc(NULL, nbBytes, MEM_RESERVE, PAGE_NOACCESS);
+	if (ptr == NULL)
+		return false;
+#else
+	void* ptr = mmap(NULL, nbBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (ptr == MAP_FAILED)
+		return false;
+#ifdef MADV_HUGEPAGE
+	if (nbBytes >= (std::size_t(2) << 20))
+		madvise(ptr, nbBytes, MADV_HUGEPAGE);
+#endif
+#endif
+
+	m_data = static_cast<char*>(ptr);
+	m_reserved = nbBytes;
+	m_committed = 0;
+	return true;
+}
+
+bool ReservedMemory::commit(std::size_t nbBytes)
+{
+	std::size_t ps = pageSize();
+	nbBytes = (nbBytes + ps - 1) / ps * ps;
+	if (nbBytes > m_reserved)
+		return false;
+
+	if (nbBytes > m_committed)
+	{
+#ifdef WIN32
+		if (VirtualAlloc(m_data + m_committed, nbBytes - m_committed, MEM_COMMIT, PAGE_READWRITE) == NULL)
+			return false;
+#else
+		if (mprotect(m_data + m_committed, nbBytes - m_committed, PROT_READ | PROT_WRITE) != 0)
+			return false;
+#endif
+	}
+	else if (nbBytes < m_committed)
+	{
+#ifdef WIN32
+		VirtualFree(m_data + nbBytes, m_committed - nbBytes, MEM_DECOMMIT);
+#else
+		madvise(m_data + nbBytes, m_committed - nbBytes, MADV_DONTNEED);
+		mprotect(m_data + nbBytes, m_committed - nbBytes, PROT_NONE);
+#endif
+	}
+
+	m_committed = nbBytes;
+	return true;
+}
+
+void ReservedMemory::release()
+{
+	if (m_data == NULL)
+		return;
+
+#ifdef WIN32
+	VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+	munmap(m_data, m_reserved);
+#endif
+
+	m_data = NULL;
+	m_reserved = 0;
+	m_committed = 0;
+}
+
+void ReservedMemory::swap(ReservedMemory& rm)
+{
+	std::swap(m_data, rm.m_data);
+	std::swap(m_reserved, rm.m_reserved);
+	std::swap(m_committed, rm.m_committed);
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/textParser.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+namespace TextParser
+{
+
+void splitInChunks(const char* data, std::size_t size, unsigned int nbChunks, std::vector<std::size_t>& bounds)
+{
+	if (nbChunks == 0)
+		nbChunks = 1;
+
+	bounds.resize(nbChunks + 1);
+	bounds[0] = 0;
+	for (unsigned int i = 1; i < nbChunks; ++i)
+	{
+		std::size_t pos = std::size_t((unsigned long long)(size) * i / nbChunks);
+		if (pos < bounds[i - 1])
+			pos = bounds[i - 1];
+		// chunks begin after an end of line
+		while (pos > 0 && pos < size && data[pos - 1] != '\n')
+			++pos;
+		bounds[i] = pos;
+	}
+	bounds[nbChunks] = size;
+}
+
+} // namespace TextParser
+
+} // namespace Utils
+
+} // namespace CGoGN
@@ -0,0 +1,132 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/threadPool.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+// true in the threads of the pool and in a thread executing ThreadPool::run
+static thread_local bool s_inPool = false;
+
+ThreadPool::ThreadPool() :
+	m_job(NULL),
+	m_nbJobThreads(0),
+	m_nbRunning(0),
+	m_generation(0),
+	m_stop(false)
+{}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cvStart.notify_all();
+	for (std::vector<std::thread>::iterator it = m_threads.begin(); it != m_threads.end(); ++it)
+		it->join();
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+void ThreadPool::workerLoop(unsigned int i)
+{
+	s_inPool = true;
+	unsigned long long generation = 0;
+	while (true)
+	{
+		const std::function<void(unsigned int)>* job = NULL;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_cvStart.wait(lock, [&] () { return m_stop || (m_generation != generation && i + 1 < m_nbJobThreads); });
+			if (m_stop)
+				return;
+			generation = m_generation;
+			job = m_job;
+		}
+
+		(*job)(i + 1);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (--m_nbRunning == 0)
+			m_cvEnd.notify_one();
+	}
+}
+
+void ThreadPool::run(unsigned int nb, const std::function<void(unsigned int)>& job)
+{
+	if (nb == 0)
+		return;
+
+	// nested call or pool used by another thread: temporary threads
+	std::unique_lock<std::mutex> runLock(m_runMutex, std::defer_lock);
+	if (s_inPool || !runLock.try_lock())
+	{
+		std::vector<std::thread> threads;
+		threads.reserve(nb - 1);
+		for (unsigned int i = 1; i < nb; ++i)
+			threads.push_back(std::thread(job, i));
+		job(0);
+		for (unsigned int i = 0; i < nb - 1; ++i)
+			threads[i].join();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		while (m_threads.size() < nb - 1)
+		{
+			unsigned int i = (unsigned int)(m_threads.size());
+			m_threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+		}
+
+		m_job = &job;
+		m_nbJobThreads = nb;
+		m_nbRunning = nb - 1;
+		++m_generation;
+	}
+	m_cvStart.notify_all();
+
+	s_inPool = true;
+	job(0);
+	s_inPool = false;
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cvEnd.wait(lock, [&] () { return m_nbRunning == 0; });
+	m_job = NULL;
+	m_nbJobThreads = 0;
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
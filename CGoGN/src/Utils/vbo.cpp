@@ -137,6 +137,14 @@ void VBO::updateData(const AttributeMultiVectorGen* attrib)
 
 	m_nbElts = nbb * byteTableSize / attrib->getSizeOfType();
 
+	// contiguous storage: one transfer for all blocks
+	if (attrib->getContiguousPointer() != NULL)
+	{
+		if (nbb > 0)
+			glBufferSubData(GL_ARRAY_BUFFER, 0, nbb * byteTableSize, attrib->getContiguousPointer());
+		return;
+	}
+
 	unsigned int offset = 0;
 
 	for (unsigned int i = 0; i < nbb; ++i)
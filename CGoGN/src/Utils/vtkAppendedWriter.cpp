@@ -0,0 +1,172 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/vtkAppendedWriter.h"
+#include "Utils/compress.h"
+#include "Utils/cgognStream.h"
+
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+const std::size_t VTKAppendedWriter::BLOCK_SIZE;
+
+// number of characters reserved for each offset in the xml (patched at the end of write)
+static const std::size_t OFFSET_WIDTH = 20;
+
+// number of blocks compressed before being written
+static const std::size_t BATCH_NB_BLOCKS = 256;
+
+VTKAppendedWriter::VTKAppendedWriter(Compression compression, unsigned int nbThreads, int level) :
+	m_compression(compression),
+	m_nbThreads(nbThreads),
+	m_level(level)
+{}
+
+void VTKAppendedWriter::begin(const std::string& type)
+{
+	m_type = type;
+	m_xml = "<?xml version=\"1.0\"?>\n";
+	m_xml += "<VTKFile type=\"" + type + "\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\"";
+	if (m_compression == ZLIB)
+		m_xml += " compressor=\"vtkZLibDataCompressor\"";
+	m_xml += ">\n";
+	m_arrays.clear();
+	m_owned.clear();
+}
+
+void VTKAppendedWriter::xml(const std::string& text)
+{
+	m_xml += text;
+}
+
+void VTKAppendedWriter::addArray(const std::string& vtkType, const std::string& name, unsigned int nbComp, Array& a)
+{
+	std::ostringstream oss;
+	oss << "<DataArray type=\"" << vtkType << "\" Name=\"" << name << "\" NumberOfComponents=\"" << nbComp << "\" format=\"appended\" offset=\"";
+	m_xml += oss.str();
+	a.offsetPos = m_xml.size();
+	m_xml += std::string(OFFSET_WIDTH, ' ');
+	m_xml += "\"/>\n";
+	m_arrays.push_back(a);
+}
+
+void VTKAppendedWriter::dataArray(const std::string& vtkType, const std::string& name, unsigned int nbComp,
+								  const std::vector<void*>& blocks, std::size_t blockSize, std::size_t nbBytes)
+{
+	Array a;
+	a.blockSize = blockSize;
+	for (std::size_t i = 0, pos = 0; i < blocks.size() && pos < nbBytes; ++i, pos += blockSize)
+		a.blocks.push_back(std::make_pair(static_cast<const char*>(blocks[i]), std::min(blockSize, nbBytes - pos)));
+	addArray(vtkType, name, nbComp, a);
+}
+
+bool VTKAppendedWriter::write(const std::string& filename)
+{
+	std::ofstream fout(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!fout.good())
+	{
+		CGoGNerr << "Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	m_xml += "<AppendedData encoding=\"raw\">\n_";
+	fout.write(m_xml.data(), m_xml.size());
+	const std::streamoff start = fout.tellp();
+
+	std::vector<unsigned long long> offsets(m_arrays.size());
+	std::vector<std::string> compressed;
+	for (unsigned int i = 0; i < m_arrays.size(); ++i)
+	{
+		const Array& a = m_arrays[i];
+		offsets[i] = (unsigned long long)(std::streamoff(fout.tellp()) - start);
+
+		if (m_compression == RAW)
+		{
+			unsigned long long nbBytes = 0;
+			for (std::size_t b = 0; b < a.blocks.size(); ++b)
+				nbBytes += a.blocks[b].second;
+			fout.write(reinterpret_cast<const char*>(&nbBytes), sizeof(unsigned long long));
+			for (std::size_t b = 0; b < a.blocks.size(); ++b)
+				fout.write(a.blocks[b].first, a.blocks[b].second);
+			continue;
+		}
+
+		// header: number of blocks, size of the blocks, size of the last block if partial,
+		// then the compressed sizes (known after compression: written back at the end)
+		const std::size_t nbBlocks = a.blocks.size();
+		std::vector<unsigned long long> header(3 + nbBlocks, 0);
+		header[0] = nbBlocks;
+		header[1] = a.blockSize;
+		if (nbBlocks > 0 && a.blocks.back().second != a.blockSize)
+			header[2] = a.blocks.back().second;
+		const std::streamoff headerPos = fout.tellp();
+		fout.write(reinterpret_cast<const char*>(&header[0]), header.size() * sizeof(unsigned long long));
+
+		for (std::size_t first = 0; first < nbBlocks; first += BATCH_NB_BLOCKS)
+		{
+			const std::size_t last = std::min(first + BATCH_NB_BLOCKS, nbBlocks);
+			std::vector<std::pair<const char*, std::size_t> > batch(a.blocks.begin() + first, a.blocks.begin() + last);
+			zlibCompressGroups(batch, 1, compressed, m_nbThreads, m_level);
+			for (std::size_t b = 0; b < compressed.size(); ++b)
+			{
+				header[3 + first + b] = compressed[b].size();
+				fout.write(compressed[b].data(), compressed[b].size());
+			}
+		}
+
+		const std::streamoff end = fout.tellp();
+		fout.seekp(headerPos);
+		fout.write(reinterpret_cast<const char*>(&header[0]), header.size() * sizeof(unsigned long long));
+		fout.seekp(end);
+	}
+
+	const std::string trailer = "\n</AppendedData>\n</VTKFile>\n";
+	fout.write(trailer.data(), trailer.size());
+
+	// offsets of the arrays in the xml
+	for (unsigned int i = 0; i < m_arrays.size(); ++i)
+	{
+		std::ostringstream oss;
+		oss << offsets[i];
+		fout.seekp(std::streamoff(m_arrays[i].offsetPos));
+		fout.write(oss.str().data(), oss.str().size());
+	}
+
+	bool ok = fout.good();
+	fout.close();
+	m_owned.clear();
+	return ok;
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
@@ -10,7 +10,7 @@
 
 #include "NL/nl.h"
 #include "Algo/LinearSolving/basic.h"
-#include "Eigen/Dense"
+#include "Algo/Deformation/asRigidAsPossible.h"
 
 namespace CGoGN
 {
@@ -18,8 +18,6 @@ namespace CGoGN
 namespace SCHNApps
 {
 
-typedef NoTypeNameAttribute<Eigen::Matrix3f> Eigen_Matrix3f;
-
 struct MapParameters
 {
 	MapParameters();
@@ -37,13 +35,15 @@ struct MapParameters
 
 	VertexAttribute<PFP2::VEC3, PFP2::MAP> positionInit;
 	VertexAttribute<PFP2::VEC3, PFP2::MAP> diffCoord;
-	VertexAttribute<Eigen_Matrix3f, PFP2::MAP> vertexRotationMatrix;
-	VertexAttribute<PFP2::VEC3, PFP2::MAP> rotatedDiffCoord;
 
 	VertexAttribute<unsigned int, PFP2::MAP> vIndex;
 	unsigned int nb_vertices;
 
 	NLContext nlContext;
+
+	// ARAP solver, its factorization is updated when the selections change
+	Algo::Surface::Deformation::ARAP<PFP2>* arap;
+	bool selectionChanged;
 };
 
 class Surface_Deformation_Plugin : public PluginInteraction
@@ -21,13 +21,17 @@ MapParameters::MapParameters() :
 	handleSelector(NULL),
 	freeSelector(NULL),
 	initialized(false),
-	nlContext(NULL)
+	nlContext(NULL),
+	arap(NULL),
+	selectionChanged(true)
 {}
 
 MapParameters::~MapParameters()
 {
 	if(nlContext)
 		nlDeleteContext(nlContext);
+	if(arap)
+		delete arap;
 }
 
 void MapParameters::start(MapHandlerGen* mhg)
@@ -46,14 +50,6 @@ void MapParameters::start(MapHandlerGen* mhg)
 			if(!diffCoord.isValid())
 				diffCoord = mh->addAttribute<PFP2::VEC3, VERTEX>("diffCoord");
 
-			vertexRotationMatrix = mh->getAttribute<Eigen_Matrix3f, VERTEX>("vertexRotationMatrix");
-			if(!vertexRotationMatrix.isValid())
-				vertexRotationMatrix = mh->addAttribute<Eigen_Matrix3f, VERTEX>("vertexRotationMatrix");
-
-			rotatedDiffCoord = mh->getAttribute<PFP2::VEC3, VERTEX>("rotatedDiffCoord");
-			if(!rotatedDiffCoord.isValid())
-				rotatedDiffCoord = mh->addAttribute<PFP2::VEC3, VERTEX>("rotatedDiffCoord");
-
 			vIndex = mh->getAttribute<unsigned int, VERTEX>("vIndex");
 			if(!vIndex.isValid())
 				vIndex = mh->addAttribute<unsigned int, VERTEX>("vIndex");
@@ -64,9 +60,6 @@ void MapParameters::start(MapHandlerGen* mhg)
 
 			Algo::Surface::Geometry::computeLaplacianTopoVertices<PFP2>(*map, positionAttribute, diffCoord);
 
-			for(unsigned int i = vertexRotationMatrix.begin(); i != vertexRotationMatrix.end(); vertexRotationMatrix.next(i))
-				vertexRotationMatrix[i] = Eigen::Matrix3f::Identity();
-
 			nb_vertices = Algo::Topo::computeIndexCells<VERTEX>(*map, vIndex);
 
 			if(nlContext)
@@ -76,6 +69,12 @@ void MapParameters::start(MapHandlerGen* mhg)
 			nlSolverParameteri(NL_LEAST_SQUARES, NL_TRUE);
 			nlSolverParameteri(NL_SOLVER, NL_CHOLMOD_EXT);
 
+			// rest pose: the positions copied in positionInit
+			if(arap)
+				delete arap;
+			arap = new Algo::Surface::Deformation::ARAP<PFP2>(*map, positionAttribute);
+			selectionChanged = true;
+
 			initialized = true;
 		}
 	}
@@ -91,17 +90,16 @@ void MapParameters::stop(MapHandlerGen* mh)
 //		if(diffCoord.isValid())
 //			mh->removeAttribute(diffCoord);
 
-//		if(vertexRotationMatrix.isValid())
-//			mh->removeAttribute(vertexRotationMatrix);
-
-//		if(rotatedDiffCoord.isValid())
-//			mh->removeAttribute(rotatedDiffCoord);
-
 //		if(vIndex.isValid())
 //			mh->removeAttribute(vIndex);
 
 		if(nlContext)
 			nlDeleteContext(nlContext);
+		nlContext = NULL;
+
+		if(arap)
+			delete arap;
+		arap = NULL;
 
 		initialized = false;
 	}
@@ -317,6 +315,7 @@ void Surface_Deformation_Plugin::selectedCellsChanged(CellSelectorGen* cs)
 	{
 		nlMakeCurrent(p.nlContext) ;
 		nlReset(NL_FALSE) ;
+		p.selectionChanged = true;
 	}
 }
 
@@ -419,135 +418,21 @@ void Surface_Deformation_Plugin::matchDiffCoord(MapHandlerGen* mh)
 
 void Surface_Deformation_Plugin::asRigidAsPossible(MapHandlerGen* mh)
 {
-	PFP2::MAP* map = static_cast<MapHandler<PFP2>*>(mh)->getMap();
 	MapParameters& p = h_parameterSet[mh];
 
 	if (p.initialized)
 	{
-		CellMarkerNoUnmark<PFP2::MAP, VERTEX> m(*map) ;
-
-		for (Dart d = map->begin(); d != map->end(); map->next(d))
+		// the laplacian of the free vertices is factorized only when the selections change
+		if (p.selectionChanged)
 		{
-			if (!m.isMarked(d))
-			{
-				m.mark(d) ;
-
-				Eigen::Matrix3f cov = Eigen::Matrix3f::Zero() ;
-				PFP2::VEC3 pp = p.positionAttribute[d] ;
-				PFP2::VEC3 ppInit = p.positionInit[d] ;
-	//			PFP2::REAL area = p.vertexArea[d] ;
-				Dart it = d ;
-				do
-				{
-					Dart neigh = map->phi1(it) ;
-					PFP2::VEC3 v = p.positionAttribute[neigh] - pp ;
-					PFP2::VEC3 vv = p.positionInit[neigh] - ppInit ;
-					for (unsigned int i = 0; i < 3; ++i)
-						for (unsigned int j = 0; j < 3; ++j)
-							cov(i,j) += v[i] * vv[j];// * perMap->edgeWeight[it] / area ;
-					Dart dboundary = map->phi_1(it) ;
-					if (map->phi2(dboundary) == dboundary)
-					{
-						v = p.positionAttribute[dboundary] - pp ;
-						vv = p.positionInit[dboundary] - pp ;
-						for(unsigned int i = 0; i < 3; ++i)
-							for(unsigned int j = 0; j < 3; ++j)
-								cov(i,j) += v[i] * vv[j];// * perMap->edgeWeight[dboundary] / area ;
-					}
-					it = map->alpha1(it) ;
-				} while (it != d) ;
-
-				Eigen::JacobiSVD<Eigen::Matrix3f> svd(cov, Eigen::ComputeFullU | Eigen::ComputeFullV) ;
-				Eigen::Matrix3f R = svd.matrixU() * svd.matrixV().transpose() ;
-
-				if (R.determinant() < 0)
-				{
-					Eigen::Matrix3f U = svd.matrixU() ;
-					for (unsigned int i = 0; i < 3; ++i)
-						U(i,2) *= -1 ;
-					R = U * svd.matrixV().transpose() ;
-				}
-
-				p.vertexRotationMatrix[d] = R ;
-			}
+			p.arap->setFreeVertices(p.freeSelector->getMarker());
+			p.selectionChanged = false;
 		}
 
-		for (Dart d = map->begin(); d != map->end(); map->next(d))
-		{
-			if (m.isMarked(d))
-			{
-				m.unmark(d) ;
-
-				unsigned int degree = 0 ;
-				Eigen::Matrix3f r = Eigen::Matrix3f::Zero() ;
-				Dart it = d ;
-				do
-				{
-					r += p.vertexRotationMatrix[map->phi1(it)] ;
-					++degree ;
-					Dart dboundary = map->phi_1(it) ;
-					if(map->phi2(dboundary) == dboundary)
-					{
-						r += p.vertexRotationMatrix[dboundary] ;
-						++degree ;
-					}
-					it = map->alpha1(it) ;
-				} while (it != d) ;
-				r += p.vertexRotationMatrix[d] ;
-				r /= degree + 1 ;
-				PFP2::VEC3& dc = p.diffCoord[d] ;
-				Eigen::Vector3f rdc(dc[0], dc[1], dc[2]) ;
-				rdc = r * rdc ;
-				p.rotatedDiffCoord[d] = PFP2::VEC3(rdc[0], rdc[1], rdc[2]) ;
-
-	//			Eigen::Vector3f rdc = Eigen::Vector3f::Zero() ;
-	//			Dart it = d ;
-	//			PFP::REAL vArea = p.vertexArea[d] ;
-	//			Eigen::Matrix3f& rotM = p.vertexRotationMatrix[d] ;
-	//			PFP::REAL val = 0 ;
-	//			do
-	//			{
-	//				Dart ddn = map->phi1(it) ;
-	//				PFP::REAL w = p.edgeWeight[it] / vArea ;
-	//				PFP::VEC3 vv = (p.positionInit[ddn] - p.positionInit[it]) * w ;
-	//				val += w ;
-	//				Eigen::Matrix3f r = 0.5f * (p.vertexRotationMatrix[ddn] + rotM) ;
-	//				Eigen::Vector3f vvr = r * Eigen::Vector3f(vv[0], vv[1], vv[2]) ;
-	//				rdc += vvr ;
-	//				Dart dboundary = map->phi_1(it) ;
-	//				if(map->phi2(dboundary) == dboundary)
-	//				{
-	//					w = p.edgeWeight[dboundary] / vArea ;
-	//					vv = (p.positionInit[dboundary] - p.positionInit[it]) * w ;
-	//					val += w ;
-	//					r = 0.5f * (p.vertexRotationMatrix[dboundary] + rotM) ;
-	//					vvr = r * Eigen::Vector3f(vv[0], vv[1], vv[2]) ;
-	//					rdc += vvr ;
-	//				}
-	//				it = map->alpha1(it) ;
-	//			} while(it != d) ;
-	//			rdc /= val ;
-	//			p.rotatedDiffCoord[d] = PFP::VEC3(rdc[0], rdc[1], rdc[2]) ;
-			}
-		}
-
-		nlMakeCurrent(p.nlContext);
-		if (nlGetCurrentState() == NL_STATE_INITIAL)
-			nlBegin(NL_SYSTEM);
-		for (int coord = 0; coord < 3; ++coord)
-		{
-			Algo::LinearSolving::setupVariables<PFP2>(*map, p.vIndex, p.freeSelector->getMarker(), p.positionAttribute, coord);
-			nlBegin(NL_MATRIX);
-	//		LinearSolving::addRowsRHS_Laplacian_Cotan<PFP2>(*map, p.vIndex, p.edgeWeight, p.vertexArea, p.rotatedDiffCoord, coord);
-			Algo::LinearSolving::addRowsRHS_Laplacian_Topo<PFP2>(*map, p.vIndex, p.rotatedDiffCoord, coord);
-			nlEnd(NL_MATRIX);
-			nlEnd(NL_SYSTEM);
-			nlSolve();
-			Algo::LinearSolving::getResult<PFP2>(*map, p.vIndex, p.positionAttribute, coord);
-			nlReset(NL_TRUE);
-		}
+		p.arap->iterate();
 	}
 }
+
 #if CGOGN_QT_DESIRED_VERSION == 5
 	Q_PLUGIN_METADATA(IID "CGoGN.SCHNapps.Plugin")
 #else
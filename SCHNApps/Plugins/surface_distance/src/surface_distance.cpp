@@ -122,12 +122,18 @@ void Surface_Distance_Plugin::computeDistance(
 	PFP2::MAP* map1 = mh1->getMap();
 	PFP2::MAP* map2 = mh2->getMap();
 
-	// compute distance between map1 and map2 here
-	//   distance from map1 to map2 can be stored in map1 vertex attribute distance1
-	//   distance from map2 to map1 can be stored in map2 vertex attribute distance2
-
-	// Algo::Geometry::computeDistance<PFP2>(map1, position1, distance1, map2, position2);
-	// Algo::Geometry::computeDistance<PFP2>(map2, position2, distance2, map1, position1);
+	// distance from map1 to map2 is stored in map1 vertex attribute distance1
+	// distance from map2 to map1 is stored in map2 vertex attribute distance2
+	Algo::Geometry::DistanceStats<PFP2::REAL> stats12;
+	Algo::Geometry::DistanceStats<PFP2::REAL> stats21;
+	Algo::Geometry::DistanceStats<PFP2::REAL> stats = Algo::Geometry::Parallel::computeSymmetricDistance<PFP2>(
+		*map1, position1, distance1, *map2, position2, distance2, stats12, stats21);
+
+	CGoGNout << mapName1.toStdString() << " -> " << mapName2.toStdString()
+			 << " : Hausdorff = " << stats12.max << " / mean = " << stats12.mean << " / RMS = " << stats12.rms << CGoGNendl;
+	CGoGNout << mapName2.toStdString() << " -> " << mapName1.toStdString()
+			 << " : Hausdorff = " << stats21.max << " / mean = " << stats21.mean << " / RMS = " << stats21.rms << CGoGNendl;
+	CGoGNout << "symmetric : Hausdorff = " << stats.max << " / RMS = " << stats.rms << CGoGNendl;
 
 	this->pythonRecording("computeDistance", "", mapName1, positionAttributeName1, distanceAttributeName1, 
 							mapName2, positionAttributeName2, distanceAttributeName2);
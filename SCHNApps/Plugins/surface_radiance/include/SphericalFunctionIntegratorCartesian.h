@@ -1,57 +1,98 @@
-#ifndef SPHERICALFUNCTIONINTEGRATORCARTESIAN_H
-#define SPHERICALFUNCTIONINTEGRATORCARTESIAN_H
-
-#include "sphere_lebedev_rule.h"
-
-typedef double (*CartesianFunction)(double x, double y, double z, void* userData);		// Prototype for the function to be evaluated
-typedef bool (*CartesianDomain)(double x, double y, double z, void* userData);			// Prototype for the domain definition (true: inside, false: outside)
-
-class SphericalFunctionIntegratorCartesian
-{
-public:
-	SphericalFunctionIntegratorCartesian();
-	~SphericalFunctionIntegratorCartesian();
-
-	static const unsigned int maxRuleId = 65;						// Span of rule id (inclusive)
-	static inline bool RuleAvailable(unsigned int ruleId);			// States that the quadrature rule is available
-	static inline unsigned int RuleOrder(unsigned int ruleId);		// Number of points used in the quadrature
-	static inline unsigned int RulePrecision(unsigned int ruleId);	// Max degree of exactly integrated polynomial
-
-	void Init(unsigned int ruleId);									// Rule to use for subsequent integration - allocates quadrature samples and weights
-	void Release();													// Release cached informations
-
-	/*
-	 *	Integrates a function over a user-specified domain of the full 2D-sphere
-	 *
-	 *	outIntegral: resulting value
-	 *	outArea: area of the integration domain, as specified by the dom function
-	 *	f: function to integrate
-	 *	userDataFunction: user callback value passed to f during evaluation
-	 *	dom: Implicit domain definition (true when inside, false outside)
-	 *	userDataDomain: user callback value passed to dom during evaluation
-	 *	
-	 */
-	void Compute(double* outIntegral, double* outArea, CartesianFunction f, void* userDataFunction, CartesianDomain dom, void* userDataDomain) const;
-
-protected:
-	unsigned int rId;
-	unsigned int rOrder;
-	double* quadValues;		// [x_i] then [y_i], then [z_i], then [w_i] values
-};
-
-bool SphericalFunctionIntegratorCartesian::RuleAvailable(unsigned int ruleId)
-{
-	return available_table(ruleId) == 1;
-}
-
-unsigned int SphericalFunctionIntegratorCartesian::RuleOrder(unsigned int ruleId)
-{
-	return order_table(ruleId);
-}
-
-unsigned int SphericalFunctionIntegratorCartesian::RulePrecision(unsigned int ruleId)
-{
-	return precision_table(ruleId);
-}
-
-#endif
+#ifndef SPHERICALFUNCTIONINTEGRATORCARTESIAN_H
+#define SPHERICALFUNCTIONINTEGRATORCARTESIAN_H
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+
+#include "sphere_lebedev_rule.h"
+
+typedef double (*CartesianFunction)(double x, double y, double z, void* userData);		// Prototype for the function to be evaluated
+typedef bool (*CartesianDomain)(double x, double y, double z, void* userData);			// Prototype for the domain definition (true: inside, false: outside)
+
+class SphericalFunctionIntegratorCartesian
+{
+public:
+	SphericalFunctionIntegratorCartesian();
+	~SphericalFunctionIntegratorCartesian();
+
+	static const unsigned int maxRuleId = 65;						// Span of rule id (inclusive)
+	static inline bool RuleAvailable(unsigned int ruleId);			// States that the quadrature rule is available
+	static inline unsigned int RuleOrder(unsigned int ruleId);		// Number of points used in the quadrature
+	static inline unsigned int RulePrecision(unsigned int ruleId);	// Max degree of exactly integrated polynomial
+
+	void Init(unsigned int ruleId);									// Rule to use for subsequent integration - allocates quadrature samples and weights
+	void Release();													// Release cached informations
+
+	/*
+	 *	Integrates a function over a user-specified domain of the full 2D-sphere
+	 *
+	 *	outIntegral: resulting value
+	 *	outArea: area of the integration domain, as specified by the dom function
+	 *	f: function to integrate
+	 *	userDataFunction: user callback value passed to f during evaluation
+	 *	dom: Implicit domain definition (true when inside, false outside)
+	 *	userDataDomain: user callback value passed to dom during evaluation
+	 *	
+	 */
+	void Compute(double* outIntegral, double* outArea, CartesianFunction f, void* userDataFunction, CartesianDomain dom, void* userDataDomain) const;
+
+	/*
+	 *	Same integration for a function already evaluated at the quadrature samples
+	 *	(e.g. by a SphericalHarmonicsBatch built on GetSamples)
+	 *
+	 *	values: the function values at the GetNbSamples() samples
+	 */
+	template <typename T>
+	void Compute(double* outIntegral, double* outArea, const T* values, CartesianDomain dom, void* userDataDomain) const;
+
+	unsigned int GetNbSamples() const { return rOrder; }
+	const double* GetSamplesX() const { return quadValues; }
+	const double* GetSamplesY() const { return quadValues + rOrder; }
+	const double* GetSamplesZ() const { return quadValues + 2 * rOrder; }
+
+protected:
+	unsigned int rId;
+	unsigned int rOrder;
+	double* quadValues;		// [x_i] then [y_i], then [z_i], then [w_i] values
+};
+
+template <typename T>
+void SphericalFunctionIntegratorCartesian::Compute(double* outIntegral, double* outArea, const T* values, CartesianDomain dom, void* userDataDomain) const
+{
+	double intVal = 0.0;
+	double areaVal = 0.0;
+
+	const double* px = quadValues;
+	const double* py = quadValues + rOrder;
+	const double* pz = quadValues + 2 * rOrder;
+	const double* pw = quadValues + 3 * rOrder;
+
+	for(unsigned i = 0 ; i < rOrder ; i++)
+	{
+		if(dom(px[i], py[i], pz[i], userDataDomain))
+		{
+			intVal += pw[i] * double(values[i]);
+			areaVal += pw[i];
+		}
+	}
+
+	*outIntegral = intVal * 4.0 * M_PI;
+	*outArea = areaVal * 4.0 * M_PI;
+}
+
+bool SphericalFunctionIntegratorCartesian::RuleAvailable(unsigned int ruleId)
+{
+	return available_table(ruleId) == 1;
+}
+
+unsigned int SphericalFunctionIntegratorCartesian::RuleOrder(unsigned int ruleId)
+{
+	return order_table(ruleId);
+}
+
+unsigned int SphericalFunctionIntegratorCartesian::RulePrecision(unsigned int ruleId)
+{
+	return precision_table(ruleId);
+}
+
+#endif
@@ -4,7 +4,9 @@
 #include "Algo/Decimation/selector.h"
 #include "Algo/Decimation/approximator.h"
 #include "Utils/qem.h"
+#include "Utils/indexedHeap.h"
 #include "Utils/sphericalHarmonics.h"
+#include "Utils/sphericalHarmonicsBatch.h"
 
 #include "SphericalFunctionIntegratorCartesian.h"
 
@@ -33,7 +35,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<float, Dart>::iterator it;
+		typename Utils::IndexedHeap<float, Dart>::Handle handle;
 		bool valid;
 		static std::string CGoGNnameOfType() { return "LightfieldGradEdgeInfo"; }
 	} LightfieldEdgeInfo;
@@ -47,8 +49,11 @@ private:
 
 	SphericalFunctionIntegratorCartesian m_integrator;
 
-	std::multimap<float, Dart> edges;
-	typename std::multimap<float, Dart>::iterator cur;
+	// SH basis at the quadrature samples of m_integrator, built by init
+	Utils::SphericalHarmonicsBatch<REAL>* m_shBatch;
+	std::vector<REAL> m_squaredNorm;
+
+	Utils::IndexedHeap<float, Dart> edges;
 
 	void initEdgeInfo(Dart d);
 	void updateEdgeInfo(Dart d);
@@ -63,13 +68,6 @@ private:
 		return x*n[0] + y*n[1] + z*n[2] >= 0.0;
 	}
 
-	static double SHEvalCartesian_Error(double x, double y, double z, void* u)
-	{
-		SH& e = *(SH*)(u);
-		VEC3 c = e.evaluate_at(x, y, z, 0);
-		return c.norm2();
-	}
-
 public:
 	EdgeSelector_Radiance(
 		MAP& m,
@@ -87,7 +85,8 @@ public:
 		m_positionApproximator(posApprox),
 		m_normalApproximator(normApprox),
 		m_radianceApproximator(radApprox),
-		m_nb_coefs(0)
+		m_nb_coefs(0),
+		m_shBatch(NULL)
 	{
 		edgeInfo = m.template checkAttribute<EdgeInfo, EDGE, PFP2::MAP>("EdgeInfo");
 		m_quadric = m.template checkAttribute<Utils::Quadric<PFP2::REAL>, VERTEX, PFP2::MAP>(pos.name() + "_QEM");
@@ -100,6 +99,7 @@ public:
 		this->m_map.removeAttribute(m_quadric);
 //		this->m_map.removeAttribute(m_avgColor);
 		m_integrator.Release();
+		delete m_shBatch;
 	}
 
 	Algo::Surface::Decimation::SelectorType getType() { return Algo::Surface::Decimation::S_OTHER; }
@@ -123,11 +123,11 @@ public:
 			Dart dd = this->m_map.phi2(d);
 			if (edgeInfo[d].valid)
 			{
-				(*errors)[d] = edgeInfo[d].it->first;
+				(*errors)[d] = edges.key(edgeInfo[d].handle);
 			}
-			if (edgeInfo[dd].valid && edgeInfo[dd].it->first < (*errors)[d])
+			if (edgeInfo[dd].valid && edges.key(edgeInfo[dd].handle) < (*errors)[d])
 			{
-				(*errors)[d] = edgeInfo[dd].it->first;
+				(*errors)[d] = edges.key(edgeInfo[dd].handle);
 			}
 			if (!(edgeInfo[d].valid || edgeInfo[dd].valid))
 				(*errors)[d] = -1;
@@ -26,6 +26,11 @@ bool EdgeSelector_Radiance<PFP>::init()
 
 	m_integrator.Init(29) ;
 
+	delete m_shBatch;
+	m_shBatch = new Utils::SphericalHarmonicsBatch<REAL>(SH::get_resolution());
+	m_shBatch->setDirections(m_integrator.GetNbSamples(), m_integrator.GetSamplesX(), m_integrator.GetSamplesY(), m_integrator.GetSamplesZ());
+	m_squaredNorm.resize(m_integrator.GetNbSamples());
+
 	// init QEM quadrics
 	for (Vertex v : allVerticesOf(m))
 	{
@@ -43,15 +48,13 @@ bool EdgeSelector_Radiance<PFP>::init()
 		m_quadric[d_1] += q ;	// of the 3 incident vertices
 	}
 
-	// init multimap for each Half-edge
+	// init queue for each Half-edge
 	edges.clear() ;
 
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e) ;	// init the edges with their optimal position
-	}						// and insert them in the multimap according to their error
-
-	cur = edges.begin() ; 	// init the current edge to the first one
+	}						// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -59,9 +62,9 @@ bool EdgeSelector_Radiance<PFP>::init()
 template <typename PFP>
 bool EdgeSelector_Radiance<PFP>::nextEdge(Dart& d)  const
 {
-	if(cur == edges.end() || edges.empty())
+	if(edges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = edges.top() ;
 	return true ;
 }
 
@@ -72,35 +75,35 @@ void EdgeSelector_Radiance<PFP>::updateBeforeCollapse(Dart d)
 
 	Dart dd = m.phi2(d);
 
-	EdgeInfo& edgeE = edgeInfo[d];
-	if(edgeE.valid)
+	EdgeInfo* edgeE = &(edgeInfo[d]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		edges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		edges.erase(edgeE->handle) ;
 	}
-	edgeE = edgeInfo[m.phi1(d)];
-	if(edgeE.valid)
+	edgeE = &(edgeInfo[m.phi1(d)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		edges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		edges.erase(edgeE->handle) ;
 	}
-	edgeE = edgeInfo[m.phi_1(d)];
-	if(edgeE.valid)
+	edgeE = &(edgeInfo[m.phi_1(d)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		edges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		edges.erase(edgeE->handle) ;
 	}
-	edgeE = edgeInfo[m.phi1(dd)];
-	if(edgeE.valid)
+	edgeE = &(edgeInfo[m.phi1(dd)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		edges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		edges.erase(edgeE->handle) ;
 	}
-	edgeE = edgeInfo[m.phi_1(dd)];
-	if(edgeE.valid)
+	edgeE = &(edgeInfo[m.phi_1(dd)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		edges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		edges.erase(edgeE->handle) ;
 	}
 }
 
@@ -145,8 +148,6 @@ void EdgeSelector_Radiance<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 			}
 		}
 	}
-
-	cur = edges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -170,7 +171,7 @@ void EdgeSelector_Radiance<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if (einfo.valid)
-		edges.erase(einfo.it);
+		edges.erase(einfo.handle);
 
 	if (m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo);
@@ -214,7 +215,7 @@ void EdgeSelector_Radiance<PFP>::computeEdgeInfo(Dart d, EdgeInfo& einfo)
 		einfo.valid = false ;
 	else
 	{
-		einfo.it = this->edges.insert(std::make_pair(std::max(err, REAL(0)), d)) ;
+		einfo.handle = this->edges.insert(std::max(err, REAL(0)), d) ;
 		einfo.valid = true ;
 	}
 }
@@ -259,7 +260,8 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 
 		double integral;
 		double area;
-		m_integrator.Compute(&integral, &area, EdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, EdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
+		m_shBatch->evaluateSquaredNorm(diffRad.get_coef_tab(), &m_squaredNorm[0]);
+		m_integrator.Compute(&integral, &area, &m_squaredNorm[0], EdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
 
 		error += tArea * integral / area;
 
@@ -290,7 +292,8 @@ typename PFP::REAL EdgeSelector_Radiance<PFP>::computeRadianceError(Dart d, cons
 
 		double integral;
 		double area;
-		m_integrator.Compute(&integral, &area, EdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, EdgeSelector_Radiance<PFP>::isInHemisphere, n1.data());
+		m_shBatch->evaluateSquaredNorm(diffRad.get_coef_tab(), &m_squaredNorm[0]);
+		m_integrator.Compute(&integral, &area, &m_squaredNorm[0], EdgeSelector_Radiance<PFP>::isInHemisphere, n1.data());
 
 		error += tArea * integral / area;
 
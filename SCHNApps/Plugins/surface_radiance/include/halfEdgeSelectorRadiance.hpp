@@ -38,6 +38,11 @@ bool HalfEdgeSelector_Radiance<PFP>::init()
 
 	m_integrator.Init(29) ;
 
+	delete m_shBatch;
+	m_shBatch = new Utils::SphericalHarmonicsBatch<REAL>(SH::get_resolution());
+	m_shBatch->setDirections(m_integrator.GetNbSamples(), m_integrator.GetSamplesX(), m_integrator.GetSamplesY(), m_integrator.GetSamplesZ());
+	m_squaredNorm.resize(m_integrator.GetNbSamples());
+
 	// init QEM quadrics
 	for (Vertex v : allVerticesOf(m))
 	{
@@ -55,15 +60,13 @@ bool HalfEdgeSelector_Radiance<PFP>::init()
 		m_quadric[d_1] += q ;	// of the 3 incident vertices
 	}
 
-	// init multimap for each Half-edge
+	// init queue for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin() ; d != m.end() ; m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
-
-	cur = halfEdges.begin() ; 	// init the current edge to the first one
+	}							// and insert them in the queue according to their error
 
 	return true ;
 }
@@ -71,9 +74,9 @@ bool HalfEdgeSelector_Radiance<PFP>::init()
 template <typename PFP>
 bool HalfEdgeSelector_Radiance<PFP>::nextEdge(Dart& d)  const
 {
-	if(cur == halfEdges.end() || halfEdges.empty())
+	if(halfEdges.empty())
 		return false ;
-	d = (*cur).second ;
+	d = halfEdges.top() ;
 	return true ;
 }
 
@@ -84,41 +87,41 @@ void HalfEdgeSelector_Radiance<PFP>::updateBeforeCollapse(Dart d)
 
 	Dart dd = m.phi2(d);
 
-	HalfEdgeInfo& edgeE = halfEdgeInfo[d];
-	if(edgeE.valid)
+	HalfEdgeInfo* edgeE = &(halfEdgeInfo[d]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		halfEdges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		halfEdges.erase(edgeE->handle) ;
 	}
-	edgeE = halfEdgeInfo[dd];
-	if(edgeE.valid)
+	edgeE = &(halfEdgeInfo[dd]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		halfEdges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		halfEdges.erase(edgeE->handle) ;
 	}
-	edgeE = halfEdgeInfo[m.phi1(d)];
-	if(edgeE.valid)
+	edgeE = &(halfEdgeInfo[m.phi1(d)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		halfEdges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		halfEdges.erase(edgeE->handle) ;
 	}
-	edgeE = halfEdgeInfo[m.phi_1(d)];
-	if(edgeE.valid)
+	edgeE = &(halfEdgeInfo[m.phi_1(d)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		halfEdges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		halfEdges.erase(edgeE->handle) ;
 	}
-	edgeE = halfEdgeInfo[m.phi1(dd)];
-	if(edgeE.valid)
+	edgeE = &(halfEdgeInfo[m.phi1(dd)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		halfEdges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		halfEdges.erase(edgeE->handle) ;
 	}
-	edgeE = halfEdgeInfo[m.phi_1(dd)];
-	if(edgeE.valid)
+	edgeE = &(halfEdgeInfo[m.phi_1(dd)]);
+	if(edgeE->valid)
 	{
-		edgeE.valid = false ;
-		halfEdges.erase(edgeE.it) ;
+		edgeE->valid = false ;
+		halfEdges.erase(edgeE->handle) ;
 	}
 }
 
@@ -187,8 +190,6 @@ void HalfEdgeSelector_Radiance<PFP>::updateAfterCollapse(Dart d2, Dart dd2)
 		}
 		it = m.phi2(m.phi_1(it));
 	} while (it != stop);
-
-	cur = halfEdges.begin() ; // set the current edge to the first one
 }
 
 template <typename PFP>
@@ -213,7 +214,7 @@ void HalfEdgeSelector_Radiance<PFP>::updateHalfEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if (heinfo.valid)
-			halfEdges.erase(heinfo.it);
+			halfEdges.erase(heinfo.handle);
 		if (m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo);
 		else
@@ -230,7 +231,7 @@ void HalfEdgeSelector_Radiance<PFP>::updateHalfEdgeInfo(Dart d, bool recompute)
 		{									// if the edge cannot be collapsed now
 			if (heinfo.valid)				// and it was before
 			{
-				halfEdges.erase(heinfo.it) ;
+				halfEdges.erase(heinfo.handle) ;
 				heinfo.valid = false ;
 			}
 		}
@@ -275,7 +276,7 @@ void HalfEdgeSelector_Radiance<PFP>::computeHalfEdgeInfo(Dart d, HalfEdgeInfo& h
 		heinfo.valid = false ;
 	else
 	{
-		heinfo.it = this->halfEdges.insert(std::make_pair(std::max(err, REAL(0)), d)) ;
+		heinfo.handle = this->halfEdges.insert(std::max(err, REAL(0)), d) ;
 		heinfo.valid = true ;
 	}
 }
@@ -319,7 +320,8 @@ typename PFP::REAL HalfEdgeSelector_Radiance<PFP>::computeRadianceError(Dart d)
 
 		double integral;
 		double area;
-		m_integrator.Compute(&integral, &area, HalfEdgeSelector_Radiance<PFP>::SHEvalCartesian_Error, &diffRad, HalfEdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
+		m_shBatch->evaluateSquaredNorm(diffRad.get_coef_tab(), &m_squaredNorm[0]);
+		m_integrator.Compute(&integral, &area, &m_squaredNorm[0], HalfEdgeSelector_Radiance<PFP>::isInHemisphere, n0.data());
 
 		error += tArea * integral / area;
 
@@ -6,6 +6,7 @@
 #include "dialog_computeRadianceDistance.h"
 
 #include "Utils/sphericalHarmonics.h"
+#include "Utils/sphericalHarmonicsBatch.h"
 #include "Utils/bivariatePolynomials.h"
 #include "Utils/Shaders/shaderRadiancePerVertex.h"
 #include "Utils/Shaders/shaderRadiancePerVertex_P.h"
@@ -169,13 +170,6 @@ protected:
 		PFP2::REAL* n = (PFP2::REAL*)(u);
 		return x*n[0] + y*n[1] + z*n[2] >= 0.0;
 	}
-
-	static double SHEvalCartesian_Error(double x, double y, double z, void* u)
-	{
-		Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>& e = *(Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>*)(u);
-		PFP2::VEC3 c = e.evaluate_at(x, y, z, 0);
-		return c.norm2();
-	}
 };
 
 } // namespace SCHNApps
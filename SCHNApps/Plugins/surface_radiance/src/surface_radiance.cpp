@@ -662,6 +662,12 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 	SphericalFunctionIntegratorCartesian integrator;
 	integrator.Init(29);
 
+	// SH basis at the quadrature samples, shared by all threads
+	const unsigned int nbSamples = integrator.GetNbSamples();
+	Utils::SphericalHarmonicsBatch<PFP2::REAL> shBatch(Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3>::get_resolution());
+	shBatch.setDirections(nbSamples, integrator.GetSamplesX(), integrator.GetSamplesY(), integrator.GetSamplesZ());
+	std::vector<std::vector<PFP2::REAL> > squaredNorms(CGoGN::Parallel::NumberOfThreads + 1, std::vector<PFP2::REAL>(nbSamples));
+
 	PFP2::MAP* map1 = mh1->getMap();
 	PFP2::MAP* map2 = mh2->getMap();
 
@@ -671,9 +677,6 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 
 	// for each vertex of map1
 
-	std::vector<PFP2::REAL> errors;
-	errors.reserve(100000);
-
 	map2->setExternalThreadsAuthorization(true);
 
 	Parallel::foreach_cell<VERTEX>(*map1, [&] (Vertex v, unsigned int threadIndex)
@@ -721,20 +724,24 @@ void Surface_Radiance_Plugin::computeRadianceDistance(
 		Utils::SphericalHarmonics<PFP2::REAL, PFP2::VEC3> diffRad(mapParams1.radiance[v]);
 		diffRad -= CPR;
 
+		std::vector<PFP2::REAL>& squaredNorm = squaredNorms[threadIndex];
+		shBatch.evaluateSquaredNorm(diffRad.get_coef_tab(), &squaredNorm[0]);
+
 		double integral;
 		double area;
-		integrator.Compute(&integral, &area, SHEvalCartesian_Error, &diffRad, isInHemisphere, N.data());
+		integrator.Compute(&integral, &area, &squaredNorm[0], isInHemisphere, N.data());
 
-		PFP2::REAL radError = integral / area;
-
-		distance1[v] = radError;
-
-		errors.push_back(radError);
+		distance1[v] = integral / area;
 	}
 	);
 
 	map2->setExternalThreadsAuthorization(false);
 
+	std::vector<PFP2::REAL> errors;
+	errors.reserve(100000);
+	for (Vertex v : allVerticesOf(*map1))
+		errors.push_back(distance1[v]);
+
 	std::sort(errors.begin(), errors.end());
 	PFP2::REAL Q1 = errors[int(errors.size() / 4)];
 //	PFP2::REAL Q2 = errors[int(errors.size() / 2)];